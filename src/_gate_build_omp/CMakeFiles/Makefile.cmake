@@ -0,0 +1,109 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/src/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitLinkInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindOpenMP.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/test_algebra.dir/DependInfo.cmake"
+  "CMakeFiles/test_apply.dir/DependInfo.cmake"
+  "CMakeFiles/test_apsp.dir/DependInfo.cmake"
+  "CMakeFiles/test_assign.dir/DependInfo.cmake"
+  "CMakeFiles/test_bc.dir/DependInfo.cmake"
+  "CMakeFiles/test_bfs.dir/DependInfo.cmake"
+  "CMakeFiles/test_cluster.dir/DependInfo.cmake"
+  "CMakeFiles/test_complement.dir/DependInfo.cmake"
+  "CMakeFiles/test_compressed_snapshot.dir/DependInfo.cmake"
+  "CMakeFiles/test_ewiseadd_matrix.dir/DependInfo.cmake"
+  "CMakeFiles/test_ewiseadd_vector.dir/DependInfo.cmake"
+  "CMakeFiles/test_ewisemult_matrix.dir/DependInfo.cmake"
+  "CMakeFiles/test_ewisemult_vector.dir/DependInfo.cmake"
+  "CMakeFiles/test_expressions.dir/DependInfo.cmake"
+  "CMakeFiles/test_extract_column.dir/DependInfo.cmake"
+  "CMakeFiles/test_extract_stdmat.dir/DependInfo.cmake"
+  "CMakeFiles/test_extract_stdvec.dir/DependInfo.cmake"
+  "CMakeFiles/test_extracttuples.dir/DependInfo.cmake"
+  "CMakeFiles/test_fusion.dir/DependInfo.cmake"
+  "CMakeFiles/test_homework.dir/DependInfo.cmake"
+  "CMakeFiles/test_in_place.dir/DependInfo.cmake"
+  "CMakeFiles/test_k_truss.dir/DependInfo.cmake"
+  "CMakeFiles/test_matrix_build.dir/DependInfo.cmake"
+  "CMakeFiles/test_matrix_interop.dir/DependInfo.cmake"
+  "CMakeFiles/test_matrix_io.dir/DependInfo.cmake"
+  "CMakeFiles/test_maxflow.dir/DependInfo.cmake"
+  "CMakeFiles/test_metrics.dir/DependInfo.cmake"
+  "CMakeFiles/test_mis.dir/DependInfo.cmake"
+  "CMakeFiles/test_mst.dir/DependInfo.cmake"
+  "CMakeFiles/test_mxm.dir/DependInfo.cmake"
+  "CMakeFiles/test_mxv.dir/DependInfo.cmake"
+  "CMakeFiles/test_nonblocking.dir/DependInfo.cmake"
+  "CMakeFiles/test_numa_placement.dir/DependInfo.cmake"
+  "CMakeFiles/test_page_rank.dir/DependInfo.cmake"
+  "CMakeFiles/test_reduce.dir/DependInfo.cmake"
+  "CMakeFiles/test_reduction_mode.dir/DependInfo.cmake"
+  "CMakeFiles/test_snapshot.dir/DependInfo.cmake"
+  "CMakeFiles/test_sssp.dir/DependInfo.cmake"
+  "CMakeFiles/test_task_pool.dir/DependInfo.cmake"
+  "CMakeFiles/test_tiled_matrix.dir/DependInfo.cmake"
+  "CMakeFiles/test_transpose.dir/DependInfo.cmake"
+  "CMakeFiles/test_triangle_count.dir/DependInfo.cmake"
+  "CMakeFiles/test_vxm.dir/DependInfo.cmake"
+  "CMakeFiles/test_parallel_openmp.dir/DependInfo.cmake"
+  "CMakeFiles/bfs_demo.dir/DependInfo.cmake"
+  "CMakeFiles/bfs_level_demo.dir/DependInfo.cmake"
+  "CMakeFiles/k_truss_demo.dir/DependInfo.cmake"
+  "CMakeFiles/masked_mxm_homework.dir/DependInfo.cmake"
+  "CMakeFiles/mxm_homework.dir/DependInfo.cmake"
+  "CMakeFiles/peer_pressure_demo.dir/DependInfo.cmake"
+  "CMakeFiles/peer_pressure_karate_demo.dir/DependInfo.cmake"
+  "CMakeFiles/reduction_mode_demo.dir/DependInfo.cmake"
+  "CMakeFiles/sssp_demo.dir/DependInfo.cmake"
+  "CMakeFiles/triangle_count_demo.dir/DependInfo.cmake"
+  )
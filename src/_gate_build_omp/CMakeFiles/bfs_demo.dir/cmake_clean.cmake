@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bfs_demo.dir/demo/bfs_demo.cpp.o"
+  "CMakeFiles/bfs_demo.dir/demo/bfs_demo.cpp.o.d"
+  "bin/bfs_demo"
+  "bin/bfs_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bfs_demo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
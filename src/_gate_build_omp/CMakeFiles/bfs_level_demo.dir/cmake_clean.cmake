@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bfs_level_demo.dir/demo/bfs_level_demo.cpp.o"
+  "CMakeFiles/bfs_level_demo.dir/demo/bfs_level_demo.cpp.o.d"
+  "bin/bfs_level_demo"
+  "bin/bfs_level_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bfs_level_demo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/k_truss_demo.dir/demo/k_truss_demo.cpp.o"
+  "CMakeFiles/k_truss_demo.dir/demo/k_truss_demo.cpp.o.d"
+  "bin/k_truss_demo"
+  "bin/k_truss_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/k_truss_demo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/masked_mxm_homework.dir/demo/masked_mxm_homework.cpp.o"
+  "CMakeFiles/masked_mxm_homework.dir/demo/masked_mxm_homework.cpp.o.d"
+  "bin/masked_mxm_homework"
+  "bin/masked_mxm_homework.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/masked_mxm_homework.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
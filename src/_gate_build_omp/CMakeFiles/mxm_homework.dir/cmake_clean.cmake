@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mxm_homework.dir/demo/mxm_homework.cpp.o"
+  "CMakeFiles/mxm_homework.dir/demo/mxm_homework.cpp.o.d"
+  "bin/mxm_homework"
+  "bin/mxm_homework.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mxm_homework.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
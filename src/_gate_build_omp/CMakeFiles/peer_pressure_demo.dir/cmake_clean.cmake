@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/peer_pressure_demo.dir/demo/peer_pressure_demo.cpp.o"
+  "CMakeFiles/peer_pressure_demo.dir/demo/peer_pressure_demo.cpp.o.d"
+  "bin/peer_pressure_demo"
+  "bin/peer_pressure_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/peer_pressure_demo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/reduction_mode_demo.dir/demo/reduction_mode_demo.cpp.o"
+  "CMakeFiles/reduction_mode_demo.dir/demo/reduction_mode_demo.cpp.o.d"
+  "bin/reduction_mode_demo"
+  "bin/reduction_mode_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/reduction_mode_demo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sssp_demo.dir/demo/sssp_demo.cpp.o"
+  "CMakeFiles/sssp_demo.dir/demo/sssp_demo.cpp.o.d"
+  "bin/sssp_demo"
+  "bin/sssp_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sssp_demo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_apply.dir/test/test_apply.cpp.o"
+  "CMakeFiles/test_apply.dir/test/test_apply.cpp.o.d"
+  "bin/test_apply"
+  "bin/test_apply.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_apply.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_apsp.dir/test/test_apsp.cpp.o"
+  "CMakeFiles/test_apsp.dir/test/test_apsp.cpp.o.d"
+  "bin/test_apsp"
+  "bin/test_apsp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_apsp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
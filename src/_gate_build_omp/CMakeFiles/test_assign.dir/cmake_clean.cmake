@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_assign.dir/test/test_assign.cpp.o"
+  "CMakeFiles/test_assign.dir/test/test_assign.cpp.o.d"
+  "bin/test_assign"
+  "bin/test_assign.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_assign.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_bfs.dir/test/test_bfs.cpp.o"
+  "CMakeFiles/test_bfs.dir/test/test_bfs.cpp.o.d"
+  "bin/test_bfs"
+  "bin/test_bfs.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_bfs.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
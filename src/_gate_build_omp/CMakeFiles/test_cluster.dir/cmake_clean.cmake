@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_cluster.dir/test/test_cluster.cpp.o"
+  "CMakeFiles/test_cluster.dir/test/test_cluster.cpp.o.d"
+  "bin/test_cluster"
+  "bin/test_cluster.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_cluster.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
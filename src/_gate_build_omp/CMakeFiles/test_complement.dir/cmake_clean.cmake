@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_complement.dir/test/test_complement.cpp.o"
+  "CMakeFiles/test_complement.dir/test/test_complement.cpp.o.d"
+  "bin/test_complement"
+  "bin/test_complement.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_complement.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_compressed_snapshot.dir/test/test_compressed_snapshot.cpp.o"
+  "CMakeFiles/test_compressed_snapshot.dir/test/test_compressed_snapshot.cpp.o.d"
+  "bin/test_compressed_snapshot"
+  "bin/test_compressed_snapshot.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_compressed_snapshot.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_ewiseadd_matrix.dir/test/test_ewiseadd_matrix.cpp.o"
+  "CMakeFiles/test_ewiseadd_matrix.dir/test/test_ewiseadd_matrix.cpp.o.d"
+  "bin/test_ewiseadd_matrix"
+  "bin/test_ewiseadd_matrix.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_ewiseadd_matrix.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
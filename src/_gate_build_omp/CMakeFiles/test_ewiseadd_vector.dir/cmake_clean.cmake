@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_ewiseadd_vector.dir/test/test_ewiseadd_vector.cpp.o"
+  "CMakeFiles/test_ewiseadd_vector.dir/test/test_ewiseadd_vector.cpp.o.d"
+  "bin/test_ewiseadd_vector"
+  "bin/test_ewiseadd_vector.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_ewiseadd_vector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
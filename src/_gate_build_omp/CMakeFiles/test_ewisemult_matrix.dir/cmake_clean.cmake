@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_ewisemult_matrix.dir/test/test_ewisemult_matrix.cpp.o"
+  "CMakeFiles/test_ewisemult_matrix.dir/test/test_ewisemult_matrix.cpp.o.d"
+  "bin/test_ewisemult_matrix"
+  "bin/test_ewisemult_matrix.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_ewisemult_matrix.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_ewisemult_vector.dir/test/test_ewisemult_vector.cpp.o"
+  "CMakeFiles/test_ewisemult_vector.dir/test/test_ewisemult_vector.cpp.o.d"
+  "bin/test_ewisemult_vector"
+  "bin/test_ewisemult_vector.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_ewisemult_vector.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
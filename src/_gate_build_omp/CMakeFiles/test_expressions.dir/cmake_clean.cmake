@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_expressions.dir/test/test_expressions.cpp.o"
+  "CMakeFiles/test_expressions.dir/test/test_expressions.cpp.o.d"
+  "bin/test_expressions"
+  "bin/test_expressions.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_expressions.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
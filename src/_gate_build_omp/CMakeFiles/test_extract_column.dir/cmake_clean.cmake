@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_extract_column.dir/test/test_extract_column.cpp.o"
+  "CMakeFiles/test_extract_column.dir/test/test_extract_column.cpp.o.d"
+  "bin/test_extract_column"
+  "bin/test_extract_column.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_extract_column.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
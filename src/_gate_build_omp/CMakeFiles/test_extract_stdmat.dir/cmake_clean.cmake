@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_extract_stdmat.dir/test/test_extract_stdmat.cpp.o"
+  "CMakeFiles/test_extract_stdmat.dir/test/test_extract_stdmat.cpp.o.d"
+  "bin/test_extract_stdmat"
+  "bin/test_extract_stdmat.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_extract_stdmat.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
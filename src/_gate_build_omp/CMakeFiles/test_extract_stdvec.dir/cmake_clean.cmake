@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_extract_stdvec.dir/test/test_extract_stdvec.cpp.o"
+  "CMakeFiles/test_extract_stdvec.dir/test/test_extract_stdvec.cpp.o.d"
+  "bin/test_extract_stdvec"
+  "bin/test_extract_stdvec.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_extract_stdvec.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_extracttuples.dir/test/test_extracttuples.cpp.o"
+  "CMakeFiles/test_extracttuples.dir/test/test_extracttuples.cpp.o.d"
+  "bin/test_extracttuples"
+  "bin/test_extracttuples.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_extracttuples.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_fusion.dir/test/test_fusion.cpp.o"
+  "CMakeFiles/test_fusion.dir/test/test_fusion.cpp.o.d"
+  "bin/test_fusion"
+  "bin/test_fusion.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_fusion.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
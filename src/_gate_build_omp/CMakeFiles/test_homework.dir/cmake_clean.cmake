@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_homework.dir/test/test_homework.cpp.o"
+  "CMakeFiles/test_homework.dir/test/test_homework.cpp.o.d"
+  "bin/test_homework"
+  "bin/test_homework.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_homework.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
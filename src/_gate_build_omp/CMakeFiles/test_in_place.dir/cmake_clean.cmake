@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_in_place.dir/test/test_in_place.cpp.o"
+  "CMakeFiles/test_in_place.dir/test/test_in_place.cpp.o.d"
+  "bin/test_in_place"
+  "bin/test_in_place.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_in_place.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_k_truss.dir/test/test_k_truss.cpp.o"
+  "CMakeFiles/test_k_truss.dir/test/test_k_truss.cpp.o.d"
+  "bin/test_k_truss"
+  "bin/test_k_truss.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_k_truss.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
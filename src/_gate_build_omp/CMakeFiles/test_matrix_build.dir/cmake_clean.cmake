@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_matrix_build.dir/test/test_matrix_build.cpp.o"
+  "CMakeFiles/test_matrix_build.dir/test/test_matrix_build.cpp.o.d"
+  "bin/test_matrix_build"
+  "bin/test_matrix_build.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_matrix_build.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
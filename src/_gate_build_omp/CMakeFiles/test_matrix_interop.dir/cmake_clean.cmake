@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_matrix_interop.dir/test/test_matrix_interop.cpp.o"
+  "CMakeFiles/test_matrix_interop.dir/test/test_matrix_interop.cpp.o.d"
+  "bin/test_matrix_interop"
+  "bin/test_matrix_interop.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_matrix_interop.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
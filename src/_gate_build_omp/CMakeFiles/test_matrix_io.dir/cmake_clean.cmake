@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_matrix_io.dir/test/test_matrix_io.cpp.o"
+  "CMakeFiles/test_matrix_io.dir/test/test_matrix_io.cpp.o.d"
+  "bin/test_matrix_io"
+  "bin/test_matrix_io.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_matrix_io.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
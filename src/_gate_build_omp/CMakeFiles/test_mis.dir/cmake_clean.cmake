@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mis.dir/test/test_mis.cpp.o"
+  "CMakeFiles/test_mis.dir/test/test_mis.cpp.o.d"
+  "bin/test_mis"
+  "bin/test_mis.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mis.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_mst.dir/test/test_mst.cpp.o"
+  "CMakeFiles/test_mst.dir/test/test_mst.cpp.o.d"
+  "bin/test_mst"
+  "bin/test_mst.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_mst.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
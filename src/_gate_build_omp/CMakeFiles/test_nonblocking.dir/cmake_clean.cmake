@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_nonblocking.dir/test/test_nonblocking.cpp.o"
+  "CMakeFiles/test_nonblocking.dir/test/test_nonblocking.cpp.o.d"
+  "bin/test_nonblocking"
+  "bin/test_nonblocking.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_nonblocking.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
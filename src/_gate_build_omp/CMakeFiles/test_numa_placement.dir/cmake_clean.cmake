@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_numa_placement.dir/test/test_numa_placement.cpp.o"
+  "CMakeFiles/test_numa_placement.dir/test/test_numa_placement.cpp.o.d"
+  "bin/test_numa_placement"
+  "bin/test_numa_placement.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_numa_placement.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_page_rank.dir/test/test_page_rank.cpp.o"
+  "CMakeFiles/test_page_rank.dir/test/test_page_rank.cpp.o.d"
+  "bin/test_page_rank"
+  "bin/test_page_rank.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_page_rank.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_parallel_openmp.dir/graphblas/platforms/openmp/test/test_parallel.cpp.o"
+  "CMakeFiles/test_parallel_openmp.dir/graphblas/platforms/openmp/test/test_parallel.cpp.o.d"
+  "bin/test_parallel_openmp"
+  "bin/test_parallel_openmp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_parallel_openmp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_reduction_mode.dir/test/test_reduction_mode.cpp.o"
+  "CMakeFiles/test_reduction_mode.dir/test/test_reduction_mode.cpp.o.d"
+  "bin/test_reduction_mode"
+  "bin/test_reduction_mode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_reduction_mode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_sssp.dir/test/test_sssp.cpp.o"
+  "CMakeFiles/test_sssp.dir/test/test_sssp.cpp.o.d"
+  "bin/test_sssp"
+  "bin/test_sssp.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_sssp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_task_pool.dir/test/test_task_pool.cpp.o"
+  "CMakeFiles/test_task_pool.dir/test/test_task_pool.cpp.o.d"
+  "bin/test_task_pool"
+  "bin/test_task_pool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_task_pool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
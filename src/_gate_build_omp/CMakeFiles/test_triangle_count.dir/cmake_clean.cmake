@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_triangle_count.dir/test/test_triangle_count.cpp.o"
+  "CMakeFiles/test_triangle_count.dir/test/test_triangle_count.cpp.o.d"
+  "bin/test_triangle_count"
+  "bin/test_triangle_count.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_triangle_count.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
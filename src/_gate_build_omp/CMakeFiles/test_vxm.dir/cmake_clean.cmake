@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_vxm.dir/test/test_vxm.cpp.o"
+  "CMakeFiles/test_vxm.dir/test/test_vxm.cpp.o.d"
+  "bin/test_vxm"
+  "bin/test_vxm.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_vxm.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/triangle_count_demo.dir/demo/triangle_count_demo.cpp.o"
+  "CMakeFiles/triangle_count_demo.dir/demo/triangle_count_demo.cpp.o.d"
+  "bin/triangle_count_demo"
+  "bin/triangle_count_demo.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/triangle_count_demo.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
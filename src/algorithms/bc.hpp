@@ -46,6 +46,53 @@
 
 namespace algorithms
 {
+    /// Number of sources handled by one task of the batch BC algorithms.
+    static GraphBLAS::IndexType const BC_SOURCES_PER_TASK = 32;
+
+    //************************************************************************
+    /**
+     * @brief Split a batch of sources into batches of BC_SOURCES_PER_TASK,
+     *        compute their BC contributions as tasks and add them up.
+     *
+     * The batches do not depend on the number of threads, so neither does
+     * the result.
+     *
+     * @param[in]  n         The number of vertices in the graph.
+     * @param[in]  s         The set of source vertex indices.
+     * @param[in]  batch_fn  batch_fn(batch) returns the BC contributions
+     *                       from the sources in batch.
+     */
+    template<typename ScalarT, typename BatchFunctionT>
+    std::vector<ScalarT> sum_over_source_batches(
+        GraphBLAS::IndexType             n,
+        GraphBLAS::IndexArrayType const &s,
+        BatchFunctionT                   batch_fn)
+    {
+        GraphBLAS::IndexType num_batches(
+            (s.size() + BC_SOURCES_PER_TASK - 1)/BC_SOURCES_PER_TASK);
+        std::vector<std::vector<ScalarT> > partials(num_batches);
+
+        GraphBLAS::parallel_for(
+            0, s.size(),
+            [&](GraphBLAS::IndexType begin, GraphBLAS::IndexType end)
+            {
+                GraphBLAS::IndexArrayType batch(s.begin() + begin,
+                                                s.begin() + end);
+                partials[begin/BC_SOURCES_PER_TASK] = batch_fn(batch);
+            },
+            BC_SOURCES_PER_TASK);
+
+        std::vector<ScalarT> result(n, static_cast<ScalarT>(0));
+        for (auto const &partial : partials)
+        {
+            for (GraphBLAS::IndexType k = 0; k < n; ++k)
+            {
+                result[k] += partial[k];
+            }
+        }
+        return result;
+    }
+
     //************************************************************************
     /**
      * @brief Compute the vertex betweenness centrality of all vertices in the
@@ -86,6 +133,16 @@ namespace algorithms
             throw GraphBLAS::DimensionException();
         }
 
+        // Large batches are split into batches of BC_SOURCES_PER_TASK
+        // sources that run as separate tasks.
+        if (nsver > BC_SOURCES_PER_TASK)
+        {
+            return sum_over_source_batches<float>(
+                A.nrows(), s,
+                [&A](GraphBLAS::IndexArrayType const &batch)
+                { return vertex_betweenness_centrality_batch_alt_trans_v2(A, batch); });
+        }
+
         GRB_BC_LOG("batch size (p): " << nsver);
 
         using T = typename MatrixT::ScalarType;
@@ -293,6 +350,16 @@ namespace algorithms
             throw GraphBLAS::DimensionException();
         }
 
+        // Large batches are split into batches of BC_SOURCES_PER_TASK
+        // sources that run as separate tasks.
+        if (nsver > BC_SOURCES_PER_TASK)
+        {
+            return sum_over_source_batches<float>(
+                A.nrows(), s,
+                [&A](GraphBLAS::IndexArrayType const &batch)
+                { return vertex_betweenness_centrality_batch_alt_trans(A, batch); });
+        }
+
         using T = typename MatrixT::ScalarType;
 
         GraphBLAS::IndexType m = A.nrows();
@@ -468,6 +535,16 @@ namespace algorithms
             throw GraphBLAS::DimensionException();
         }
 
+        // Large batches are split into batches of BC_SOURCES_PER_TASK
+        // sources that run as separate tasks.
+        if (nsver > BC_SOURCES_PER_TASK)
+        {
+            return sum_over_source_batches<float>(
+                A.nrows(), s,
+                [&A](GraphBLAS::IndexArrayType const &batch)
+                { return vertex_betweenness_centrality_batch_alt(A, batch); });
+        }
+
         using T = typename MatrixT::ScalarType;
 
         GraphBLAS::IndexType m(A.nrows());
@@ -645,6 +722,16 @@ namespace algorithms
             throw GraphBLAS::DimensionException();
         }
 
+        // Large batches are split into batches of BC_SOURCES_PER_TASK
+        // sources that run as separate tasks.
+        if (nsver > BC_SOURCES_PER_TASK)
+        {
+            return sum_over_source_batches<float>(
+                A.nrows(), s,
+                [&A](GraphBLAS::IndexArrayType const &batch)
+                { return vertex_betweenness_centrality_batch(A, batch); });
+        }
+
         using T = typename MatrixT::ScalarType;
 
         GraphBLAS::IndexType m(A.nrows());
@@ -829,6 +916,16 @@ namespace algorithms
             throw GraphBLAS::DimensionException();
         }
 
+        // Large batches are split into batches of BC_SOURCES_PER_TASK
+        // sources that run as separate tasks.
+        if (p > BC_SOURCES_PER_TASK)
+        {
+            return sum_over_source_batches<double>(
+                graph.nrows(), src_nodes,
+                [&graph](GraphBLAS::IndexArrayType const &batch)
+                { return vertex_betweenness_centrality_batch_old(graph, batch); });
+        }
+
         using T = typename MatrixT::ScalarType;
 
         // GrB_Matrix_nrows(&N, graph)
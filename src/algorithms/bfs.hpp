@@ -124,6 +124,10 @@ namespace
 //****************************************************************************
 namespace algorithms
 {
+    /// Number of traversals (rows of the wavefronts) run by one task of
+    /// bfs_batch.
+    static GraphBLAS::IndexType const BFS_TRAVERSALS_PER_TASK = 16;
+
     //************************************************************************
     /**
      * @brief Perform a single breadth first search (BFS) traversal on the
@@ -216,6 +220,19 @@ namespace algorithms
     {
         using T = typename MatrixT::ScalarType;
 
+        // The traversals are independent: run blocks of them as tasks.
+        if ((GraphBLAS::TaskPool::instance().num_threads() > 1) &&
+            (wavefronts.nrows() > BFS_TRAVERSALS_PER_TASK))
+        {
+            parent_list = wavefronts;
+            GraphBLAS::for_each_row_block(
+                parent_list, BFS_TRAVERSALS_PER_TASK,
+                [&graph](GraphBLAS::Matrix<
+                             typename ParentListMatrixT::ScalarType> &block)
+                { bfs_batch(graph, block, block); });
+            return;
+        }
+
         // Set the roots parents to themselves using one-based indices because
         // the mask is sensitive to stored zeros.
         parent_list = wavefronts;
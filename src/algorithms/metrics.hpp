@@ -326,6 +326,38 @@ namespace algorithms
         return sum;
     }
 
+    /**
+     * @brief Compute the closeness centrality of a set of vertices in the
+     *        given graph.
+     *
+     * The search from each vertex runs as a separate task.
+     *
+     * @param[in]  graph  The graph to compute the closeness centrality of
+     *                    vertices in.
+     * @param[in]  vids   The vertices to compute the closeness centrality of.
+     *
+     * @return The closeness centrality of each vertex in vids
+     */
+    template<typename MatrixT>
+    std::vector<typename MatrixT::ScalarType> closeness_centrality(
+        MatrixT const                   &graph,
+        GraphBLAS::IndexArrayType const &vids)
+    {
+        std::vector<typename MatrixT::ScalarType> result(vids.size());
+
+        GraphBLAS::parallel_for(
+            0, vids.size(),
+            [&](GraphBLAS::IndexType begin, GraphBLAS::IndexType end)
+            {
+                for (GraphBLAS::IndexType idx = begin; idx < end; ++idx)
+                {
+                    result[idx] = closeness_centrality(graph, vids[idx]);
+                }
+            });
+
+        return result;
+    }
+
 } // algorithms
 
 #endif // METRICS_HPP
@@ -142,17 +142,22 @@ namespace algorithms
 
         // Create an adjacency matrix of the correct type (combining
         // source vertex ID with edge weight
-        GraphBLAS::IndexArrayType i(graph.nvals());
-        GraphBLAS::IndexArrayType j(graph.nvals());
-        std::vector<T> vals(graph.nvals());
-        graph.extractTuples(i.begin(), j.begin(), vals.begin());
-        std::vector<MSTType<T>> new_vals;
-        for (GraphBLAS::IndexType ix = 0; ix < i.size(); ++ix)
-        {
-            new_vals.push_back(std::make_pair(i[ix], vals[ix]));
-        }
+        GraphBLAS::MatrixRows<MSTType<T>> A_rows(rows);
+        GraphBLAS::visit_rows(
+            graph,
+            [&](GraphBLAS::IndexType row_idx,
+                std::vector<std::tuple<GraphBLAS::IndexType, T> > const &row)
+            {
+                A_rows[row_idx].reserve(row.size());
+                for (auto const &elt : row)
+                {
+                    A_rows[row_idx].push_back(std::make_tuple(
+                        std::get<0>(elt),
+                        std::make_pair(row_idx, std::get<1>(elt))));
+                }
+            });
         GraphBLAS::Matrix<MSTType<T>> A(rows, cols);
-        A.build(i, j, new_vals);
+        GraphBLAS::import_rows(A, std::move(A_rows));
         //GraphBLAS::print_matrix(std::cout, A, "Hybrid A matrix");
 
         // chose some arbitrary vertex to start
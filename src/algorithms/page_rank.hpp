@@ -40,6 +40,14 @@
 
 namespace algorithms
 {
+    /// x*x, the squared error of each element
+    template <typename D1, typename D2 = D1>
+    struct Square
+    {
+        typedef D2 result_type;
+        inline D2 operator()(D1 input) const { return input*input; }
+    };
+
     /**
      * @brief Compute the page rank for each node in a graph.
      *
@@ -81,27 +89,26 @@ namespace algorithms
             throw GraphBLAS::DimensionException();
         }
 
-        // Compute the scaled graph matrix
-        GraphBLAS::Matrix<RealT> m(rows, cols);
-
-        // cast graph scalar type to RealT
-        GraphBLAS::apply(m,
+        // Rather than a copy of the graph with each row normalized by its
+        // out-degree and scaled by the damping factor, compute the scale
+        // of each row (damping_factor/(sum of the row)) and apply it to the
+        // ranks before each vxm, so that the graph is only read.  (This
+        // lets page_rank run on a TiledMatrix.)
+        GraphBLAS::Vector<RealT> row_scale(rows);
+        GraphBLAS::reduce(row_scale,
+                          GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                          GraphBLAS::Plus<RealT>(),
+                          graph);
+        GraphBLAS::apply(row_scale,
                          GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
-                         GraphBLAS::Identity<T,RealT>(),
-                         graph);
-
-        // Normalize the edge weights of the graph by the vertices out-degree
-        GraphBLAS::normalize_rows(m);
-        //GraphBLAS::print_matrix(std::cout, m, "Normalized Graph");
-
-        // scale the normalized edge weights by the damping factor
+                         GraphBLAS::MultiplicativeInverse<RealT>(),
+                         row_scale);
         GraphBLAS::apply(
-            m,
+            row_scale,
             GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
             GraphBLAS::BinaryOp_Bind2nd<RealT,
                                         GraphBLAS::Times<RealT>>(damping_factor),
-            m);
-        //GraphBLAS::print_matrix(std::cout, m, "Scaled Graph");
+            row_scale);
 
         GraphBLAS::BinaryOp_Bind2nd<RealT, GraphBLAS::Plus<RealT> >
             add_scaled_teleport((1.0 - damping_factor)/
@@ -115,7 +122,7 @@ namespace algorithms
 
 
         GraphBLAS::Vector<RealT> new_rank(rows);
-        GraphBLAS::Vector<RealT> delta(rows);
+        GraphBLAS::Vector<RealT> scaled_rank(rows);
         for (GraphBLAS::IndexType i = 0; i < max_iters; ++i)
         {
             //std::cout << "============= ITERATION " << i << " ============"
@@ -123,44 +130,43 @@ namespace algorithms
             //print_vector(std::cout, page_rank, "rank");
 
             // Compute the new rank: [1 x M][M x N] = [1 x N]
+            GraphBLAS::eWiseMult(scaled_rank,
+                                 GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                                 GraphBLAS::Times<RealT>(),
+                                 page_rank, row_scale);
             GraphBLAS::vxm(new_rank,
                            GraphBLAS::NoMask(),
                            GraphBLAS::Second<RealT>(),
                            GraphBLAS::ArithmeticSemiring<RealT>(),
-                           page_rank, m);
+                           scaled_rank, graph);
             //print_vector(std::cout, new_rank, "step 1:");
 
             // [1 x M][M x 1] = [1 x 1] = always (1 - damping_factor)
             // rank*(m + scaling_mat*teleport): [1 x 1][1 x M] + [1 x N] = [1 x M]
-            //use apply:
-            GraphBLAS::apply(new_rank,
-                             GraphBLAS::NoMask(),
-                             GraphBLAS::NoAccumulate(),
-                             add_scaled_teleport,
-                             new_rank);
-            //GraphBLAS::print_vector(std::cout, new_rank, "new_rank");
-
-            // Test for convergence - compute squared error
+            // and the test for convergence - compute squared error
+            // (delta = rank - new_rank, sum of delta.*delta) - and the
+            // copy of new_rank into page_rank, fused into one pass over
+            // page_rank and new_rank.
             /// @todo should be mean squared error. (divide r2/N)
             RealT squared_error(0);
-            GraphBLAS::eWiseAdd(delta,
-                                GraphBLAS::NoMask(),
-                                GraphBLAS::NoAccumulate(),
-                                GraphBLAS::Minus<RealT>(),
-                                page_rank, new_rank);
-            GraphBLAS::eWiseMult(delta,
-                                 GraphBLAS::NoMask(),
-                                 GraphBLAS::NoAccumulate(),
-                                 GraphBLAS::Times<RealT>(),
-                                 delta, delta);
-            GraphBLAS::reduce(squared_error,
-                              GraphBLAS::NoAccumulate(),
-                              GraphBLAS::PlusMonoid<RealT>(),
-                              delta);
+            GraphBLAS::fused::reduce(
+                squared_error,
+                GraphBLAS::NoAccumulate(),
+                GraphBLAS::PlusMonoid<RealT>(),
+                GraphBLAS::fused::apply(
+                    Square<RealT>(),
+                    GraphBLAS::fused::eWiseAdd(
+                        GraphBLAS::Minus<RealT>(),
+                        page_rank,
+                        GraphBLAS::fused::store(
+                            page_rank,
+                            GraphBLAS::fused::store(
+                                new_rank,
+                                GraphBLAS::fused::apply(add_scaled_teleport,
+                                                        new_rank))))));
 
             //std::cout << "Squared error = " << r2 << std::endl;
 
-            page_rank = new_rank;
             // check mean-squared error
             if (squared_error/((RealT)rows) < threshold)
             {
@@ -38,6 +38,10 @@
 
 namespace algorithms
 {
+    /// Number of sources (rows of the paths matrix) searched by one task of
+    /// batch_sssp.
+    static GraphBLAS::IndexType const SSSP_SOURCES_PER_TASK = 16;
+
     /**
      * @brief Compute the lenghts of the single source shortest path(s) of
      *        one specified starting vertex in the given graph.
@@ -151,6 +155,19 @@ namespace algorithms
             throw GraphBLAS::DimensionException();
         }
 
+        // The searches from each source are independent: run blocks of
+        // them as tasks.
+        if ((GraphBLAS::TaskPool::instance().num_threads() > 1) &&
+            (paths.nrows() > SSSP_SOURCES_PER_TASK))
+        {
+            GraphBLAS::for_each_row_block(
+                paths, SSSP_SOURCES_PER_TASK,
+                [&graph](GraphBLAS::Matrix<typename PathMatrixT::ScalarType>
+                         &paths_block)
+                { batch_sssp(graph, paths_block); });
+            return;
+        }
+
         /// @todo why num_rows iterations?  Should be the diameter or terminate
         /// when there are no changes?
         for (GraphBLAS::IndexType k = 0; k < graph.nrows(); ++k)
@@ -218,26 +235,32 @@ namespace algorithms
         // t = infinity, t[src] = 0
         t.setElement(src, 0);
 
-        // AL = A .* (A <= delta)
+        // AL = A .* (A <= delta) and AH = A .* (A > delta) do not depend
+        // on each other, so they are built concurrently.
         MatrixT AL(n, n);
-        GraphBLAS::BinaryOp_Bind2nd<T, GraphBLAS::LessEqual<T>>
-            leq_delta((T)delta);
-        GraphBLAS::apply(AL, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
-                         leq_delta, graph);
-        GraphBLAS::apply(AL, AL, GraphBLAS::NoAccumulate(),
-                         GraphBLAS::Identity<T>(), graph, true);
-        GraphBLAS::print_matrix(std::cerr, AL, "AL = A(<=delta)");
-
-        // AH = A .* (A > delta)
         MatrixT AH(n, n);
-        //GraphBLAS::apply(AH, GraphBLAS::complement(AL), GraphBLAS::NoAccumulate(),
-        //                 GraphBLAS::Identity<T>(), A);
-        GraphBLAS::BinaryOp_Bind2nd<T, GraphBLAS::GreaterThan<T>>
-            gt_delta(delta);
-        GraphBLAS::apply(AH, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
-                         gt_delta, graph);
-        GraphBLAS::apply(AH, AH, GraphBLAS::NoAccumulate(),
-                         GraphBLAS::Identity<T>(), graph, true);
+        {
+            GraphBLAS::NonBlockingContext context;
+
+            GraphBLAS::BinaryOp_Bind2nd<T, GraphBLAS::LessEqual<T>>
+                leq_delta((T)delta);
+            GraphBLAS::apply(AL, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                             leq_delta, graph);
+            GraphBLAS::apply(AL, AL, GraphBLAS::NoAccumulate(),
+                             GraphBLAS::Identity<T>(), graph, true);
+
+            //GraphBLAS::apply(AH, GraphBLAS::complement(AL), GraphBLAS::NoAccumulate(),
+            //                 GraphBLAS::Identity<T>(), A);
+            GraphBLAS::BinaryOp_Bind2nd<T, GraphBLAS::GreaterThan<T>>
+                gt_delta(delta);
+            GraphBLAS::apply(AH, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                             gt_delta, graph);
+            GraphBLAS::apply(AH, AH, GraphBLAS::NoAccumulate(),
+                             GraphBLAS::Identity<T>(), graph, true);
+
+            context.wait();
+        }
+        GraphBLAS::print_matrix(std::cerr, AL, "AL = A(<=delta)");
         GraphBLAS::print_matrix(std::cerr, AH, "AH = A(>delta)");
 
         // i = 0
@@ -103,20 +103,14 @@ namespace algorithms
     typename MatrixT::ScalarType triangle_count_masked(MatrixT const &L)
     {
         using T = typename MatrixT::ScalarType;
-        GraphBLAS::IndexType rows(L.nrows());
-        GraphBLAS::IndexType cols(L.ncols());
-
-        MatrixT B(rows, cols);
-        GraphBLAS::mxm(B,
-                       L, GraphBLAS::NoAccumulate(),
-                       GraphBLAS::ArithmeticSemiring<T>(),
-                       L, GraphBLAS::transpose(L));
 
+        // sum(L .* (L * L')) without storing the masked product
         T sum = 0;
         GraphBLAS::reduce(sum,
                           GraphBLAS::NoAccumulate(),
                           GraphBLAS::PlusMonoid<T>(),
-                          B);
+                          L.mul(GraphBLAS::transpose(L),
+                                GraphBLAS::ArithmeticSemiring<T>()).masked(L));
         return sum;
     }
 
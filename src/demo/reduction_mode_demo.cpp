@@ -0,0 +1,154 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+//****************************************************************************
+// Times the reductions of a matrix, mxv, and a fused reduction of the
+// difference of two vectors (as in the PageRank error) in each reduction
+// mode.
+//
+// usage: reduction_mode_demo [num_nodes [edges_per_node [repetitions]]]
+//****************************************************************************
+
+namespace
+{
+    typedef GraphBLAS::Matrix<double> RealMatrix;
+    typedef GraphBLAS::Vector<double> RealVector;
+
+    char const *mode_name(GraphBLAS::ReductionMode mode)
+    {
+        switch (mode)
+        {
+        case GraphBLAS::ReductionMode::FAST:         return "FAST";
+        case GraphBLAS::ReductionMode::REPRODUCIBLE: return "REPRODUCIBLE";
+        default:                                     return "COMPENSATED";
+        }
+    }
+
+    /// Milliseconds per call of fn, over reps calls.
+    template <typename FunctionT>
+    double time_ms(unsigned int reps, FunctionT fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned int rep = 0; rep < reps; ++rep)
+        {
+            fn();
+        }
+        std::chrono::duration<double, std::milli> elapsed(
+            std::chrono::steady_clock::now() - start);
+        return elapsed.count()/reps;
+    }
+}
+
+//****************************************************************************
+int main(int argc, char **argv)
+{
+    GraphBLAS::IndexType num_nodes((argc > 1) ? std::atol(argv[1]) : 20000);
+    GraphBLAS::IndexType degree((argc > 2) ? std::atol(argv[2]) : 16);
+    unsigned int reps((argc > 3) ? std::atoi(argv[3]) : 10);
+
+    // A graph with a few hubs, so that rows have very different lengths,
+    // and edge weights that do not add exactly.
+    GraphBLAS::IndexArrayType rows, cols;
+    std::vector<double> vals;
+    for (GraphBLAS::IndexType i = 0; i < num_nodes; ++i)
+    {
+        GraphBLAS::IndexType out_degree((i % 1000 == 0) ? 50*degree : degree);
+        for (GraphBLAS::IndexType k = 0; k < out_degree; ++k)
+        {
+            rows.push_back(i);
+            cols.push_back((i*7919 + k*k*104729 + k) % num_nodes);
+            vals.push_back(1.0/(1.0 + (i + k) % 97));
+        }
+    }
+    RealMatrix A(num_nodes, num_nodes);
+    A.build(rows, cols, vals);
+
+    RealVector u(num_nodes);
+    GraphBLAS::assign(u, GraphBLAS::NoMask(), GraphBLAS::NoAccumulate(),
+                      1.0/num_nodes, GraphBLAS::AllIndices());
+
+    std::cout << "Nodes: " << num_nodes << ", edges: " << A.nvals()
+              << ", repetitions: " << reps << std::endl;
+    std::cout << std::setw(14) << "mode"
+              << std::setw(14) << "reduce (ms)"
+              << std::setw(14) << "row sums"
+              << std::setw(14) << "mxv"
+              << std::setw(14) << "fused"
+              << "   sum" << std::endl;
+
+    for (auto mode : {GraphBLAS::ReductionMode::FAST,
+                      GraphBLAS::ReductionMode::REPRODUCIBLE,
+                      GraphBLAS::ReductionMode::COMPENSATED})
+    {
+        GraphBLAS::ReductionContext context(mode);
+
+        double sum(0);
+        double reduce_ms(time_ms(reps, [&]() {
+                    GraphBLAS::reduce(sum, GraphBLAS::NoAccumulate(),
+                                      GraphBLAS::PlusMonoid<double>(), A); }));
+
+        RealVector w(num_nodes);
+        double rows_ms(time_ms(reps, [&]() {
+                    GraphBLAS::reduce(w, GraphBLAS::NoMask(),
+                                      GraphBLAS::NoAccumulate(),
+                                      GraphBLAS::PlusMonoid<double>(), A); }));
+
+        double mxv_ms(time_ms(reps, [&]() {
+                    GraphBLAS::mxv(w, GraphBLAS::NoMask(),
+                                   GraphBLAS::NoAccumulate(),
+                                   GraphBLAS::ArithmeticSemiring<double>(),
+                                   A, u); }));
+
+        double error(0);
+        double fused_ms(time_ms(reps, [&]() {
+                    GraphBLAS::fused::reduce(
+                        error, GraphBLAS::NoAccumulate(),
+                        GraphBLAS::PlusMonoid<double>(),
+                        GraphBLAS::fused::eWiseAdd(
+                            GraphBLAS::Minus<double>(), w, u)); }));
+
+        std::cout << std::setw(14) << mode_name(mode)
+                  << std::setw(14) << reduce_ms
+                  << std::setw(14) << rows_ms
+                  << std::setw(14) << mxv_ms
+                  << std::setw(14) << fused_ms
+                  << "   " << std::setprecision(17) << sum
+                  << std::setprecision(6) << std::endl;
+    }
+
+    return 0;
+}
@@ -28,7 +28,6 @@
  */
 
 #include <iostream>
-#include <fstream>
 #include <chrono>
 
 #define GRAPHBLAS_DEBUG 1
@@ -45,62 +44,23 @@ int main(int argc, char **argv)
         exit(1);
     }
 
-    // Read the edgelist and create the tuple arrays
-    std::string pathname(argv[1]);
-    std::ifstream infile(pathname);
-    GraphBLAS::IndexArrayType iL, iU, iA;
-    GraphBLAS::IndexArrayType jL, jU, jA;
-    int64_t num_rows = 0;
-    int64_t max_id = 0;
-    uint64_t src, dst;
-//    for (std::string row; getline(infile, row, '\n');)
-//    {
-//        std::cout << "Row: " << row << std::endl;
-//        sscanf(row.c_str(), "%ld\t%ld", &src, &dst);
-    while (infile)
-    {
-        infile >> src >> dst;
-        //std::cout << "Read: " << src << ", " << dst << std::endl;
-        if (src > max_id) max_id = src;
-        if (dst > max_id) max_id = dst;
-
-        if (src < dst)
-        {
-            iA.push_back(src);
-            jA.push_back(dst);
-
-            iU.push_back(src);
-            jU.push_back(dst);
-        }
-        else if (dst < src)
-        {
-            iA.push_back(src);
-            jA.push_back(dst);
-
-            iL.push_back(src);
-            jL.push_back(dst);
-        }
-        // else ignore self loops
-
-        ++num_rows;
-    }
-    std::cout << "Read " << num_rows << " rows." << std::endl;
-    std::cout << "#Nodes = " << (max_id + 1) << std::endl;
-
-    GraphBLAS::IndexType NUM_NODES(max_id + 1);
+    // Read the edgelist (without self loops) and split it into the lower
+    // and upper triangles
     typedef int32_t T;
-    std::vector<T> v(iA.size(), 1);
 
     /// @todo change scalar type to unsigned int or GraphBLAS::IndexType
     typedef GraphBLAS::Matrix<T, GraphBLAS::DirectedMatrixTag> MatType;
 
-    MatType A(NUM_NODES, NUM_NODES);
+    GraphBLAS::EdgeListOptions options;
+    options.skip_self_loops = true;
+    MatType A(GraphBLAS::read_edge_list<MatType>(argv[1], options));
+    std::cout << "Read " << A.nvals() << " edges." << std::endl;
+    std::cout << "#Nodes = " << A.nrows() << std::endl;
+
+    GraphBLAS::IndexType NUM_NODES(A.nrows());
     MatType L(NUM_NODES, NUM_NODES);
     MatType U(NUM_NODES, NUM_NODES);
-
-    A.build(iA.begin(), jA.begin(), v.begin(), iA.size());
-    L.build(iL.begin(), jL.begin(), v.begin(), iL.size());
-    U.build(iU.begin(), jU.begin(), v.begin(), iU.size());
+    GraphBLAS::split(A, L, U);
 
     std::cout << "Running algorithm(s)..." << std::endl;
     T count(0);
@@ -84,15 +84,21 @@ namespace GraphBLAS
 
         IndexType nrows() const { return m_mat.nrows(); }
         IndexType ncols() const { return m_mat.ncols(); }
-        IndexType nvals() const { return m_mat.nvals(); }
+        IndexType nvals() const
+        {
+            detail::sync_read(m_mat);
+            return m_mat.nvals();
+        }
 
         bool hasElement(IndexType row, IndexType col) const
         {
+            detail::sync_read(m_mat);
             return (m_mat.hasElement(row,col));
         }
 
         ScalarType extractElement(IndexType row, IndexType col) const
         {
+            detail::sync_read(m_mat);
             return m_mat.extractElement(row, col);
         }
 
@@ -104,6 +110,7 @@ namespace GraphBLAS
                                   RAIteratorJT        col_it,
                                   RAIteratorVT        values)
         {
+            detail::sync_read(m_mat);
             m_mat.extractTuples(row_it, col_it, values);
         }
 
@@ -115,6 +122,7 @@ namespace GraphBLAS
                                   ColSequenceT              &col_indices,
                                   std::vector<ValueT>       &values)
         {
+            detail::sync_read(m_mat);
             m_mat.extractTuples(row_indices, col_indices, values);
         }
 
@@ -123,6 +131,7 @@ namespace GraphBLAS
         void printInfo(std::ostream &os) const
         {
             os << "Frontend MatrixComplementView of:";
+            detail::sync_read(m_mat);
             m_mat.printInfo(os);
         }
 
@@ -282,6 +291,7 @@ namespace GraphBLAS
 
         //--------------------------------------------------------------------
 
+        friend struct expr::backend_access;
     };
 
     //************************************************************************
@@ -331,15 +341,21 @@ namespace GraphBLAS
         }
 
         IndexType size() const  { return m_vec.size(); }
-        IndexType nvals() const { return m_vec.nvals(); }
+        IndexType nvals() const
+        {
+            detail::sync_read(m_vec);
+            return m_vec.nvals();
+        }
 
         bool hasElement(IndexType index) const
         {
+            detail::sync_read(m_vec);
             return m_vec.hasElement(index);
         }
 
         ScalarType extractElement(IndexType index) const
         {
+            detail::sync_read(m_vec);
             return m_vec.extractElement(index);
         }
 
@@ -348,6 +364,7 @@ namespace GraphBLAS
         inline void extractTuples(RAIteratorIT        i_it,
                                   RAIteratorVT        v_it)
         {
+            detail::sync_read(m_vec);
             m_vec.extractTuples(i_it, v_it);
         }
 
@@ -357,6 +374,7 @@ namespace GraphBLAS
         inline void extractTuples(SequenceT                 &indices,
                                   std::vector<ValueT>       &values)
         {
+            detail::sync_read(m_vec);
             m_vec.extractTuples(indices, values);
         }
 
@@ -365,6 +383,7 @@ namespace GraphBLAS
         void printInfo(std::ostream &os) const
         {
             os << "Frontend VectorComplementView of:";
+            detail::sync_read(m_vec);
             m_vec.printInfo(os);
         }
 
@@ -571,6 +590,10 @@ namespace GraphBLAS
                                   BinaryOpT        op,
                                   AMatrixT  const &A,
                                   bool             replace_flag);
+
+        //--------------------------------------------------------------------
+
+        friend struct expr::backend_access;
     };
 
 } // end namespace GraphBLAS
@@ -31,12 +31,15 @@
 
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/param_unpack.hpp>
 
 #define GB_INCLUDE_BACKEND_MATRIX 1
 #include <backend_include.hpp>
 
+#include <graphblas/NonBlocking.hpp>
+
 
 //****************************************************************************
 // The new namespace
@@ -57,6 +60,23 @@ namespace GraphBLAS
     template<typename MatrixT>
     class MatrixComplementView;
 
+    namespace expr
+    {
+        struct backend_access;
+
+        template<typename AT, typename BT, typename SemiringT>
+        class Product;
+
+        template<typename AT, typename BT, typename BinaryOpT>
+        class EWiseAdd;
+
+        template<typename AT, typename BT, typename BinaryOpT>
+        class EWiseMult;
+
+        template<typename OutT, typename MaskT>
+        class Target;
+    }
+
     //************************************************************************
 
     /**
@@ -102,7 +122,18 @@ namespace GraphBLAS
          * @param[in] rhs   The matrix to copy.
          */
         Matrix(Matrix<ScalarT, TagsT...> const &rhs)
-            : m_mat(rhs.m_mat)
+            : m_mat(detail::completed(rhs.m_mat))
+        {
+        }
+
+        /**
+         * @brief Move constructor.
+         *
+         * @param[in] rhs   The matrix whose storage is taken.  It is left
+         *                  empty with the same shape.
+         */
+        Matrix(Matrix<ScalarT, TagsT...> &&rhs)
+            : m_mat(std::move(detail::released(rhs.m_mat)))
         {
         }
 
@@ -134,7 +165,7 @@ namespace GraphBLAS
         {
         }
 
-        ~Matrix() { }
+        ~Matrix() { detail::sync_write(m_mat); }
 
         /// @todo Should assignment work only if dimensions are same?
         Matrix<ScalarT, TagsT...> &
@@ -143,15 +174,33 @@ namespace GraphBLAS
             if (this != &rhs)
             {
                 // backend currently doing dimension check.
+                detail::sync_write(m_mat);
+                detail::sync_read(rhs.m_mat);
                 m_mat = rhs.m_mat;
             }
             return *this;
         }
 
+        /// Move assignment: the storage of rhs is taken and rhs is cleared.
+        Matrix<ScalarT, TagsT...> &
+        operator=(Matrix<ScalarT, TagsT...> &&rhs)
+        {
+            if (this != &rhs)
+            {
+                // backend currently doing dimension check.
+                detail::sync_write(m_mat);
+                detail::sync_write(rhs.m_mat);
+                m_mat = std::move(rhs.m_mat);
+            }
+            return *this;
+        }
+
 
         /// @todo need to change to mix and match internal types
         bool operator==(Matrix<ScalarT, TagsT...> const &rhs) const
         {
+            detail::sync_read(m_mat);
+            detail::sync_read(rhs.m_mat);
             return (m_mat == rhs.m_mat);
         }
 
@@ -185,6 +234,7 @@ namespace GraphBLAS
                    IndexType    num_vals,
                    BinaryOpT    dup = BinaryOpT())
         {
+            detail::sync_write(m_mat);
             m_mat.build(i_it, j_it, v_it, num_vals, dup);
         }
 
@@ -214,30 +264,59 @@ namespace GraphBLAS
                 throw DimensionException("Matrix::build");
             }
 
+            detail::sync_write(m_mat);
             m_mat.build(row_indices.begin(), col_indices.begin(),
                         values.begin(), values.size(), dup);
         }
 
-        void clear() { m_mat.clear(); }
+        void clear()
+        {
+            detail::sync_write(m_mat);
+            m_mat.clear();
+        }
+
+        /**
+         * @brief Place the rows on the NUMA nodes of the system (a no-op
+         *        without NUMA support).  The contents do not change.
+         */
+        void place(NumaPolicy policy)
+        {
+            detail::sync_write(m_mat);
+            m_mat.place(policy);
+        }
+
+        /// The policy the rows were last placed with.
+        NumaPolicy placement() const
+        {
+            detail::sync_read(m_mat);
+            return m_mat.placement();
+        }
 
         IndexType nrows() const  { return m_mat.nrows(); }
         IndexType ncols() const  { return m_mat.ncols(); }
-        IndexType nvals() const  { return m_mat.nvals(); }
+        IndexType nvals() const
+        {
+            detail::sync_read(m_mat);
+            return m_mat.nvals();
+        }
 
         bool hasElement(IndexType row, IndexType col) const
         {
+            detail::sync_read(m_mat);
             return m_mat.hasElement(row, col);
         }
 
         /// @todo I don't think this is a valid interface for sparse
         void setElement(IndexType row, IndexType col, ScalarT const &val)
         {
+            detail::sync_write(m_mat);
             m_mat.setElement(row, col, val);
         }
 
         /// @throw NoValueException if there is no value stored at (row,col)
         ScalarT extractElement(IndexType row, IndexType col) const
         {
+            detail::sync_read(m_mat);
             return m_mat.extractElement(row, col);
         }
 
@@ -248,6 +327,7 @@ namespace GraphBLAS
                                   RAIteratorJT        col_it,
                                   RAIteratorVT        values) const
         {
+            detail::sync_read(m_mat);
             m_mat.extractTuples(row_it, col_it, values);
         }
 
@@ -257,6 +337,7 @@ namespace GraphBLAS
                                   ColSequenceT            &col_indices,
                                   std::vector<ScalarT>    &values) const
         {
+            detail::sync_read(m_mat);
             m_mat.extractTuples(row_indices.begin(),
                                 col_indices.begin(),
                                 values.begin());
@@ -266,9 +347,42 @@ namespace GraphBLAS
         /// information.
         void printInfo(std::ostream &os) const
         {
+            detail::sync_read(m_mat);
             m_mat.printInfo(os);
         }
 
+        //--------------------------------------------------------------------
+        // Expressions (expressions.hpp)
+
+        /// The output C<Mask> of an expression: C(Mask, replace_flag) = expr.
+        template<typename MaskT>
+        expr::Target<Matrix, MaskT> operator()(MaskT const &Mask,
+                                               bool         replace_flag = false)
+        {
+            return expr::Target<Matrix, MaskT>(*this, Mask, replace_flag);
+        }
+
+        /// This matrix times B (a matrix or vector) over the semiring op.
+        template<typename BT, typename SemiringT>
+        expr::Product<Matrix, BT, SemiringT> mul(BT const &B, SemiringT op) const
+        {
+            return expr::Product<Matrix, BT, SemiringT>(*this, B, op);
+        }
+
+        /// The element-wise union of this matrix and B.
+        template<typename BT, typename BinaryOpT>
+        expr::EWiseAdd<Matrix, BT, BinaryOpT> add(BT const &B, BinaryOpT op) const
+        {
+            return expr::EWiseAdd<Matrix, BT, BinaryOpT>(*this, B, op);
+        }
+
+        /// The element-wise intersection of this matrix and B.
+        template<typename BT, typename BinaryOpT>
+        expr::EWiseMult<Matrix, BT, BinaryOpT> emult(BT const &B, BinaryOpT op) const
+        {
+            return expr::EWiseMult<Matrix, BT, BinaryOpT>(*this, B, op);
+        }
+
     private:
 
         // 4.3.1:
@@ -533,6 +647,10 @@ namespace GraphBLAS
 
         //--------------------------------------------------------------------
 
+        friend struct expr::backend_access;
+
+        //--------------------------------------------------------------------
+
         // .... ADD OTHER OPERATIONS AS FRIENDS AS THEY ARE IMPLEMENTED .....
 
         template <typename MatrixT>
@@ -582,6 +700,7 @@ namespace GraphBLAS
         // ostr << label << ": zero = " << mat.m_mat.get_zero() << std::endl;
         ostr << label << " (" << mat.nrows() << "x" << mat.ncols() << ")"
              << std::endl;
+        detail::sync_read(mat.m_mat);
         backend::pretty_print_matrix(ostr, mat.m_mat);
     }
 
@@ -0,0 +1,597 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_NON_BLOCKING_HPP
+#define GB_NON_BLOCKING_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <graphblas/TaskPool.hpp>
+#include <graphblas/ReductionMode.hpp>
+
+#define GB_INCLUDE_BACKEND_MATRIX 1
+#define GB_INCLUDE_BACKEND_VECTOR 1
+#define GB_INCLUDE_BACKEND_TRANSPOSE_VIEW 1
+#define GB_INCLUDE_BACKEND_COMPLEMENT_VIEW 1
+#include <backend_include.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace detail
+    {
+        class DeferredGraph;
+
+        //********************************************************************
+        /// The graph of the calling thread's NonBlockingContext, if any.
+        inline DeferredGraph *&current_graph()
+        {
+            static thread_local DeferredGraph *graph = nullptr;
+            return graph;
+        }
+
+        //********************************************************************
+        /**
+         * @brief The operations recorded by a NonBlockingContext, in the
+         *        order they were called, with their dependencies.
+         *
+         * An operation depends on the last operation that wrote each
+         * object it reads, and on the operations that read its output
+         * since then.  Objects are identified by the address of their
+         * backend storage.  Operations whose dependencies are done run
+         * together as tasks of the TaskPool.
+         */
+        class DeferredGraph
+        {
+        public:
+            typedef std::function<void()> Operation;
+
+            DeferredGraph() : m_num_pending(0) {}
+
+            DeferredGraph(DeferredGraph const &) = delete;
+            DeferredGraph &operator=(DeferredGraph const &) = delete;
+
+            /// Record op, which reads the objects in reads and writes output.
+            void add(Operation                       op,
+                     std::vector<void const *> const &reads,
+                     void const                      *output)
+            {
+                std::size_t index(m_nodes.size());
+                Node node;
+                node.op = std::move(op);
+
+                for (auto id : reads)
+                {
+                    add_writer_dependency(node, id);
+                    m_readers[id].push_back(index);
+                }
+
+                // The output was read too (by the mask or accumulation),
+                // so this waits for its earlier readers as well.
+                for (auto reader : m_readers[output])
+                {
+                    if ((reader != index) && !m_nodes[reader].done)
+                    {
+                        node.deps.push_back(reader);
+                    }
+                }
+                m_readers[output].clear();
+                m_last_writer[output] = index;
+
+                m_nodes.push_back(std::move(node));
+                ++m_num_pending;
+            }
+
+            /**
+             * Run the operations that the objects in ids are waiting on:
+             * the ones that write them and, if they are about to be
+             * modified (or destroyed), the ones that read them.
+             */
+            void complete(std::vector<void const *> const &ids,
+                          bool                             for_write)
+            {
+                if (m_num_pending == 0)
+                {
+                    return;
+                }
+
+                std::vector<std::size_t> targets;
+                for (auto id : ids)
+                {
+                    auto writer = m_last_writer.find(id);
+                    if (writer != m_last_writer.end())
+                    {
+                        targets.push_back(writer->second);
+                    }
+
+                    if (for_write)
+                    {
+                        auto readers = m_readers.find(id);
+                        if (readers != m_readers.end())
+                        {
+                            targets.insert(targets.end(),
+                                           readers->second.begin(),
+                                           readers->second.end());
+                        }
+                    }
+                }
+
+                run(targets);
+
+                if (for_write)
+                {
+                    // Everything that touched these objects is done, and
+                    // their addresses may be reused.
+                    for (auto id : ids)
+                    {
+                        m_last_writer.erase(id);
+                        m_readers.erase(id);
+                    }
+                }
+            }
+
+            /// Run every recorded operation.
+            void complete_all()
+            {
+                std::vector<std::size_t> targets;
+                for (std::size_t index = 0; index < m_nodes.size(); ++index)
+                {
+                    if (!m_nodes[index].done)
+                    {
+                        targets.push_back(index);
+                    }
+                }
+                run(targets);
+            }
+
+            std::size_t num_pending() const { return m_num_pending; }
+
+        private:
+            struct SuspendRecording
+            {
+                SuspendRecording() : m_graph(current_graph())
+                {
+                    current_graph() = nullptr;
+                }
+                ~SuspendRecording() { current_graph() = m_graph; }
+
+                DeferredGraph *m_graph;
+            };
+
+            struct Node
+            {
+                Node() : done(false) {}
+
+                Operation                op;
+                std::vector<std::size_t> deps;
+                bool                     done;
+            };
+
+            void add_writer_dependency(Node &node, void const *id)
+            {
+                auto writer = m_last_writer.find(id);
+                if ((writer != m_last_writer.end()) &&
+                    !m_nodes[writer->second].done)
+                {
+                    node.deps.push_back(writer->second);
+                }
+            }
+
+            bool is_ready(Node const &node) const
+            {
+                for (auto dep : node.deps)
+                {
+                    if (!m_nodes[dep].done)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            /// Run the targets and the pending operations they depend on,
+            /// one level of ready operations at a time.
+            void run(std::vector<std::size_t> targets)
+            {
+                std::vector<std::size_t> pending;
+                std::vector<bool> visited(m_nodes.size(), false);
+                while (!targets.empty())
+                {
+                    std::size_t index(targets.back());
+                    targets.pop_back();
+                    if (visited[index] || m_nodes[index].done)
+                    {
+                        continue;
+                    }
+                    visited[index] = true;
+                    pending.push_back(index);
+                    targets.insert(targets.end(),
+                                   m_nodes[index].deps.begin(),
+                                   m_nodes[index].deps.end());
+                }
+                std::sort(pending.begin(), pending.end());
+
+                // The operations call the backend directly; anything else
+                // this thread runs meanwhile (tasks it takes from the
+                // pool while waiting) must not be recorded here.
+                SuspendRecording suspend;
+
+                try
+                {
+                    while (!pending.empty())
+                    {
+                        std::vector<std::size_t> ready, blocked;
+                        for (auto index : pending)
+                        {
+                            if (is_ready(m_nodes[index]))
+                                ready.push_back(index);
+                            else
+                                blocked.push_back(index);
+                        }
+
+                        run_level(ready);
+                        pending.swap(blocked);
+                    }
+                }
+                catch (...)
+                {
+                    // The outputs of the failed level are unspecified, so
+                    // nothing that was recorded can be run any more.
+                    reset();
+                    throw;
+                }
+
+                if (m_num_pending == 0)
+                {
+                    reset();
+                }
+            }
+
+            void run_level(std::vector<std::size_t> const &ready)
+            {
+                if (ready.size() == 1)
+                {
+                    // Let a lone operation use all of the backend's threads
+                    m_nodes[ready.front()].op();
+                }
+                else
+                {
+                    TaskGroup group;
+                    for (auto index : ready)
+                    {
+                        Operation *op(&m_nodes[index].op);
+                        group.run([op]() { (*op)(); });
+                    }
+                    group.wait();
+                }
+
+                for (auto index : ready)
+                {
+                    // Drop the arguments that the operation kept
+                    m_nodes[index].done = true;
+                    m_nodes[index].op = Operation();
+                }
+                m_num_pending -= ready.size();
+            }
+
+            void reset()
+            {
+                m_nodes.clear();
+                m_last_writer.clear();
+                m_readers.clear();
+                m_num_pending = 0;
+            }
+
+            std::vector<Node>                                         m_nodes;
+            std::unordered_map<void const *, std::size_t>             m_last_writer;
+            std::unordered_map<void const *, std::vector<std::size_t> > m_readers;
+            std::size_t                                               m_num_pending;
+        };
+
+        //********************************************************************
+        // storage_ids(ids, arg) appends the addresses of the backend
+        // containers that an argument of a backend operation reads.
+
+        template <typename ArgT>
+        inline void storage_ids(std::vector<void const *> &, ArgT const &);
+
+        template <typename ScalarT, typename... TagsT>
+        inline void storage_ids(std::vector<void const *>                  &ids,
+                                backend::Matrix<ScalarT, TagsT...> const &A);
+
+        template <typename ScalarT, typename... TagsT>
+        inline void storage_ids(std::vector<void const *>                  &ids,
+                                backend::Vector<ScalarT, TagsT...> const &u);
+
+        template <typename MatrixT>
+        inline void storage_ids(std::vector<void const *>          &ids,
+                                backend::TransposeView<MatrixT> const &A);
+
+        template <typename MatrixT>
+        inline void storage_ids(std::vector<void const *>                 &ids,
+                                backend::MatrixComplementView<MatrixT> const &A);
+
+        template <typename VectorT>
+        inline void storage_ids(std::vector<void const *>                 &ids,
+                                backend::VectorComplementView<VectorT> const &u);
+
+        /// Masks, operators, scalars and index arrays hold no containers.
+        template <typename ArgT>
+        inline void storage_ids(std::vector<void const *> &, ArgT const &)
+        {
+        }
+
+        template <typename ScalarT, typename... TagsT>
+        inline void storage_ids(std::vector<void const *>                  &ids,
+                                backend::Matrix<ScalarT, TagsT...> const &A)
+        {
+            ids.push_back(&A);
+        }
+
+        template <typename ScalarT, typename... TagsT>
+        inline void storage_ids(std::vector<void const *>                  &ids,
+                                backend::Vector<ScalarT, TagsT...> const &u)
+        {
+            ids.push_back(&u);
+        }
+
+        template <typename MatrixT>
+        inline void storage_ids(std::vector<void const *>          &ids,
+                                backend::TransposeView<MatrixT> const &A)
+        {
+            storage_ids(ids, A.matrix());
+        }
+
+        template <typename MatrixT>
+        inline void storage_ids(std::vector<void const *>                 &ids,
+                                backend::MatrixComplementView<MatrixT> const &A)
+        {
+            storage_ids(ids, A.matrix());
+        }
+
+        template <typename VectorT>
+        inline void storage_ids(std::vector<void const *>                 &ids,
+                                backend::VectorComplementView<VectorT> const &u)
+        {
+            storage_ids(ids, u.vector());
+        }
+
+        inline void collect_storage_ids(std::vector<void const *> &)
+        {
+        }
+
+        template <typename ArgT, typename... ArgsT>
+        inline void collect_storage_ids(std::vector<void const *> &ids,
+                                        ArgT const                &arg,
+                                        ArgsT const &...           args)
+        {
+            storage_ids(ids, arg);
+            collect_storage_ids(ids, args...);
+        }
+
+        //********************************************************************
+        // deferred_argument(arg) is what a recorded operation keeps of an
+        // argument: a reference to a container (which stays alive until
+        // the operations that use it are done), and a copy of anything
+        // else (views are small and refer to their containers).
+
+        template <typename ArgT>
+        inline ArgT deferred_argument(ArgT const &arg)
+        {
+            return arg;
+        }
+
+        template <typename ScalarT, typename... TagsT>
+        inline std::reference_wrapper<backend::Matrix<ScalarT, TagsT...> const>
+        deferred_argument(backend::Matrix<ScalarT, TagsT...> const &A)
+        {
+            return std::cref(A);
+        }
+
+        template <typename ScalarT, typename... TagsT>
+        inline std::reference_wrapper<backend::Vector<ScalarT, TagsT...> const>
+        deferred_argument(backend::Vector<ScalarT, TagsT...> const &u)
+        {
+            return std::cref(u);
+        }
+
+        //********************************************************************
+        /**
+         * Call fn(output, args...), a backend operation that writes output,
+         * now or, inside a NonBlockingContext, when its result is needed.
+         */
+        template <typename FunctionT, typename OutputT, typename... ArgsT>
+        inline void dispatch(FunctionT       fn,
+                             OutputT        &output,
+                             ArgsT const &... args)
+        {
+            DeferredGraph *graph(current_graph());
+            if (graph == nullptr)
+            {
+                fn(output, args...);
+                return;
+            }
+
+            std::vector<void const *> reads;
+            collect_storage_ids(reads, output, args...);
+            graph->add(with_reduction_mode(
+                           reduction_mode(),
+                           std::bind(fn, std::ref(output),
+                                     deferred_argument(args)...)),
+                       reads, &output);
+        }
+
+        /**
+         * Call fn(output, args...) now, where output is not a container
+         * (a scalar), after the operations its arguments are waiting on.
+         */
+        template <typename FunctionT, typename OutputT, typename... ArgsT>
+        inline void dispatch_blocking(FunctionT       fn,
+                                      OutputT        &output,
+                                      ArgsT const &... args)
+        {
+            DeferredGraph *graph(current_graph());
+            if (graph != nullptr)
+            {
+                std::vector<void const *> reads;
+                collect_storage_ids(reads, args...);
+                graph->complete(reads, false);
+            }
+            fn(output, args...);
+        }
+
+        /// Complete the operations that write a container or view.
+        template <typename BackendT>
+        inline void sync_read(BackendT const &obj)
+        {
+            DeferredGraph *graph(current_graph());
+            if (graph != nullptr)
+            {
+                std::vector<void const *> ids;
+                storage_ids(ids, obj);
+                graph->complete(ids, false);
+            }
+        }
+
+        /// Complete the operations that use a container before it is
+        /// modified or destroyed.
+        template <typename BackendT>
+        inline void sync_write(BackendT const &obj)
+        {
+            DeferredGraph *graph(current_graph());
+            if (graph != nullptr)
+            {
+                std::vector<void const *> ids;
+                storage_ids(ids, obj);
+                graph->complete(ids, true);
+            }
+        }
+
+        /// sync_read(obj), for use in member initializers.
+        template <typename BackendT>
+        inline BackendT const &completed(BackendT const &obj)
+        {
+            sync_read(obj);
+            return obj;
+        }
+
+        /// sync_write(obj), for use in member initializers.
+        template <typename BackendT>
+        inline BackendT &released(BackendT &obj)
+        {
+            sync_write(obj);
+            return obj;
+        }
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief Execute the operations called by this thread in non-blocking
+     *        mode while the context exists.
+     *
+     * The operations (mxm, eWiseAdd, apply, ...) check their dimensions
+     * and are then only recorded.  They run when a result is needed: when
+     * nvals(), hasElement(), extractElement() or extractTuples() is
+     * called on their output, when a container they use is modified or
+     * destroyed, on wait(), and when the context ends.  Operations that
+     * do not depend on each other run concurrently on the TaskPool.
+     * Reducing to a scalar runs at once.
+     *
+     * A context created inside another one joins the outer one.  The
+     * destructor cannot report exceptions, so call wait() first to see
+     * them; after an exception the recorded operations are discarded.
+     */
+    class NonBlockingContext
+    {
+    public:
+        NonBlockingContext()
+            : m_outer(detail::current_graph())
+        {
+            if (m_outer == nullptr)
+            {
+                detail::current_graph() = &m_graph;
+            }
+        }
+
+        ~NonBlockingContext()
+        {
+            if (m_outer == nullptr)
+            {
+                try
+                {
+                    m_graph.complete_all();
+                }
+                catch (...)
+                {
+                }
+                detail::current_graph() = nullptr;
+            }
+        }
+
+        NonBlockingContext(NonBlockingContext const &) = delete;
+        NonBlockingContext &operator=(NonBlockingContext const &) = delete;
+
+        /// Run all of the recorded operations.
+        void wait()
+        {
+            detail::current_graph()->complete_all();
+        }
+
+        /// The number of recorded operations that have not run yet.
+        std::size_t num_pending() const
+        {
+            return detail::current_graph()->num_pending();
+        }
+
+    private:
+        detail::DeferredGraph *m_outer;
+        detail::DeferredGraph  m_graph;
+    };
+
+    /// Run the operations recorded by the calling thread's
+    /// NonBlockingContext (nothing in blocking mode).
+    inline void wait()
+    {
+        detail::DeferredGraph *graph(detail::current_graph());
+        if (graph != nullptr)
+        {
+            graph->complete_all();
+        }
+    }
+
+} // GraphBLAS
+
+#endif // GB_NON_BLOCKING_HPP
@@ -0,0 +1,305 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#ifndef GB_REDUCTION_MODE_HPP
+#define GB_REDUCTION_MODE_HPP
+
+#pragma once
+
+#include <cmath>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    //************************************************************************
+    /**
+     * @brief How reductions (reduce, and the sums of mxv, vxm and mxm)
+     *        combine values.
+     *
+     * FAST lets a parallel backend divide the values among its threads
+     * however balances the work best, so floating point results can change
+     * with the number of threads.  REPRODUCIBLE combines the values in a
+     * fixed tree (see TreeReduction) that depends only on their number, so
+     * results are the same bit for bit on any number of threads and on
+     * every backend.  COMPENSATED is REPRODUCIBLE with compensated
+     * (Neumaier) summation for PlusMonoid and Plus of floating point types.
+     */
+    enum class ReductionMode
+    {
+        FAST,
+        REPRODUCIBLE,
+        COMPENSATED
+    };
+
+    namespace detail
+    {
+        /// The reduction mode of the calling thread.
+        inline ReductionMode &current_reduction_mode()
+        {
+            static thread_local ReductionMode mode = ReductionMode::FAST;
+            return mode;
+        }
+    }
+
+    /// The reduction mode of the calling thread's ReductionContext, or FAST.
+    inline ReductionMode reduction_mode()
+    {
+        return detail::current_reduction_mode();
+    }
+
+    //************************************************************************
+    /**
+     * @brief Use a reduction mode for the operations called by this thread
+     *        while the context exists.
+     *
+     * Operations recorded by a NonBlockingContext and tasks submitted to a
+     * TaskPool keep the mode that was in effect when they were called.
+     * The previous mode is restored when the context ends.
+     */
+    class ReductionContext
+    {
+    public:
+        explicit ReductionContext(ReductionMode mode)
+            : m_saved(detail::current_reduction_mode())
+        {
+            detail::current_reduction_mode() = mode;
+        }
+
+        ~ReductionContext()
+        {
+            detail::current_reduction_mode() = m_saved;
+        }
+
+        ReductionContext(ReductionContext const &) = delete;
+        ReductionContext &operator=(ReductionContext const &) = delete;
+
+    private:
+        ReductionMode m_saved;
+    };
+
+    namespace detail
+    {
+        /// fn, to be called in a ReductionContext with the given mode.
+        template <typename FunctionT>
+        inline std::function<void()> with_reduction_mode(ReductionMode mode,
+                                                         FunctionT     fn)
+        {
+            return [mode, fn]() mutable
+            {
+                ReductionContext context(mode);
+                fn();
+            };
+        }
+    }
+
+    /// The number of consecutive values a TreeReduction combines left to
+    /// right before the block results are combined pairwise.
+    static IndexType const REDUCTION_BLOCK_SIZE = 1024;
+
+    namespace detail
+    {
+        template <typename ScalarT, typename BinaryOpT>
+        struct is_compensable_sum : std::false_type {};
+
+        template <typename ScalarT>
+        struct is_compensable_sum<ScalarT, PlusMonoid<ScalarT> >
+            : std::is_floating_point<ScalarT> {};
+
+        template <typename ScalarT>
+        struct is_compensable_sum<ScalarT, Plus<ScalarT, ScalarT, ScalarT> >
+            : std::is_floating_point<ScalarT> {};
+    }
+
+    //************************************************************************
+    /**
+     * @brief The reduction of a sequence of values with a binary op in an
+     *        order that depends only on the length of the sequence.
+     *
+     * The values are divided into blocks of REDUCTION_BLOCK_SIZE, each
+     * block is reduced left to right, and the block results are combined
+     * as a binary tree: blocks 2k and 2k + 1, then those results in pairs,
+     * and so on, with what is left over combined from the right at the
+     * end.  A block can also be reduced on its own (by a different thread)
+     * and added with add_block(), which gives the same result as adding
+     * its values one at a time.
+     *
+     * With compensation, sums of floating point values (PlusMonoid or
+     * Plus) carry the rounding error of each addition (Neumaier's variant
+     * of Kahan summation) and add it back at the end.
+     */
+    template <typename ScalarT, typename BinaryOpT>
+    class TreeReduction
+    {
+    public:
+        /// A partial result: the value, and the error of a compensated sum.
+        struct Partial
+        {
+            ScalarT value;
+            ScalarT error;
+        };
+
+        TreeReduction(BinaryOpT op, bool compensated)
+            : m_op(op),
+              m_compensated(
+                  compensated &&
+                  detail::is_compensable_sum<ScalarT, BinaryOpT>::value),
+              m_count(0)
+        {
+        }
+
+        /// Add the next value.
+        void add(ScalarT value)
+        {
+            if (m_count == 0)
+            {
+                m_block.value = value;
+                m_block.error = ScalarT(0);
+            }
+            else
+            {
+                m_block = combine(m_block, Partial{value, ScalarT(0)});
+            }
+
+            if (++m_count == REDUCTION_BLOCK_SIZE)
+            {
+                push(m_block);
+                m_count = 0;
+            }
+        }
+
+        /**
+         * @brief Add the partial() of the next block of count values, where
+         *        count is REDUCTION_BLOCK_SIZE except for the last block.
+         */
+        void add_block(Partial const &block, IndexType count)
+        {
+            if (count == REDUCTION_BLOCK_SIZE)
+            {
+                push(block);
+            }
+            else if (count > 0)
+            {
+                m_block = block;
+                m_count = count;
+            }
+        }
+
+        /// Whether no values have been added.
+        bool empty() const
+        {
+            return m_levels.empty() && (m_count == 0);
+        }
+
+        /// The reduction of the values added so far (not empty()).
+        Partial partial()
+        {
+            std::size_t idx(m_stack.size());
+            Partial acc((m_count > 0) ? m_block : m_stack[--idx]);
+            while (idx > 0)
+            {
+                --idx;
+                acc = combine(m_stack[idx], acc);
+            }
+            return acc;
+        }
+
+        /// The reduction of the values added so far (not empty()).
+        ScalarT result()
+        {
+            Partial acc(partial());
+            return m_compensated ? ScalarT(acc.value + acc.error) : acc.value;
+        }
+
+    private:
+        Partial combine(Partial const &lhs, Partial const &rhs)
+        {
+            if (m_compensated)
+            {
+                return compensated_sum(
+                    lhs, rhs,
+                    detail::is_compensable_sum<ScalarT, BinaryOpT>());
+            }
+            return Partial{m_op(lhs.value, rhs.value), ScalarT(0)};
+        }
+
+        static Partial compensated_sum(Partial const &lhs,
+                                       Partial const &rhs,
+                                       std::true_type)
+        {
+            ScalarT sum(lhs.value + rhs.value);
+            ScalarT error((std::abs(lhs.value) >= std::abs(rhs.value)) ?
+                          (lhs.value - sum) + rhs.value :
+                          (rhs.value - sum) + lhs.value);
+            return Partial{sum, ScalarT(lhs.error + rhs.error + error)};
+        }
+
+        // Not used: m_compensated is false for other ops and types.
+        static Partial compensated_sum(Partial const &lhs,
+                                       Partial const &,
+                                       std::false_type)
+        {
+            return lhs;
+        }
+
+        /// Push a block result and combine the results of equal levels,
+        /// like carries in a binary counter.
+        void push(Partial const &block)
+        {
+            m_stack.push_back(block);
+            m_levels.push_back(0);
+            while ((m_levels.size() > 1) &&
+                   (m_levels[m_levels.size() - 2] == m_levels.back()))
+            {
+                Partial rhs(m_stack.back());
+                m_stack.pop_back();
+                m_levels.pop_back();
+                m_stack.back() = combine(m_stack.back(), rhs);
+                ++m_levels.back();
+            }
+        }
+
+        BinaryOpT                m_op;
+        bool                     m_compensated;
+        Partial                  m_block;
+        IndexType                m_count;
+        std::vector<Partial>     m_stack;
+        std::vector<IndexType>   m_levels;
+    };
+} // GraphBLAS
+
+#endif // GB_REDUCTION_MODE_HPP
@@ -0,0 +1,438 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_TASK_POOL_HPP
+#define GB_TASK_POOL_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <graphblas/types.hpp>
+#include <graphblas/ReductionMode.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    //************************************************************************
+    /**
+     * @brief A work-stealing pool of threads that runs the independent
+     *        tasks of an algorithm (one traversal per source, for example).
+     *
+     * Each thread has a deque of tasks: it runs the newest of its own
+     * tasks first and, when it has none, steals the oldest task of another
+     * thread.  Tasks are submitted through a TaskGroup (or parallel_for),
+     * and a thread waiting on a group runs tasks instead of blocking, so
+     * tasks may themselves start and wait on groups.
+     *
+     * The thread that waits counts as one of the pool's threads, so a pool
+     * of n threads starts n - 1 workers.  While a task runs, the
+     * operations it calls use a single thread (the OpenMP backend would
+     * otherwise start a team per task); a pool of one thread runs tasks
+     * inline and leaves the operations their threads.
+     */
+    class TaskPool
+    {
+    public:
+        typedef std::function<void()> Task;
+
+        explicit TaskPool(unsigned int num_threads = default_num_threads())
+            : m_num_threads(std::max(num_threads, 1U)),
+              m_queued(0),
+              m_stop(false)
+        {
+            for (unsigned int idx = 0; idx < m_num_threads; ++idx)
+            {
+                m_queues.emplace_back(new TaskQueue());
+            }
+            for (unsigned int idx = 1; idx < m_num_threads; ++idx)
+            {
+                m_workers.emplace_back(&TaskPool::work, this, idx);
+            }
+        }
+
+        ~TaskPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_wake_mutex);
+                m_stop = true;
+            }
+            m_wake_cv.notify_all();
+
+            for (auto &worker : m_workers)
+            {
+                worker.join();
+            }
+        }
+
+        TaskPool(TaskPool const &) = delete;
+        TaskPool &operator=(TaskPool const &) = delete;
+
+        /// The pool used by the algorithms.
+        static TaskPool &instance()
+        {
+            static TaskPool pool;
+            return pool;
+        }
+
+        /// The number of threads the OpenMP backend would use, or the
+        /// number of cores.
+        static unsigned int default_num_threads()
+        {
+#ifdef _OPENMP
+            return std::max(omp_get_max_threads(), 1);
+#else
+            return std::max(std::thread::hardware_concurrency(), 1U);
+#endif
+        }
+
+        /// The number of threads that run tasks (the workers and the
+        /// thread that waits).
+        unsigned int num_threads() const { return m_num_threads; }
+
+        /**
+         * @brief Queue a task: on the calling worker's own deque, or on the
+         *        deque shared by the threads outside the pool.  The task
+         *        runs in the calling thread's reduction mode.
+         */
+        void submit(Task task)
+        {
+            task = detail::with_reduction_mode(reduction_mode(),
+                                               std::move(task));
+
+            WorkerId const &self(current_worker());
+            std::size_t queue_idx((self.pool == this) ? self.index : 0);
+
+            {
+                std::lock_guard<std::mutex> lock(m_queues[queue_idx]->mutex);
+                m_queues[queue_idx]->tasks.push_back(std::move(task));
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_wake_mutex);
+                ++m_queued;
+            }
+            m_wake_cv.notify_one();
+        }
+
+        /**
+         * @brief Run one queued task on the calling thread, if there is
+         *        one.
+         *
+         * @return false if every deque was empty.
+         */
+        bool run_pending_task()
+        {
+            WorkerId const &self(current_worker());
+            std::size_t queue_idx((self.pool == this) ? self.index : 0);
+
+            Task task;
+            if (!take_task(queue_idx, task))
+            {
+                return false;
+            }
+
+            run_task(task);
+            return true;
+        }
+
+    private:
+        struct TaskQueue
+        {
+            std::mutex       mutex;
+            std::deque<Task> tasks;
+        };
+
+        struct WorkerId
+        {
+            TaskPool const *pool;
+            std::size_t     index;
+        };
+
+        /// The pool (if any) and deque that belong to the calling thread.
+        static WorkerId &current_worker()
+        {
+            static thread_local WorkerId worker_id = {nullptr, 0};
+            return worker_id;
+        }
+
+        /// Runs a task with the operations it calls limited to one thread.
+        class SerialOperations
+        {
+        public:
+#ifdef _OPENMP
+            SerialOperations() : m_saved_num_threads(omp_get_max_threads())
+            {
+                omp_set_num_threads(1);
+            }
+            ~SerialOperations() { omp_set_num_threads(m_saved_num_threads); }
+
+        private:
+            int m_saved_num_threads;
+#endif
+        };
+
+        static void run_task(Task &task)
+        {
+            SerialOperations serial;
+            task();
+            task = nullptr;
+        }
+
+        /// Pop the newest task of queue_idx or steal the oldest task of
+        /// another deque.
+        bool take_task(std::size_t queue_idx, Task &task)
+        {
+            {
+                TaskQueue &own(*m_queues[queue_idx]);
+                std::lock_guard<std::mutex> lock(own.mutex);
+                if (!own.tasks.empty())
+                {
+                    task = std::move(own.tasks.back());
+                    own.tasks.pop_back();
+                    --m_queued;
+                    return true;
+                }
+            }
+
+            for (std::size_t offset = 1; offset < m_queues.size(); ++offset)
+            {
+                TaskQueue &victim(
+                    *m_queues[(queue_idx + offset) % m_queues.size()]);
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                    --m_queued;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void work(std::size_t index)
+        {
+            current_worker().pool = this;
+            current_worker().index = index;
+
+            Task task;
+            while (true)
+            {
+                if (take_task(index, task))
+                {
+                    run_task(task);
+                    continue;
+                }
+
+                std::unique_lock<std::mutex> lock(m_wake_mutex);
+                m_wake_cv.wait(lock, [this]() {
+                        return m_stop || (m_queued.load() > 0); });
+                if (m_stop && (m_queued.load() == 0))
+                {
+                    return;
+                }
+            }
+        }
+
+        unsigned int                            m_num_threads;
+        std::vector<std::unique_ptr<TaskQueue> > m_queues;
+        std::vector<std::thread>                m_workers;
+
+        std::mutex                              m_wake_mutex;
+        std::condition_variable                 m_wake_cv;
+        std::atomic<std::size_t>                m_queued;
+        bool                                    m_stop;
+    };
+
+    //************************************************************************
+    /**
+     * @brief A set of tasks run on a TaskPool that can be waited on.
+     *
+     * An exception thrown by a task is rethrown by wait (the first one, if
+     * several tasks throw).
+     */
+    class TaskGroup
+    {
+    public:
+        explicit TaskGroup(TaskPool &pool = TaskPool::instance())
+            : m_pool(pool),
+              m_pending(0)
+        {
+        }
+
+        /// Waits for the tasks still running (their exceptions are lost).
+        ~TaskGroup()
+        {
+            finish();
+        }
+
+        TaskGroup(TaskGroup const &) = delete;
+        TaskGroup &operator=(TaskGroup const &) = delete;
+
+        /// Run fn() as a task of this group (at once if the pool has a
+        /// single thread).
+        template <typename FunctionT>
+        void run(FunctionT fn)
+        {
+            if (m_pool.num_threads() == 1)
+            {
+                execute(fn);
+                return;
+            }
+
+            ++m_pending;
+            m_pool.submit([this, fn]() mutable {
+                    execute(fn);
+                    --m_pending; // the group may be gone after this
+                });
+        }
+
+        /// Run tasks until every task of this group is done.
+        void wait()
+        {
+            finish();
+
+            if (m_error)
+            {
+                std::exception_ptr error;
+                std::swap(error, m_error);
+                std::rethrow_exception(error);
+            }
+        }
+
+    private:
+        template <typename FunctionT>
+        void execute(FunctionT &fn)
+        {
+            try
+            {
+                fn();
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(m_error_mutex);
+                if (!m_error)
+                {
+                    m_error = std::current_exception();
+                }
+            }
+        }
+
+        void finish()
+        {
+            while (m_pending.load() > 0)
+            {
+                if (!m_pool.run_pending_task())
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+
+        TaskPool                 &m_pool;
+        std::atomic<std::size_t>  m_pending;
+        std::mutex                m_error_mutex;
+        std::exception_ptr        m_error;
+    };
+
+    //************************************************************************
+    /**
+     * @brief Call fn(chunk_begin, chunk_end) for each chunk of grain
+     *        indices of [begin, end), in parallel on a TaskPool.
+     *
+     * The chunks are the same for any number of threads, so work that is
+     * combined per chunk gives the same result.  The range is split in
+     * halves recursively, so idle threads steal large parts of it.
+     */
+    template <typename FunctionT>
+    void parallel_for(IndexType  begin,
+                      IndexType  end,
+                      FunctionT  fn,
+                      IndexType  grain = 1,
+                      TaskPool  &pool = TaskPool::instance())
+    {
+        if (end <= begin)
+        {
+            return;
+        }
+
+        grain = std::max<IndexType>(grain, 1);
+        IndexType num_chunks((end - begin + grain - 1)/grain);
+
+        auto run_chunk = [&](IndexType chunk)
+        {
+            IndexType chunk_begin(begin + chunk*grain);
+            fn(chunk_begin, std::min(chunk_begin + grain, end));
+        };
+
+        if ((pool.num_threads() == 1) || (num_chunks == 1))
+        {
+            for (IndexType chunk = 0; chunk < num_chunks; ++chunk)
+            {
+                run_chunk(chunk);
+            }
+            return;
+        }
+
+        TaskGroup group(pool);
+        std::function<void(IndexType, IndexType)> split;
+        split = [&](IndexType first, IndexType last)
+        {
+            while (last - first > 1)
+            {
+                IndexType mid(first + (last - first)/2);
+                group.run([&split, mid, last]() { split(mid, last); });
+                last = mid;
+            }
+            run_chunk(first);
+        };
+
+        split(0, num_chunks);
+        group.wait();
+    }
+
+} // GraphBLAS
+
+#endif // GB_TASK_POOL_HPP
@@ -0,0 +1,911 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * @file TiledMatrix.hpp
+ *
+ * @brief A read-only matrix kept on disk as tiles of consecutive rows, for
+ *        graphs larger than memory, and the operations that stream it.
+ *
+ * mxv, vxm and reduce on a TiledMatrix read its tiles from the file in
+ * order, one tile at a time, while the next tile is read by another
+ * thread.  Only two tiles and the vectors are kept in memory.  The
+ * algorithms that use only these operations on their graph (such as
+ * algorithms::bfs and algorithms::page_rank) run on a TiledMatrix
+ * unchanged.
+ *
+ * The file is a TiledMatrixHeader, the tiles (each aligned to
+ * SNAPSHOT_ALIGNMENT bytes and laid out like a snapshot: row offsets,
+ * column indices and values) and a directory of the tiles.
+ */
+
+#ifndef GB_TILED_MATRIX_HPP
+#define GB_TILED_MATRIX_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/algebra.hpp>
+#include <graphblas/Matrix.hpp>
+#include <graphblas/Vector.hpp>
+#include <graphblas/operations.hpp>
+#include <graphblas/ReductionMode.hpp>
+#include <graphblas/TaskPool.hpp>
+#include <graphblas/NonBlocking.hpp>
+#include <graphblas/expressions.hpp>
+#include <graphblas/snapshot.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    /// The default size of the tiles written by TiledMatrixWriter (a tile
+    /// holds whole rows, so a long row makes a larger tile).
+    static std::size_t const TILED_MATRIX_TILE_BYTES = 1 << 26;
+
+    /// The number of rows of a tile processed by one task.
+    static IndexType const TILED_MATRIX_ROWS_PER_TASK = 1024;
+
+    namespace detail
+    {
+        //********************************************************************
+        /// The first bytes of a tiled matrix file.
+        struct TiledMatrixHeader
+        {
+            char          magic[8];       ///< "GBTLTILE"
+            std::uint32_t byte_order;     ///< 0x01020304 as written
+            std::uint32_t version;        ///< SNAPSHOT_VERSION
+            std::uint32_t scalar_type;    ///< snapshot_type_tag<ScalarT>()
+            std::uint32_t reserved;
+            std::uint64_t nrows;
+            std::uint64_t ncols;
+            std::uint64_t nvals;
+            std::uint64_t num_tiles;
+            std::uint64_t directory_pos;
+        };
+
+        static_assert(sizeof(TiledMatrixHeader) == 64,
+                      "TiledMatrixHeader must be 64 bytes");
+
+        /// An entry of the directory at the end of a tiled matrix file.
+        struct TileEntry
+        {
+            std::uint64_t row_begin;
+            std::uint64_t nrows;
+            std::uint64_t nvals;
+            std::uint64_t pos;
+            std::uint64_t size;
+        };
+
+        /// Where the sections of a tile start (relative to the tile), and
+        /// its size.
+        struct TileLayout
+        {
+            TileLayout(IndexType nrows, IndexType nvals, std::size_t value_size)
+                : indices_pos(snapshot_align((nrows + 1)*sizeof(IndexType))),
+                  values_pos(snapshot_align(indices_pos +
+                                            nvals*sizeof(IndexType))),
+                  size(snapshot_align(values_pos + nvals*value_size))
+            {}
+
+            std::uint64_t indices_pos;
+            std::uint64_t values_pos;
+            std::uint64_t size;
+        };
+
+        /// Read size bytes at pos of a file (which must hold them).
+        inline void read_at(int fd, char *data, std::size_t size,
+                            std::uint64_t pos, std::string const &path)
+        {
+            while (size > 0)
+            {
+                ssize_t count(::pread(fd, data, size, pos));
+                if (count <= 0)
+                {
+                    throw IOException("cannot read " + path);
+                }
+                data += count;
+                size -= count;
+                pos += count;
+            }
+        }
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief Writes a tiled matrix file a row at a time, so a matrix can be
+     *        written from a source larger than memory (a MappedMatrix for
+     *        example).
+     *
+     * A tile is written when its rows reach the tile size given to the
+     * constructor.
+     */
+    template <typename ScalarT>
+    class TiledMatrixWriter
+    {
+    public:
+        typedef typename detail::snapshot_value<ScalarT>::type ValueType;
+
+        /// @throw IOException  if the file cannot be created.
+        TiledMatrixWriter(std::string const &path,
+                          IndexType          nrows,
+                          IndexType          ncols,
+                          std::size_t        tile_bytes = TILED_MATRIX_TILE_BYTES)
+            : m_path(path),
+              m_out(path, std::ios::binary),
+              m_nrows(nrows),
+              m_ncols(ncols),
+              m_nvals(0),
+              m_tile_bytes(tile_bytes),
+              m_row_begin(0),
+              m_pos(sizeof(detail::TiledMatrixHeader))
+        {
+            if (!m_out)
+            {
+                throw IOException("cannot open " + path);
+            }
+            m_offsets.push_back(0);
+            m_out.seekp(m_pos);
+            write_padding(detail::snapshot_align(m_pos) - m_pos);
+        }
+
+        TiledMatrixWriter(TiledMatrixWriter const &) = delete;
+        TiledMatrixWriter &operator=(TiledMatrixWriter const &) = delete;
+
+        /// The number of rows appended so far.
+        IndexType rows() const { return m_row_begin + m_offsets.size() - 1; }
+
+        /**
+         * @brief Append the next row: a sequence of (column index, value)
+         *        tuples in increasing column order.
+         *
+         * @throw IndexOutOfBoundsException  if there are no rows left or a
+         *                                   column index is out of range.
+         */
+        template <typename RowT>
+        void appendRow(RowT const &row)
+        {
+            if (rows() >= m_nrows)
+            {
+                throw IndexOutOfBoundsException(
+                    "TiledMatrixWriter::appendRow: too many rows");
+            }
+            for (auto const &elt : row)
+            {
+                if (std::get<0>(elt) >= m_ncols)
+                {
+                    throw IndexOutOfBoundsException(
+                        "TiledMatrixWriter::appendRow: index out of bounds");
+                }
+                m_indices.push_back(std::get<0>(elt));
+                m_values.push_back(static_cast<ValueType>(std::get<1>(elt)));
+            }
+            m_offsets.push_back(m_indices.size());
+
+            if (m_offsets.size()*sizeof(IndexType) +
+                m_indices.size()*(sizeof(IndexType) + sizeof(ValueType)) >=
+                m_tile_bytes)
+            {
+                flush_tile();
+            }
+        }
+
+        /**
+         * @brief Write the last tile (the rows not appended are empty),
+         *        the directory and the header.
+         *
+         * @throw IOException  if the file cannot be written.
+         */
+        void finish()
+        {
+            while (rows() < m_nrows)
+            {
+                m_offsets.push_back(m_indices.size());
+            }
+            flush_tile();
+
+            detail::TiledMatrixHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, "GBTLTILE", 8);
+            header.byte_order = 0x01020304;
+            header.version = SNAPSHOT_VERSION;
+            header.scalar_type = detail::snapshot_type_tag<ScalarT>();
+            header.nrows = m_nrows;
+            header.ncols = m_ncols;
+            header.nvals = m_nvals;
+            header.num_tiles = m_tiles.size();
+            header.directory_pos = m_pos;
+
+            m_out.write(reinterpret_cast<char const *>(m_tiles.data()),
+                        m_tiles.size()*sizeof(detail::TileEntry));
+            m_out.seekp(0);
+            m_out.write(reinterpret_cast<char const *>(&header),
+                        sizeof(header));
+            m_out.close();
+            if (!m_out)
+            {
+                throw IOException("cannot write " + m_path);
+            }
+        }
+
+    private:
+        void write_padding(std::size_t size)
+        {
+            static char const zeros[SNAPSHOT_ALIGNMENT] = {};
+            m_out.write(zeros, size);
+            m_pos += size;
+        }
+
+        void flush_tile()
+        {
+            IndexType nrows(m_offsets.size() - 1);
+            if (nrows == 0)
+            {
+                return;
+            }
+
+            IndexType nvals(m_indices.size());
+            detail::TileLayout layout(nrows, nvals, sizeof(ValueType));
+            detail::TileEntry entry = {m_row_begin, nrows, nvals, m_pos,
+                                       layout.size};
+            std::uint64_t begin(m_pos);
+
+            m_out.write(reinterpret_cast<char const *>(m_offsets.data()),
+                        m_offsets.size()*sizeof(IndexType));
+            m_pos += m_offsets.size()*sizeof(IndexType);
+            write_padding(begin + layout.indices_pos - m_pos);
+            m_out.write(reinterpret_cast<char const *>(m_indices.data()),
+                        nvals*sizeof(IndexType));
+            m_pos += nvals*sizeof(IndexType);
+            write_padding(begin + layout.values_pos - m_pos);
+            m_out.write(reinterpret_cast<char const *>(m_values.data()),
+                        nvals*sizeof(ValueType));
+            m_pos += nvals*sizeof(ValueType);
+            write_padding(begin + layout.size - m_pos);
+
+            m_tiles.push_back(entry);
+            m_nvals += nvals;
+            m_row_begin += nrows;
+            m_offsets.assign(1, 0);
+            m_indices.clear();
+            m_values.clear();
+        }
+
+        std::string                      m_path;
+        std::ofstream                    m_out;
+        IndexType                        m_nrows;
+        IndexType                        m_ncols;
+        IndexType                        m_nvals;
+        std::size_t                      m_tile_bytes;
+        IndexType                        m_row_begin;
+        std::uint64_t                    m_pos;
+        std::vector<detail::TileEntry>   m_tiles;
+
+        // The rows of the tile being written
+        std::vector<IndexType>           m_offsets;
+        std::vector<IndexType>           m_indices;
+        std::vector<ValueType>           m_values;
+    };
+
+    //************************************************************************
+    /**
+     * @brief A read-only matrix kept on disk as tiles of consecutive rows.
+     *
+     * Nothing but the directory of the tiles is read when it is opened;
+     * forEachTile() reads the tiles in order, each while the previous one
+     * is being processed, and mxv, vxm and reduce use it to stream the
+     * matrix.
+     */
+    template <typename ScalarT>
+    class TiledMatrix
+    {
+    public:
+        typedef ScalarT ScalarType;
+        typedef typename detail::snapshot_value<ScalarT>::type ValueType;
+        typedef typename MappedMatrix<ScalarT>::RowView RowView;
+
+        /// The rows of one tile, in memory.
+        class Tile
+        {
+        public:
+            Tile() : m_capacity(0), m_row_begin(0), m_nrows(0) {}
+
+            IndexType rowBegin() const { return m_row_begin; }
+            IndexType rowEnd() const   { return m_row_begin + m_nrows; }
+            IndexType nvals() const    { return m_offsets[m_nrows]; }
+
+            /// A row of the tile (row_index is a row of the matrix).
+            RowView getRow(IndexType row_index) const
+            {
+                IndexType local(row_index - m_row_begin);
+                IndexType first(m_offsets[local]);
+                return RowView(m_indices + first, m_values + first,
+                               m_offsets[local + 1] - first);
+            }
+
+        private:
+            friend class TiledMatrix<ScalarT>;
+
+            // new char[] is suitably aligned for any scalar type
+            std::unique_ptr<char[]>  m_data;
+            std::size_t              m_capacity;
+            IndexType                m_row_begin;
+            IndexType                m_nrows;
+            IndexType const         *m_offsets;
+            IndexType const         *m_indices;
+            ValueType const         *m_values;
+        };
+
+        /**
+         * @brief Open a tiled matrix file (see TiledMatrixWriter and
+         *        save_tiled()).
+         *
+         * @throw IOException  if the file is not a tiled matrix of ScalarT
+         *                     or is corrupt.
+         */
+        explicit TiledMatrix(std::string const &path)
+            : m_path(path),
+              m_fd(::open(path.c_str(), O_RDONLY))
+        {
+            if (m_fd < 0)
+            {
+                throw IOException("cannot open " + path);
+            }
+            try
+            {
+                open();
+            }
+            catch (...)
+            {
+                ::close(m_fd);
+                throw;
+            }
+        }
+
+        ~TiledMatrix() { ::close(m_fd); }
+
+        TiledMatrix(TiledMatrix const &) = delete;
+        TiledMatrix &operator=(TiledMatrix const &) = delete;
+
+        IndexType nrows() const    { return m_nrows; }
+        IndexType ncols() const    { return m_ncols; }
+        IndexType nvals() const    { return m_nvals; }
+        IndexType numTiles() const { return m_tiles.size(); }
+
+        /// Read a tile into tile (reusing its memory).
+        void readTile(IndexType tile_index, Tile &tile) const
+        {
+            detail::TileEntry const &entry(m_tiles[tile_index]);
+            if (tile.m_capacity < entry.size)
+            {
+                tile.m_data.reset(new char[entry.size]);
+                tile.m_capacity = entry.size;
+            }
+            detail::read_at(m_fd, tile.m_data.get(), entry.size, entry.pos,
+                            m_path);
+
+            detail::TileLayout layout(entry.nrows, entry.nvals,
+                                      sizeof(ValueType));
+            char const *data(tile.m_data.get());
+            tile.m_row_begin = entry.row_begin;
+            tile.m_nrows = entry.nrows;
+            tile.m_offsets = reinterpret_cast<IndexType const *>(data);
+            tile.m_indices = reinterpret_cast<IndexType const *>(
+                data + layout.indices_pos);
+            tile.m_values = reinterpret_cast<ValueType const *>(
+                data + layout.values_pos);
+            if ((tile.m_offsets[0] != 0) ||
+                (tile.m_offsets[entry.nrows] != entry.nvals))
+            {
+                throw IOException("tiled matrix has a corrupt tile: " + m_path);
+            }
+        }
+
+        /**
+         * @brief Call fn(tile) for each tile in order.  The next tile is
+         *        read by another thread while fn runs.
+         */
+        template <typename FunctionT>
+        void forEachTile(FunctionT fn) const
+        {
+            if (m_tiles.empty())
+            {
+                return;
+            }
+
+            Tile current, next;
+            readTile(0, current);
+            for (IndexType tile_index = 0; tile_index < m_tiles.size();
+                 ++tile_index)
+            {
+                std::future<void> prefetch;
+                if (tile_index + 1 < m_tiles.size())
+                {
+                    prefetch = std::async(
+                        std::launch::async,
+                        [this, tile_index, &next]()
+                        { readTile(tile_index + 1, next); });
+                }
+
+                try
+                {
+                    fn(static_cast<Tile const &>(current));
+                }
+                catch (...)
+                {
+                    if (prefetch.valid())
+                    {
+                        prefetch.wait();
+                    }
+                    throw;
+                }
+
+                if (prefetch.valid())
+                {
+                    prefetch.get();
+                }
+                std::swap(current, next);
+            }
+        }
+
+    private:
+        void open()
+        {
+            struct stat info;
+            if (::fstat(m_fd, &info) != 0)
+            {
+                throw IOException("cannot read " + m_path);
+            }
+            std::uint64_t file_size(info.st_size);
+
+            detail::TiledMatrixHeader header;
+            if (file_size < sizeof(header))
+            {
+                throw IOException("not a tiled matrix: " + m_path);
+            }
+            detail::read_at(m_fd, reinterpret_cast<char *>(&header),
+                            sizeof(header), 0, m_path);
+            if ((std::memcmp(header.magic, "GBTLTILE", 8) != 0) ||
+                (header.byte_order != 0x01020304))
+            {
+                throw IOException("not a tiled matrix (or of another byte "
+                                  "order): " + m_path);
+            }
+            if (header.version != SNAPSHOT_VERSION)
+            {
+                throw IOException("unsupported tiled matrix version " +
+                                  std::to_string(header.version) + ": " +
+                                  m_path);
+            }
+            if (header.scalar_type != detail::snapshot_type_tag<ScalarT>())
+            {
+                throw IOException("tiled matrix holds another scalar type: " +
+                                  m_path);
+            }
+            if (header.directory_pos +
+                header.num_tiles*sizeof(detail::TileEntry) != file_size)
+            {
+                throw IOException("tiled matrix is truncated or corrupt: " +
+                                  m_path);
+            }
+
+            m_nrows = header.nrows;
+            m_ncols = header.ncols;
+            m_nvals = header.nvals;
+            m_tiles.resize(header.num_tiles);
+            detail::read_at(m_fd, reinterpret_cast<char *>(m_tiles.data()),
+                            m_tiles.size()*sizeof(detail::TileEntry),
+                            header.directory_pos, m_path);
+
+            // The tiles must cover the rows in order
+            IndexType row_begin(0), nvals(0);
+            for (auto const &entry : m_tiles)
+            {
+                detail::TileLayout layout(entry.nrows, entry.nvals,
+                                          sizeof(ValueType));
+                if ((entry.row_begin != row_begin) ||
+                    (entry.size != layout.size) ||
+                    (entry.pos + entry.size > header.directory_pos))
+                {
+                    throw IOException("tiled matrix has a corrupt directory: " +
+                                      m_path);
+                }
+                row_begin += entry.nrows;
+                nvals += entry.nvals;
+            }
+            if ((row_begin != m_nrows) || (nvals != m_nvals))
+            {
+                throw IOException("tiled matrix has a corrupt directory: " +
+                                  m_path);
+            }
+
+            ::posix_fadvise(m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+
+        std::string                     m_path;
+        int                             m_fd;
+        IndexType                       m_nrows;
+        IndexType                       m_ncols;
+        IndexType                       m_nvals;
+        std::vector<detail::TileEntry>  m_tiles;
+    };
+
+    //************************************************************************
+    /**
+     * @brief Write a matrix as a tiled matrix file.
+     *
+     * @throw IOException  if the file cannot be written.
+     */
+    template <typename ScalarT, typename... TagsT>
+    void save_tiled(std::string               const &path,
+                    Matrix<ScalarT, TagsT...> const &A,
+                    std::size_t tile_bytes = TILED_MATRIX_TILE_BYTES)
+    {
+        auto const &mat(expr::backend_access::matrix(A));
+        detail::sync_read(mat);
+
+        TiledMatrixWriter<ScalarT> out(path, mat.nrows(), mat.ncols(),
+                                       tile_bytes);
+        for (IndexType row_idx = 0; row_idx < mat.nrows(); ++row_idx)
+        {
+            out.appendRow(mat.getRow(row_idx));
+        }
+        out.finish();
+    }
+
+    /**
+     * @brief Write a mapped snapshot as a tiled matrix file, a row at a
+     *        time (so the matrix need not fit in memory).
+     *
+     * @throw IOException  if the file cannot be written.
+     */
+    template <typename ScalarT>
+    void save_tiled(std::string           const &path,
+                    MappedMatrix<ScalarT> const &A,
+                    std::size_t tile_bytes = TILED_MATRIX_TILE_BYTES)
+    {
+        TiledMatrixWriter<ScalarT> out(path, A.nrows(), A.ncols(), tile_bytes);
+        for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+        {
+            out.appendRow(A.getRow(row_idx));
+        }
+        out.finish();
+    }
+
+    namespace detail
+    {
+        //********************************************************************
+        /// A vector expanded to dense arrays of values and of flags that
+        /// tell which values are stored.
+        template <typename ScalarT>
+        struct DenseOperand
+        {
+            template <typename VectorT>
+            explicit DenseOperand(VectorT const &u)
+                : values(u.size()), stored(u.size(), 0)
+            {
+                IndexArrayType indices(u.nvals());
+                std::vector<ScalarT> vals(u.nvals());
+                u.extractTuples(indices, vals);
+                for (IndexType idx = 0; idx < indices.size(); ++idx)
+                {
+                    values[indices[idx]] = vals[idx];
+                    stored[indices[idx]] = 1;
+                }
+            }
+
+            explicit DenseOperand(IndexType size)
+                : values(size), stored(size, 0) {}
+
+            /// The stored values as a Vector.
+            Vector<ScalarT> toVector() const
+            {
+                std::vector<std::tuple<IndexType, ScalarT> > contents;
+                for (IndexType idx = 0; idx < values.size(); ++idx)
+                {
+                    if (stored[idx])
+                    {
+                        contents.push_back(std::make_tuple(
+                            idx, static_cast<ScalarT>(values[idx])));
+                    }
+                }
+                Vector<ScalarT> t(values.size());
+                expr::backend_access::vector(t).setContents(contents);
+                return t;
+            }
+
+            // char rather than bool so that the values of different rows
+            // can be written concurrently.
+            typedef typename std::conditional<
+                std::is_same<ScalarT, bool>::value, char, ScalarT>::type
+                ValueType;
+
+            std::vector<ValueType>  values;
+            std::vector<char>       stored;
+        };
+
+        /// w<mask> = accum(w, t), by the frontend apply
+        template <typename WVectorT, typename MaskT, typename AccumT,
+                  typename D3ScalarT>
+        void write_tiled_result(WVectorT                         &w,
+                                MaskT                      const &mask,
+                                AccumT                            accum,
+                                DenseOperand<D3ScalarT>    const &t,
+                                bool                              replace_flag)
+        {
+            Vector<D3ScalarT> t_vec(t.toVector());
+            GraphBLAS::apply(w, mask, accum, Identity<D3ScalarT>(), t_vec,
+                             replace_flag);
+        }
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief mxv (4.3.3) with a TiledMatrix: each row's dot product is
+     *        computed as its tile is streamed, the rows of a tile in
+     *        parallel.
+     */
+    template<typename WVectorT,
+             typename MaskT,
+             typename AccumT,
+             typename SemiringT,
+             typename AScalarT,
+             typename UVectorT>
+    inline void mxv(WVectorT                      &w,
+                    MaskT                   const &mask,
+                    AccumT                         accum,
+                    SemiringT                      op,
+                    TiledMatrix<AScalarT>   const &A,
+                    UVectorT                const &u,
+                    bool                           replace_flag = false)
+    {
+        typedef typename SemiringT::result_type D3ScalarType;
+        typedef typename UVectorT::ScalarType   UScalarType;
+
+        check_size_size(w, mask, "mxv: w.size != mask.size");
+        check_size_nrows(w, A, "mxv: w.size != A.nrows");
+        check_size_ncols(u, A, "mxv: u.size != A.ncols");
+
+        detail::DenseOperand<UScalarType> u_dense(u);
+        detail::DenseOperand<D3ScalarType> t(A.nrows());
+        A.forEachTile(
+            [&](typename TiledMatrix<AScalarT>::Tile const &tile)
+            {
+                parallel_for(
+                    tile.rowBegin(), tile.rowEnd(),
+                    [&](IndexType row_begin, IndexType row_end)
+                    {
+                        for (IndexType row_idx = row_begin; row_idx < row_end;
+                             ++row_idx)
+                        {
+                            D3ScalarType sum(op.zero());
+                            char stored(0);
+                            for (auto elt : tile.getRow(row_idx))
+                            {
+                                IndexType col_idx(std::get<0>(elt));
+                                if (u_dense.stored[col_idx])
+                                {
+                                    D3ScalarType product(
+                                        op.mult(std::get<1>(elt),
+                                                static_cast<UScalarType>(
+                                                    u_dense.values[col_idx])));
+                                    sum = op.add(sum, product);
+                                    stored = 1;
+                                }
+                            }
+                            t.values[row_idx] = sum;
+                            t.stored[row_idx] = stored;
+                        }
+                    },
+                    TILED_MATRIX_ROWS_PER_TASK);
+            });
+
+        detail::write_tiled_result(w, mask, accum, t, replace_flag);
+    }
+
+    /**
+     * @brief vxm (4.3.2) with a TiledMatrix: the rows of each tile with a
+     *        stored value in u are scattered into a dense result as the
+     *        tile is streamed.
+     */
+    template<typename WVectorT,
+             typename MaskT,
+             typename AccumT,
+             typename SemiringT,
+             typename UVectorT,
+             typename AScalarT>
+    inline void vxm(WVectorT                      &w,
+                    MaskT                   const &mask,
+                    AccumT                         accum,
+                    SemiringT                      op,
+                    UVectorT                const &u,
+                    TiledMatrix<AScalarT>   const &A,
+                    bool                           replace_flag = false)
+    {
+        typedef typename SemiringT::result_type D3ScalarType;
+        typedef typename UVectorT::ScalarType   UScalarType;
+
+        check_size_size(w, mask, "vxm: w.size != mask.size");
+        check_size_ncols(w, A, "vxm: w.size != A.ncols");
+        check_size_nrows(u, A, "vxm: u.size != A.nrows");
+
+        detail::DenseOperand<UScalarType> u_dense(u);
+        detail::DenseOperand<D3ScalarType> t(A.ncols());
+        A.forEachTile(
+            [&](typename TiledMatrix<AScalarT>::Tile const &tile)
+            {
+                for (IndexType row_idx = tile.rowBegin();
+                     row_idx < tile.rowEnd(); ++row_idx)
+                {
+                    if (!u_dense.stored[row_idx])
+                    {
+                        continue;
+                    }
+                    UScalarType u_val(u_dense.values[row_idx]);
+                    for (auto elt : tile.getRow(row_idx))
+                    {
+                        IndexType col_idx(std::get<0>(elt));
+                        if (!t.stored[col_idx])
+                        {
+                            t.values[col_idx] = op.zero();
+                            t.stored[col_idx] = 1;
+                        }
+                        t.values[col_idx] = op.add(
+                            static_cast<D3ScalarType>(t.values[col_idx]),
+                            op.mult(u_val, std::get<1>(elt)));
+                    }
+                }
+            });
+
+        detail::write_tiled_result(w, mask, accum, t, replace_flag);
+    }
+
+    /**
+     * @brief reduce (4.3.9.1, the rows to a vector) of a TiledMatrix, the
+     *        rows of each tile in parallel.
+     */
+    template<typename WVectorT,
+             typename MaskT,
+             typename AccumT,
+             typename BinaryOpT,  // monoid or binary op only
+             typename AScalarT>
+    inline void reduce(WVectorT                      &w,
+                       MaskT                   const &mask,
+                       AccumT                         accum,
+                       BinaryOpT                      op,
+                       TiledMatrix<AScalarT>   const &A,
+                       bool                           replace_flag = false)
+    {
+        typedef typename BinaryOpT::result_type D3ScalarType;
+
+        check_size_size(w, mask, "reduce(mat2vec): w.size != mask.size");
+        check_size_nrows(w, A, "reduce(mat2vec): w.size != A.nrows");
+
+        detail::DenseOperand<D3ScalarType> t(A.nrows());
+        A.forEachTile(
+            [&](typename TiledMatrix<AScalarT>::Tile const &tile)
+            {
+                parallel_for(
+                    tile.rowBegin(), tile.rowEnd(),
+                    [&](IndexType row_begin, IndexType row_end)
+                    {
+                        for (IndexType row_idx = row_begin; row_idx < row_end;
+                             ++row_idx)
+                        {
+                            auto row(tile.getRow(row_idx));
+                            if (row.empty())
+                            {
+                                continue;
+                            }
+                            auto it(row.begin());
+                            D3ScalarType sum(
+                                static_cast<D3ScalarType>(std::get<1>(*it)));
+                            for (++it; it != row.end(); ++it)
+                            {
+                                sum = op(sum, static_cast<D3ScalarType>(
+                                             std::get<1>(*it)));
+                            }
+                            t.values[row_idx] = sum;
+                            t.stored[row_idx] = 1;
+                        }
+                    },
+                    TILED_MATRIX_ROWS_PER_TASK);
+            });
+
+        detail::write_tiled_result(w, mask, accum, t, replace_flag);
+    }
+
+    /**
+     * @brief reduce (4.3.9.3, to a scalar) of a TiledMatrix.  The values
+     *        are reduced in row order, by a TreeReduction unless the
+     *        reduction mode is FAST.
+     */
+    template<typename ValueT,
+             typename AccumT,
+             typename MonoidT, // monoid only
+             typename AScalarT>
+    inline void reduce(ValueT                        &val,
+                       AccumT                         accum,
+                       MonoidT                        op,
+                       TiledMatrix<AScalarT>   const &A)
+    {
+        typedef typename MonoidT::result_type D3ScalarType;
+
+        ReductionMode const mode(reduction_mode());
+        TreeReduction<D3ScalarType, MonoidT> tree(
+            op, mode == ReductionMode::COMPENSATED);
+        D3ScalarType t(op.identity());
+        A.forEachTile(
+            [&](typename TiledMatrix<AScalarT>::Tile const &tile)
+            {
+                for (IndexType row_idx = tile.rowBegin();
+                     row_idx < tile.rowEnd(); ++row_idx)
+                {
+                    for (auto elt : tile.getRow(row_idx))
+                    {
+                        D3ScalarType value(
+                            static_cast<D3ScalarType>(std::get<1>(elt)));
+                        if (mode == ReductionMode::FAST)
+                        {
+                            t = op(t, value);
+                        }
+                        else
+                        {
+                            tree.add(value);
+                        }
+                    }
+                }
+            });
+        if ((mode != ReductionMode::FAST) && !tree.empty())
+        {
+            t = tree.result();
+        }
+
+        ValueT z;
+        backend::opt_accum_scalar(z, val, t, accum);
+        val = z;
+    }
+} // GraphBLAS
+
+#endif // GB_TILED_MATRIX_HPP
@@ -87,15 +87,21 @@ namespace GraphBLAS
 
         IndexType nrows() const { return m_mat.nrows(); }
         IndexType ncols() const { return m_mat.ncols(); }
-        IndexType nvals() const { return m_mat.nvals(); }
+        IndexType nvals() const
+        {
+            detail::sync_read(m_mat);
+            return m_mat.nvals();
+        }
 
         bool hasElement(IndexType row, IndexType col) const
         {
+            detail::sync_read(m_mat);
             return m_mat.hasElement(row, col);
         }
 
         ScalarType extractElement(IndexType row, IndexType col) const
         {
+            detail::sync_read(m_mat);
             return m_mat.extractElement(row, col);
         }
 
@@ -107,6 +113,7 @@ namespace GraphBLAS
                                   RAIteratorJT        col_it,
                                   RAIteratorVT        values)
         {
+            detail::sync_read(m_mat);
             m_mat.extractTuples(row_it, col_it, values);
         }
 
@@ -119,6 +126,7 @@ namespace GraphBLAS
                                   ColSequenceT            &col_indices,
                                   std::vector<ValueT>     &values)
         {
+            detail::sync_read(m_mat);
             m_mat.extractTuples(row_indices, col_indices, values);
         }
 
@@ -127,6 +135,7 @@ namespace GraphBLAS
         void printInfo(std::ostream &os) const
         {
             os << "Frontend TransposeView of:" << std::endl;
+            detail::sync_read(m_mat);
             m_mat.printInfo(os);
         }
 
@@ -137,6 +146,33 @@ namespace GraphBLAS
             return os;
         }
 
+        //--------------------------------------------------------------------
+        // Expressions (expressions.hpp)
+
+        /// This transpose times B (a matrix or vector) over the semiring op.
+        template<typename BT, typename SemiringT>
+        expr::Product<TransposeView, BT, SemiringT> mul(BT const &B,
+                                                        SemiringT op) const
+        {
+            return expr::Product<TransposeView, BT, SemiringT>(*this, B, op);
+        }
+
+        /// The element-wise union of this transpose and B.
+        template<typename BT, typename BinaryOpT>
+        expr::EWiseAdd<TransposeView, BT, BinaryOpT> add(BT const &B,
+                                                         BinaryOpT op) const
+        {
+            return expr::EWiseAdd<TransposeView, BT, BinaryOpT>(*this, B, op);
+        }
+
+        /// The element-wise intersection of this transpose and B.
+        template<typename BT, typename BinaryOpT>
+        expr::EWiseMult<TransposeView, BT, BinaryOpT> emult(BT const &B,
+                                                            BinaryOpT op) const
+        {
+            return expr::EWiseMult<TransposeView, BT, BinaryOpT>(*this, B, op);
+        }
+
     private:
         BackendType m_mat;
 
@@ -346,6 +382,10 @@ namespace GraphBLAS
                                      AccumT          accum,
                                      AMatrixT const &A,
                                      bool            replace_flag);
+
+        //--------------------------------------------------------------------
+
+        friend struct expr::backend_access;
     };
 
 } // end namespace GraphBLAS
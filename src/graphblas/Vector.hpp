@@ -31,12 +31,15 @@
 
 #include <cstddef>
 #include <type_traits>
+#include <utility>
 #include <graphblas/detail/config.hpp>
 #include <graphblas/detail/param_unpack.hpp>
 
 #define GB_INCLUDE_BACKEND_VECTOR 1
 #include <backend_include.hpp>
 
+#include <graphblas/NonBlocking.hpp>
+
 namespace GraphBLAS
 {
     template<typename ScalarT, typename... TagsT>
@@ -45,6 +48,32 @@ namespace GraphBLAS
     template<typename VectorT>
     class VectorComplementView;
 
+    namespace fused
+    {
+        template <typename VectorT>
+        class VectorTerm;
+
+        template <typename VectorT, typename TermT>
+        class StoreTerm;
+    }
+
+    namespace expr
+    {
+        struct backend_access;
+
+        template<typename AT, typename BT, typename SemiringT>
+        class Product;
+
+        template<typename AT, typename BT, typename BinaryOpT>
+        class EWiseAdd;
+
+        template<typename AT, typename BT, typename BinaryOpT>
+        class EWiseMult;
+
+        template<typename OutT, typename MaskT>
+        class Target;
+    }
+
     //**************************************************************************
     template<typename ScalarT, typename... TagsT>
     class Vector
@@ -103,8 +132,30 @@ namespace GraphBLAS
             : m_vec(values, zero)
         {
         }
+
+        /**
+         * @brief Copy constructor.
+         *
+         * @param[in] rhs   The vector to copy.
+         */
+        Vector(Vector<ScalarT, TagsT...> const &rhs)
+            : m_vec(detail::completed(rhs.m_vec))
+        {
+        }
+
+        /**
+         * @brief Move constructor.
+         *
+         * @param[in] rhs   The vector whose storage is taken.  It is left
+         *                  empty with the same size.
+         */
+        Vector(Vector<ScalarT, TagsT...> &&rhs)
+            : m_vec(std::move(detail::released(rhs.m_vec)))
+        {
+        }
+
         /// Destructor
-        ~Vector() { }
+        ~Vector() { detail::sync_write(m_vec); }
 
         /**
          * @brief Assignment from another vector
@@ -114,16 +165,35 @@ namespace GraphBLAS
          * @todo Should assignment work only if dimensions are same?
          * @note This clears any previous information
          */
-        Vector<ScalarT, TagsT...>
+        Vector<ScalarT, TagsT...>&
         operator=(Vector<ScalarT, TagsT...> const &rhs)
         {
             if (this != &rhs)
             {
+                detail::sync_write(m_vec);
+                detail::sync_read(rhs.m_vec);
                 m_vec = rhs.m_vec;
             }
             return *this;
         }
 
+        /**
+         * @brief Move assignment from another vector
+         *
+         * @param[in]  rhs  The vector whose storage is taken.  It is cleared.
+         */
+        Vector<ScalarT, TagsT...>&
+        operator=(Vector<ScalarT, TagsT...> &&rhs)
+        {
+            if (this != &rhs)
+            {
+                detail::sync_write(m_vec);
+                detail::sync_write(rhs.m_vec);
+                m_vec = std::move(rhs.m_vec);
+            }
+            return *this;
+        }
+
         /**
          * @brief Assignment from dense data
          *
@@ -134,6 +204,7 @@ namespace GraphBLAS
          */
         Vector<ScalarT, TagsT...>& operator=(std::vector<ScalarT> const &rhs)
         {
+            detail::sync_write(m_vec);
             m_vec = rhs;
             return *this;
         }
@@ -141,6 +212,8 @@ namespace GraphBLAS
         /// @todo need to change to mix and match internal types
         bool operator==(Vector<ScalarT, TagsT...> const &rhs) const
         {
+            detail::sync_read(m_vec);
+            detail::sync_read(rhs.m_vec);
             return (m_vec == rhs.m_vec);
         }
 
@@ -170,6 +243,7 @@ namespace GraphBLAS
                    IndexType    num_vals,
                    BinaryOpT    dup = BinaryOpT())
         {
+            detail::sync_write(m_vec);
             m_vec.build(i_it, v_it, num_vals, dup);
         }
 
@@ -195,28 +269,57 @@ namespace GraphBLAS
             {
                 throw DimensionException("Vector::build");
             }
+            detail::sync_write(m_vec);
             m_vec.build(indices.begin(), values.begin(), values.size(), dup);
         }
 
-        void clear() { m_vec.clear(); }
+        void clear()
+        {
+            detail::sync_write(m_vec);
+            m_vec.clear();
+        }
+
+        /**
+         * @brief Place the stored values on the NUMA nodes of the system (a no-op
+         *        without NUMA support).  The contents do not change.
+         */
+        void place(NumaPolicy policy)
+        {
+            detail::sync_write(m_vec);
+            m_vec.place(policy);
+        }
+
+        /// The policy the stored values were last placed with.
+        NumaPolicy placement() const
+        {
+            detail::sync_read(m_vec);
+            return m_vec.placement();
+        }
 
         IndexType size() const   { return m_vec.size(); }
-        IndexType nvals() const  { return m_vec.nvals(); }
+        IndexType nvals() const
+        {
+            detail::sync_read(m_vec);
+            return m_vec.nvals();
+        }
 
         bool hasElement(IndexType index) const
         {
+            detail::sync_read(m_vec);
             return m_vec.hasElement(index);
         }
 
         void setElement(IndexType      index,
                         ScalarT const &new_val)
         {
+            detail::sync_write(m_vec);
             m_vec.setElement(index, new_val);
         }
 
         /// @throw NoValueException if there is no value stored at (row,col)
         ScalarT extractElement(IndexType index) const
         {
+            detail::sync_read(m_vec);
             return m_vec.extractElement(index);
         }
 
@@ -225,12 +328,14 @@ namespace GraphBLAS
         void extractTuples(RAIteratorIT        i_it,
                            RAIteratorVT        v_it) const
         {
+            detail::sync_read(m_vec);
             m_vec.extractTuples(i_it, v_it);
         }
 
         void extractTuples(IndexArrayType        &indices,
                            std::vector<ScalarT>  &values) const
         {
+            detail::sync_read(m_vec);
             m_vec.extractTuples(indices, values);
         }
 
@@ -238,9 +343,42 @@ namespace GraphBLAS
         /// information.
         void printInfo(std::ostream &os) const
         {
+            detail::sync_read(m_vec);
             m_vec.printInfo(os);
         }
 
+        //--------------------------------------------------------------------
+        // Expressions (expressions.hpp)
+
+        /// The output w<mask> of an expression: w(mask, replace_flag) = expr.
+        template<typename MaskT>
+        expr::Target<Vector, MaskT> operator()(MaskT const &mask,
+                                               bool         replace_flag = false)
+        {
+            return expr::Target<Vector, MaskT>(*this, mask, replace_flag);
+        }
+
+        /// This vector times the matrix A over the semiring op.
+        template<typename AT, typename SemiringT>
+        expr::Product<Vector, AT, SemiringT> mul(AT const &A, SemiringT op) const
+        {
+            return expr::Product<Vector, AT, SemiringT>(*this, A, op);
+        }
+
+        /// The element-wise union of this vector and v.
+        template<typename VT, typename BinaryOpT>
+        expr::EWiseAdd<Vector, VT, BinaryOpT> add(VT const &v, BinaryOpT op) const
+        {
+            return expr::EWiseAdd<Vector, VT, BinaryOpT>(*this, v, op);
+        }
+
+        /// The element-wise intersection of this vector and v.
+        template<typename VT, typename BinaryOpT>
+        expr::EWiseMult<Vector, VT, BinaryOpT> emult(VT const &v, BinaryOpT op) const
+        {
+            return expr::EWiseMult<Vector, VT, BinaryOpT>(*this, v, op);
+        }
+
     private:
 
         // 4.3.2
@@ -465,6 +603,19 @@ namespace GraphBLAS
 
         //*********************************************************************
 
+        // The terms of fused expressions (fusion.hpp)
+        template <typename VectorT>
+        friend class fused::VectorTerm;
+
+        template <typename VectorT, typename TermT>
+        friend class fused::StoreTerm;
+
+        //*********************************************************************
+
+        friend struct expr::backend_access;
+
+        //*********************************************************************
+
         // .... ADD OTHER OPERATIONS AS FRIENDS AS THEY ARE IMPLEMENTED .....
 
     private:
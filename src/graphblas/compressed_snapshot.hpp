@@ -0,0 +1,504 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * @file compressed_snapshot.hpp
+ *
+ * @brief Compressed snapshots: the snapshot format (see snapshot.hpp)
+ *        with the indices delta encoded as variable-length integers.
+ *
+ * The rows of a matrix are stored in blocks of COMPRESSED_BLOCK_ROWS
+ * rows, each block being
+ *
+ * - the number of stored values of each row, as varints;
+ * - the column indices of each row: the first one, then the gap to each
+ *   next one less one, as varints;
+ * - the values of the block, as in a snapshot;
+ *
+ * followed by a directory of the blocks.  A varint holds seven bits in
+ * each byte, low bits first, with the high bit set on all but the last
+ * byte, so the gaps of a row with many stored values take one byte each.
+ * The blocks are independent: they are encoded and decoded in parallel,
+ * and CompressedMatrix decodes just the block of the rows asked for.  A
+ * vector is stored as a single row.
+ */
+
+#ifndef GB_COMPRESSED_SNAPSHOT_HPP
+#define GB_COMPRESSED_SNAPSHOT_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/Matrix.hpp>
+#include <graphblas/Vector.hpp>
+#include <graphblas/TaskPool.hpp>
+#include <graphblas/NonBlocking.hpp>
+#include <graphblas/expressions.hpp>
+#include <graphblas/matrix_interop.hpp>
+#include <graphblas/snapshot.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    /// The number of rows in a block of a compressed snapshot.
+    static IndexType const COMPRESSED_BLOCK_ROWS = 4096;
+
+    namespace detail
+    {
+        //********************************************************************
+        /// An entry of the directory at the end of a compressed snapshot.
+        struct CompressedBlockEntry
+        {
+            std::uint64_t pos;            ///< of the block in the file
+            std::uint64_t values_pos;     ///< of the block's values
+            std::uint64_t nvals;
+        };
+
+        inline void append_varint(std::vector<unsigned char> &out,
+                                  std::uint64_t               value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<unsigned char>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<unsigned char>(value));
+        }
+
+        /// Decode a varint at p (which is advanced past it); p must not
+        /// reach end.
+        inline std::uint64_t read_varint(unsigned char const *&p,
+                                         unsigned char const  *end)
+        {
+            if ((p != end) && (*p < 0x80))
+            {
+                return *p++;
+            }
+
+            std::uint64_t value(0);
+            for (unsigned int shift = 0; (p != end) && (shift < 64); shift += 7)
+            {
+                unsigned char byte(*p++);
+                value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+                if (byte < 0x80)
+                {
+                    return value;
+                }
+            }
+            throw IOException("compressed snapshot has a corrupt block");
+        }
+
+        /// The encoded indices and the values of a block of rows.
+        template <typename ValueT>
+        struct CompressedBlock
+        {
+            std::vector<unsigned char>  indices;
+            std::vector<ValueT>         values;
+        };
+
+        /// Encode rows [row_begin, row_end), given by get_row(row_index).
+        template <typename ValueT, typename GetRowT>
+        void encode_block(CompressedBlock<ValueT> &block,
+                          IndexType                row_begin,
+                          IndexType                row_end,
+                          GetRowT                  get_row)
+        {
+            block.indices.clear();
+            block.values.clear();
+            for (IndexType row_idx = row_begin; row_idx < row_end; ++row_idx)
+            {
+                append_varint(block.indices, get_row(row_idx).size());
+            }
+            for (IndexType row_idx = row_begin; row_idx < row_end; ++row_idx)
+            {
+                IndexType next(0);
+                for (auto const &elt : get_row(row_idx))
+                {
+                    append_varint(block.indices, std::get<0>(elt) - next);
+                    next = std::get<0>(elt) + 1;
+                    block.values.push_back(
+                        static_cast<ValueT>(std::get<1>(elt)));
+                }
+            }
+        }
+
+        /// Check that a block lies before the directory.
+        template <typename ValueT>
+        void check_block(CompressedBlockEntry const &entry,
+                         SnapshotHeader       const &header)
+        {
+            if ((entry.pos > entry.values_pos) ||
+                (entry.values_pos + entry.nvals*sizeof(ValueT) >
+                 header.offsets_pos))
+            {
+                throw IOException("compressed snapshot has a corrupt "
+                                  "directory");
+            }
+        }
+
+        /// Decode a block of nrows rows into rows[0, nrows), checking the
+        /// indices against ncols.
+        template <typename ScalarT, typename ValueT>
+        void decode_block(std::vector<std::tuple<IndexType, ScalarT> > *rows,
+                          IndexType             nrows,
+                          IndexType             ncols,
+                          unsigned char const  *p,
+                          unsigned char const  *end,
+                          ValueT        const  *values,
+                          IndexType             nvals)
+        {
+            std::vector<IndexType> row_nvals(nrows);
+            IndexType count(0);
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                row_nvals[row_idx] = read_varint(p, end);
+                count += row_nvals[row_idx];
+            }
+            if (count != nvals)
+            {
+                throw IOException("compressed snapshot has a corrupt block");
+            }
+
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                auto &row(rows[row_idx]);
+                row.clear();
+                row.reserve(row_nvals[row_idx]);
+                IndexType next(0);
+                for (IndexType idx = 0; idx < row_nvals[row_idx]; ++idx)
+                {
+                    IndexType col_idx(next + read_varint(p, end));
+                    if ((col_idx >= ncols) || (col_idx < next))
+                    {
+                        throw IOException("compressed snapshot has an index "
+                                          "out of range");
+                    }
+                    ValueT value;
+                    std::memcpy(&value, values++, sizeof(value));
+                    row.push_back(std::make_tuple(
+                        col_idx, static_cast<ScalarT>(value)));
+                    next = col_idx + 1;
+                }
+            }
+        }
+
+        /**
+         * @brief Write the rows [0, nrows) given by get_row(row_index) as
+         *        the blocks and directory of a compressed snapshot.  The
+         *        blocks are encoded in parallel, a batch at a time.
+         */
+        template <typename ScalarT, typename GetRowT>
+        void write_compressed(std::string const &path,
+                              std::uint32_t      kind,
+                              IndexType          nrows,
+                              IndexType          ncols,
+                              IndexType          nvals,
+                              IndexType          block_rows,
+                              GetRowT            get_row)
+        {
+            typedef typename snapshot_value<ScalarT>::type ValueType;
+
+            SnapshotHeader header(make_snapshot_header<ScalarT>(
+                kind, nrows, ncols, nvals));
+            header.block_rows = block_rows;
+            header.num_blocks = (nrows + block_rows - 1)/block_rows;
+
+            SnapshotWriter out(path);
+            std::vector<CompressedBlockEntry> directory;
+            IndexType const batch_size(
+                4*std::max<IndexType>(TaskPool::instance().num_threads(), 1));
+            std::vector<CompressedBlock<ValueType> > blocks(batch_size);
+
+            for (IndexType batch_begin = 0; batch_begin < header.num_blocks;
+                 batch_begin += batch_size)
+            {
+                IndexType batch_end(std::min<IndexType>(
+                    batch_begin + batch_size, header.num_blocks));
+                parallel_for(
+                    batch_begin, batch_end,
+                    [&](IndexType block_begin, IndexType block_end)
+                    {
+                        for (IndexType block = block_begin; block < block_end;
+                             ++block)
+                        {
+                            encode_block(
+                                blocks[block - batch_begin],
+                                block*block_rows,
+                                std::min(nrows, (block + 1)*block_rows),
+                                get_row);
+                        }
+                    });
+
+                for (IndexType block = batch_begin; block < batch_end; ++block)
+                {
+                    CompressedBlock<ValueType> const &encoded(
+                        blocks[block - batch_begin]);
+                    CompressedBlockEntry entry;
+                    entry.pos = out.position();
+                    out.write_array(encoded.indices.data(),
+                                    encoded.indices.size());
+                    out.align();
+                    entry.values_pos = out.position();
+                    entry.nvals = encoded.values.size();
+                    out.write_array(encoded.values.data(),
+                                    encoded.values.size());
+                    directory.push_back(entry);
+                }
+            }
+
+            out.align();
+            header.offsets_pos = out.position();
+            out.write_array(directory.data(), directory.size());
+            out.finish(header);
+        }
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief A read-only matrix decoded a block of rows at a time from a
+     *        mapped compressed snapshot (see save_compressed()).
+     */
+    template <typename ScalarT>
+    class CompressedMatrix
+    {
+    public:
+        typedef ScalarT ScalarType;
+        typedef typename detail::snapshot_value<ScalarT>::type ValueType;
+        typedef std::vector<std::tuple<IndexType, ScalarT> > RowType;
+
+        /**
+         * @brief Map the compressed snapshot of a matrix.
+         *
+         * @param[in] verify  Also check the checksum (which reads the whole
+         *                    file).
+         *
+         * @throw IOException  if the file is not a compressed snapshot of a
+         *                     matrix of ScalarT or is corrupt.
+         */
+        explicit CompressedMatrix(std::string const &path, bool verify = false)
+            : m_file(path),
+              m_header(detail::read_snapshot_header<ScalarT>(
+                           m_file, path, detail::SNAPSHOT_COMPRESSED_MATRIX,
+                           verify))
+        {
+            m_directory = reinterpret_cast<detail::CompressedBlockEntry const *>(
+                m_file.begin() + m_header.offsets_pos);
+        }
+
+        CompressedMatrix(CompressedMatrix const &) = delete;
+        CompressedMatrix &operator=(CompressedMatrix const &) = delete;
+
+        IndexType nrows() const     { return m_header.nrows; }
+        IndexType ncols() const     { return m_header.ncols; }
+        IndexType nvals() const     { return m_header.nvals; }
+        IndexType blockRows() const { return m_header.block_rows; }
+        IndexType numBlocks() const { return m_header.num_blocks; }
+
+        /**
+         * @brief Decode the rows of a block (rows [block*blockRows(),
+         *        (block + 1)*blockRows())) into rows, which is resized.
+         *
+         * @throw IOException  if the block is corrupt.
+         */
+        void decodeBlock(IndexType block, std::vector<RowType> &rows) const
+        {
+            IndexType row_begin(block*m_header.block_rows);
+            IndexType row_end(std::min<IndexType>(
+                m_header.nrows, row_begin + m_header.block_rows));
+            rows.resize(row_end - row_begin);
+            decode(block, rows.data());
+        }
+
+        /// Decode one row (and the rows before it in its block).
+        RowType getRow(IndexType row_index) const
+        {
+            if (row_index >= m_header.nrows)
+            {
+                throw IndexOutOfBoundsException(
+                    "CompressedMatrix::getRow: index out of bounds");
+            }
+            std::vector<RowType> rows;
+            decodeBlock(row_index/m_header.block_rows, rows);
+            return std::move(rows[row_index % m_header.block_rows]);
+        }
+
+        /// Decode the block into rows[0, rows in the block).
+        void decode(IndexType block, RowType *rows) const
+        {
+            detail::CompressedBlockEntry const &entry(m_directory[block]);
+            detail::check_block<ValueType>(entry, m_header);
+            IndexType row_begin(block*m_header.block_rows);
+            IndexType row_end(std::min<IndexType>(
+                m_header.nrows, row_begin + m_header.block_rows));
+            unsigned char const *base(
+                reinterpret_cast<unsigned char const *>(m_file.begin()));
+            detail::decode_block(
+                rows, row_end - row_begin, m_header.ncols,
+                base + entry.pos, base + entry.values_pos,
+                reinterpret_cast<ValueType const *>(base + entry.values_pos),
+                entry.nvals);
+        }
+
+    private:
+        detail::MappedFile                          m_file;
+        detail::SnapshotHeader                      m_header;
+        detail::CompressedBlockEntry const         *m_directory;
+    };
+
+    namespace detail
+    {
+        template <typename ScalarT, typename... TagsT>
+        Matrix<ScalarT, TagsT...> load_compressed_snapshot(
+            std::string const &path,
+            bool               verify,
+            Matrix<ScalarT, TagsT...> *)
+        {
+            CompressedMatrix<ScalarT> compressed(path, verify);
+            MatrixRows<ScalarT> rows(compressed.nrows());
+            parallel_for(
+                0, compressed.numBlocks(),
+                [&](IndexType block_begin, IndexType block_end)
+                {
+                    for (IndexType block = block_begin; block < block_end;
+                         ++block)
+                    {
+                        compressed.decode(
+                            block, rows.data() + block*compressed.blockRows());
+                    }
+                });
+
+            Matrix<ScalarT, TagsT...> A(compressed.nrows(), compressed.ncols());
+            import_rows(A, std::move(rows));
+            return A;
+        }
+
+        template <typename ScalarT, typename... TagsT>
+        Vector<ScalarT, TagsT...> load_compressed_snapshot(
+            std::string const &path,
+            bool               verify,
+            Vector<ScalarT, TagsT...> *)
+        {
+            typedef typename snapshot_value<ScalarT>::type ValueType;
+
+            MappedFile file(path);
+            SnapshotHeader header(read_snapshot_header<ScalarT>(
+                file, path, SNAPSHOT_COMPRESSED_VECTOR, verify));
+            CompressedBlockEntry const &entry(
+                *reinterpret_cast<CompressedBlockEntry const *>(
+                    file.begin() + header.offsets_pos));
+            check_block<ValueType>(entry, header);
+            unsigned char const *base(
+                reinterpret_cast<unsigned char const *>(file.begin()));
+
+            std::vector<std::tuple<IndexType, ScalarT> > contents;
+            decode_block(&contents, 1, header.ncols,
+                         base + entry.pos, base + entry.values_pos,
+                         reinterpret_cast<ValueType const *>(
+                             base + entry.values_pos),
+                         entry.nvals);
+
+            Vector<ScalarT, TagsT...> w(header.ncols);
+            expr::backend_access::vector(w).setContents(contents);
+            return w;
+        }
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief Write a compressed snapshot of a matrix, which
+     *        load_compressed() reads back and CompressedMatrix maps.
+     *
+     * @throw IOException  if the file cannot be written.
+     */
+    template <typename ScalarT, typename... TagsT>
+    void save_compressed(std::string               const &path,
+                         Matrix<ScalarT, TagsT...> const &A)
+    {
+        auto const &mat(expr::backend_access::matrix(A));
+        detail::sync_read(mat);
+
+        detail::write_compressed<ScalarT>(
+            path, detail::SNAPSHOT_COMPRESSED_MATRIX,
+            mat.nrows(), mat.ncols(), mat.nvals(), COMPRESSED_BLOCK_ROWS,
+            [&mat](IndexType row_index) -> decltype(mat.getRow(row_index))
+            { return mat.getRow(row_index); });
+    }
+
+    /**
+     * @brief Write a compressed snapshot of a vector, which
+     *        load_compressed() reads back.
+     *
+     * @throw IOException  if the file cannot be written.
+     */
+    template <typename ScalarT, typename... TagsT>
+    void save_compressed(std::string               const &path,
+                         Vector<ScalarT, TagsT...> const &u)
+    {
+        auto const &vec(expr::backend_access::vector(u));
+        detail::sync_read(vec);
+
+        std::vector<std::tuple<IndexType, ScalarT> > contents(
+            vec.getContents());
+        detail::write_compressed<ScalarT>(
+            path, detail::SNAPSHOT_COMPRESSED_VECTOR,
+            1, vec.size(), contents.size(), 1,
+            [&contents](IndexType) -> decltype(contents) const &
+            { return contents; });
+    }
+
+    /**
+     * @brief Read a matrix or vector from a compressed snapshot written by
+     *        save_compressed().  The blocks are decoded in parallel.
+     *
+     * @tparam ContainerT  The Matrix or Vector type to read; its scalar
+     *                     type must be the one the snapshot was saved with.
+     * @param[in] verify   Check the checksum, which costs another pass over
+     *                     the file.
+     *
+     * @throw IOException  if the file cannot be read, is not a compressed
+     *                     snapshot of a ContainerT or is corrupt.
+     */
+    template <typename ContainerT>
+    ContainerT load_compressed(std::string const &path, bool verify = true)
+    {
+        return detail::load_compressed_snapshot(
+            path, verify, static_cast<ContainerT *>(nullptr));
+    }
+} // GraphBLAS
+
+#endif // GB_COMPRESSED_SNAPSHOT_HPP
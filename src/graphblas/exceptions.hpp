@@ -180,6 +180,28 @@ namespace GraphBLAS
 
         std::string m_message;
     };
+
+    //************************************************************************
+    // Errors of reading and writing files (matrix_io.hpp)
+    //************************************************************************
+
+    //************************************************************************
+    class IOException : public std::exception
+    {
+    public:
+        IOException(std::string const &msg)
+            : m_message(msg) {}
+
+        IOException() {}
+
+    private:
+        const char* what() const throw()
+        {
+            return ("IOException: " + m_message).c_str();
+        }
+
+        std::string m_message;
+    };
 }
 
 #endif // GB_EXCEPTIONS_HPP
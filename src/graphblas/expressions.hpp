@@ -0,0 +1,405 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * @file expressions.hpp
+ *
+ * @brief Masked GraphBLAS statements written as expressions.
+ *
+ * An output with its mask is written C(Mask, replace_flag) and assigned an
+ * expression, with = (no accumulator) or += (accumulate with Plus):
+ *
+ *     C(M, true) = A.mul(transpose(B), ArithmeticSemiring<T>());
+ *     w(complement(v)) += u.mul(A, MinPlusSemiring<T>());
+ *     C(NoMask()) = A.add(B, Plus<T>());
+ *
+ * The expression only records its operands; the statement is lowered to
+ * the operation it names (mxm, vxm or mxv depending on which operands are
+ * vectors, eWiseAdd or eWiseMult) when it is assigned, so it costs the
+ * same as the call.
+ *
+ * A reduction of a masked product, reduce(sum, accum, monoid,
+ * A.mul(B, op).masked(M)) (or the matrix to vector reduce), is lowered to
+ * a kernel that reduces the dot products as they are computed and never
+ * stores the product.  The product is not converted to the output type
+ * before it is reduced.  B's columns are used one at a time, so B is best
+ * a transpose.
+ */
+
+#ifndef GB_EXPRESSIONS_HPP
+#define GB_EXPRESSIONS_HPP
+
+#pragma once
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+#include <graphblas/Matrix.hpp>
+#include <graphblas/Vector.hpp>
+#include <graphblas/TransposeView.hpp>
+#include <graphblas/ComplementView.hpp>
+#include <graphblas/operations.hpp>
+#include <graphblas/NonBlocking.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace expr
+    {
+        //********************************************************************
+        /// Access to the backend objects of the frontend containers and
+        /// views (the fused reductions below call the backend directly).
+        struct backend_access
+        {
+            template <typename MatrixT>
+            static typename MatrixT::BackendType const &
+            matrix(MatrixT const &A) { return A.m_mat; }
+
+            template <typename MatrixT>
+            static typename MatrixT::BackendType &
+            matrix(MatrixT &C) { return C.m_mat; }
+
+            template <typename VectorT>
+            static typename VectorT::BackendType const &
+            vector(VectorT const &u) { return u.m_vec; }
+
+            template <typename VectorT>
+            static typename VectorT::BackendType &
+            vector(VectorT &w) { return w.m_vec; }
+        };
+
+        //********************************************************************
+        /// How an expression holds an operand: containers by reference and
+        /// views (which only refer to a container) by value, so that
+        /// transpose(A) can be used in an expression.
+        template <typename T>
+        struct operand
+        {
+            typedef T const &type;
+        };
+
+        template <typename MatrixT>
+        struct operand<TransposeView<MatrixT> >
+        {
+            typedef TransposeView<MatrixT> type;
+        };
+
+        template <typename MatrixT>
+        struct operand<MatrixComplementView<MatrixT> >
+        {
+            typedef MatrixComplementView<MatrixT> type;
+        };
+
+        template <typename VectorT>
+        struct operand<VectorComplementView<VectorT> >
+        {
+            typedef VectorComplementView<VectorT> type;
+        };
+
+        //********************************************************************
+        // The multiplication named by the tags of the operands.
+        template <typename OutT, typename MaskT, typename AccumT,
+                  typename SemiringT, typename AT, typename BT>
+        inline void multiply(OutT &out, MaskT const &mask, AccumT accum,
+                             SemiringT op, AT const &A, BT const &B,
+                             bool replace_flag, matrix_tag, matrix_tag)
+        {
+            GraphBLAS::mxm(out, mask, accum, op, A, B, replace_flag);
+        }
+
+        template <typename OutT, typename MaskT, typename AccumT,
+                  typename SemiringT, typename AT, typename BT>
+        inline void multiply(OutT &out, MaskT const &mask, AccumT accum,
+                             SemiringT op, AT const &u, BT const &A,
+                             bool replace_flag, vector_tag, matrix_tag)
+        {
+            GraphBLAS::vxm(out, mask, accum, op, u, A, replace_flag);
+        }
+
+        template <typename OutT, typename MaskT, typename AccumT,
+                  typename SemiringT, typename AT, typename BT>
+        inline void multiply(OutT &out, MaskT const &mask, AccumT accum,
+                             SemiringT op, AT const &A, BT const &u,
+                             bool replace_flag, matrix_tag, vector_tag)
+        {
+            GraphBLAS::mxv(out, mask, accum, op, A, u, replace_flag);
+        }
+
+        //********************************************************************
+        /// The reduction of the product of A and B masked by M (see
+        /// Product::masked).
+        template <typename AT, typename BT, typename SemiringT, typename MaskT>
+        class MaskedProduct
+        {
+        public:
+            MaskedProduct(AT const &A, BT const &B, SemiringT op,
+                          MaskT const &M)
+                : m_A(A), m_B(B), m_op(op), m_M(M)
+            {
+            }
+
+            AT        const &A()  const { return m_A; }
+            BT        const &B()  const { return m_B; }
+            SemiringT        op() const { return m_op; }
+            MaskT     const &M()  const { return m_M; }
+
+        private:
+            typename operand<AT>::type    m_A;
+            typename operand<BT>::type    m_B;
+            SemiringT                     m_op;
+            typename operand<MaskT>::type m_M;
+        };
+
+        //********************************************************************
+        /// A.mul(B, op): the product of A and B over the semiring op.
+        template <typename AT, typename BT, typename SemiringT>
+        class Product
+        {
+        public:
+            Product(AT const &A, BT const &B, SemiringT op)
+                : m_A(A), m_B(B), m_op(op)
+            {
+            }
+
+            template <typename OutT, typename MaskT, typename AccumT>
+            void lower(OutT        &out,
+                       MaskT const &mask,
+                       AccumT       accum,
+                       bool         replace_flag) const
+            {
+                multiply(out, mask, accum, m_op, m_A, m_B, replace_flag,
+                         typename AT::tag_type(), typename BT::tag_type());
+            }
+
+            /// The product masked by M, to be reduced.
+            template <typename MaskT>
+            MaskedProduct<AT, BT, SemiringT, MaskT> masked(MaskT const &M) const
+            {
+                return MaskedProduct<AT, BT, SemiringT, MaskT>(m_A, m_B,
+                                                               m_op, M);
+            }
+
+        private:
+            typename operand<AT>::type m_A;
+            typename operand<BT>::type m_B;
+            SemiringT                  m_op;
+        };
+
+        //********************************************************************
+        /// A.add(B, op): the element-wise union of A and B.
+        template <typename AT, typename BT, typename BinaryOpT>
+        class EWiseAdd
+        {
+        public:
+            EWiseAdd(AT const &A, BT const &B, BinaryOpT op)
+                : m_A(A), m_B(B), m_op(op)
+            {
+            }
+
+            template <typename OutT, typename MaskT, typename AccumT>
+            void lower(OutT        &out,
+                       MaskT const &mask,
+                       AccumT       accum,
+                       bool         replace_flag) const
+            {
+                GraphBLAS::eWiseAdd(out, mask, accum, m_op, m_A, m_B,
+                                    replace_flag);
+            }
+
+        private:
+            typename operand<AT>::type m_A;
+            typename operand<BT>::type m_B;
+            BinaryOpT                  m_op;
+        };
+
+        //********************************************************************
+        /// A.emult(B, op): the element-wise intersection of A and B.
+        template <typename AT, typename BT, typename BinaryOpT>
+        class EWiseMult
+        {
+        public:
+            EWiseMult(AT const &A, BT const &B, BinaryOpT op)
+                : m_A(A), m_B(B), m_op(op)
+            {
+            }
+
+            template <typename OutT, typename MaskT, typename AccumT>
+            void lower(OutT        &out,
+                       MaskT const &mask,
+                       AccumT       accum,
+                       bool         replace_flag) const
+            {
+                GraphBLAS::eWiseMult(out, mask, accum, m_op, m_A, m_B,
+                                     replace_flag);
+            }
+
+        private:
+            typename operand<AT>::type m_A;
+            typename operand<BT>::type m_B;
+            BinaryOpT                  m_op;
+        };
+
+        //********************************************************************
+        /// C(Mask, replace_flag): the output of a statement.
+        template <typename OutT, typename MaskT>
+        class Target
+        {
+        public:
+            typedef typename OutT::ScalarType ScalarType;
+
+            Target(OutT &out, MaskT const &mask, bool replace_flag)
+                : m_out(out), m_mask(mask), m_replace_flag(replace_flag)
+            {
+            }
+
+            /// out<mask> = expr
+            template <typename ExprT>
+            Target &operator=(ExprT const &expr)
+            {
+                expr.lower(m_out, m_mask, NoAccumulate(), m_replace_flag);
+                return *this;
+            }
+
+            /// out<mask> = out + expr
+            template <typename ExprT>
+            Target &operator+=(ExprT const &expr)
+            {
+                expr.lower(m_out, m_mask, Plus<ScalarType>(), m_replace_flag);
+                return *this;
+            }
+
+        private:
+            OutT                            &m_out;
+            typename operand<MaskT>::type    m_mask;
+            bool                             m_replace_flag;
+        };
+    } // expr
+
+    //************************************************************************
+    // Reductions of masked products
+    //************************************************************************
+
+    namespace detail
+    {
+        struct backend_reduce_masked_mxm
+        {
+            template <typename... ArgsT>
+            void operator()(ArgsT &&... args) const
+            {
+                backend::reduce_masked_mxm(std::forward<ArgsT>(args)...);
+            }
+        };
+
+        struct backend_reduce_masked_mxm_to_scalar
+        {
+            template <typename... ArgsT>
+            void operator()(ArgsT &&... args) const
+            {
+                backend::reduce_masked_mxm_to_scalar(
+                    std::forward<ArgsT>(args)...);
+            }
+        };
+    }
+
+    /// reduce (matrix to vector) of (A*B)<M>, without the product matrix.
+    template<typename WVectorT,
+             typename MaskT,
+             typename AccumT,
+             typename MonoidT,
+             typename AMatrixT,
+             typename BMatrixT,
+             typename SemiringT,
+             typename MMatrixT>
+    inline void reduce(
+        WVectorT                                                     &w,
+        MaskT                                                  const &mask,
+        AccumT                                                        accum,
+        MonoidT                                                       op,
+        expr::MaskedProduct<AMatrixT, BMatrixT, SemiringT, MMatrixT> const &AB,
+        bool                                                   replace_flag = false)
+    {
+        GRB_LOG_FN_BEGIN("reduce - masked product to vector");
+
+        check_size_size(w, mask, "reduce(masked mxm): w.size != mask.size");
+        check_size_nrows(w, AB.A(), "reduce(masked mxm): w.size != A.nrows");
+        check_ncols_nrows(AB.A(), AB.B(),
+                          "reduce(masked mxm): A.ncols != B.nrows");
+        check_nrows_nrows(AB.A(), AB.M(),
+                          "reduce(masked mxm): A.nrows != M.nrows");
+        check_ncols_ncols(AB.B(), AB.M(),
+                          "reduce(masked mxm): B.ncols != M.ncols");
+
+        detail::dispatch(detail::backend_reduce_masked_mxm(),
+                         expr::backend_access::vector(w),
+                         expr::backend_access::vector(mask),
+                         accum, op,
+                         expr::backend_access::matrix(AB.M()),
+                         AB.op(),
+                         expr::backend_access::matrix(AB.A()),
+                         expr::backend_access::matrix(AB.B()),
+                         replace_flag);
+
+        GRB_LOG_FN_END("reduce - masked product to vector");
+    }
+
+    /// reduce (matrix to scalar) of (A*B)<M>, without the product matrix.
+    template<typename ValueT,
+             typename AccumT,
+             typename MonoidT,
+             typename AMatrixT,
+             typename BMatrixT,
+             typename SemiringT,
+             typename MMatrixT>
+    inline void reduce(
+        ValueT                                                       &val,
+        AccumT                                                        accum,
+        MonoidT                                                       op,
+        expr::MaskedProduct<AMatrixT, BMatrixT, SemiringT, MMatrixT> const &AB)
+    {
+        GRB_LOG_FN_BEGIN("reduce - masked product to scalar");
+
+        check_ncols_nrows(AB.A(), AB.B(),
+                          "reduce(masked mxm): A.ncols != B.nrows");
+        check_nrows_nrows(AB.A(), AB.M(),
+                          "reduce(masked mxm): A.nrows != M.nrows");
+        check_ncols_ncols(AB.B(), AB.M(),
+                          "reduce(masked mxm): B.ncols != M.ncols");
+
+        detail::dispatch_blocking(detail::backend_reduce_masked_mxm_to_scalar(),
+                                  val, accum, op,
+                                  expr::backend_access::matrix(AB.M()),
+                                  AB.op(),
+                                  expr::backend_access::matrix(AB.A()),
+                                  expr::backend_access::matrix(AB.B()));
+
+        GRB_LOG_FN_END("reduce - masked product to scalar");
+    }
+} // GraphBLAS
+
+#endif // GB_EXPRESSIONS_HPP
@@ -0,0 +1,552 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * @file fusion.hpp
+ *
+ * @brief Fused chains of element-wise vector operations.
+ *
+ * A chain of apply, eWiseAdd and eWiseMult calls on vectors is written as
+ * one expression and evaluated in a single pass over its input vectors,
+ * without the intermediate vectors:
+ *
+ *     // sum((u - f(v))^2), keeping f(v) in v
+ *     fused::reduce(err, NoAccumulate(), PlusMonoid<double>(),
+ *                   fused::apply(square,
+ *                                fused::eWiseAdd(Minus<double>(), u,
+ *                                    fused::store(v, fused::apply(f, v)))));
+ *
+ * The terms of an expression walk the stored elements of their operands
+ * in index order: apply transforms each element, eWiseAdd merges the
+ * union and eWiseMult the intersection of its operands' elements, as the
+ * operations do.  store() writes the elements of a term to a vector (the
+ * vector is replaced, like the output of an operation with no mask or
+ * accumulator) and passes them on.  Stores happen after the pass, so a
+ * vector may be both read and stored by the same expression.  A vector
+ * read twice by an expression is walked twice.
+ */
+
+#ifndef GB_FUSION_HPP
+#define GB_FUSION_HPP
+
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/Vector.hpp>
+#include <graphblas/NonBlocking.hpp>
+#include <graphblas/ReductionMode.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace fused
+    {
+        //********************************************************************
+        // Every term has the same interface:
+        //
+        //   ScalarType             the type of its elements
+        //   size()                 the size of the vector it produces
+        //   start()                position on the first element
+        //   done(), index(), value(), next()
+        //                          walk the elements in index order
+        //   drain()                walk whatever its parent did not
+        //   commit()               write the stored vectors
+        //********************************************************************
+
+        //********************************************************************
+        /// The stored elements of a vector.
+        template <typename VectorT>
+        class VectorTerm
+        {
+        public:
+            typedef typename VectorT::ScalarType ScalarType;
+
+            explicit VectorTerm(VectorT const &u)
+                : m_vec(u.m_vec),
+                  m_it(m_vec.end()),
+                  m_end(m_vec.end())
+            {
+            }
+
+            IndexType size() const { return m_vec.size(); }
+
+            void start()
+            {
+                detail::sync_read(m_vec);
+                m_it = m_vec.begin();
+                m_end = m_vec.end();
+                load();
+            }
+
+            bool       done() const  { return m_it == m_end; }
+            IndexType  index() const { return m_index; }
+            ScalarType value() const { return m_value; }
+
+            void next()
+            {
+                ++m_it;
+                load();
+            }
+
+            void drain()  {}
+            void commit() {}
+
+        private:
+            typedef typename VectorT::BackendType BackendType;
+
+            void load()
+            {
+                if (m_it != m_end)
+                {
+                    std::tie(m_index, m_value) = *m_it;
+                }
+            }
+
+            BackendType const                    &m_vec;
+            typename BackendType::const_iterator  m_it;
+            typename BackendType::const_iterator  m_end;
+            IndexType                             m_index;
+            ScalarType                            m_value;
+        };
+
+        //********************************************************************
+        /// op(x) for each element x of a term.
+        template <typename UnaryOpT, typename TermT>
+        class ApplyTerm
+        {
+        public:
+            typedef typename UnaryOpT::result_type ScalarType;
+
+            ApplyTerm(UnaryOpT op, TermT const &term)
+                : m_op(op),
+                  m_term(term)
+            {
+            }
+
+            IndexType size() const { return m_term.size(); }
+
+            void       start()       { m_term.start(); }
+            bool       done() const  { return m_term.done(); }
+            IndexType  index() const { return m_term.index(); }
+            ScalarType value() const
+            {
+                return static_cast<ScalarType>(m_op(m_term.value()));
+            }
+            void       next()        { m_term.next(); }
+
+            void drain()  { m_term.drain(); }
+            void commit() { m_term.commit(); }
+
+        private:
+            // The operators' call operators are not const
+            mutable UnaryOpT m_op;
+            TermT            m_term;
+        };
+
+        //********************************************************************
+        /// The union of the elements of two terms: op(x, y) where both have
+        /// an element, and the element of the one that has it elsewhere.
+        template <typename BinaryOpT, typename LhsTermT, typename RhsTermT>
+        class UnionTerm
+        {
+        public:
+            typedef typename BinaryOpT::result_type ScalarType;
+
+            UnionTerm(BinaryOpT       op,
+                      LhsTermT const &lhs,
+                      RhsTermT const &rhs)
+                : m_op(op),
+                  m_lhs(lhs),
+                  m_rhs(rhs)
+            {
+                if (m_lhs.size() != m_rhs.size())
+                {
+                    throw DimensionException("fused::eWiseAdd: size != size");
+                }
+            }
+
+            IndexType size() const { return m_lhs.size(); }
+
+            void start()
+            {
+                m_lhs.start();
+                m_rhs.start();
+            }
+
+            bool done() const { return m_lhs.done() && m_rhs.done(); }
+
+            IndexType index() const
+            {
+                if (m_rhs.done() ||
+                    (!m_lhs.done() && (m_lhs.index() < m_rhs.index())))
+                {
+                    return m_lhs.index();
+                }
+                return m_rhs.index();
+            }
+
+            ScalarType value() const
+            {
+                IndexType idx(index());
+                bool in_lhs(!m_lhs.done() && (m_lhs.index() == idx));
+                bool in_rhs(!m_rhs.done() && (m_rhs.index() == idx));
+
+                if (in_lhs && in_rhs)
+                {
+                    return static_cast<ScalarType>(
+                        m_op(m_lhs.value(), m_rhs.value()));
+                }
+                return in_lhs ? static_cast<ScalarType>(m_lhs.value())
+                              : static_cast<ScalarType>(m_rhs.value());
+            }
+
+            void next()
+            {
+                IndexType idx(index());
+                if (!m_lhs.done() && (m_lhs.index() == idx))
+                {
+                    m_lhs.next();
+                }
+                if (!m_rhs.done() && (m_rhs.index() == idx))
+                {
+                    m_rhs.next();
+                }
+            }
+
+            void drain()
+            {
+                m_lhs.drain();
+                m_rhs.drain();
+            }
+
+            void commit()
+            {
+                m_lhs.commit();
+                m_rhs.commit();
+            }
+
+        private:
+            mutable BinaryOpT m_op;
+            LhsTermT          m_lhs;
+            RhsTermT          m_rhs;
+        };
+
+        //********************************************************************
+        /// The intersection of the elements of two terms: op(x, y) where
+        /// both have an element.
+        template <typename BinaryOpT, typename LhsTermT, typename RhsTermT>
+        class IntersectionTerm
+        {
+        public:
+            typedef typename BinaryOpT::result_type ScalarType;
+
+            IntersectionTerm(BinaryOpT       op,
+                             LhsTermT const &lhs,
+                             RhsTermT const &rhs)
+                : m_op(op),
+                  m_lhs(lhs),
+                  m_rhs(rhs)
+            {
+                if (m_lhs.size() != m_rhs.size())
+                {
+                    throw DimensionException("fused::eWiseMult: size != size");
+                }
+            }
+
+            IndexType size() const { return m_lhs.size(); }
+
+            void start()
+            {
+                m_lhs.start();
+                m_rhs.start();
+                align();
+            }
+
+            bool done() const { return m_lhs.done() || m_rhs.done(); }
+
+            IndexType index() const { return m_lhs.index(); }
+
+            ScalarType value() const
+            {
+                return static_cast<ScalarType>(
+                    m_op(m_lhs.value(), m_rhs.value()));
+            }
+
+            void next()
+            {
+                m_lhs.next();
+                m_rhs.next();
+                align();
+            }
+
+            void drain()
+            {
+                m_lhs.drain();
+                m_rhs.drain();
+            }
+
+            void commit()
+            {
+                m_lhs.commit();
+                m_rhs.commit();
+            }
+
+        private:
+            /// Skip to the next index that both terms have.
+            void align()
+            {
+                while (!done() && (m_lhs.index() != m_rhs.index()))
+                {
+                    if (m_lhs.index() < m_rhs.index())
+                        m_lhs.next();
+                    else
+                        m_rhs.next();
+                }
+            }
+
+            mutable BinaryOpT m_op;
+            LhsTermT          m_lhs;
+            RhsTermT          m_rhs;
+        };
+
+        //********************************************************************
+        /// The elements of a term, which are also written to a vector.
+        template <typename VectorT, typename TermT>
+        class StoreTerm
+        {
+        public:
+            typedef typename VectorT::ScalarType ScalarType;
+
+            StoreTerm(VectorT &w, TermT const &term)
+                : m_vec(w.m_vec),
+                  m_term(term)
+            {
+                if (m_vec.size() != m_term.size())
+                {
+                    throw DimensionException("fused::store: size != size");
+                }
+            }
+
+            IndexType size() const { return m_term.size(); }
+
+            void start()
+            {
+                detail::sync_write(m_vec);
+                m_contents.clear();
+                m_term.start();
+                load();
+            }
+
+            bool       done() const  { return m_term.done(); }
+            IndexType  index() const { return m_term.index(); }
+            ScalarType value() const { return m_value; }
+
+            void next()
+            {
+                m_contents.push_back(std::make_tuple(m_term.index(), m_value));
+                m_term.next();
+                load();
+            }
+
+            void drain()
+            {
+                while (!done())
+                {
+                    next();
+                }
+                m_term.drain();
+            }
+
+            void commit()
+            {
+                m_term.commit();
+                m_vec.setContents(m_contents);
+                m_contents.clear();
+            }
+
+        private:
+            typedef typename VectorT::BackendType BackendType;
+
+            void load()
+            {
+                if (!m_term.done())
+                {
+                    m_value = static_cast<ScalarType>(m_term.value());
+                }
+            }
+
+            BackendType                                      &m_vec;
+            TermT                                             m_term;
+            ScalarType                                        m_value;
+            std::vector<std::tuple<IndexType, ScalarType> >   m_contents;
+        };
+
+        //********************************************************************
+        // The term of an operand: a vector or another term.
+
+        template <typename OperandT>
+        struct term_of
+        {
+            typedef OperandT type;
+            static OperandT const &make(OperandT const &term) { return term; }
+        };
+
+        template <typename ScalarT, typename... TagsT>
+        struct term_of<Vector<ScalarT, TagsT...> >
+        {
+            typedef VectorTerm<Vector<ScalarT, TagsT...> > type;
+            static type make(Vector<ScalarT, TagsT...> const &u)
+            {
+                return type(u);
+            }
+        };
+
+        //********************************************************************
+        /// op(x) for each element of u (a vector or a term).
+        template <typename UnaryOpT, typename OperandT>
+        inline ApplyTerm<UnaryOpT, typename term_of<OperandT>::type>
+        apply(UnaryOpT op, OperandT const &u)
+        {
+            return ApplyTerm<UnaryOpT, typename term_of<OperandT>::type>(
+                op, term_of<OperandT>::make(u));
+        }
+
+        /// The element-wise union of u and v, combined with op.
+        template <typename BinaryOpT, typename UOperandT, typename VOperandT>
+        inline UnionTerm<BinaryOpT,
+                         typename term_of<UOperandT>::type,
+                         typename term_of<VOperandT>::type>
+        eWiseAdd(BinaryOpT op, UOperandT const &u, VOperandT const &v)
+        {
+            return UnionTerm<BinaryOpT,
+                             typename term_of<UOperandT>::type,
+                             typename term_of<VOperandT>::type>(
+                op, term_of<UOperandT>::make(u), term_of<VOperandT>::make(v));
+        }
+
+        /// The element-wise intersection of u and v, combined with op.
+        template <typename BinaryOpT, typename UOperandT, typename VOperandT>
+        inline IntersectionTerm<BinaryOpT,
+                                typename term_of<UOperandT>::type,
+                                typename term_of<VOperandT>::type>
+        eWiseMult(BinaryOpT op, UOperandT const &u, VOperandT const &v)
+        {
+            return IntersectionTerm<BinaryOpT,
+                                    typename term_of<UOperandT>::type,
+                                    typename term_of<VOperandT>::type>(
+                op, term_of<UOperandT>::make(u), term_of<VOperandT>::make(v));
+        }
+
+        /// The elements of u, which are also stored in w.
+        template <typename WScalarT, typename OperandT, typename... WTagsT>
+        inline StoreTerm<Vector<WScalarT, WTagsT...>,
+                         typename term_of<OperandT>::type>
+        store(Vector<WScalarT, WTagsT...> &w, OperandT const &u)
+        {
+            return StoreTerm<Vector<WScalarT, WTagsT...>,
+                             typename term_of<OperandT>::type>(
+                w, term_of<OperandT>::make(u));
+        }
+
+        //********************************************************************
+        /// w = u, in one pass over the vectors that u reads.
+        template <typename WScalarT, typename OperandT, typename... WTagsT>
+        inline void assign(Vector<WScalarT, WTagsT...> &w, OperandT const &u)
+        {
+            auto term(store(w, u));
+            term.start();
+            term.drain();
+            term.commit();
+        }
+
+        template <typename ValueT, typename AccumT, typename TScalarT>
+        inline void accumulate_scalar(ValueT &val, AccumT accum, TScalarT t)
+        {
+            val = static_cast<ValueT>(accum(val, t));
+        }
+
+        template <typename ValueT, typename TScalarT>
+        inline void accumulate_scalar(ValueT &val, NoAccumulate, TScalarT t)
+        {
+            val = static_cast<ValueT>(t);
+        }
+
+        /**
+         * @brief val = [val accum] reduction of the elements of u with
+         *        the monoid, in one pass over the vectors that u reads.
+         */
+        template <typename ValueT,
+                  typename AccumT,
+                  typename MonoidT,
+                  typename OperandT>
+        inline void reduce(ValueT         &val,
+                           AccumT          accum,
+                           MonoidT         op,
+                           OperandT const &u)
+        {
+            typedef typename MonoidT::result_type D3ScalarType;
+            typename term_of<OperandT>::type term(term_of<OperandT>::make(u));
+
+            D3ScalarType t(op.identity());
+            ReductionMode const mode(reduction_mode());
+            TreeReduction<D3ScalarType, MonoidT> tree(
+                op, mode == ReductionMode::COMPENSATED);
+            term.start();
+            while (!term.done())
+            {
+                if (mode == ReductionMode::FAST)
+                {
+                    t = op(t, term.value());
+                }
+                else
+                {
+                    tree.add(term.value());
+                }
+                term.next();
+            }
+            term.drain();
+            term.commit();
+
+            if (!tree.empty())
+            {
+                t = tree.result();
+            }
+
+            accumulate_scalar(val, accum, t);
+        }
+    } // fused
+} // GraphBLAS
+
+#endif // GB_FUSION_HPP
@@ -0,0 +1,566 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * @file generators.hpp
+ *
+ * @brief Synthetic graphs for tests and benchmarks: R-MAT and Graph500
+ *        Kronecker graphs, Erdos-Renyi graphs, 2D and 3D grids and
+ *        power-law graphs.
+ *
+ * The random numbers of an edge depend only on the seed and the number of
+ * the edge, so a generator returns the same matrix for a given seed
+ * whatever the number of threads.  The edges are generated in tasks of
+ * GENERATOR_EDGES_PER_TASK edges, in parallel on the TaskPool, and are
+ * then passed to one build() of the matrix (duplicate edges are merged
+ * and keep the weight of the last one).
+ */
+
+#ifndef GB_GENERATORS_HPP
+#define GB_GENERATORS_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/TaskPool.hpp>
+#include <graphblas/matrix_io.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    /// The number of edges generated by one task.
+    static IndexType const GENERATOR_EDGES_PER_TASK = 1 << 16;
+
+    //************************************************************************
+    /// The options shared by the generators.
+    struct GeneratorOptions
+    {
+        GeneratorOptions()
+            : seed(1),
+              symmetric(false),
+              self_loops(false),
+              weighted(false),
+              min_weight(1),
+              max_weight(1)
+        {
+        }
+
+        /// The same seed (and arguments) gives the same matrix.
+        std::uint64_t seed;
+
+        /// Store every edge in both directions (an undirected graph).
+        bool symmetric;
+
+        /// Keep the edges from a vertex to itself.
+        bool self_loops;
+
+        /// Store weights drawn uniformly from [min_weight, max_weight]
+        /// (integers for an integral scalar type) instead of 1.
+        bool weighted;
+        double min_weight;
+        double max_weight;
+    };
+
+    namespace detail
+    {
+        //********************************************************************
+        inline std::uint64_t generator_mix(std::uint64_t x)
+        {
+            x += 0x9e3779b97f4a7c15ULL;
+            x = (x ^ (x >> 30))*0xbf58476d1ce4e5b9ULL;
+            x = (x ^ (x >> 27))*0x94d049bb133111ebULL;
+            return x ^ (x >> 31);
+        }
+
+        //********************************************************************
+        /**
+         * The random numbers of one edge: a splitmix64 sequence started
+         * from the seed and the number of the edge.
+         */
+        class EdgeRandom
+        {
+        public:
+            EdgeRandom(std::uint64_t seed, IndexType edge)
+                : m_state(generator_mix(seed ^ generator_mix(edge)))
+            {
+            }
+
+            std::uint64_t next()
+            {
+                m_state += 0x9e3779b97f4a7c15ULL;
+                return generator_mix(m_state);
+            }
+
+            /// A double in [0, 1).
+            double uniform()
+            {
+                return static_cast<double>(next() >> 11)*(1.0/9007199254740992.0);
+            }
+
+            /// An integer in [0, n).
+            IndexType below(IndexType n)
+            {
+                return static_cast<IndexType>(uniform()*static_cast<double>(n))
+                    % n;
+            }
+
+        private:
+            std::uint64_t m_state;
+        };
+
+        //********************************************************************
+        template <typename ScalarT>
+        ScalarT edge_weight(EdgeRandom              &rng,
+                            GeneratorOptions const  &options,
+                            std::true_type)          // integral
+        {
+            long long min_weight(std::llround(options.min_weight));
+            long long max_weight(std::llround(options.max_weight));
+            return static_cast<ScalarT>(
+                min_weight + static_cast<long long>(
+                    rng.below(static_cast<IndexType>(max_weight - min_weight) + 1)));
+        }
+
+        template <typename ScalarT>
+        ScalarT edge_weight(EdgeRandom              &rng,
+                            GeneratorOptions const  &options,
+                            std::false_type)
+        {
+            return static_cast<ScalarT>(
+                options.min_weight +
+                rng.uniform()*(options.max_weight - options.min_weight));
+        }
+
+        template <typename ScalarT>
+        ScalarT edge_weight(EdgeRandom &rng, GeneratorOptions const &options)
+        {
+            if (!options.weighted || std::is_same<ScalarT, bool>::value)
+            {
+                return static_cast<ScalarT>(1);
+            }
+            return edge_weight<ScalarT>(
+                rng, options,
+                std::integral_constant<bool,
+                                       std::is_integral<ScalarT>::value>());
+        }
+
+        //********************************************************************
+        inline void check_generator_options(GeneratorOptions const &options,
+                                            std::string const      &name)
+        {
+            if (options.weighted && !(options.min_weight <= options.max_weight))
+            {
+                throw InvalidValueException(
+                    name + ": min_weight is greater than max_weight");
+            }
+        }
+
+        //********************************************************************
+        /**
+         * Build a num_vertices x num_vertices matrix from num_edges calls
+         * of edge_fn(edge, rng, src, dst), which sets the ends of an edge
+         * and returns false to leave the edge out.
+         */
+        template <typename MatrixT, typename EdgeFnT>
+        MatrixT generate_edges(IndexType                num_vertices,
+                               IndexType                num_edges,
+                               GeneratorOptions const  &options,
+                               EdgeFnT                  edge_fn)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            IndexType num_tasks((num_edges + GENERATOR_EDGES_PER_TASK - 1)/
+                                GENERATOR_EDGES_PER_TASK);
+            std::vector<TupleChunk<ScalarType> > chunks(num_tasks);
+            parallel_for(
+                0, num_tasks,
+                [&](IndexType task_begin, IndexType task_end)
+                {
+                    for (IndexType task = task_begin; task < task_end; ++task)
+                    {
+                        TupleChunk<ScalarType> &chunk(chunks[task]);
+                        IndexType edge_begin(task*GENERATOR_EDGES_PER_TASK);
+                        IndexType edge_end(
+                            std::min(edge_begin + GENERATOR_EDGES_PER_TASK,
+                                     num_edges));
+                        IndexType capacity(edge_end - edge_begin);
+                        chunk.rows.reserve(options.symmetric ? 2*capacity
+                                                             : capacity);
+                        chunk.cols.reserve(chunk.rows.capacity());
+                        chunk.vals.reserve(chunk.rows.capacity());
+
+                        for (IndexType edge = edge_begin; edge < edge_end;
+                             ++edge)
+                        {
+                            EdgeRandom rng(options.seed, edge);
+                            IndexType src, dst;
+                            if (!edge_fn(edge, rng, src, dst) ||
+                                ((src == dst) && !options.self_loops))
+                            {
+                                continue;
+                            }
+
+                            ScalarType weight(
+                                edge_weight<ScalarType>(rng, options));
+                            chunk.add(src, dst, weight);
+                            if (options.symmetric && (src != dst))
+                            {
+                                chunk.add(dst, src, weight);
+                            }
+                        }
+                    }
+                });
+
+            MatrixT A(num_vertices, num_vertices);
+            build_from_chunks(A, chunks);
+            return A;
+        }
+
+        //********************************************************************
+        /// The quadrant probabilities of an R-MAT graph.
+        struct RmatProbabilities
+        {
+            RmatProbabilities(double a, double b, double c)
+                : ab(a + b), abc(a + b + c), a(a)
+            {
+                if (!(a >= 0.) || !(b >= 0.) || !(c >= 0.) || !(abc <= 1.))
+                {
+                    throw InvalidValueException(
+                        "rmat: a, b and c must be non-negative with "
+                        "a + b + c <= 1");
+                }
+            }
+
+            /// Choose the quadrant of one level of the recursion.
+            void choose(EdgeRandom  &rng,
+                        IndexType    bit,
+                        IndexType   &src,
+                        IndexType   &dst) const
+            {
+                double u(rng.uniform());
+                if (u >= a)
+                {
+                    if (u < ab)
+                    {
+                        dst |= bit;
+                    }
+                    else if (u < abc)
+                    {
+                        src |= bit;
+                    }
+                    else
+                    {
+                        src |= bit;
+                        dst |= bit;
+                    }
+                }
+            }
+
+            double ab, abc, a;
+        };
+
+        inline void check_scale(IndexType scale, std::string const &name)
+        {
+            if (scale >= 8*sizeof(IndexType) - 1)
+            {
+                throw InvalidValueException(name + ": scale is too large");
+            }
+        }
+
+        //********************************************************************
+        /**
+         * A bijection of [0, 2^scale) chosen by the seed, used to relabel
+         * the vertices of a Kronecker graph so that the vertex ids say
+         * nothing about the degrees.
+         */
+        class VertexScramble
+        {
+        public:
+            VertexScramble(IndexType scale, std::uint64_t seed)
+                : m_mask((IndexType(1) << scale) - 1),
+                  m_shift(std::max<IndexType>(scale/2, 1)),
+                  m_mul1(generator_mix(seed ^ 0x5ca1ab1eULL) | 1),
+                  m_add1(generator_mix(seed ^ 0xdecafbadULL)),
+                  m_mul2(generator_mix(seed ^ 0xfeedfaceULL) | 1),
+                  m_add2(generator_mix(seed ^ 0xbaddcafeULL))
+            {
+            }
+
+            IndexType operator()(IndexType vertex) const
+            {
+                IndexType x((vertex*m_mul1 + m_add1) & m_mask);
+                x ^= x >> m_shift;
+                x = (x*m_mul2 + m_add2) & m_mask;
+                return x ^ (x >> m_shift);
+            }
+
+        private:
+            IndexType m_mask;
+            IndexType m_shift;
+            IndexType m_mul1, m_add1, m_mul2, m_add2;
+        };
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief An R-MAT graph with 2^scale vertices and edge_factor*2^scale
+     *        edges.
+     *
+     * Each edge picks one quadrant of the adjacency matrix per level of
+     * the recursion, with probabilities a, b, c and 1 - a - b - c (top
+     * left, top right, bottom left, bottom right).  The defaults are the
+     * Graph500 parameters.
+     */
+    template <typename MatrixT>
+    MatrixT rmat(IndexType                scale,
+                 IndexType                edge_factor,
+                 GeneratorOptions const  &options = GeneratorOptions(),
+                 double                   a = 0.57,
+                 double                   b = 0.19,
+                 double                   c = 0.19)
+    {
+        detail::check_scale(scale, "rmat");
+        detail::check_generator_options(options, "rmat");
+        detail::RmatProbabilities const probabilities(a, b, c);
+
+        IndexType num_vertices(IndexType(1) << scale);
+        return detail::generate_edges<MatrixT>(
+            num_vertices, edge_factor*num_vertices, options,
+            [&](IndexType, detail::EdgeRandom &rng,
+                IndexType &src, IndexType &dst)
+            {
+                src = dst = 0;
+                for (IndexType bit = num_vertices >> 1; bit != 0; bit >>= 1)
+                {
+                    probabilities.choose(rng, bit, src, dst);
+                }
+                return true;
+            });
+    }
+
+    //************************************************************************
+    /**
+     * @brief A Graph500 Kronecker graph: an R-MAT graph with the Graph500
+     *        parameters whose vertices are relabelled by a permutation
+     *        chosen by the seed.
+     *
+     * The Graph500 generator (scale, edge_factor 16) is
+     * kronecker<MatrixT>(scale, 16, options) with options.symmetric set.
+     */
+    template <typename MatrixT>
+    MatrixT kronecker(IndexType                scale,
+                      IndexType                edge_factor,
+                      GeneratorOptions const  &options = GeneratorOptions())
+    {
+        detail::check_scale(scale, "kronecker");
+        detail::check_generator_options(options, "kronecker");
+        detail::RmatProbabilities const probabilities(0.57, 0.19, 0.19);
+        detail::VertexScramble const scramble(scale, options.seed);
+
+        IndexType num_vertices(IndexType(1) << scale);
+        return detail::generate_edges<MatrixT>(
+            num_vertices, edge_factor*num_vertices, options,
+            [&](IndexType, detail::EdgeRandom &rng,
+                IndexType &src, IndexType &dst)
+            {
+                src = dst = 0;
+                for (IndexType bit = num_vertices >> 1; bit != 0; bit >>= 1)
+                {
+                    probabilities.choose(rng, bit, src, dst);
+                }
+                src = scramble(src);
+                dst = scramble(dst);
+                return true;
+            });
+    }
+
+    //************************************************************************
+    /**
+     * @brief An Erdos-Renyi graph: num_edges edges whose ends are drawn
+     *        uniformly from num_vertices vertices.
+     *
+     * The edges are drawn independently (the G(n, m) model with
+     * replacement), so a few may be duplicates that are merged.
+     */
+    template <typename MatrixT>
+    MatrixT erdos_renyi(IndexType                num_vertices,
+                        IndexType                num_edges,
+                        GeneratorOptions const  &options = GeneratorOptions())
+    {
+        detail::check_generator_options(options, "erdos_renyi");
+        if ((num_vertices == 0) && (num_edges != 0))
+        {
+            throw InvalidValueException("erdos_renyi: no vertices");
+        }
+
+        return detail::generate_edges<MatrixT>(
+            num_vertices, num_edges, options,
+            [&](IndexType, detail::EdgeRandom &rng,
+                IndexType &src, IndexType &dst)
+            {
+                src = rng.below(num_vertices);
+                dst = rng.below(num_vertices);
+                return true;
+            });
+    }
+
+    //************************************************************************
+    /**
+     * @brief A power-law graph: num_edges edges whose ends are drawn with
+     *        probability proportional to (vertex + 1)^(-1/(exponent - 1)),
+     *        so that the expected degrees follow a power law with the
+     *        given exponent (the Chung-Lu model).
+     *
+     * A smaller exponent (> 1) gives a more skewed graph; exponents of 2 to
+     * 3 are typical of real networks.  Vertex 0 has the highest degree.
+     */
+    template <typename MatrixT>
+    MatrixT power_law(IndexType                num_vertices,
+                      IndexType                num_edges,
+                      double                   exponent,
+                      GeneratorOptions const  &options = GeneratorOptions())
+    {
+        detail::check_generator_options(options, "power_law");
+        if (!(exponent > 1.))
+        {
+            throw InvalidValueException("power_law: exponent must be > 1");
+        }
+        if ((num_vertices == 0) && (num_edges != 0))
+        {
+            throw InvalidValueException("power_law: no vertices");
+        }
+
+        // Invert the CDF of the continuous density x^-alpha on
+        // [1, num_vertices + 1)
+        double const alpha(1./(exponent - 1.));
+        double const n(static_cast<double>(num_vertices));
+        double const beta(1. - alpha);
+        double const range((std::fabs(beta) < 1e-12) ?
+                           std::log(n + 1.) : std::pow(n + 1., beta) - 1.);
+        auto draw = [=](detail::EdgeRandom &rng)
+        {
+            double u(rng.uniform());
+            double x((std::fabs(beta) < 1e-12) ?
+                     std::exp(u*range) : std::pow(1. + u*range, 1./beta));
+            IndexType vertex(static_cast<IndexType>(x) - 1);
+            return std::min(vertex, num_vertices - 1);
+        };
+
+        return detail::generate_edges<MatrixT>(
+            num_vertices, num_edges, options,
+            [&](IndexType, detail::EdgeRandom &rng,
+                IndexType &src, IndexType &dst)
+            {
+                src = draw(rng);
+                dst = draw(rng);
+                return true;
+            });
+    }
+
+    //************************************************************************
+    /**
+     * @brief A num_rows x num_cols grid: vertex row*num_cols + col has an
+     *        edge to its right and lower neighbours (in both directions
+     *        when options.symmetric is set).
+     */
+    template <typename MatrixT>
+    MatrixT grid_2d(IndexType                num_rows,
+                    IndexType                num_cols,
+                    GeneratorOptions const  &options = GeneratorOptions())
+    {
+        detail::check_generator_options(options, "grid_2d");
+
+        IndexType num_vertices(num_rows*num_cols);
+        return detail::generate_edges<MatrixT>(
+            num_vertices, 2*num_vertices, options,
+            [&](IndexType edge, detail::EdgeRandom &,
+                IndexType &src, IndexType &dst)
+            {
+                src = edge/2;
+                IndexType row(src/num_cols), col(src % num_cols);
+                if (edge % 2 == 0)
+                {
+                    dst = src + 1;
+                    return col + 1 < num_cols;
+                }
+                dst = src + num_cols;
+                return row + 1 < num_rows;
+            });
+    }
+
+    //************************************************************************
+    /**
+     * @brief An nx x ny x nz grid: vertex (z*ny + y)*nx + x has an edge to
+     *        its neighbours in +x, +y and +z (in both directions when
+     *        options.symmetric is set).
+     */
+    template <typename MatrixT>
+    MatrixT grid_3d(IndexType                nx,
+                    IndexType                ny,
+                    IndexType                nz,
+                    GeneratorOptions const  &options = GeneratorOptions())
+    {
+        detail::check_generator_options(options, "grid_3d");
+
+        IndexType num_vertices(nx*ny*nz);
+        return detail::generate_edges<MatrixT>(
+            num_vertices, 3*num_vertices, options,
+            [&](IndexType edge, detail::EdgeRandom &,
+                IndexType &src, IndexType &dst)
+            {
+                src = edge/3;
+                IndexType x(src % nx), y((src/nx) % ny), z(src/(nx*ny));
+                switch (edge % 3)
+                {
+                case 0:
+                    dst = src + 1;
+                    return x + 1 < nx;
+                case 1:
+                    dst = src + nx;
+                    return y + 1 < ny;
+                default:
+                    dst = src + nx*ny;
+                    return z + 1 < nz;
+                }
+            });
+    }
+
+} // GraphBLAS
+
+#endif // GB_GENERATORS_HPP
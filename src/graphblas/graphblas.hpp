@@ -38,6 +38,7 @@
 #include <graphblas/exceptions.hpp>
 
 #include <graphblas/algebra.hpp>
+#include <graphblas/ReductionMode.hpp>
 
 #include <graphblas/Matrix.hpp>
 #include <graphblas/Vector.hpp>
@@ -46,6 +47,16 @@
 
 #include <graphblas/operations.hpp>
 #include <graphblas/matrix_utils.hpp>
+#include <graphblas/matrix_interop.hpp>
+#include <graphblas/matrix_io.hpp>
+#include <graphblas/TaskPool.hpp>
+#include <graphblas/NonBlocking.hpp>
+#include <graphblas/fusion.hpp>
+#include <graphblas/expressions.hpp>
+#include <graphblas/snapshot.hpp>
+#include <graphblas/TiledMatrix.hpp>
+#include <graphblas/compressed_snapshot.hpp>
+#include <graphblas/generators.hpp>
 
 #define GB_INCLUDE_BACKEND_ALL 1
 #include <backend_include.hpp>
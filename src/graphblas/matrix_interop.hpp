@@ -0,0 +1,439 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * @file matrix_interop.hpp
+ *
+ * @brief Handing the contents of a Matrix to and from other code without
+ *        going through tuples: as the matrix's own rows (without copying)
+ *        or as CSR and CSC arrays.
+ *
+ * A Matrix stores each row as a vector of (column index, value) tuples in
+ * increasing column order.  import_rows() and export_rows() move those
+ * row vectors in and out in O(1) (plus O(nrows) to count the values), so
+ * they are how stages of a pipeline hand a matrix over.  CSR and CSC
+ * arrays do not match this layout: import_csr() and import_csc() copy
+ * them into the rows in one pass (in parallel for CSR) with one
+ * allocation per row, and export_csr() and export_csc() fill the arrays
+ * from the rows.  None of them sorts anything or builds tuple arrays.
+ */
+
+#ifndef GB_MATRIX_INTEROP_HPP
+#define GB_MATRIX_INTEROP_HPP
+
+#pragma once
+
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/Matrix.hpp>
+#include <graphblas/TaskPool.hpp>
+#include <graphblas/NonBlocking.hpp>
+#include <graphblas/expressions.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    /// The rows of a Matrix: a (column index, value) vector for each row,
+    /// in increasing column order.
+    template <typename ScalarT>
+    using MatrixRows =
+        std::vector<std::vector<std::tuple<IndexType, ScalarT> > >;
+
+    /// The number of rows a task handles in the functions below.
+    static IndexType const INTEROP_ROWS_PER_TASK = 1024;
+
+    namespace detail
+    {
+        /// Check the column indices of a row: in range and increasing.
+        template <typename IndexIteratorT>
+        void check_row_indices(IndexIteratorT  first,
+                               IndexIteratorT  last,
+                               IndexType       ncols,
+                               char const     *fn)
+        {
+            for (IndexIteratorT it = first; it != last; ++it)
+            {
+                if (*it >= ncols)
+                {
+                    throw IndexOutOfBoundsException(
+                        std::string(fn) + ": index out of bounds");
+                }
+                if ((it != first) && (*it <= *(it - 1)))
+                {
+                    throw InvalidIndexException(
+                        std::string(fn) + ": indices of a row not increasing");
+                }
+            }
+        }
+
+        /// Check that offsets [0, n] start at 0, do not decrease and end
+        /// at nvals.
+        template <typename OffsetIteratorT>
+        void check_offsets(OffsetIteratorT  offsets,
+                           IndexType        n,
+                           char const      *fn)
+        {
+            bool valid(offsets[0] == 0);
+            for (IndexType idx = 0; valid && (idx < n); ++idx)
+            {
+                valid = (offsets[idx] <= offsets[idx + 1]);
+            }
+            if (!valid)
+            {
+                throw InvalidValueException(
+                    std::string(fn) + ": offsets must start at 0 and not "
+                    "decrease");
+            }
+        }
+
+        /// Values can be written by concurrent tasks unless they are
+        /// packed bits (std::vector<bool>).
+        template <typename ScalarT>
+        IndexType interop_grain(IndexType n)
+        {
+            return std::is_same<ScalarT, bool>::value ?
+                std::max<IndexType>(n, 1) : INTEROP_ROWS_PER_TASK;
+        }
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief Replace the contents of A with rows, without copying them.
+     *
+     * The previous rows of A are handed back in rows.  No values are
+     * checked unless validate is set.
+     *
+     * @param[in,out] rows      A.nrows() rows, each in increasing column
+     *                          order.
+     * @param[in]     validate  Check the column indices (in parallel).
+     *
+     * @throw DimensionException          if rows.size() != A.nrows().
+     * @throw IndexOutOfBoundsException   if validate is set and a column
+     *                                    index is out of range.
+     * @throw InvalidIndexException       if validate is set and the column
+     *                                    indices of a row do not increase.
+     */
+    template <typename ScalarT, typename... TagsT>
+    void import_rows(Matrix<ScalarT, TagsT...> &A,
+                     MatrixRows<ScalarT>      &&rows,
+                     bool                       validate = false)
+    {
+        auto &mat(expr::backend_access::matrix(A));
+        detail::sync_write(mat);
+
+        if (rows.size() != mat.nrows())
+        {
+            throw DimensionException("import_rows: rows.size != A.nrows");
+        }
+
+        if (validate)
+        {
+            IndexType ncols(mat.ncols());
+            parallel_for(
+                0, rows.size(),
+                [&](IndexType row_begin, IndexType row_end)
+                {
+                    for (IndexType row_idx = row_begin; row_idx < row_end;
+                         ++row_idx)
+                    {
+                        IndexArrayType indices;
+                        indices.reserve(rows[row_idx].size());
+                        for (auto const &elt : rows[row_idx])
+                        {
+                            indices.push_back(std::get<0>(elt));
+                        }
+                        detail::check_row_indices(indices.begin(),
+                                                  indices.end(), ncols,
+                                                  "import_rows");
+                    }
+                },
+                INTEROP_ROWS_PER_TASK);
+        }
+
+        mat.setRows(std::move(rows));
+    }
+
+    /**
+     * @brief Take the rows of A without copying them; A is left with no
+     *        stored values.
+     */
+    template <typename ScalarT, typename... TagsT>
+    MatrixRows<ScalarT> export_rows(Matrix<ScalarT, TagsT...> &A)
+    {
+        auto &mat(expr::backend_access::matrix(A));
+        detail::sync_write(mat);
+
+        MatrixRows<ScalarT> rows(mat.nrows());
+        mat.setRows(std::move(rows));
+        return rows;
+    }
+
+    /**
+     * @brief Call fn(row_index, row) for each row of A, where row is the
+     *        row's (column index, value) vector in A, from parallel tasks
+     *        (so fn must only write state of its own row).
+     */
+    template <typename ScalarT, typename... TagsT, typename FunctionT>
+    void visit_rows(Matrix<ScalarT, TagsT...> const &A, FunctionT fn)
+    {
+        auto const &mat(expr::backend_access::matrix(A));
+        detail::sync_read(mat);
+
+        parallel_for(
+            0, mat.nrows(),
+            [&](IndexType row_begin, IndexType row_end)
+            {
+                for (IndexType row_idx = row_begin; row_idx < row_end;
+                     ++row_idx)
+                {
+                    fn(row_idx, mat.getRow(row_idx));
+                }
+            },
+            INTEROP_ROWS_PER_TASK);
+    }
+
+    //************************************************************************
+    /**
+     * @brief Replace the contents of A with the matrix in the CSR arrays
+     *        row_ptr (A.nrows() + 1 offsets), col_idx and values (both
+     *        row_ptr[A.nrows()] long).
+     *
+     * The arrays are only read (they can be the caller's memory, of any
+     * random access type).  The rows are filled in parallel, each with a
+     * single allocation.
+     *
+     * @param[in] validate  Check the offsets and column indices.
+     *
+     * @throw IndexOutOfBoundsException  if validate is set and a column
+     *                                   index is out of range.
+     * @throw InvalidIndexException      if validate is set and the column
+     *                                   indices of a row do not increase.
+     * @throw InvalidValueException      if validate is set and the
+     *                                   offsets are not valid.
+     */
+    template <typename ScalarT, typename... TagsT,
+              typename RowPtrIteratorT,
+              typename ColIdxIteratorT,
+              typename ValueIteratorT>
+    void import_csr(Matrix<ScalarT, TagsT...> &A,
+                    RowPtrIteratorT            row_ptr,
+                    ColIdxIteratorT            col_idx,
+                    ValueIteratorT             values,
+                    bool                       validate = false)
+    {
+        IndexType nrows(A.nrows()), ncols(A.ncols());
+        if (validate)
+        {
+            detail::check_offsets(row_ptr, nrows, "import_csr");
+        }
+
+        MatrixRows<ScalarT> rows(nrows);
+        parallel_for(
+            0, nrows,
+            [&](IndexType row_begin, IndexType row_end)
+            {
+                for (IndexType row_idx = row_begin; row_idx < row_end;
+                     ++row_idx)
+                {
+                    IndexType first(row_ptr[row_idx]);
+                    IndexType last(row_ptr[row_idx + 1]);
+                    if (validate)
+                    {
+                        detail::check_row_indices(col_idx + first,
+                                                  col_idx + last, ncols,
+                                                  "import_csr");
+                    }
+
+                    auto &row(rows[row_idx]);
+                    row.reserve(last - first);
+                    for (IndexType idx = first; idx < last; ++idx)
+                    {
+                        row.push_back(std::make_tuple(
+                            static_cast<IndexType>(col_idx[idx]),
+                            static_cast<ScalarT>(values[idx])));
+                    }
+                }
+            },
+            INTEROP_ROWS_PER_TASK);
+
+        import_rows(A, std::move(rows));
+    }
+
+    /**
+     * @brief Copy A into the CSR arrays row_ptr, col_idx and values, which
+     *        are resized (so their memory is reused).
+     */
+    template <typename ScalarT, typename... TagsT>
+    void export_csr(Matrix<ScalarT, TagsT...> const &A,
+                    IndexArrayType                  &row_ptr,
+                    IndexArrayType                  &col_idx,
+                    std::vector<ScalarT>            &values)
+    {
+        auto const &mat(expr::backend_access::matrix(A));
+        detail::sync_read(mat);
+
+        IndexType nrows(mat.nrows());
+        row_ptr = mat.row_nnz_prefix();
+        col_idx.resize(row_ptr[nrows]);
+        values.resize(row_ptr[nrows]);
+        parallel_for(
+            0, nrows,
+            [&](IndexType row_begin, IndexType row_end)
+            {
+                for (IndexType row_idx = row_begin; row_idx < row_end;
+                     ++row_idx)
+                {
+                    IndexType idx(row_ptr[row_idx]);
+                    for (auto const &elt : mat.getRow(row_idx))
+                    {
+                        col_idx[idx] = std::get<0>(elt);
+                        values[idx] = std::get<1>(elt);
+                        ++idx;
+                    }
+                }
+            },
+            detail::interop_grain<ScalarT>(nrows));
+    }
+
+    //************************************************************************
+    /**
+     * @brief Replace the contents of A with the matrix in the CSC arrays
+     *        col_ptr (A.ncols() + 1 offsets), row_idx and values.
+     *
+     * The values are counted into rows and then scattered into them a
+     * column at a time, so each row is allocated once and comes out in
+     * column order.
+     *
+     * @param[in] validate  Check the offsets and row indices.
+     *
+     * @throw IndexOutOfBoundsException  if validate is set and a row index
+     *                                   is out of range.
+     * @throw InvalidIndexException      if validate is set and the row
+     *                                   indices of a column do not
+     *                                   increase.
+     * @throw InvalidValueException      if validate is set and the
+     *                                   offsets are not valid.
+     */
+    template <typename ScalarT, typename... TagsT,
+              typename ColPtrIteratorT,
+              typename RowIdxIteratorT,
+              typename ValueIteratorT>
+    void import_csc(Matrix<ScalarT, TagsT...> &A,
+                    ColPtrIteratorT            col_ptr,
+                    RowIdxIteratorT            row_idx,
+                    ValueIteratorT             values,
+                    bool                       validate = false)
+    {
+        IndexType nrows(A.nrows()), ncols(A.ncols());
+        if (validate)
+        {
+            detail::check_offsets(col_ptr, ncols, "import_csc");
+            for (IndexType col = 0; col < ncols; ++col)
+            {
+                detail::check_row_indices(row_idx + col_ptr[col],
+                                          row_idx + col_ptr[col + 1], nrows,
+                                          "import_csc");
+            }
+        }
+
+        IndexType nvals(col_ptr[ncols]);
+        std::vector<IndexType> counts(nrows, 0);
+        for (IndexType idx = 0; idx < nvals; ++idx)
+        {
+            ++counts[row_idx[idx]];
+        }
+
+        MatrixRows<ScalarT> rows(nrows);
+        for (IndexType row = 0; row < nrows; ++row)
+        {
+            rows[row].reserve(counts[row]);
+        }
+        for (IndexType col = 0; col < ncols; ++col)
+        {
+            for (IndexType idx = col_ptr[col]; idx < col_ptr[col + 1]; ++idx)
+            {
+                rows[row_idx[idx]].push_back(
+                    std::make_tuple(col, static_cast<ScalarT>(values[idx])));
+            }
+        }
+
+        import_rows(A, std::move(rows));
+    }
+
+    /**
+     * @brief Copy A into the CSC arrays col_ptr, row_idx and values, which
+     *        are resized (so their memory is reused).
+     */
+    template <typename ScalarT, typename... TagsT>
+    void export_csc(Matrix<ScalarT, TagsT...> const &A,
+                    IndexArrayType                  &col_ptr,
+                    IndexArrayType                  &row_idx,
+                    std::vector<ScalarT>            &values)
+    {
+        auto const &mat(expr::backend_access::matrix(A));
+        detail::sync_read(mat);
+
+        IndexType nrows(mat.nrows()), ncols(mat.ncols());
+        col_ptr.assign(ncols + 1, 0);
+        for (IndexType row = 0; row < nrows; ++row)
+        {
+            for (auto const &elt : mat.getRow(row))
+            {
+                ++col_ptr[std::get<0>(elt) + 1];
+            }
+        }
+        for (IndexType col = 0; col < ncols; ++col)
+        {
+            col_ptr[col + 1] += col_ptr[col];
+        }
+
+        // Scatter the rows in order, so each column's rows increase
+        IndexArrayType next(col_ptr.begin(), col_ptr.end() - 1);
+        row_idx.resize(col_ptr[ncols]);
+        values.resize(col_ptr[ncols]);
+        for (IndexType row = 0; row < nrows; ++row)
+        {
+            for (auto const &elt : mat.getRow(row))
+            {
+                IndexType idx(next[std::get<0>(elt)]++);
+                row_idx[idx] = row;
+                values[idx] = std::get<1>(elt);
+            }
+        }
+    }
+} // GraphBLAS
+
+#endif // GB_MATRIX_INTEROP_HPP
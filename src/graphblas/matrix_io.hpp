@@ -0,0 +1,815 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * @file matrix_io.hpp
+ *
+ * @brief Reading and writing matrices as Matrix Market files and as edge
+ *        lists (TSV or CSV).
+ *
+ * Files are mapped into memory and their lines are parsed in chunks of
+ * IO_CHUNK_SIZE bytes, in parallel on the TaskPool.  The tuples of the
+ * chunks are then passed to one build() of the matrix.
+ */
+
+#ifndef GB_MATRIX_IO_HPP
+#define GB_MATRIX_IO_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/TaskPool.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    /// The number of bytes of text parsed (or formatted) by one task.
+    static std::size_t const IO_CHUNK_SIZE = 1 << 22;
+
+    //************************************************************************
+    /// How read_edge_list interprets the lines of an edge list.
+    struct EdgeListOptions
+    {
+        EdgeListOptions()
+            : num_vertices(0),
+              symmetric(false),
+              one_based(false),
+              skip_self_loops(false)
+        {
+        }
+
+        /// The number of rows and columns of the matrix, or 0 for one more
+        /// than the largest vertex id.
+        IndexType num_vertices;
+
+        /// Store every edge in both directions (an undirected graph).
+        bool symmetric;
+
+        /// The vertex ids start at 1 instead of 0.
+        bool one_based;
+
+        /// Leave out the edges from a vertex to itself.
+        bool skip_self_loops;
+    };
+
+    namespace detail
+    {
+        //********************************************************************
+        /// A file mapped read-only into memory.
+        class MappedFile
+        {
+        public:
+            MappedFile(std::string const &path)
+                : m_data(nullptr),
+                  m_size(0)
+            {
+                int fd(::open(path.c_str(), O_RDONLY));
+                if (fd < 0)
+                {
+                    throw IOException("cannot open " + path);
+                }
+
+                struct stat info;
+                if (::fstat(fd, &info) != 0)
+                {
+                    ::close(fd);
+                    throw IOException("cannot read " + path);
+                }
+
+                m_size = static_cast<std::size_t>(info.st_size);
+                if (m_size > 0)
+                {
+                    void *data(::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE,
+                                      fd, 0));
+                    if (data == MAP_FAILED)
+                    {
+                        ::close(fd);
+                        throw IOException("cannot map " + path);
+                    }
+                    ::madvise(data, m_size, MADV_SEQUENTIAL);
+                    m_data = static_cast<char const *>(data);
+                }
+                ::close(fd);
+            }
+
+            ~MappedFile()
+            {
+                if (m_data != nullptr)
+                {
+                    ::munmap(const_cast<char *>(m_data), m_size);
+                }
+            }
+
+            MappedFile(MappedFile const &) = delete;
+            MappedFile &operator=(MappedFile const &) = delete;
+
+            char const *begin() const { return m_data; }
+            char const *end() const   { return m_data + m_size; }
+
+        private:
+            char const  *m_data;
+            std::size_t  m_size;
+        };
+
+        //********************************************************************
+        // Parsing a line [p, end) of text
+
+        /// Separators: spaces, tabs and commas (and the \r of \r\n).
+        inline bool is_separator(char c)
+        {
+            return (c == ' ') || (c == '\t') || (c == ',') || (c == '\r');
+        }
+
+        inline char const *skip_separators(char const *p, char const *end)
+        {
+            while ((p != end) && is_separator(*p))
+            {
+                ++p;
+            }
+            return p;
+        }
+
+        /// The end of the field that starts at p.
+        inline char const *field_end(char const *p, char const *end)
+        {
+            while ((p != end) && !is_separator(*p))
+            {
+                ++p;
+            }
+            return p;
+        }
+
+        /// Parse the unsigned integer field at p and move p past it.
+        inline bool parse_index(char const *&p, char const *end,
+                                IndexType &index)
+        {
+            p = skip_separators(p, end);
+            char const *last(field_end(p, end));
+            if (p == last)
+            {
+                return false;
+            }
+
+            IndexType value(0);
+            for (; p != last; ++p)
+            {
+                unsigned int digit(static_cast<unsigned char>(*p) - '0');
+                if (digit > 9)
+                {
+                    return false;
+                }
+                value = value*10 + digit;
+            }
+            index = value;
+            return true;
+        }
+
+        /// Parse the number field at p (an integer, or floating point in
+        /// the format of strtod) and move p past it.
+        template <typename ScalarT>
+        bool parse_value(char const *&p, char const *end, ScalarT &value)
+        {
+            p = skip_separators(p, end);
+            char const *last(field_end(p, end));
+            if (p == last)
+            {
+                return false;
+            }
+
+            // Integers (most of the values of integer matrices and of
+            // edge weights) without strtod
+            char const *digits(((*p == '-') || (*p == '+')) ? p + 1 : p);
+            if ((digits != last) && (last - digits < 19) &&
+                std::all_of(digits, last,
+                            [](char c) { return (c >= '0') && (c <= '9'); }))
+            {
+                long long magnitude(0);
+                for (char const *d = digits; d != last; ++d)
+                {
+                    magnitude = magnitude*10 + (*d - '0');
+                }
+                value = static_cast<ScalarT>((*p == '-') ? -magnitude :
+                                             magnitude);
+                p = last;
+                return true;
+            }
+
+            // strtod needs a terminated copy: the mapped text may end with
+            // the number.
+            char buffer[64];
+            std::size_t length(last - p);
+            if (length >= sizeof(buffer))
+            {
+                return false;
+            }
+            std::memcpy(buffer, p, length);
+            buffer[length] = '\0';
+
+            char *parsed_end;
+            double parsed(std::strtod(buffer, &parsed_end));
+            if (parsed_end != buffer + length)
+            {
+                return false;
+            }
+            value = static_cast<ScalarT>(parsed);
+            p = last;
+            return true;
+        }
+
+        /// Whether nothing but separators is left on the line.
+        inline bool at_line_end(char const *p, char const *end)
+        {
+            return skip_separators(p, end) == end;
+        }
+
+        /// The line (at most 80 characters of it) for error messages.
+        inline std::string quote_line(char const *begin, char const *end)
+        {
+            return "\"" + std::string(begin, std::min(end, begin + 80)) + "\"";
+        }
+
+        //********************************************************************
+        /**
+         * @brief The tuples read from one chunk of a file.
+         *
+         * bool values are kept as char so that chunks can be copied into
+         * one array by different threads.
+         */
+        template <typename ScalarT>
+        struct TupleChunk
+        {
+            typedef typename std::conditional<
+                std::is_same<ScalarT, bool>::value, char, ScalarT>::type
+                ValueType;
+
+            TupleChunk() : num_lines(0), max_index(0) {}
+
+            void add(IndexType row, IndexType col, ScalarT val)
+            {
+                rows.push_back(row);
+                cols.push_back(col);
+                vals.push_back(static_cast<ValueType>(val));
+                max_index = std::max(max_index, std::max(row, col) + 1);
+            }
+
+            std::vector<IndexType>  rows;
+            std::vector<IndexType>  cols;
+            std::vector<ValueType>  vals;
+            IndexType               num_lines;   ///< entry lines read
+            IndexType               max_index;   ///< largest index + 1
+        };
+
+        /**
+         * @brief Call parse_line(line_begin, line_end, chunk) for each line
+         *        of [begin, end), in chunks of about IO_CHUNK_SIZE bytes
+         *        that start at line starts, in parallel.
+         */
+        template <typename ScalarT, typename LineFunctionT>
+        void parse_lines(std::vector<TupleChunk<ScalarT> > &chunks,
+                         char const                         *begin,
+                         char const                         *end,
+                         LineFunctionT                       parse_line)
+        {
+            std::vector<char const *> bounds(1, begin);
+            while (bounds.back() != end)
+            {
+                char const *next(bounds.back() +
+                                 std::min<std::size_t>(IO_CHUNK_SIZE,
+                                                       end - bounds.back()));
+                if (next != end)
+                {
+                    char const *newline(static_cast<char const *>(
+                        std::memchr(next, '\n', end - next)));
+                    next = (newline == nullptr) ? end : newline + 1;
+                }
+                bounds.push_back(next);
+            }
+
+            chunks.clear();
+            chunks.resize(bounds.size() - 1);
+            parallel_for(
+                0, chunks.size(),
+                [&](IndexType chunk_begin, IndexType chunk_end)
+                {
+                    for (IndexType idx = chunk_begin; idx < chunk_end; ++idx)
+                    {
+                        char const *line(bounds[idx]);
+                        while (line != bounds[idx + 1])
+                        {
+                            char const *newline(static_cast<char const *>(
+                                std::memchr(line, '\n',
+                                            bounds[idx + 1] - line)));
+                            char const *line_end(
+                                (newline == nullptr) ? bounds[idx + 1] : newline);
+                            parse_line(line, line_end, chunks[idx]);
+                            line = (newline == nullptr) ? line_end : newline + 1;
+                        }
+                    }
+                });
+        }
+
+        /// Build A from the tuples of the chunks (which are emptied).
+        template <typename MatrixT, typename ScalarT>
+        void build_from_chunks(MatrixT                            &A,
+                               std::vector<TupleChunk<ScalarT> >  &chunks)
+        {
+            typedef typename TupleChunk<ScalarT>::ValueType ValueType;
+
+            std::vector<IndexType> offsets(chunks.size() + 1, 0);
+            for (IndexType idx = 0; idx < chunks.size(); ++idx)
+            {
+                offsets[idx + 1] = offsets[idx] + chunks[idx].rows.size();
+            }
+
+            IndexArrayType rows(offsets.back()), cols(offsets.back());
+            std::vector<ValueType> vals(offsets.back());
+            parallel_for(
+                0, chunks.size(),
+                [&](IndexType chunk_begin, IndexType chunk_end)
+                {
+                    for (IndexType idx = chunk_begin; idx < chunk_end; ++idx)
+                    {
+                        TupleChunk<ScalarT> &chunk(chunks[idx]);
+                        std::copy(chunk.rows.begin(), chunk.rows.end(),
+                                  rows.begin() + offsets[idx]);
+                        std::copy(chunk.cols.begin(), chunk.cols.end(),
+                                  cols.begin() + offsets[idx]);
+                        std::copy(chunk.vals.begin(), chunk.vals.end(),
+                                  vals.begin() + offsets[idx]);
+                        chunk = TupleChunk<ScalarT>();
+                    }
+                });
+
+            A.build(rows.begin(), cols.begin(), vals.begin(), rows.size());
+        }
+
+        //********************************************************************
+        // Formatting
+
+        inline void append_index(std::string &out, IndexType index)
+        {
+            char buffer[24];
+            char *p(buffer + sizeof(buffer));
+            do
+            {
+                *--p = static_cast<char>('0' + index % 10);
+                index /= 10;
+            } while (index != 0);
+            out.append(p, buffer + sizeof(buffer));
+        }
+
+        template <typename ScalarT>
+        void append_value(std::string &out, ScalarT value, std::true_type)
+        {
+            // integral
+            if (value < ScalarT(0))
+            {
+                out.push_back('-');
+                append_index(out, IndexType(0) - static_cast<IndexType>(value));
+            }
+            else
+            {
+                append_index(out, static_cast<IndexType>(value));
+            }
+        }
+
+        template <typename ScalarT>
+        void append_value(std::string &out, ScalarT value, std::false_type)
+        {
+            // floating point, with enough digits to read back the same value
+            char buffer[48];
+            int length(std::snprintf(buffer, sizeof(buffer), "%.*g",
+                                     std::numeric_limits<ScalarT>::max_digits10,
+                                     static_cast<double>(value)));
+            out.append(buffer, length);
+        }
+
+        template <typename ScalarT>
+        void append_value(std::string &out, ScalarT value)
+        {
+            append_value(out, value,
+                         std::integral_constant<
+                             bool, std::is_integral<ScalarT>::value>());
+        }
+
+        /**
+         * @brief Write header and then the tuples of A, a line each as
+         *        format_line(out, row, col, val) makes it.  Blocks of lines
+         *        are formatted in parallel and written in order.
+         */
+        template <typename MatrixT, typename LineFunctionT>
+        void write_lines(std::string const &path,
+                         std::string const &header,
+                         MatrixT     const &A,
+                         LineFunctionT      format_line)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            std::ofstream out(path, std::ios::binary);
+            if (!out)
+            {
+                throw IOException("cannot open " + path);
+            }
+            out.write(header.data(), header.size());
+
+            IndexType nvals(A.nvals());
+            IndexArrayType rows(nvals), cols(nvals);
+            std::vector<ScalarType> vals(nvals);
+            A.extractTuples(rows, cols, vals);
+
+            // About IO_CHUNK_SIZE bytes of text per block
+            IndexType const block_size(IO_CHUNK_SIZE/32);
+            IndexType const num_blocks((nvals + block_size - 1)/block_size);
+            TaskPool &pool(TaskPool::instance());
+            IndexType const batch(std::max<IndexType>(pool.num_threads(), 1));
+
+            std::vector<std::string> text(batch);
+            for (IndexType first = 0; first < num_blocks; first += batch)
+            {
+                IndexType last(std::min(first + batch, num_blocks));
+                parallel_for(
+                    first, last,
+                    [&](IndexType block_begin, IndexType block_end)
+                    {
+                        for (IndexType block = block_begin; block < block_end;
+                             ++block)
+                        {
+                            std::string &block_text(text[block - first]);
+                            block_text.clear();
+                            IndexType end(std::min(nvals,
+                                                   (block + 1)*block_size));
+                            for (IndexType idx = block*block_size; idx < end;
+                                 ++idx)
+                            {
+                                format_line(block_text,
+                                            rows[idx], cols[idx], vals[idx]);
+                            }
+                        }
+                    });
+
+                for (IndexType block = first; block < last; ++block)
+                {
+                    out.write(text[block - first].data(),
+                              text[block - first].size());
+                }
+            }
+
+            if (!out)
+            {
+                throw IOException("cannot write " + path);
+            }
+        }
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief Read a matrix from a Matrix Market file.
+     *
+     * Supports coordinate files with real, integer or pattern values (a
+     * pattern entry has the value 1) that are general, symmetric or
+     * skew-symmetric.  The other triangle of a symmetric (or
+     * skew-symmetric) file is stored as the entries are read.
+     *
+     * @throw IOException  if the file cannot be read, or is not a
+     *                     supported Matrix Market file.
+     */
+    template <typename MatrixT>
+    MatrixT read_matrix_market(std::string const &path)
+    {
+        typedef typename MatrixT::ScalarType ScalarType;
+
+        detail::MappedFile file(path);
+        char const *p(file.begin());
+        char const *end(file.end());
+
+        auto next_line = [&]() -> std::string
+        {
+            char const *newline(static_cast<char const *>(
+                std::memchr(p, '\n', end - p)));
+            char const *line_end((newline == nullptr) ? end : newline);
+            std::string line(p, line_end);
+            p = (newline == nullptr) ? end : newline + 1;
+            return line;
+        };
+
+        // %%MatrixMarket matrix coordinate <field> <symmetry>
+        std::string banner(next_line());
+        std::transform(banner.begin(), banner.end(), banner.begin(),
+                       [](char c) { return static_cast<char>(std::tolower(c)); });
+        char object[32], format[32], field[32], symmetry[32];
+        if ((std::sscanf(banner.c_str(), "%%%%matrixmarket %31s %31s %31s %31s",
+                         object, format, field, symmetry) != 4) ||
+            (std::string(object) != "matrix"))
+        {
+            throw IOException("read_matrix_market: not a Matrix Market file: " +
+                              path);
+        }
+
+        std::string field_str(field), symmetry_str(symmetry);
+        bool pattern(field_str == "pattern");
+        bool symmetric(symmetry_str == "symmetric");
+        bool skew(symmetry_str == "skew-symmetric");
+        if ((std::string(format) != "coordinate") ||
+            !(pattern || (field_str == "real") || (field_str == "integer") ||
+              (field_str == "double")) ||
+            !(symmetric || skew || (symmetry_str == "general")))
+        {
+            throw IOException("read_matrix_market: unsupported format \"" +
+                              std::string(format) + " " + field_str + " " +
+                              symmetry_str + "\": " + path);
+        }
+
+        // Comments, then the size line
+        std::string size_line;
+        do
+        {
+            if (p == end)
+            {
+                throw IOException("read_matrix_market: no size line: " + path);
+            }
+            size_line = next_line();
+        } while (size_line.empty() || (size_line[0] == '%') ||
+                 detail::at_line_end(size_line.data(),
+                                     size_line.data() + size_line.size()));
+
+        IndexType nrows, ncols, nentries;
+        char const *s(size_line.data());
+        char const *s_end(s + size_line.size());
+        if (!detail::parse_index(s, s_end, nrows) ||
+            !detail::parse_index(s, s_end, ncols) ||
+            !detail::parse_index(s, s_end, nentries) ||
+            !detail::at_line_end(s, s_end))
+        {
+            throw IOException("read_matrix_market: bad size line " +
+                              detail::quote_line(size_line.data(), s_end));
+        }
+
+        // row col [value], 1-based
+        std::vector<detail::TupleChunk<ScalarType> > chunks;
+        detail::parse_lines(
+            chunks, p, end,
+            [&](char const *line, char const *line_end,
+                detail::TupleChunk<ScalarType> &chunk)
+            {
+                char const *q(detail::skip_separators(line, line_end));
+                if ((q == line_end) || (*q == '%'))
+                {
+                    return;
+                }
+
+                IndexType row, col;
+                ScalarType val(1);
+                if (!detail::parse_index(q, line_end, row) ||
+                    !detail::parse_index(q, line_end, col) ||
+                    (!pattern && !detail::parse_value(q, line_end, val)) ||
+                    !detail::at_line_end(q, line_end))
+                {
+                    throw IOException("read_matrix_market: bad entry " +
+                                      detail::quote_line(line, line_end));
+                }
+                if ((row == 0) || (row > nrows) || (col == 0) || (col > ncols))
+                {
+                    throw IOException("read_matrix_market: index out of range " +
+                                      detail::quote_line(line, line_end));
+                }
+
+                ++chunk.num_lines;
+                chunk.add(row - 1, col - 1, val);
+                if ((symmetric || skew) && (row != col))
+                {
+                    chunk.add(col - 1, row - 1,
+                              skew ? static_cast<ScalarType>(-val) : val);
+                }
+            });
+
+        IndexType num_lines(0);
+        for (auto const &chunk : chunks)
+        {
+            num_lines += chunk.num_lines;
+        }
+        if (num_lines != nentries)
+        {
+            throw IOException("read_matrix_market: " + std::to_string(num_lines) +
+                              " entries instead of " + std::to_string(nentries) +
+                              ": " + path);
+        }
+
+        MatrixT A(nrows, ncols);
+        detail::build_from_chunks(A, chunks);
+        return A;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Write a matrix as a general coordinate Matrix Market file, of
+     *        integer values for integral scalar types and real values
+     *        otherwise.
+     *
+     * @throw IOException  if the file cannot be written.
+     */
+    template <typename MatrixT>
+    void write_matrix_market(std::string const &path, MatrixT const &A)
+    {
+        typedef typename MatrixT::ScalarType ScalarType;
+
+        std::string header("%%MatrixMarket matrix coordinate ");
+        header += (std::is_integral<ScalarType>::value ? "integer" : "real");
+        header += " general\n";
+        detail::append_index(header, A.nrows());
+        header += ' ';
+        detail::append_index(header, A.ncols());
+        header += ' ';
+        detail::append_index(header, A.nvals());
+        header += '\n';
+
+        detail::write_lines(
+            path, header, A,
+            [](std::string &out, IndexType row, IndexType col, ScalarType val)
+            {
+                detail::append_index(out, row + 1);
+                out.push_back(' ');
+                detail::append_index(out, col + 1);
+                out.push_back(' ');
+                detail::append_value(out, val);
+                out.push_back('\n');
+            });
+    }
+
+    //************************************************************************
+    /**
+     * @brief Read a graph from an edge list: a line "src dst [weight]" for
+     *        each edge, with the fields separated by spaces, tabs or commas
+     *        (TSV or CSV).
+     *
+     * An edge without a weight has the value 1.  Lines that start with #
+     * or % are comments, and a first line that does not start with a
+     * vertex id (a CSV column header) is skipped.  Later edges replace
+     * earlier ones between the same vertices.
+     *
+     * @throw IOException  if the file cannot be read or has a bad line.
+     */
+    template <typename MatrixT>
+    MatrixT read_edge_list(std::string     const &path,
+                           EdgeListOptions const &options = EdgeListOptions())
+    {
+        typedef typename MatrixT::ScalarType ScalarType;
+
+        detail::MappedFile file(path);
+        char const *begin(file.begin());
+        char const *end(file.end());
+
+        // Skip a column header
+        char const *first(detail::skip_separators(begin, end));
+        if ((first != end) && !((*first >= '0') && (*first <= '9')) &&
+            (*first != '#') && (*first != '%') && (*first != '\n'))
+        {
+            char const *newline(static_cast<char const *>(
+                std::memchr(begin, '\n', end - begin)));
+            begin = (newline == nullptr) ? end : newline + 1;
+        }
+
+        IndexType const base(options.one_based ? 1 : 0);
+        std::vector<detail::TupleChunk<ScalarType> > chunks;
+        detail::parse_lines(
+            chunks, begin, end,
+            [&](char const *line, char const *line_end,
+                detail::TupleChunk<ScalarType> &chunk)
+            {
+                char const *q(detail::skip_separators(line, line_end));
+                if ((q == line_end) || (*q == '#') || (*q == '%'))
+                {
+                    return;
+                }
+
+                IndexType src, dst;
+                ScalarType weight(1);
+                if (!detail::parse_index(q, line_end, src) ||
+                    !detail::parse_index(q, line_end, dst) ||
+                    !(detail::at_line_end(q, line_end) ||
+                      detail::parse_value(q, line_end, weight)) ||
+                    !detail::at_line_end(q, line_end) ||
+                    (src < base) || (dst < base))
+                {
+                    throw IOException("read_edge_list: bad edge " +
+                                      detail::quote_line(line, line_end));
+                }
+
+                src -= base;
+                dst -= base;
+                if (options.skip_self_loops && (src == dst))
+                {
+                    return;
+                }
+
+                chunk.add(src, dst, weight);
+                if (options.symmetric && (src != dst))
+                {
+                    chunk.add(dst, src, weight);
+                }
+            });
+
+        IndexType num_vertices(options.num_vertices);
+        if (num_vertices == 0)
+        {
+            for (auto const &chunk : chunks)
+            {
+                num_vertices = std::max(num_vertices, chunk.max_index);
+            }
+        }
+        else
+        {
+            for (auto const &chunk : chunks)
+            {
+                if (chunk.max_index > num_vertices)
+                {
+                    throw IOException("read_edge_list: vertex id out of "
+                                      "range: " + path);
+                }
+            }
+        }
+
+        MatrixT A(num_vertices, num_vertices);
+        detail::build_from_chunks(A, chunks);
+        return A;
+    }
+
+    //************************************************************************
+    /**
+     * @brief Write the stored elements of a matrix as an edge list: a line
+     *        "row col value" (or "row col") each, 0-based, with the fields
+     *        separated by delimiter ('\t' for TSV, ',' for CSV).
+     *
+     * @throw IOException  if the file cannot be written.
+     */
+    template <typename MatrixT>
+    void write_edge_list(std::string const &path,
+                         MatrixT     const &A,
+                         char               delimiter = '\t',
+                         bool               write_values = true)
+    {
+        typedef typename MatrixT::ScalarType ScalarType;
+
+        detail::write_lines(
+            path, std::string(), A,
+            [delimiter, write_values](std::string &out, IndexType row,
+                                      IndexType col, ScalarType val)
+            {
+                detail::append_index(out, row);
+                out.push_back(delimiter);
+                detail::append_index(out, col);
+                if (write_values)
+                {
+                    out.push_back(delimiter);
+                    detail::append_value(out, val);
+                }
+                out.push_back('\n');
+            });
+    }
+} // GraphBLAS
+
+#endif // GB_MATRIX_IO_HPP
@@ -30,10 +30,15 @@
 #ifndef GB_MATRIX_UTILS_HPP
 #define GB_MATRIX_UTILS_HPP
 
+#include <algorithm>
 #include <functional>
+#include <memory>
+#include <tuple>
 #include <vector>
 
 #include <graphblas/graphblas.hpp>
+#include <graphblas/TaskPool.hpp>
+#include <graphblas/matrix_interop.hpp>
 
 #define GB_INCLUDE_BACKEND_UTILITY 1
 #include <backend_include.hpp>
@@ -105,34 +110,24 @@ namespace GraphBLAS
 
         using T = typename MatrixT::ScalarType;
 
-        GraphBLAS::IndexType rows(A.nrows());
-        GraphBLAS::IndexType cols(A.ncols());
-        GraphBLAS::IndexType nvals(A.nvals());
-
-        GraphBLAS::IndexArrayType i(nvals), j(nvals);
-        std::vector<T> v(nvals);
-        A.extractTuples(i, j, v);
-
-        IndexArrayType iL,jL, iU,jU;
-        std::vector<T> vL, vU;
-
-        for (GraphBLAS::IndexType idx = 0; idx < nvals; ++idx)
-        {
-            if (i[idx] < j[idx])
+        // Each row of A is split at the diagonal into a row of L and a row
+        // of U, which are then moved into L and U.
+        MatrixRows<T> L_rows(A.nrows()), U_rows(A.nrows());
+        visit_rows(
+            A,
+            [&](IndexType row_idx,
+                std::vector<std::tuple<IndexType, T> > const &row)
             {
-                iU.push_back(i[idx]);
-                jU.push_back(j[idx]);
-                vU.push_back(v[idx]);
-            }
-            else
-            {
-                iL.push_back(i[idx]);
-                jL.push_back(j[idx]);
-                vL.push_back(v[idx]);
-            }
-        }
-        L.build(iL.begin(), jL.begin(), vL.begin(), vL.size());
-        U.build(iU.begin(), jU.begin(), vU.begin(), vU.size());
+                auto upper(std::upper_bound(
+                    row.begin(), row.end(), row_idx,
+                    [](IndexType idx, std::tuple<IndexType, T> const &elt)
+                    { return idx < std::get<0>(elt); }));
+                L_rows[row_idx].assign(row.begin(), upper);
+                U_rows[row_idx].assign(upper, row.end());
+            });
+
+        import_rows(L, std::move(L_rows));
+        import_rows(U, std::move(U_rows));
     }
 
     //************************************************************************
@@ -209,6 +204,70 @@ namespace GraphBLAS
                        GraphBLAS::ArithmeticSemiring<T>(),
                        A, Adiag);
     }
+
+    //************************************************************************
+    /**
+     * @brief Update blocks of rows of a matrix in parallel
+     *
+     * Each block of rows_per_task rows is copied into a matrix of its own,
+     * updated by fn(block) as a task of the TaskPool, and written back.
+     *
+     * @param[in,out] A              Matrix whose rows are independent
+     * @param[in]     rows_per_task  Number of rows in a block
+     * @param[in]     fn             Function called with each block
+     */
+    template<typename MatrixT, typename FunctionT>
+    void for_each_row_block(MatrixT    &A,
+                            IndexType   rows_per_task,
+                            FunctionT   fn)
+    {
+        using BlockT = GraphBLAS::Matrix<typename MatrixT::ScalarType>;
+
+        IndexType nrows(A.nrows());
+        IndexType ncols(A.ncols());
+        rows_per_task = std::max<IndexType>(rows_per_task, 1);
+        IndexType num_blocks((nrows + rows_per_task - 1)/rows_per_task);
+
+        auto block_rows = [&](IndexType block_idx)
+        {
+            IndexArrayType rows;
+            for (IndexType row_idx = block_idx*rows_per_task;
+                 row_idx < std::min(nrows, (block_idx + 1)*rows_per_task);
+                 ++row_idx)
+            {
+                rows.push_back(row_idx);
+            }
+            return rows;
+        };
+
+        std::vector<std::unique_ptr<BlockT> > blocks(num_blocks);
+        parallel_for(
+            0, nrows,
+            [&](IndexType row_begin, IndexType)
+            {
+                IndexType block_idx(row_begin/rows_per_task);
+                IndexArrayType rows(block_rows(block_idx));
+
+                std::unique_ptr<BlockT> block(new BlockT(rows.size(), ncols));
+                GraphBLAS::extract(*block,
+                                   GraphBLAS::NoMask(),
+                                   GraphBLAS::NoAccumulate(),
+                                   A, rows, GraphBLAS::AllIndices());
+                fn(*block);
+                blocks[block_idx] = std::move(block);
+            },
+            rows_per_task);
+
+        for (IndexType block_idx = 0; block_idx < num_blocks; ++block_idx)
+        {
+            GraphBLAS::assign(A,
+                              GraphBLAS::NoMask(),
+                              GraphBLAS::NoAccumulate(),
+                              *blocks[block_idx],
+                              block_rows(block_idx),
+                              GraphBLAS::AllIndices());
+        }
+    }
 }
 
 #endif // GB_MATRIX_UTILS_HPP
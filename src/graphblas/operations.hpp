@@ -32,7 +32,9 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
+#include <type_traits>
 #include <vector>
 
 #include <graphblas/algebra.hpp>
@@ -42,6 +44,7 @@
 #include <graphblas/Matrix.hpp>
 #include <graphblas/Vector.hpp>
 #include <graphblas/indices.hpp>
+#include <graphblas/NonBlocking.hpp>
 
 #include <graphblas/detail/logging.h>
 #include <graphblas/detail/config.hpp>
@@ -52,6 +55,101 @@
 #define GB_INCLUDE_BACKEND_OPERATIONS 1
 #include <backend_include.hpp>
 
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace detail
+    {
+        // Function objects that call the backend operations, so that a call
+        // can be recorded by a NonBlockingContext.
+#define GB_BACKEND_OPERATION(NAME)                                      \
+        struct backend_##NAME                                           \
+        {                                                               \
+            template <typename... ArgsT>                                \
+            void operator()(ArgsT &&... args) const                     \
+            {                                                           \
+                backend::NAME(std::forward<ArgsT>(args)...);            \
+            }                                                           \
+        };
+
+        GB_BACKEND_OPERATION(mxm)
+        GB_BACKEND_OPERATION(vxm)
+        GB_BACKEND_OPERATION(mxv)
+        GB_BACKEND_OPERATION(eWiseMult)
+        GB_BACKEND_OPERATION(eWiseAdd)
+        GB_BACKEND_OPERATION(extract)
+        GB_BACKEND_OPERATION(assign)
+        GB_BACKEND_OPERATION(assign_constant)
+        GB_BACKEND_OPERATION(apply)
+        GB_BACKEND_OPERATION(reduce)
+        GB_BACKEND_OPERATION(reduce_vector_to_scalar)
+        GB_BACKEND_OPERATION(reduce_matrix_to_scalar)
+        GB_BACKEND_OPERATION(transpose)
+        GB_BACKEND_OPERATION(apply_in_place)
+        GB_BACKEND_OPERATION(eWiseAdd_in_place)
+        GB_BACKEND_OPERATION(eWiseMult_in_place)
+
+#undef GB_BACKEND_OPERATION
+
+        // Whether an input is the output object itself.
+        template <typename OutputT, typename InputT>
+        inline bool is_output(OutputT const &, InputT const &)
+        {
+            return false;
+        }
+
+        template <typename OutputT>
+        inline bool is_output(OutputT const &out, OutputT const &in)
+        {
+            return &out == &in;
+        }
+
+        template <typename OutputT>
+        inline bool updates_in_place_impl(OutputT const &, bool found)
+        {
+            return found;
+        }
+
+        template <typename OutputT, typename InputT, typename... InputsT>
+        inline bool updates_in_place_impl(OutputT      const &out,
+                                          bool                found,
+                                          InputT       const &in,
+                                          InputsT      const &... ins)
+        {
+            if (is_output(out, in))
+            {
+                return updates_in_place_impl(out, true, ins...);
+            }
+
+            // An input that reads the output through a view (a transpose,
+            // say) sees rows other than the one being rewritten.
+            std::vector<void const *> ids;
+            storage_ids(ids, in);
+            if (std::find(ids.begin(), ids.end(),
+                          static_cast<void const *>(&out)) != ids.end())
+            {
+                return false;
+            }
+            return updates_in_place_impl(out, found, ins...);
+        }
+
+        /**
+         * @brief Whether an unmasked row-by-row operation can rewrite its
+         *        output in place: some input is the output object itself
+         *        and no other input reads it through a view.
+         */
+        template <typename MaskT, typename OutputT, typename... InputsT>
+        inline bool updates_in_place(MaskT    const &,
+                                     OutputT  const &out,
+                                     InputsT  const &... ins)
+        {
+            return std::is_same<MaskT, GraphBLAS::NoMask>::value &&
+                updates_in_place_impl(out, false, ins...);
+        }
+    }
+}
+
 //****************************************************************************
 // New signatures to conform to GraphBLAS Specification
 //****************************************************************************
@@ -92,8 +190,9 @@ namespace GraphBLAS
         check_ncols_ncols(C, B, "mxm: C.ncols != B.ncols");
         check_ncols_nrows(A, B, "mxm: A.ncols != B.nrows");
 
-        backend::mxm(C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
-                     replace_flag);
+        detail::dispatch(detail::backend_mxm(),
+                         C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
+                         replace_flag);
 
         GRB_LOG_VERBOSE("C (Result): " << C.m_mat);
         GRB_LOG_FN_END("mxm - 4.3.1 - matrix-matrix multiply");
@@ -129,8 +228,9 @@ namespace GraphBLAS
         check_size_ncols(w, A, "vxm: w.size != A.ncols");
         check_size_nrows(u, A, "vxm: u.size != A.nrows");
 
-        backend::vxm(w.m_vec, mask.m_vec, accum, op, u.m_vec, A.m_mat,
-                     replace_flag);
+        detail::dispatch(detail::backend_vxm(),
+                         w.m_vec, mask.m_vec, accum, op, u.m_vec, A.m_mat,
+                         replace_flag);
 
         GRB_LOG_VERBOSE("w out :" << w.m_vec);
         GRB_LOG_FN_END("mxm - 4.3.2 - vector-matrix multiply");
@@ -166,8 +266,9 @@ namespace GraphBLAS
         check_size_nrows(w, A, "mxv: w.size != A.nrows");
         check_size_ncols(u, A, "mxv: u.size != A.ncols");
 
-        backend::mxv(w.m_vec, mask.m_vec, accum, op, A.m_mat, u.m_vec,
-                     replace_flag);
+        detail::dispatch(detail::backend_mxv(),
+                         w.m_vec, mask.m_vec, accum, op, A.m_mat, u.m_vec,
+                         replace_flag);
         GRB_LOG_VERBOSE("w out :" << w.m_vec);
         GRB_LOG_FN_END("mxv - 4.3.3 - matrix-vector multiply");
     }
@@ -210,8 +311,9 @@ namespace GraphBLAS
         check_size_size(w, u, "eWiseMult(vec): w.size != u.size");
         check_size_size(u, v, "eWiseMult(vec): u.size != v.size");
 
-        backend::eWiseMult(w.m_vec, mask.m_vec, accum, op, u.m_vec, v.m_vec,
-                           replace_flag);
+        detail::dispatch(detail::backend_eWiseMult(),
+                         w.m_vec, mask.m_vec, accum, op, u.m_vec, v.m_vec,
+                         replace_flag);
 
         GRB_LOG_VERBOSE("w out :" << w.m_vec);
         GRB_LOG_FN_END("eWiseMult - 4.3.4.1 - element-wise vector multiply");
@@ -249,8 +351,17 @@ namespace GraphBLAS
         check_ncols_ncols(A, B, "eWiseMult(mat): A.ncols != B.ncols");
         check_nrows_nrows(A, B, "eWiseMult(mat): A.nrows != B.nrows");
 
-        backend::eWiseMult(C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
-                           replace_flag);
+        if (detail::updates_in_place(Mask, C.m_mat, A.m_mat, B.m_mat))
+        {
+            detail::dispatch(detail::backend_eWiseMult_in_place(),
+                             C.m_mat, accum, op, A.m_mat, B.m_mat);
+        }
+        else
+        {
+            detail::dispatch(detail::backend_eWiseMult(),
+                             C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
+                             replace_flag);
+        }
 
         GRB_LOG_VERBOSE("C out :" << C.m_mat);
         GRB_LOG_FN_END("eWiseMult - 4.3.4.2 - element-wise matrix multiply");
@@ -291,8 +402,9 @@ namespace GraphBLAS
         check_size_size(w, u, "eWiseAdd(vec): w.size != u.size");
         check_size_size(u, v, "eWiseAdd(vec): u.size != v.size");
 
-        backend::eWiseAdd(w.m_vec, mask.m_vec, accum, op, u.m_vec, v.m_vec,
-                          replace_flag);
+        detail::dispatch(detail::backend_eWiseAdd(),
+                         w.m_vec, mask.m_vec, accum, op, u.m_vec, v.m_vec,
+                         replace_flag);
 
         GRB_LOG_VERBOSE("w out :" << w.m_vec);
         GRB_LOG_FN_END("eWiseAdd - 4.3.5.1 - element-wise vector addition");
@@ -330,8 +442,17 @@ namespace GraphBLAS
         check_ncols_ncols(A, B, "eWiseAdd(mat): A.ncols != B.ncols");
         check_nrows_nrows(A, B, "eWiseAdd(mat): A.nrows != B.nrows");
 
-        backend::eWiseAdd(C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
-                          replace_flag);
+        if (detail::updates_in_place(Mask, C.m_mat, A.m_mat, B.m_mat))
+        {
+            detail::dispatch(detail::backend_eWiseAdd_in_place(),
+                             C.m_mat, accum, op, A.m_mat, B.m_mat);
+        }
+        else
+        {
+            detail::dispatch(detail::backend_eWiseAdd(),
+                             C.m_mat, Mask.m_mat, accum, op, A.m_mat, B.m_mat,
+                             replace_flag);
+        }
 
         GRB_LOG_VERBOSE("C out :" << C.m_mat);
         GRB_LOG_FN_END("eWiseAdd - 4.3.5.2 - element-wise matrix addition");
@@ -367,8 +488,9 @@ namespace GraphBLAS
         check_size_nindices(w, indices,
                             "extract(std vec): w.size != indicies.size");
 
-        backend::extract(w.m_vec, mask.m_vec, accum, u.m_vec,
-                         indices, replace_flag);
+        detail::dispatch(detail::backend_extract(),
+                         w.m_vec, mask.m_vec, accum, u.m_vec, indices,
+                         replace_flag);
 
         GRB_LOG_FN_END("extract - 4.3.6.1 - standard vector variant");
     }
@@ -406,8 +528,9 @@ namespace GraphBLAS
         check_ncols_nindices(C, col_indices,
                              "extract(std mat): C.ncols != col_indices");
 
-        backend::extract(C.m_mat, Mask.m_mat, accum, A.m_mat,
-                         row_indices, col_indices, replace_flag);
+        detail::dispatch(detail::backend_extract(),
+                         C.m_mat, Mask.m_mat, accum, A.m_mat, row_indices,
+                         col_indices, replace_flag);
 
         GRB_LOG_FN_END("SEQUENTIAL extract - 4.3.6.2 - standard matrix variant");
     }
@@ -444,7 +567,8 @@ namespace GraphBLAS
         check_index_within_ncols(col_index, A,
                                  "extract(col): col_index >= A.ncols");
 
-        backend::extract(w.m_vec, mask.m_vec, accum, A.m_mat, row_indices,
+        detail::dispatch(detail::backend_extract(),
+                         w.m_vec, mask.m_vec, accum, A.m_mat, row_indices,
                          col_index, replace_flag);
         GRB_LOG_FN_END("extract - 4.3.6.3 - column (and row) variant");
     }
@@ -483,8 +607,9 @@ namespace GraphBLAS
         check_size_nindices(u, indices,
                             "assign(std vec): u.size != |indicies|");
 
-        backend::assign(w.m_vec, mask.m_vec, accum, u.m_vec, indices,
-                        replace_flag);
+        detail::dispatch(detail::backend_assign(),
+                         w.m_vec, mask.m_vec, accum, u.m_vec, indices,
+                         replace_flag);
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
         GRB_LOG_FN_END("assign - 4.3.7.1 - standard vector variant");
@@ -526,8 +651,9 @@ namespace GraphBLAS
         check_ncols_nindices(A, col_indices,
                              "assign(std mat): A.ncols != |col_indices|");
 
-        backend::assign(C.m_mat, Mask.m_mat, accum, A.m_mat,
-                        row_indices, col_indices, replace_flag);
+        detail::dispatch(detail::backend_assign(),
+                         C.m_mat, Mask.m_mat, accum, A.m_mat, row_indices,
+                         col_indices, replace_flag);
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("assign - 4.3.7.2 - standard matrix variant");
@@ -564,8 +690,9 @@ namespace GraphBLAS
         check_index_within_ncols(col_index, C,
                                  "assign(col): col_index >= C.ncols");
 
-        backend::assign(C.m_mat, mask.m_vec, accum, u.m_vec,
-                        row_indices, col_index, replace_flag);
+        detail::dispatch(detail::backend_assign(),
+                         C.m_mat, mask.m_vec, accum, u.m_vec, row_indices,
+                         col_index, replace_flag);
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("assign - 4.3.7.3 - column variant");
@@ -601,8 +728,9 @@ namespace GraphBLAS
         check_index_within_nrows(row_index, C,
                                  "assign(col): row_index >= C.nrows");
 
-        backend::assign(C.m_mat, mask.m_vec, accum, u.m_vec,
-                        row_index, col_indices, replace_flag);
+        detail::dispatch(detail::backend_assign(),
+                         C.m_mat, mask.m_vec, accum, u.m_vec, row_index,
+                         col_indices, replace_flag);
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("assign - 4.3.7.4 - row variant");
@@ -637,8 +765,9 @@ namespace GraphBLAS
         check_nindices_within_size(indices, w,
                                    "assign(const vec): indicies.size !<= w.size");
 
-        backend::assign_constant(w.m_vec, mask.m_vec, accum, val, indices,
-                                 replace_flag);
+        detail::dispatch(detail::backend_assign_constant(),
+                         w.m_vec, mask.m_vec, accum, val, indices,
+                         replace_flag);
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
         GRB_LOG_FN_END("assign - 4.3.7.5 - constant vector variant");
@@ -681,8 +810,9 @@ namespace GraphBLAS
         check_nindices_within_ncols(
             col_indices, C,
             "assign(const mat): indicies.size !<= C.ncols");
-        backend::assign_constant(C.m_mat, Mask.m_mat, accum, val,
-                                 row_indices, col_indices, replace_flag);
+        detail::dispatch(detail::backend_assign_constant(),
+                         C.m_mat, Mask.m_mat, accum, val, row_indices,
+                         col_indices, replace_flag);
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("assign - 4.3.7.6 - constant matrix variant");
@@ -717,7 +847,17 @@ namespace GraphBLAS
         check_size_size(w, mask, "apply(vec): w.size != mask.size");
         check_size_size(w, u, "apply(vec): w.size != u.size");
 
-        backend::apply(w.m_vec, mask.m_vec, accum, op, u.m_vec, replace_flag);
+        if (detail::updates_in_place(mask, w.m_vec, u.m_vec))
+        {
+            detail::dispatch(detail::backend_apply_in_place(),
+                             w.m_vec, accum, op);
+        }
+        else
+        {
+            detail::dispatch(detail::backend_apply(),
+                             w.m_vec, mask.m_vec, accum, op, u.m_vec,
+                             replace_flag);
+        }
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
         GRB_LOG_FN_END("assign - 4.3.8.1 - vector variant");
@@ -751,7 +891,17 @@ namespace GraphBLAS
         check_ncols_ncols(C, A, "apply(mat): C.ncols != A.ncols");
         check_nrows_nrows(C, A, "apply(mat): C.nrows != A.nrows");
 
-        backend::apply(C.m_mat, Mask.m_mat, accum, op, A.m_mat, replace_flag);
+        if (detail::updates_in_place(Mask, C.m_mat, A.m_mat))
+        {
+            detail::dispatch(detail::backend_apply_in_place(),
+                             C.m_mat, accum, op);
+        }
+        else
+        {
+            detail::dispatch(detail::backend_apply(),
+                             C.m_mat, Mask.m_mat, accum, op, A.m_mat,
+                             replace_flag);
+        }
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("apply - 4.3.8.2 - matrix variant");
@@ -786,7 +936,9 @@ namespace GraphBLAS
         check_size_size(w, mask, "reduce(mat2vec): w.size != mask.size");
         check_size_nrows(w, A, "reduce(mat2vec): w.size != A.nrows");
 
-        backend::reduce(w.m_vec, mask.m_vec, accum, op, A.m_mat, replace_flag);
+        detail::dispatch(detail::backend_reduce(),
+                         w.m_vec, mask.m_vec, accum, op, A.m_mat,
+                         replace_flag);
 
         GRB_LOG_VERBOSE("w out: " << w.m_vec);
         GRB_LOG_FN_END("reduce - 4.3.9.1 - matrix to vector variant");
@@ -810,7 +962,8 @@ namespace GraphBLAS
         GRB_LOG_VERBOSE_OP(op);
         GRB_LOG_VERBOSE("u in: " << u.m_vec);
 
-        backend::reduce_vector_to_scalar(val, accum, op, u.m_vec);
+        detail::dispatch_blocking(detail::backend_reduce_vector_to_scalar(),
+                                  val, accum, op, u.m_vec);
 
         GRB_LOG_VERBOSE("val out: " << val);
         GRB_LOG_FN_END("reduce - 4.3.9.2 - vector to scalar variant");
@@ -836,7 +989,8 @@ namespace GraphBLAS
         GRB_LOG_VERBOSE_OP(op);
         GRB_LOG_VERBOSE("A in: " << A.m_mat);
 
-        backend::reduce_matrix_to_scalar(val, accum, op, A.m_mat);
+        detail::dispatch_blocking(detail::backend_reduce_matrix_to_scalar(),
+                                  val, accum, op, A.m_mat);
 
         GRB_LOG_VERBOSE("val out: " << val);
         GRB_LOG_FN_END("reduce - 4.3.9.3 - matrix to scalar variant");
@@ -869,7 +1023,8 @@ namespace GraphBLAS
         check_ncols_nrows(C, A, "transpose: C.ncols != A.nrows");
         check_ncols_nrows(A, C, "transpose: A.ncols != C.nrows");
 
-        backend::transpose(C.m_mat, Mask.m_mat, accum, A.m_mat, replace_flag);
+        detail::dispatch(detail::backend_transpose(),
+                         C.m_mat, Mask.m_mat, accum, A.m_mat, replace_flag);
 
         GRB_LOG_VERBOSE("C out: " << C.m_mat);
         GRB_LOG_FN_END("transpose - 4.3.10");
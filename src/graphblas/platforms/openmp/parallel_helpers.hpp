@@ -0,0 +1,911 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Thread control and the parallel building blocks shared by the OpenMP
+ * backend's operations.  Each row (or element) of a result is computed by
+ * exactly one thread in the same way as in the sequential backend, so the
+ * results do not depend on the number of threads.  The exception is a row
+ * heavy enough to be split between threads (see partition_rows): its pieces
+ * are combined in column order, which changes the order of floating point
+ * sums but not integer results.
+ */
+
+#ifndef GB_OPENMP_PARALLEL_HELPERS_HPP
+#define GB_OPENMP_PARALLEL_HELPERS_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+#include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/TransposeView.hpp>
+#include <graphblas/platforms/sequential/Workspace.hpp>
+#include <graphblas/platforms/sequential/sparse_helpers.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /// Rows handed to a thread at a time by the dynamically scheduled
+        /// row loops.
+        static constexpr IndexType PARALLEL_ROW_CHUNK = 64;
+
+        /// Blocks of about equal work made for each thread by
+        /// partition_rows (more than one so that threads that finish early
+        /// can take another).
+        static constexpr IndexType BLOCKS_PER_THREAD = 4;
+
+        //********************************************************************
+        /**
+         * @brief Set the number of threads used by subsequent operations
+         *        (the default comes from OMP_NUM_THREADS or the number of
+         *        cores).
+         */
+        inline void set_num_threads(int num_threads)
+        {
+#ifdef _OPENMP
+            omp_set_num_threads(std::max(num_threads, 1));
+#endif
+        }
+
+        /// The number of threads subsequent operations will use.
+        inline int get_num_threads()
+        {
+#ifdef _OPENMP
+            return omp_get_max_threads();
+#else
+            return 1;
+#endif
+        }
+
+        /// The number of the calling thread within its team.
+        inline int get_thread_num()
+        {
+#ifdef _OPENMP
+            return omp_get_thread_num();
+#else
+            return 0;
+#endif
+        }
+
+        /// The number of threads in the calling thread's team.
+        inline int get_team_size()
+        {
+#ifdef _OPENMP
+            return omp_get_num_threads();
+#else
+            return 1;
+#endif
+        }
+
+        //********************************************************************
+        /// The rows of a matrix under construction, one vector per row.
+        template <typename ScalarT>
+        using RowSet = std::vector<std::vector<std::tuple<IndexType, ScalarT> > >;
+
+        //********************************************************************
+        /// Replace every row of T with the corresponding row of rows.
+        template <typename MatrixT, typename ScalarT>
+        void install_rows(MatrixT &T, RowSet<ScalarT> &rows)
+        {
+            for (IndexType row_idx = 0; row_idx < rows.size(); ++row_idx)
+            {
+                T.setRow(row_idx, std::move(rows[row_idx]));
+            }
+        }
+
+        //********************************************************************
+        /**
+         * @brief Compute the rows of T in parallel and then install them.
+         *
+         * @param[in,out] T       Its rows are all replaced.
+         * @param[in]     row_fn  row_fn(row_idx, row) fills the (empty) row.
+         */
+        template <typename MatrixT, typename RowFunctionT>
+        void parallel_build_rows(MatrixT &T, RowFunctionT row_fn)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+
+            IndexType nrows(T.nrows());
+            RowSet<ScalarType> rows(nrows);
+
+#pragma omp parallel for schedule(dynamic, PARALLEL_ROW_CHUNK)
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                row_fn(row_idx, rows[row_idx]);
+            }
+
+            install_rows(T, rows);
+        }
+
+        //********************************************************************
+        /**
+         * @brief Call fn(idx, part) for every idx in [0, n) in parallel and
+         *        concatenate what the calls append to their part in index
+         *        order.
+         *
+         * Each thread is given one contiguous block of indices (static
+         * schedule), so concatenating the parts in thread order keeps the
+         * result in index order.
+         */
+        template <typename ElementT, typename FunctionT>
+        void parallel_gather(std::vector<ElementT> &result,
+                             IndexType              n,
+                             FunctionT              fn)
+        {
+            std::vector<std::vector<ElementT> > parts(get_num_threads());
+
+#pragma omp parallel num_threads(parts.size())
+            {
+                std::vector<ElementT> &part(parts[get_thread_num()]);
+
+#pragma omp for schedule(static)
+                for (IndexType idx = 0; idx < n; ++idx)
+                {
+                    fn(idx, part);
+                }
+            }
+
+            result.clear();
+            for (auto const &part : parts)
+            {
+                result.insert(result.end(), part.begin(), part.end());
+            }
+        }
+
+        //********************************************************************
+        /**
+         * @brief The stored values of a row whose column index is in
+         *        [col_begin, col_end), usable wherever a row is.
+         */
+        template <typename RowT>
+        class RowSlice
+        {
+        public:
+            typedef typename RowT::value_type     value_type;
+            typedef typename RowT::const_iterator const_iterator;
+
+            RowSlice(RowT const &row, IndexType col_begin, IndexType col_end)
+                : m_begin(lower_bound_col(row, col_begin)),
+                  m_end(lower_bound_col(row, col_end))
+            {
+            }
+
+            const_iterator begin() const { return m_begin; }
+            const_iterator end()   const { return m_end; }
+            bool           empty() const { return m_begin == m_end; }
+
+        private:
+            static const_iterator lower_bound_col(RowT const &row, IndexType col)
+            {
+                return std::lower_bound(
+                    row.begin(), row.end(), col,
+                    [](value_type const &tupl, IndexType idx)
+                    { return std::get<0>(tupl) < idx; });
+            }
+
+            const_iterator m_begin;
+            const_iterator m_end;
+        };
+
+        template <typename RowT>
+        RowSlice<RowT> row_slice(RowT const &row,
+                                 IndexType   col_begin,
+                                 IndexType   col_end)
+        {
+            return RowSlice<RowT>(row, col_begin, col_end);
+        }
+
+        //********************************************************************
+        /// The stored values before each row of a matrix (see
+        /// LilSparseMatrix::row_nnz_prefix): the matrix's cached copy.
+        template <typename MatrixT>
+        std::vector<IndexType> const &row_nnz_prefix(MatrixT const          &A,
+                                                     std::vector<IndexType> &)
+        {
+            return A.row_nnz_prefix();
+        }
+
+        /// The stored values before each row of a transpose, computed into
+        /// buf from the columns of the underlying matrix.
+        template <typename MatrixT>
+        std::vector<IndexType> const &row_nnz_prefix(
+            TransposeView<MatrixT> const &A,
+            std::vector<IndexType>       &buf)
+        {
+            buf.assign(A.nrows() + 1, 0);
+            for (IndexType col_idx = 0; col_idx < A.ncols(); ++col_idx)
+            {
+                for (auto const &elt : A.getCol(col_idx))
+                {
+                    ++buf[std::get<0>(elt) + 1];
+                }
+            }
+            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            {
+                buf[row_idx + 1] += buf[row_idx];
+            }
+            return buf;
+        }
+
+        //********************************************************************
+        /**
+         * @brief A unit of work of a row loop: a range of whole rows, or one
+         *        piece (a range of columns) of a row split between threads.
+         */
+        struct RowBlock
+        {
+            IndexType row_begin;
+            IndexType row_end;
+            IndexType col_begin;
+            IndexType col_end;
+            bool      split;
+        };
+
+        /**
+         * @brief Divide the rows into blocks of about equal work.
+         *
+         * Rows are grouped so that each block holds about the same share of
+         * the total work, and a row with more than twice that share is split
+         * into pieces.
+         *
+         * @param[out] blocks       The blocks, in row (and column) order.
+         * @param[in]  work_prefix  work_prefix[i] is the work of rows [0, i)
+         *                          (one element more than there are rows).
+         * @param[in]  split_row    split_row(row_idx, num_pieces, bounds)
+         *                          fills bounds with num_pieces + 1 increasing
+         *                          column bounds, from 0 to the number of
+         *                          columns, dividing the work of the row.
+         * @param[in]  allow_split  Whether heavy rows may be split.  The
+         *                          products and reductions split rows only
+         *                          in the FAST reduction mode, since the
+         *                          pieces depend on the number of threads.
+         */
+        template <typename SplitFunctionT>
+        void partition_rows(std::vector<RowBlock>        &blocks,
+                            std::vector<IndexType> const &work_prefix,
+                            SplitFunctionT                split_row,
+                            bool                          allow_split = true)
+        {
+            blocks.clear();
+
+            IndexType nrows(work_prefix.size() - 1);
+            IndexType num_threads(get_num_threads());
+            IndexType num_blocks(num_threads*BLOCKS_PER_THREAD);
+
+            // Every row costs at least one unit so that runs of empty rows
+            // are divided as well.
+            IndexType total(work_prefix.back() + nrows);
+            IndexType target(std::max<IndexType>(
+                                 1, (total + num_blocks - 1)/num_blocks));
+
+            ScratchBuffer<IndexType> bounds_buf;
+            auto &bounds(bounds_buf.get());
+
+            IndexType row_begin(0);
+            IndexType block_work(0);
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                IndexType row_work(work_prefix[row_idx + 1] -
+                                   work_prefix[row_idx] + 1);
+
+                if (allow_split && (num_threads > 1) && (row_work > 2*target))
+                {
+                    if (row_begin < row_idx)
+                    {
+                        blocks.push_back({row_begin, row_idx, 0, 0, false});
+                    }
+
+                    IndexType num_pieces(
+                        std::min((row_work + target - 1)/target, num_blocks));
+                    bounds.clear();
+                    split_row(row_idx, num_pieces, bounds);
+                    for (IndexType piece = 0; piece + 1 < bounds.size(); ++piece)
+                    {
+                        if (bounds[piece] < bounds[piece + 1])
+                        {
+                            blocks.push_back({row_idx, row_idx + 1,
+                                              bounds[piece], bounds[piece + 1],
+                                              true});
+                        }
+                    }
+
+                    row_begin = row_idx + 1;
+                    block_work = 0;
+                }
+                else
+                {
+                    block_work += row_work;
+                    if (block_work >= target)
+                    {
+                        blocks.push_back({row_begin, row_idx + 1, 0, 0, false});
+                        row_begin = row_idx + 1;
+                        block_work = 0;
+                    }
+                }
+            }
+
+            if (row_begin < nrows)
+            {
+                blocks.push_back({row_begin, nrows, 0, 0, false});
+            }
+        }
+
+        /// Divide the rows into blocks of about equal work without
+        /// splitting any row.
+        inline void partition_rows(std::vector<RowBlock>        &blocks,
+                                   std::vector<IndexType> const &work_prefix)
+        {
+            partition_rows(blocks, work_prefix,
+                           [](IndexType, IndexType, std::vector<IndexType> &) {},
+                           false);
+        }
+
+        //********************************************************************
+        /**
+         * @brief Column bounds dividing a row into pieces of about equal
+         *        work, where element_work(elt) is the work of one stored
+         *        value.
+         */
+        template <typename RowT, typename ElementWorkT>
+        void split_by_element_work(std::vector<IndexType> &bounds,
+                                   RowT             const &row,
+                                   IndexType               num_pieces,
+                                   IndexType               ncols,
+                                   ElementWorkT            element_work)
+        {
+            IndexType total(0);
+            for (auto const &elt : row)
+            {
+                total += element_work(elt);
+            }
+
+            bounds.clear();
+            bounds.push_back(0);
+
+            IndexType done(0);
+            IndexType piece(1);
+            for (auto const &elt : row)
+            {
+                if ((piece < num_pieces) && (done >= total*piece/num_pieces))
+                {
+                    if (std::get<0>(elt) > bounds.back())
+                    {
+                        bounds.push_back(std::get<0>(elt));
+                    }
+                    ++piece;
+                }
+                done += element_work(elt);
+            }
+
+            bounds.push_back(ncols);
+        }
+
+        /// Column bounds dividing a row into pieces with about the same
+        /// number of stored values.
+        template <typename RowT>
+        void split_by_elements(std::vector<IndexType> &bounds,
+                               RowT             const &row,
+                               IndexType               num_pieces,
+                               IndexType               ncols)
+        {
+            split_by_element_work(
+                bounds, row, num_pieces, ncols,
+                [](typename RowT::value_type const &) { return IndexType(1); });
+        }
+
+        //********************************************************************
+        /**
+         * @brief Blocks for an element-wise operation on the rows of A and
+         *        B: the work of a row is its number of stored values in both,
+         *        and a heavy row is split by the stored values of the longer
+         *        of its two rows.
+         */
+        template <typename AMatrixT, typename BMatrixT>
+        void partition_ewise_rows(std::vector<RowBlock> &blocks,
+                                  AMatrixT        const &A,
+                                  BMatrixT        const &B)
+        {
+            std::vector<IndexType> a_buf, b_buf;
+            std::vector<IndexType> const &a_prefix(row_nnz_prefix(A, a_buf));
+            std::vector<IndexType> const &b_prefix(row_nnz_prefix(B, b_buf));
+
+            ScratchBuffer<IndexType> work_buf;
+            auto &work_prefix(work_buf.get());
+            work_prefix.resize(a_prefix.size());
+            for (IndexType idx = 0; idx < a_prefix.size(); ++idx)
+            {
+                work_prefix[idx] = a_prefix[idx] + b_prefix[idx];
+            }
+
+            partition_rows(
+                blocks, work_prefix,
+                [&](IndexType row_idx, IndexType num_pieces,
+                    std::vector<IndexType> &bounds)
+                {
+                    if (a_prefix[row_idx + 1] - a_prefix[row_idx] >=
+                        b_prefix[row_idx + 1] - b_prefix[row_idx])
+                    {
+                        split_by_elements(bounds, A.getRow(row_idx),
+                                          num_pieces, A.ncols());
+                    }
+                    else
+                    {
+                        split_by_elements(bounds, B.getRow(row_idx),
+                                          num_pieces, B.ncols());
+                    }
+                });
+        }
+
+        //********************************************************************
+        /**
+         * @brief Run a row loop over blocks made by partition_rows.
+         *
+         * @param[in] row_fn    row_fn(row_idx, part) for each row of a block
+         *                      of whole rows; part is the block's output.
+         * @param[in] piece_fn  piece_fn(row_idx, col_begin, col_end, partial)
+         *                      for each piece of a split row.
+         * @param[in] merge_fn  merge_fn(row_idx, partials, part) once all of
+         *                      the pieces of a split row are done; partials
+         *                      are in column order.
+         *
+         * @return One output (part) per block, in row order.
+         */
+        template <typename PartT,
+                  typename RowFunctionT,
+                  typename PieceFunctionT,
+                  typename MergeFunctionT>
+        void parallel_for_blocks(std::vector<PartT>          &parts,
+                                 std::vector<RowBlock> const &blocks,
+                                 RowFunctionT                 row_fn,
+                                 PieceFunctionT               piece_fn,
+                                 MergeFunctionT               merge_fn)
+        {
+            IndexType num_blocks(blocks.size());
+            parts.clear();
+            parts.resize(num_blocks);
+
+#pragma omp parallel for schedule(dynamic, 1)
+            for (IndexType block_idx = 0; block_idx < num_blocks; ++block_idx)
+            {
+                RowBlock const &block(blocks[block_idx]);
+                if (block.split)
+                {
+                    piece_fn(block.row_begin, block.col_begin, block.col_end,
+                             parts[block_idx]);
+                }
+                else
+                {
+                    for (IndexType row_idx = block.row_begin;
+                         row_idx < block.row_end;
+                         ++row_idx)
+                    {
+                        row_fn(row_idx, parts[block_idx]);
+                    }
+                }
+            }
+
+            // The pieces of each split row are consecutive blocks; merge them
+            // into the part of the first one.
+            std::vector<IndexType> first_pieces;
+            for (IndexType block_idx = 0; block_idx < num_blocks; ++block_idx)
+            {
+                if (blocks[block_idx].split &&
+                    ((block_idx == 0) || !blocks[block_idx - 1].split ||
+                     (blocks[block_idx - 1].row_begin !=
+                      blocks[block_idx].row_begin)))
+                {
+                    first_pieces.push_back(block_idx);
+                }
+            }
+
+            IndexType num_split_rows(first_pieces.size());
+#pragma omp parallel for schedule(dynamic, 1)
+            for (IndexType split_idx = 0; split_idx < num_split_rows; ++split_idx)
+            {
+                IndexType first(first_pieces[split_idx]);
+                IndexType row_idx(blocks[first].row_begin);
+
+                std::vector<PartT> partials;
+                for (IndexType block_idx = first;
+                     (block_idx < num_blocks) && blocks[block_idx].split &&
+                         (blocks[block_idx].row_begin == row_idx);
+                     ++block_idx)
+                {
+                    partials.push_back(std::move(parts[block_idx]));
+                    parts[block_idx].clear();
+                }
+
+                merge_fn(row_idx, partials, parts[first]);
+            }
+        }
+
+        //********************************************************************
+        /**
+         * @brief parallel_gather over blocks made by partition_rows: the
+         *        elements of each row are appended by row_fn, or made by
+         *        piece_fn and merge_fn for a split row.
+         */
+        template <typename ElementT,
+                  typename RowFunctionT,
+                  typename PieceFunctionT,
+                  typename MergeFunctionT>
+        void parallel_gather(std::vector<ElementT>       &result,
+                             std::vector<RowBlock> const &blocks,
+                             RowFunctionT                 row_fn,
+                             PieceFunctionT               piece_fn,
+                             MergeFunctionT               merge_fn)
+        {
+            std::vector<std::vector<ElementT> > parts;
+            parallel_for_blocks(parts, blocks, row_fn, piece_fn, merge_fn);
+
+            result.clear();
+            for (auto const &part : parts)
+            {
+                result.insert(result.end(), part.begin(), part.end());
+            }
+        }
+
+        /**
+         * @brief parallel_build_rows over blocks made by partition_rows: a
+         *        split row is built by piece_fn(row_idx, col_begin, col_end,
+         *        piece) for each of its column ranges and the pieces are
+         *        joined.
+         */
+        template <typename MatrixT,
+                  typename RowFunctionT,
+                  typename PieceFunctionT>
+        void parallel_build_rows(MatrixT                     &T,
+                                 std::vector<RowBlock> const &blocks,
+                                 RowFunctionT                 row_fn,
+                                 PieceFunctionT               piece_fn)
+        {
+            typedef typename MatrixT::ScalarType ScalarType;
+            typedef std::vector<std::tuple<IndexType, ScalarType> > RowType;
+
+            RowSet<ScalarType> rows(T.nrows());
+            std::vector<RowType> unused;
+            parallel_for_blocks(
+                unused, blocks,
+                [&](IndexType row_idx, RowType &) { row_fn(row_idx, rows[row_idx]); },
+                piece_fn,
+                [&](IndexType row_idx, std::vector<RowType> &pieces, RowType &)
+                {
+                    for (auto const &piece : pieces)
+                    {
+                        rows[row_idx].insert(rows[row_idx].end(),
+                                             piece.begin(), piece.end());
+                    }
+                });
+
+            install_rows(T, rows);
+        }
+
+        /**
+         * @brief merge_fn for row loops that compute one value per row: the
+         *        values of the pieces that have one are combined with add, in
+         *        column order.
+         */
+        template <typename D3, typename AddT>
+        void merge_piece_values(
+            IndexType                                                 row_idx,
+            std::vector<std::vector<std::tuple<IndexType, D3> > > const &partials,
+            std::vector<std::tuple<IndexType, D3> >                  &part,
+            AddT                                                      add)
+        {
+            bool value_set(false);
+            D3 value;
+            for (auto const &partial : partials)
+            {
+                if (!partial.empty())
+                {
+                    value = (value_set ?
+                             static_cast<D3>(add(value, std::get<1>(partial[0]))) :
+                             std::get<1>(partial[0]));
+                    value_set = true;
+                }
+            }
+
+            if (value_set)
+            {
+                part.push_back(std::make_tuple(row_idx, value));
+            }
+        }
+
+        //********************************************************************
+        /**
+         * @brief Parallel version of push_products: each thread owns a range
+         *        of the result and pushes every stored element of u through
+         *        the part of its slice that falls in that range.
+         *
+         * Every element of t is summed over increasing u index, exactly as in
+         * the sequential backend.
+         */
+        template <typename D3,
+                  typename UVectorT,
+                  typename SliceFunctionT,
+                  typename MultiplyT,
+                  typename SemiringT>
+        void parallel_push_products(std::vector<std::tuple<IndexType, D3> > &t,
+                                    IndexType                                t_size,
+                                    UVectorT                          const &u,
+                                    SliceFunctionT                           slice,
+                                    MultiplyT                                mult,
+                                    SemiringT                                op)
+        {
+            RowSet<D3> parts(get_num_threads());
+
+#pragma omp parallel num_threads(parts.size())
+            {
+                IndexType tid(get_thread_num());
+                IndexType num_threads(get_team_size());
+                IndexType lo(t_size*tid/num_threads);
+                IndexType hi(t_size*(tid + 1)/num_threads);
+
+                ScratchBuffer<D3> acc_buf;
+                auto &acc(acc_buf.get());
+                ScratchBuffer<bool> acc_set_buf;
+                auto &acc_set(acc_set_buf.get());
+                acc.assign(hi - lo, op.zero());
+                acc_set.assign(hi - lo, false);
+
+                for (auto u_it = u.begin(); u_it != u.end(); ++u_it)
+                {
+                    auto const &slice_k(slice(std::get<0>(*u_it)));
+                    auto elt = std::lower_bound(
+                        slice_k.begin(), slice_k.end(), lo,
+                        [](typename std::decay<decltype(slice_k)>::type::value_type const &tupl,
+                           IndexType idx)
+                        { return std::get<0>(tupl) < idx; });
+
+                    for (; (elt != slice_k.end()) && (std::get<0>(*elt) < hi);
+                         ++elt)
+                    {
+                        IndexType idx(std::get<0>(*elt) - lo);
+                        acc[idx] = op.add(acc[idx],
+                                          mult(std::get<1>(*u_it),
+                                               std::get<1>(*elt)));
+                        acc_set[idx] = true;
+                    }
+                }
+
+                for (IndexType idx = 0; idx < hi - lo; ++idx)
+                {
+                    if (acc_set[idx])
+                    {
+                        parts[tid].push_back(
+                            std::make_tuple(lo + idx, static_cast<D3>(acc[idx])));
+                    }
+                }
+            }
+
+            t.clear();
+            for (auto const &part : parts)
+            {
+                t.insert(t.end(), part.begin(), part.end());
+            }
+        }
+
+        //********************************************************************
+        // Parallel versions of the accumulate and mask write-back steps of
+        // sparse_helpers.hpp (Matrix versions).  The vector versions are used
+        // as they are.
+        //********************************************************************
+
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename BinaryOpT >
+        void parallel_ewise_or_opt_accum(ZMatrixT         &Z,
+                                         CMatrixT const   &C,
+                                         TMatrixT const   &T,
+                                         BinaryOpT         accum)
+        {
+            typedef typename ZMatrixT::ScalarType ZScalarType;
+
+            parallel_build_rows(
+                Z,
+                [&](IndexType row_idx,
+                    std::vector<std::tuple<IndexType, ZScalarType> > &z_row)
+                {
+                    ewise_or(z_row, C.getRow(row_idx), T.getRow(row_idx), accum);
+                });
+        }
+
+        // No accumulator: Z is just T (copied or moved, nothing to compute)
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TMatrixT>
+        void parallel_ewise_or_opt_accum(ZMatrixT                    &Z,
+                                         CMatrixT const              &C,
+                                         TMatrixT const              &T,
+                                         GraphBLAS::NoAccumulate      accum)
+        {
+            ewise_or_opt_accum(Z, C, T, accum);
+        }
+
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TScalarT>
+        void parallel_ewise_or_opt_accum(ZMatrixT                      &Z,
+                                         CMatrixT const                &C,
+                                         LilSparseMatrix<TScalarT>    &&T,
+                                         GraphBLAS::NoAccumulate        accum)
+        {
+            ewise_or_opt_accum(Z, C, std::move(T), accum);
+        }
+
+        //********************************************************************
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename RowSequenceT,
+                   typename ColSequenceT,
+                   typename BinaryOpT >
+        void parallel_ewise_or_stencil_opt_accum(ZMatrixT           &Z,
+                                                 CMatrixT const     &C,
+                                                 TMatrixT const     &T,
+                                                 RowSequenceT const &row_indices,
+                                                 ColSequenceT const &col_indices,
+                                                 BinaryOpT           accum)
+        {
+            // If there is an accumulate operations, do nothing with the stencil
+            parallel_ewise_or_opt_accum(Z, C, T, accum);
+        }
+
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TMatrixT,
+                   typename RowSequenceT,
+                   typename ColSequenceT>
+        void parallel_ewise_or_stencil_opt_accum(ZMatrixT           &Z,
+                                                 CMatrixT const     &C,
+                                                 TMatrixT const     &T,
+                                                 RowSequenceT const &row_indices,
+                                                 ColSequenceT const &col_indices,
+                                                 GraphBLAS::NoAccumulate)
+        {
+            // If there is no accumulate we need to annihilate stored values
+            // in C that fall in the stencil
+            typedef typename ZMatrixT::ScalarType ZScalarType;
+
+            parallel_build_rows(
+                Z,
+                [&](IndexType row_idx,
+                    std::vector<std::tuple<IndexType, ZScalarType> > &z_row)
+                {
+                    if (searchIndices(row_indices, row_idx))
+                    {
+                        ewise_or_stencil(z_row, C.getRow(row_idx),
+                                         T.getRow(row_idx), col_indices);
+                    }
+                    else
+                    {
+                        // Row not stenciled, take the row from C only
+                        for (auto const &elt : C.getRow(row_idx))
+                        {
+                            z_row.push_back(std::make_tuple(
+                                std::get<0>(elt),
+                                static_cast<ZScalarType>(std::get<1>(elt))));
+                        }
+                    }
+                });
+        }
+
+        //********************************************************************
+        template < typename CMatrixT,
+                   typename ZMatrixT,
+                   typename MMatrixT>
+        void parallel_write_with_opt_mask(CMatrixT           &C,
+                                          ZMatrixT   const   &Z,
+                                          MMatrixT   const   &mask,
+                                          bool                replace)
+        {
+            typedef typename CMatrixT::ScalarType CScalarType;
+
+            // The rows of C are only read until all of the new rows are built
+            parallel_build_rows(
+                C,
+                [&](IndexType row_idx,
+                    std::vector<std::tuple<IndexType, CScalarType> > &c_row)
+                {
+                    apply_with_mask(c_row, C.getRow(row_idx), Z.getRow(row_idx),
+                                    mask.getRow(row_idx), replace);
+                });
+        }
+
+        // No mask: C is just Z (copied or moved, nothing to compute)
+        template < typename CMatrixT,
+                   typename ZMatrixT >
+        void parallel_write_with_opt_mask(CMatrixT                   &C,
+                                          ZMatrixT           const   &Z,
+                                          backend::NoMask    const   &mask,
+                                          bool                        replace)
+        {
+            write_with_opt_mask(C, Z, mask, replace);
+        }
+
+        template < typename CMatrixT,
+                   typename ZScalarT >
+        void parallel_write_with_opt_mask(CMatrixT                     &C,
+                                          LilSparseMatrix<ZScalarT>   &&Z,
+                                          backend::NoMask    const     &mask,
+                                          bool                          replace)
+        {
+            write_with_opt_mask(C, std::move(Z), mask, replace);
+        }
+
+        //********************************************************************
+        /// Parallel opt_accum_and_write: with no accumulator the temporary T
+        /// is written directly and no Z matrix is made.
+        template < typename CMatrixT,
+                   typename TScalarT,
+                   typename MaskT,
+                   typename AccumT >
+        void parallel_opt_accum_and_write(CMatrixT                     &C,
+                                          LilSparseMatrix<TScalarT>   &&T,
+                                          MaskT                const   &mask,
+                                          AccumT                        accum,
+                                          bool                          replace)
+        {
+            typedef typename AccumT::result_type ZScalarType;
+
+            LilSparseMatrix<ZScalarType> Z(C.nrows(), C.ncols());
+            parallel_ewise_or_opt_accum(Z, C, std::move(T), accum);
+            parallel_write_with_opt_mask(C, std::move(Z), mask, replace);
+        }
+
+        template < typename CMatrixT,
+                   typename TScalarT,
+                   typename MaskT >
+        void parallel_opt_accum_and_write(CMatrixT                     &C,
+                                          LilSparseMatrix<TScalarT>   &&T,
+                                          MaskT                const   &mask,
+                                          GraphBLAS::NoAccumulate,
+                                          bool                          replace)
+        {
+            parallel_write_with_opt_mask(C, std::move(T), mask, replace);
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif // GB_OPENMP_PARALLEL_HELPERS_HPP
@@ -0,0 +1,211 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementations of all GraphBLAS functions optimized for the OpenMP
+ * (multicore CPU) backend.
+ */
+
+#ifndef GB_OPENMP_SPARSE_EWISEADD_HPP
+#define GB_OPENMP_SPARSE_EWISEADD_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+#include <graphblas/platforms/sequential/sparse_helpers.hpp>
+#include <graphblas/platforms/openmp/parallel_helpers.hpp>
+#include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Implementation of 4.3.5.1 eWiseAdd: Vector variant
+        template<typename WScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename BinaryOpT,  //can be BinaryOp, Monoid (not Semiring)
+                 typename UVectorT,
+                 typename VVectorT,
+                 typename ...WTagsT>
+        inline void eWiseAdd(
+            GraphBLAS::backend::Vector<WScalarT, WTagsT...> &w,
+            MaskT                                     const &mask,
+            AccumT                                           accum,
+            BinaryOpT                                        op,
+            UVectorT                                  const &u,
+            VVectorT                                  const &v,
+            bool                                             replace_flag = false)
+        {
+            // =================================================================
+            // Do the basic ewise-and work: T = A .* B
+            typedef typename BinaryOpT::result_type D3ScalarType;
+            ScratchRow<D3ScalarType> t_contents_buf;
+            auto &t_contents(t_contents_buf.get());
+
+            if ((u.nvals() > 0) || (v.nvals() > 0))
+            {
+                ewise_or(t_contents, u, v, op);
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            ScratchRow<WScalarT> z_contents_buf;
+            auto &z_contents(z_contents_buf.get());
+            ewise_or_opt_accum_1D(z_contents, w, t_contents, accum);
+
+            // =================================================================
+            // Copy Z into the final output considering mask and replace
+            write_with_opt_mask_1D(w, z_contents, mask, replace_flag);
+        }
+
+        //**********************************************************************
+        /// Implementation of 4.3.5.2 eWiseAdd: Matrix variant
+        template<typename CScalarT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename BinaryOpT,  //can be BinaryOp, Monoid (not Semiring)
+                 typename AMatrixT,
+                 typename BMatrixT,
+                 typename ...CTagsT>
+        inline void eWiseAdd(
+            GraphBLAS::backend::Matrix<CScalarT, CTagsT...> &C,
+            MaskT                                     const &Mask,
+            AccumT                                           accum,
+            BinaryOpT                                        op,
+            AMatrixT                                  const &A,
+            BMatrixT                                  const &B,
+            bool                                             replace_flag = false)
+        {
+            IndexType num_rows(A.nrows());
+            IndexType num_cols(A.ncols());
+
+            typedef typename AMatrixT::ScalarType AScalarType;
+            typedef typename BMatrixT::ScalarType BScalarType;
+
+            typedef std::vector<std::tuple<IndexType,AScalarType> > ARowType;
+            typedef std::vector<std::tuple<IndexType,BScalarType> > BRowType;
+            typedef std::vector<std::tuple<IndexType,CScalarT> > CRowType;
+
+            // =================================================================
+            // Do the basic ewise-and work: T = A .* B
+            typedef typename BinaryOpT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,D3ScalarType> > TRowType;
+            LilSparseMatrix<D3ScalarType> T(num_rows, num_cols);
+
+            if ((A.nvals() > 0) || (B.nvals() > 0))
+            {
+                // create the rows of the result in parallel, balanced by
+                // their number of stored values
+                std::vector<RowBlock> blocks;
+                partition_ewise_rows(blocks, A, B);
+
+                parallel_build_rows(
+                    T, blocks,
+                    [&](IndexType row_idx, TRowType &T_row)
+                    {
+                        ARowType const &A_row(A.getRow(row_idx));
+                        BRowType const &B_row(B.getRow(row_idx));
+
+                        ewise_or(T_row, A_row, B_row, op);
+                    },
+                    [&](IndexType row_idx, IndexType col_begin,
+                        IndexType col_end, TRowType &T_piece)
+                    {
+                        ARowType const &A_row(A.getRow(row_idx));
+                        BRowType const &B_row(B.getRow(row_idx));
+
+                        ewise_or(T_piece,
+                                 row_slice(A_row, col_begin, col_end),
+                                 row_slice(B_row, col_begin, col_end),
+                                 op);
+                    });
+            }
+
+            // =================================================================
+            // Accumulate into Z
+
+            LilSparseMatrix<CScalarT> Z(num_rows, num_cols);
+            parallel_ewise_or_opt_accum(Z, C, std::move(T), accum);
+
+            // =================================================================
+            // Copy Z into the final output considering mask and replace
+            parallel_write_with_opt_mask(C, std::move(Z), Mask, replace_flag);
+        } // ewisemult
+
+        //**********************************************************************
+        /// eWiseAdd with no mask whose output is also one of its inputs.
+        /// Row i of the result depends only on row i of C, A and B, so C is
+        /// rewritten a row at a time instead of through T and Z matrices.
+        /// The frontend only calls this when neither input reads C through
+        /// a view.
+        template<typename CScalarT,
+                 typename AccumT,
+                 typename BinaryOpT,
+                 typename AMatrixT,
+                 typename BMatrixT,
+                 typename ...CTagsT>
+        inline void eWiseAdd_in_place(
+            GraphBLAS::backend::Matrix<CScalarT, CTagsT...> &C,
+            AccumT                                           accum,
+            BinaryOpT                                        op,
+            AMatrixT                                  const &A,
+            BMatrixT                                  const &B)
+        {
+            typedef typename BinaryOpT::result_type D3ScalarType;
+            typedef std::vector<std::tuple<IndexType,CScalarT> > CRowType;
+
+            // The rows of C are only read until all of the new rows are made.
+            parallel_build_rows(
+                C,
+                [&](IndexType row_idx, CRowType &z_row)
+                {
+                    ScratchRow<D3ScalarType> T_row_buf;
+                    auto &T_row(T_row_buf.get());
+                    ewise_or(T_row, A.getRow(row_idx), B.getRow(row_idx), op);
+                    ewise_or_opt_accum_1D(z_row, C.getRow(row_idx), T_row,
+                                          accum);
+                });
+        } // eWiseAdd_in_place
+
+    } // backend
+} // GraphBLAS
+
+#endif
@@ -0,0 +1,436 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * Implementation of sparse mxm for the OpenMP (multicore CPU) backend.
+ */
+
+#ifndef GB_OPENMP_SPARSE_MXM_HPP
+#define GB_OPENMP_SPARSE_MXM_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <algorithm>
+
+#include <graphblas/detail/logging.h>
+#include <graphblas/types.hpp>
+#include <graphblas/algebra.hpp>
+
+#include <graphblas/platforms/sequential/sparse_helpers.hpp>
+#include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/TransposeView.hpp>
+#include <graphblas/platforms/openmp/parallel_helpers.hpp>
+
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// Append to T_row the sum of the rows of B selected by the stored
+        /// values of A_row, using a dense accumulator (acc and acc_set hold
+        /// op.zero() and false for every column on entry and exit).
+        template<typename D3ScalarT,
+                 typename ARowT,
+                 typename BMatrixT,
+                 typename SemiringT>
+        inline void accumulate_row_products(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &T_row,
+            ARowT                                   const &A_row,
+            BMatrixT                                const &B,
+            SemiringT                                      op,
+            std::vector<D3ScalarT>                        &acc,
+            std::vector<bool>                             &acc_set)
+        {
+            ScratchBuffer<IndexType> touched_buf;
+            auto &touched(touched_buf.get());
+
+            for (auto const &a_elt : A_row)
+            {
+                for (auto const &b_elt : B.getRow(std::get<0>(a_elt)))
+                {
+                    IndexType col_idx(std::get<0>(b_elt));
+                    if (!acc_set[col_idx])
+                    {
+                        acc_set[col_idx] = true;
+                        touched.push_back(col_idx);
+                    }
+                    acc[col_idx] = op.add(acc[col_idx],
+                                          op.mult(std::get<1>(a_elt),
+                                                  std::get<1>(b_elt)));
+                }
+            }
+
+            std::sort(touched.begin(), touched.end());
+            for (auto col_idx : touched)
+            {
+                T_row.push_back(std::make_tuple(col_idx, acc[col_idx]));
+                acc[col_idx] = op.zero();
+                acc_set[col_idx] = false;
+            }
+        }
+
+        //**********************************************************************
+        /// T = AB when the rows of B are stored: each thread builds whole rows
+        /// of T, accumulating row i from the rows of B selected by row i of A
+        /// (in increasing order, so every sum matches the dot product).
+        ///
+        /// Rows are grouped by their number of multiplications, and a row of
+        /// A with many of them is split by column of A: each piece
+        /// accumulates a partial row and the partials are added in order.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm_products(LilSparseMatrix<D3ScalarT> &T,
+                                 SemiringT                   op,
+                                 AMatrixT            const  &A,
+                                 BMatrixT            const  &B)
+        {
+            typedef std::vector<std::tuple<IndexType, D3ScalarT> > TRowType;
+            typedef typename std::decay<
+                typename AMatrixT::RowType>::type::value_type AElementType;
+
+            IndexType nrow_A(A.nrows());
+            IndexType ncol_A(A.ncols());
+            IndexType ncol_B(B.ncols());
+
+            // The work of row i of T is the number of multiplications it
+            // takes: the stored values of the rows of B selected by row i
+            // of A.
+            std::vector<IndexType> b_prefix_buf;
+            std::vector<IndexType> const &b_prefix(
+                row_nnz_prefix(B, b_prefix_buf));
+            auto b_row_nnz = [&b_prefix](IndexType b_row_idx)
+                { return b_prefix[b_row_idx + 1] - b_prefix[b_row_idx]; };
+
+            ScratchBuffer<IndexType> work_buf;
+            auto &work_prefix(work_buf.get());
+            work_prefix.assign(nrow_A + 1, 0);
+
+#pragma omp parallel for schedule(dynamic, PARALLEL_ROW_CHUNK)
+            for (IndexType row_idx = 0; row_idx < nrow_A; ++row_idx)
+            {
+                IndexType flops(0);
+                for (auto const &a_elt : A.getRow(row_idx))
+                {
+                    flops += b_row_nnz(std::get<0>(a_elt));
+                }
+                work_prefix[row_idx + 1] = flops;
+            }
+            for (IndexType row_idx = 0; row_idx < nrow_A; ++row_idx)
+            {
+                work_prefix[row_idx + 1] += work_prefix[row_idx];
+            }
+
+            std::vector<RowBlock> blocks;
+            partition_rows(
+                blocks, work_prefix,
+                [&](IndexType row_idx, IndexType num_pieces,
+                    std::vector<IndexType> &bounds)
+                {
+                    split_by_element_work(
+                        bounds, A.getRow(row_idx), num_pieces, ncol_A,
+                        [&](AElementType const &elt)
+                        { return b_row_nnz(std::get<0>(elt)) + 1; });
+                },
+                reduction_mode() == ReductionMode::FAST);
+
+            // One dense accumulator per thread, made on first use.
+            int num_threads(get_num_threads());
+            std::vector<std::vector<D3ScalarT> > accs(num_threads);
+            std::vector<std::vector<bool> >      acc_sets(num_threads);
+
+            auto accumulate = [&](TRowType &T_row, IndexType row_idx,
+                                  IndexType col_begin, IndexType col_end)
+            {
+                int thread_num(get_thread_num());
+                if (accs[thread_num].empty())
+                {
+                    accs[thread_num].assign(ncol_B, op.zero());
+                    acc_sets[thread_num].assign(ncol_B, false);
+                }
+
+                typename AMatrixT::RowType const &A_row(A.getRow(row_idx));
+                accumulate_row_products(T_row,
+                                        row_slice(A_row, col_begin, col_end),
+                                        B, op,
+                                        accs[thread_num],
+                                        acc_sets[thread_num]);
+            };
+
+            RowSet<D3ScalarT> rows(nrow_A);
+            std::vector<TRowType> partial_rows;
+            parallel_for_blocks(
+                partial_rows, blocks,
+                [&](IndexType row_idx, TRowType &)
+                {
+                    accumulate(rows[row_idx], row_idx, 0, ncol_A);
+                },
+                [&](IndexType row_idx, IndexType col_begin, IndexType col_end,
+                    TRowType &partial)
+                {
+                    accumulate(partial, row_idx, col_begin, col_end);
+                },
+                [&](IndexType row_idx, std::vector<TRowType> &partials,
+                    TRowType &)
+                {
+                    ScratchRow<D3ScalarT> tmp_buf;
+                    auto &tmp(tmp_buf.get());
+                    auto &T_row(rows[row_idx]);
+                    for (auto const &partial : partials)
+                    {
+                        ewise_or(tmp, T_row, partial,
+                                 [&op](D3ScalarT const &lhs,
+                                       D3ScalarT const &rhs)
+                                 { return op.add(lhs, rhs); });
+                        T_row.swap(tmp);
+                    }
+                });
+
+            install_rows(T, rows);
+        }
+
+        //**********************************************************************
+        /// T = AB when B is a transpose: its columns are the stored rows of
+        /// the underlying matrix, so take dot products of the rows of A with
+        /// them.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename MatrixT>
+        inline void mxm_products(LilSparseMatrix<D3ScalarT>    &T,
+                                 SemiringT                      op,
+                                 AMatrixT               const  &A,
+                                 TransposeView<MatrixT> const  &B)
+        {
+            IndexType ncol_B(B.ncols());
+
+            // Every row of A is dotted with every column of B, so its work
+            // is its number of stored values.
+            std::vector<IndexType> a_prefix_buf;
+            std::vector<RowBlock> blocks;
+            partition_rows(blocks, row_nnz_prefix(A, a_prefix_buf));
+
+            parallel_build_rows(
+                T, blocks,
+                [&](IndexType row_idx,
+                    std::vector<std::tuple<IndexType, D3ScalarT> > &T_row)
+                {
+                    typename AMatrixT::RowType const &A_row(A.getRow(row_idx));
+                    if (A_row.empty())
+                    {
+                        return;
+                    }
+
+                    for (IndexType col_idx = 0; col_idx < ncol_B; ++col_idx)
+                    {
+                        D3ScalarT T_val;
+                        if (dot(T_val, A_row, B.getCol(col_idx), op))
+                        {
+                            T_row.push_back(std::make_tuple(col_idx, T_val));
+                        }
+                    }
+                },
+                [](IndexType, IndexType, IndexType,
+                   std::vector<std::tuple<IndexType, D3ScalarT> > &) {});
+        }
+
+        //**********************************************************************
+        /// Implementation of 4.3.1 mxm: Matrix-matrix multiply
+        template<typename CMatrixT,
+                 typename MMatrixT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void mxm(CMatrixT            &C,
+                        MMatrixT    const   &M,
+                        AccumT      const   &accum,
+                        SemiringT            op,
+                        AMatrixT    const   &A,
+                        BMatrixT    const   &B,
+                        bool                 replace_flag = false)
+        {
+            // Dimension checks happen in front end
+            IndexType nrow_A(A.nrows());
+            IndexType ncol_B(B.ncols());
+
+            typedef typename SemiringT::result_type D3ScalarType;
+
+            // =================================================================
+            // Do the basic dot-product work with the semi-ring.
+            ScratchMatrix<D3ScalarType> T_buf(nrow_A, ncol_B);
+            auto &T(T_buf.get());
+
+            // Build this completely based on the semiring
+            if ((A.nvals() > 0) && (B.nvals() > 0))
+            {
+                mxm_products(T, op, A, B);
+            }
+
+            GRB_LOG_VERBOSE("T: " << T);
+
+            // =================================================================
+            // Accumulate into Z and copy into the final output considering
+            // mask and replace.  T is the back buffer of C: when it is
+            // swapped in, the old rows of C become the buffer for the next
+            // product of this shape.
+            parallel_opt_accum_and_write(C, std::move(T), M, accum, replace_flag);
+
+        } // mxm
+
+        //**********************************************************************
+        /// t(i) = the reduction with monoid of row i of (A*B)<M>, for the
+        /// rows that have a value.  The rows are computed in parallel and the
+        /// product is never stored.
+        template<typename D3ScalarT,
+                 typename MonoidT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void reduce_masked_mxm_rows(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            MonoidT                                         monoid,
+            MMatrixT                                const  &M,
+            SemiringT                                       op,
+            AMatrixT                                const  &A,
+            BMatrixT                                const  &B)
+        {
+            t.clear();
+            if ((A.nvals() == 0) || (B.nvals() == 0))
+            {
+                return;
+            }
+
+            IndexType nrows(A.nrows());
+            std::vector<D3ScalarT> row_vals(nrows);
+            std::vector<char> row_set(nrows, 0);
+
+#pragma omp parallel for schedule(dynamic, PARALLEL_ROW_CHUNK)
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                row_set[row_idx] =
+                    masked_dot_reduction(row_vals[row_idx], monoid, M, row_idx,
+                                         op, A.getRow(row_idx), B);
+            }
+
+            for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+            {
+                if (row_set[row_idx])
+                {
+                    t.push_back(std::make_tuple(row_idx, row_vals[row_idx]));
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// reduce(w, mask, accum, monoid, (A*B)<M>): the row reduction of a
+        /// masked product without computing the product matrix.
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename MonoidT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void reduce_masked_mxm(WVectorT        &w,
+                                      MaskT     const &mask,
+                                      AccumT           accum,
+                                      MonoidT          monoid,
+                                      MMatrixT  const &M,
+                                      SemiringT        op,
+                                      AMatrixT  const &A,
+                                      BMatrixT  const &B,
+                                      bool             replace_flag = false)
+        {
+            typedef typename MonoidT::result_type D3ScalarType;
+            ScratchRow<D3ScalarType> t_buf;
+            auto &t(t_buf.get());
+            reduce_masked_mxm_rows(t, monoid, M, op, A, B);
+
+            typedef typename std::conditional<
+                std::is_same<AccumT, NoAccumulate>::value,
+                D3ScalarType,
+                typename AccumT::result_type>::type  ZScalarType;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
+            ewise_or_opt_accum_1D(z, w, t, accum);
+
+            write_with_opt_mask_1D(w, z, mask, replace_flag);
+        }
+
+        //**********************************************************************
+        /// reduce(val, accum, monoid, (A*B)<M>): the scalar reduction of a
+        /// masked product without computing the product matrix.  The row
+        /// results are combined in row order.
+        template<typename ValueT,
+                 typename AccumT,
+                 typename MonoidT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void reduce_masked_mxm_to_scalar(ValueT         &val,
+                                                AccumT          accum,
+                                                MonoidT         monoid,
+                                                MMatrixT const &M,
+                                                SemiringT       op,
+                                                AMatrixT const &A,
+                                                BMatrixT const &B)
+        {
+            typedef typename MonoidT::result_type D3ScalarType;
+            ScratchRow<D3ScalarType> row_vals_buf;
+            auto &row_vals(row_vals_buf.get());
+            reduce_masked_mxm_rows(row_vals, monoid, M, op, A, B);
+
+            D3ScalarType t = monoid.identity();
+            for (auto const &row_val : row_vals)
+            {
+                t = monoid(t, std::get<1>(row_val));
+            }
+
+            ValueT z;
+            opt_accum_scalar(z, val, t, accum);
+            val = z;
+        }
+    } // backend
+} // GraphBLAS
+
+#endif
@@ -0,0 +1,200 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementation of all sparse mxv for the OpenMP (multicore CPU) backend.
+ */
+
+#ifndef GB_OPENMP_SPARSE_MXV_HPP
+#define GB_OPENMP_SPARSE_MXV_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <graphblas/algebra.hpp>
+
+#include <graphblas/platforms/sequential/sparse_helpers.hpp>
+#include <graphblas/platforms/openmp/parallel_helpers.hpp>
+#include <graphblas/platforms/sequential/TransposeView.hpp>
+
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// t = Au when the rows of A are stored: take the dot product of u
+        /// with each one.  The rows are divided among the threads by their
+        /// number of stored values, and a very long row is divided into
+        /// pieces whose dot products are added.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UVectorT>
+        inline void mxv_products(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            IndexType                                       t_size,
+            SemiringT                                       op,
+            AMatrixT                                 const &A,
+            UVectorT                                 const &u)
+        {
+            typedef typename AMatrixT::ScalarType AScalarType;
+            typedef std::vector<std::tuple<IndexType, D3ScalarT> > TPartType;
+
+            std::vector<IndexType> prefix_buf;
+            std::vector<RowBlock> blocks;
+            partition_rows(
+                blocks, row_nnz_prefix(A, prefix_buf),
+                [&](IndexType row_idx, IndexType num_pieces,
+                    std::vector<IndexType> &bounds)
+                {
+                    split_by_elements(bounds, A.getRow(row_idx), num_pieces,
+                                      A.ncols());
+                },
+                reduction_mode() == ReductionMode::FAST);
+
+            parallel_gather(
+                t, blocks,
+                [&](IndexType row_idx, TPartType &part)
+                {
+                    auto const &A_row(A.getRow(row_idx));
+
+                    if (!A_row.empty())
+                    {
+                        D3ScalarT t_val;
+                        if (dot2(t_val, A_row, u, op))
+                        {
+                            part.push_back(std::make_tuple(row_idx, t_val));
+                        }
+                    }
+                },
+                [&](IndexType row_idx, IndexType col_begin, IndexType col_end,
+                    TPartType &partial)
+                {
+                    auto const &A_row(A.getRow(row_idx));
+                    auto slice(row_slice(A_row, col_begin, col_end));
+
+                    ScratchRow<AScalarType> piece_buf;
+                    auto &piece(piece_buf.get());
+                    piece.assign(slice.begin(), slice.end());
+
+                    D3ScalarT t_val;
+                    if (dot2(t_val, piece, u, op))
+                    {
+                        partial.push_back(std::make_tuple(row_idx, t_val));
+                    }
+                },
+                [&](IndexType row_idx, std::vector<TPartType> &partials,
+                    TPartType &part)
+                {
+                    merge_piece_values(row_idx, partials, part,
+                                       [&op](D3ScalarT lhs, D3ScalarT rhs)
+                                       { return op.add(lhs, rhs); });
+                });
+        }
+
+        //********************************************************************
+        /// t = Au when A is a transpose: its columns are the stored rows of
+        /// the underlying matrix, so push each stored element u(k) through
+        /// column k of A (each thread owns a range of t).
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename MatrixT,
+                 typename UVectorT>
+        inline void mxv_products(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            IndexType                                       t_size,
+            SemiringT                                       op,
+            TransposeView<MatrixT>                   const &A,
+            UVectorT                                 const &u)
+        {
+            typedef typename UVectorT::ScalarType UScalarType;
+            typedef typename MatrixT::ScalarType  AScalarType;
+
+            parallel_push_products(
+                t, t_size, u,
+                [&A](IndexType k) -> decltype(A.getCol(k))
+                { return A.getCol(k); },
+                [&op](UScalarType u_val, AScalarType a_val)
+                { return op.mult(a_val, u_val); },
+                op);
+        }
+
+        //********************************************************************
+        /// Implementation of 4.3.3 mxv: Matrix-Vector variant
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UVectorT>
+        inline void mxv(WVectorT        &w,
+                        MaskT     const &mask,
+                        AccumT           accum,
+                        SemiringT        op,
+                        AMatrixT  const &A,
+                        UVectorT  const &u,
+                        bool             replace_flag = false)
+        {
+            // =================================================================
+            // Do the basic dot-product work with the semi-ring.
+            typedef typename SemiringT::result_type D3ScalarType;
+
+            ScratchRow<D3ScalarType> t_buf;
+            auto &t(t_buf.get());
+
+            if ((A.nvals() > 0) && (u.nvals() > 0))
+            {
+                mxv_products(t, w.size(), op, A, u);
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            typedef typename std::conditional<std::is_same<AccumT, NoAccumulate>::value,
+                                              D3ScalarType,
+                                              typename AccumT::result_type>::type ZScalarType;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
+            ewise_or_opt_accum_1D(z, w, t, accum);
+
+            // =================================================================
+            // Copy Z into the final output, w, considering mask and replace
+            write_with_opt_mask_1D(w, z, mask, replace_flag);
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif
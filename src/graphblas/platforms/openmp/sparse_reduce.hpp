@@ -0,0 +1,304 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementation of all sparse reduce variants for the OpenMP (multicore CPU) backend.
+ */
+
+#ifndef GB_OPENMP_SPARSE_REDUCE_HPP
+#define GB_OPENMP_SPARSE_REDUCE_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <graphblas/algebra.hpp>
+
+#include <graphblas/platforms/sequential/sparse_helpers.hpp>
+#include <graphblas/platforms/openmp/parallel_helpers.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// t(i) = the reduction of row i of A, for the rows that have stored
+        /// values.  The rows are divided among the threads by their number
+        /// of stored values, and a very long row is reduced in pieces (in
+        /// the FAST reduction mode only: the pieces would make the result
+        /// depend on the number of threads).
+        template<typename D3ScalarT,
+                 typename BinaryOpT,
+                 typename AMatrixT>
+        inline void reduce_rows(std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+                                BinaryOpT                                       op,
+                                AMatrixT                                 const &A)
+        {
+            typedef std::vector<std::tuple<IndexType, D3ScalarT> > TPartType;
+
+            ReductionMode const mode(reduction_mode());
+
+            std::vector<IndexType> prefix_buf;
+            std::vector<RowBlock> blocks;
+            partition_rows(
+                blocks, row_nnz_prefix(A, prefix_buf),
+                [&](IndexType row_idx, IndexType num_pieces,
+                    std::vector<IndexType> &bounds)
+                {
+                    split_by_elements(bounds, A.getRow(row_idx), num_pieces,
+                                      A.ncols());
+                },
+                mode == ReductionMode::FAST);
+
+            parallel_gather(
+                t, blocks,
+                [&](IndexType row_idx, TPartType &part)
+                {
+                    D3ScalarT t_val;
+                    if (reduction(t_val, A.getRow(row_idx), op, mode))
+                    {
+                        part.push_back(std::make_tuple(row_idx, t_val));
+                    }
+                },
+                [&](IndexType row_idx, IndexType col_begin, IndexType col_end,
+                    TPartType &partial)
+                {
+                    auto const &A_row(A.getRow(row_idx));
+
+                    D3ScalarT t_val;
+                    if (reduction(t_val, row_slice(A_row, col_begin, col_end), op))
+                    {
+                        partial.push_back(std::make_tuple(row_idx, t_val));
+                    }
+                },
+                [&](IndexType row_idx, std::vector<TPartType> &partials,
+                    TPartType &part)
+                {
+                    merge_piece_values(row_idx, partials, part, op);
+                });
+        }
+
+        //********************************************************************
+        /// The reduction of all of the stored values of A, in row order, in
+        /// the order of a TreeReduction: the blocks of REDUCTION_BLOCK_SIZE
+        /// values are reduced in parallel and then combined in order.
+        template<typename D3ScalarT,
+                 typename MonoidT,
+                 typename AMatrixT>
+        inline D3ScalarT tree_reduce_matrix(MonoidT         op,
+                                            AMatrixT const &A,
+                                            bool            compensated)
+        {
+            typedef TreeReduction<D3ScalarT, MonoidT> TreeType;
+
+            std::vector<IndexType> prefix_buf;
+            auto const &prefix(row_nnz_prefix(A, prefix_buf));
+            IndexType nvals(prefix.back());
+            IndexType num_blocks((nvals + REDUCTION_BLOCK_SIZE - 1)/
+                                 REDUCTION_BLOCK_SIZE);
+
+            std::vector<typename TreeType::Partial> partials(num_blocks);
+
+#pragma omp parallel for schedule(dynamic)
+            for (IndexType block = 0; block < num_blocks; ++block)
+            {
+                IndexType begin(block*REDUCTION_BLOCK_SIZE);
+                IndexType end(std::min(begin + REDUCTION_BLOCK_SIZE, nvals));
+
+                // The row holding value number begin
+                IndexType row_idx(
+                    std::upper_bound(prefix.begin(), prefix.end(), begin) -
+                    prefix.begin() - 1);
+
+                TreeType tree(op, compensated);
+                for (IndexType pos = begin; pos < end; ++row_idx)
+                {
+                    auto const &A_row(A.getRow(row_idx));
+                    auto elt(A_row.begin() + (pos - prefix[row_idx]));
+                    for (; (elt != A_row.end()) && (pos < end); ++elt, ++pos)
+                    {
+                        tree.add(static_cast<D3ScalarT>(std::get<1>(*elt)));
+                    }
+                }
+                partials[block] = tree.partial();
+            }
+
+            TreeType tree(op, compensated);
+            for (IndexType block = 0; block < num_blocks; ++block)
+            {
+                tree.add_block(partials[block],
+                               std::min(REDUCTION_BLOCK_SIZE,
+                                        nvals - block*REDUCTION_BLOCK_SIZE));
+            }
+            return tree.result();
+        }
+
+        //********************************************************************
+        /// Implementation of 4.3.9.1 reduce: Standard Matrix to Vector variant
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename BinaryOpT,  // monoid or binary op only
+                 typename AMatrixT>
+        inline void reduce(WVectorT        &w,
+                           MaskT     const &mask,
+                           AccumT           accum,
+                           BinaryOpT        op,
+                           AMatrixT  const &A,
+                           bool             replace_flag = false)
+        {
+            // =================================================================
+            // Do the basic reduction work with the binary op
+            typedef typename BinaryOpT::result_type D3ScalarType;
+            typedef typename AMatrixT::ScalarType AScalarType;
+            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
+
+            ScratchRow<D3ScalarType> t_buf;
+            auto &t(t_buf.get());
+
+            if (A.nvals() > 0)
+            {
+                /// @todo There is something hinky with domains here.  How
+                /// does one perform the reduction in A domain but produce
+                /// partial results in D3(op)?
+                reduce_rows(t, op, A);
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            // Type generator for z: D3(accum), or D(w) if no accum.
+            typedef typename std::conditional<
+                std::is_same<AccumT, NoAccumulate>::value,
+                D3ScalarType,
+                typename AccumT::result_type>::type  ZScalarType;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
+            ewise_or_opt_accum_1D(z, w, t, accum);
+
+            // =================================================================
+            // Copy Z into the final output, w, considering mask and replace
+            write_with_opt_mask_1D(w, z, mask, replace_flag);
+        }
+
+        //********************************************************************
+        /// Implementation of 4.3.9.2 reduce: Vector to scalar variant
+        template<typename ValueT,
+                 typename AccumT,
+                 typename MonoidT, // monoid only
+                 typename UVectorT>
+        inline void reduce_vector_to_scalar(ValueT         &val,
+                                            AccumT          accum,
+                                            MonoidT         op,
+                                            UVectorT const &u)
+        {
+            // =================================================================
+            // Do the basic reduction work with the monoid
+            typedef typename MonoidT::result_type D3ScalarType;
+            typedef typename UVectorT::ScalarType UScalarType;
+            typedef std::vector<std::tuple<IndexType,UScalarType> >  UColType;
+
+            D3ScalarType t = op.identity();
+
+            if (u.nvals() > 0)
+            {
+                reduction(t, u, op, reduction_mode());
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            /// @todo Do we need a type generator for z: D(w) if no accum,
+            /// or D3(accum). I think that D(z) := D(val) should be equivalent, but
+            /// still need to work the proof.
+            ValueT z;
+            opt_accum_scalar(z, val, t, accum);
+
+            // Copy Z into the final output
+            val = z;
+        }
+
+        //********************************************************************
+        /// Implementation of 4.3.9.3 reduce: Matrix to scalar variant
+        template<typename ValueT,
+                 typename AccumT,
+                 typename MonoidT, // monoid only
+                 typename AMatrixT>
+        inline void reduce_matrix_to_scalar(ValueT         &val,
+                                            AccumT          accum,
+                                            MonoidT         op,
+                                            AMatrixT const &A)
+        {
+            // =================================================================
+            // Do the basic reduction work with the monoid
+            typedef typename MonoidT::result_type D3ScalarType;
+            typedef typename AMatrixT::ScalarType AScalarType;
+            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
+
+            D3ScalarType t = op.identity();
+            ReductionMode const mode(reduction_mode());
+
+            if ((A.nvals() > 0) && (mode != ReductionMode::FAST))
+            {
+                t = tree_reduce_matrix<D3ScalarType>(
+                    op, A, mode == ReductionMode::COMPENSATED);
+            }
+            else if (A.nvals() > 0)
+            {
+                // Reduce the rows in parallel, then combine the row results
+                // in row order
+                ScratchRow<D3ScalarType> row_vals_buf;
+                auto &row_vals(row_vals_buf.get());
+                reduce_rows(row_vals, op, A);
+
+                for (auto const &row_val : row_vals)
+                {
+                    t = op(t, std::get<1>(row_val)); // reduce each row
+                }
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            /// @todo Do we need a type generator for z: D(w) if no accum,
+            /// or D3(accum). I think that D(z) := D(val) should be equivalent, but
+            /// still need to work the proof.
+            ValueT z;
+            opt_accum_scalar(z, val, t, accum);
+
+            // Copy Z into the final output
+            val = z;
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * Implementation of the sparse matrix transpose for the OpenMP (multicore
+ * CPU) backend.
+ */
+
+#ifndef GB_OPENMP_SPARSE_TRANSPOSE_HPP
+#define GB_OPENMP_SPARSE_TRANSPOSE_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <algorithm>
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/algebra.hpp>
+
+#include <graphblas/platforms/sequential/sparse_helpers.hpp>
+#include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/TransposeView.hpp>
+#include <graphblas/platforms/openmp/parallel_helpers.hpp>
+
+//******************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //**********************************************************************
+        /// T = A' when the rows of A are stored: each thread owns a range of
+        /// the columns of A (rows of T) and collects them from every row.
+        template<typename TScalarT,
+                 typename AMatrixT>
+        inline void transpose_rows(LilSparseMatrix<TScalarT> &T,
+                                   AMatrixT            const &A)
+        {
+            typedef typename AMatrixT::ScalarType AScalarType;
+
+            IndexType nrows(A.nrows());
+            IndexType ncols(A.ncols());
+            RowSet<TScalarT> rows(ncols);
+
+#pragma omp parallel
+            {
+                IndexType tid(get_thread_num());
+                IndexType num_threads(get_team_size());
+                IndexType lo(ncols*tid/num_threads);
+                IndexType hi(ncols*(tid + 1)/num_threads);
+
+                for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+                {
+                    auto const &a_row(A.getRow(row_idx));
+                    auto elt = std::lower_bound(
+                        a_row.begin(), a_row.end(), lo,
+                        [](std::tuple<IndexType, AScalarType> const &tupl,
+                           IndexType idx)
+                        { return std::get<0>(tupl) < idx; });
+
+                    for (; (elt != a_row.end()) && (std::get<0>(*elt) < hi);
+                         ++elt)
+                    {
+                        rows[std::get<0>(*elt)].push_back(
+                            std::make_tuple(row_idx,
+                                            static_cast<TScalarT>(std::get<1>(*elt))));
+                    }
+                }
+            }
+
+            install_rows(T, rows);
+        }
+
+        /// T = A' when A is a transpose: T is the underlying matrix.
+        template<typename TScalarT,
+                 typename MatrixT>
+        inline void transpose_rows(LilSparseMatrix<TScalarT>    &T,
+                                   TransposeView<MatrixT> const &A)
+        {
+            parallel_build_rows(
+                T,
+                [&](IndexType row_idx,
+                    std::vector<std::tuple<IndexType, TScalarT> > &T_row)
+                {
+                    for (auto const &elt : A.getCol(row_idx))
+                    {
+                        T_row.push_back(std::make_tuple(
+                            std::get<0>(elt),
+                            static_cast<TScalarT>(std::get<1>(elt))));
+                    }
+                });
+        }
+
+        //**********************************************************************
+        // Implementation of 4.3.10 Matrix transpose
+        template<typename CMatrixT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename AMatrixT>
+        inline void transpose(CMatrixT       &C,
+                              MaskT    const &mask,
+                              AccumT          accum,
+                              AMatrixT const &A,
+                              bool            replace_flag = false)
+        {
+            typedef typename AMatrixT::ScalarType                   AScalarType;
+
+            IndexType nrows(A.nrows());
+            IndexType ncols(A.ncols());
+
+            // =================================================================
+            // Transpose A into T.
+            LilSparseMatrix<AScalarType> T(ncols, nrows);
+            if (A.nvals() > 0)
+            {
+                transpose_rows(T, A);
+            }
+
+            GRB_LOG_VERBOSE("T: " << T);
+
+            // =================================================================
+            // Accumulate T via C into Z
+            typedef typename std::conditional<
+                std::is_same<AccumT, NoAccumulate>::value,
+                AScalarType,
+                typename AccumT::result_type>::type  ZScalarType;
+
+            LilSparseMatrix<ZScalarType> Z(ncols, nrows);
+            parallel_ewise_or_opt_accum(Z, C, std::move(T), accum);
+
+            GRB_LOG_VERBOSE("Z: " << Z);
+
+            // =================================================================
+            // Copy Z into the final output considering mask and replace
+            parallel_write_with_opt_mask(C, std::move(Z), mask, replace_flag);
+        }
+    }
+}
+
+
+
+#endif //GB_OPENMP_SPARSE_TRANSPOSE_HPP
@@ -0,0 +1,200 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Implementations of sparse vxm for the OpenMP (multicore CPU) backend.
+ */
+
+#ifndef GB_OPENMP_SPARSE_VXM_HPP
+#define GB_OPENMP_SPARSE_VXM_HPP
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include <iterator>
+#include <iostream>
+#include <graphblas/algebra.hpp>
+
+#include <graphblas/platforms/sequential/sparse_helpers.hpp>
+#include <graphblas/platforms/openmp/parallel_helpers.hpp>
+#include <graphblas/platforms/sequential/TransposeView.hpp>
+
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// t = u'A when the rows of A are stored: push each stored element
+        /// u(k) through row k of A (each thread owns a range of t).
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename UVectorT,
+                 typename AMatrixT>
+        inline void vxm_products(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            IndexType                                       t_size,
+            SemiringT                                       op,
+            UVectorT                                 const &u,
+            AMatrixT                                 const &A)
+        {
+            typedef typename UVectorT::ScalarType UScalarType;
+            typedef typename AMatrixT::ScalarType AScalarType;
+
+            parallel_push_products(
+                t, t_size, u,
+                [&A](IndexType k) -> decltype(A.getRow(k))
+                { return A.getRow(k); },
+                [&op](UScalarType u_val, AScalarType a_val)
+                { return op.mult(u_val, a_val); },
+                op);
+        }
+
+        //********************************************************************
+        /// t = u'A when A is a transpose: the columns of A are the stored rows
+        /// of the underlying matrix, so take the dot product with each one.
+        /// The columns are divided among the threads by their number of
+        /// stored values, and a very long column is divided into pieces whose
+        /// dot products are added.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename UVectorT,
+                 typename MatrixT>
+        inline void vxm_products(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            IndexType                                       t_size,
+            SemiringT                                       op,
+            UVectorT                                 const &u,
+            TransposeView<MatrixT>                   const &A)
+        {
+            typedef typename MatrixT::ScalarType AScalarType;
+            typedef std::vector<std::tuple<IndexType, D3ScalarT> > TPartType;
+
+            std::vector<RowBlock> blocks;
+            partition_rows(
+                blocks, A.col_nnz_prefix(),
+                [&](IndexType col_idx, IndexType num_pieces,
+                    std::vector<IndexType> &bounds)
+                {
+                    split_by_elements(bounds, A.getCol(col_idx), num_pieces,
+                                      A.nrows());
+                },
+                reduction_mode() == ReductionMode::FAST);
+
+            parallel_gather(
+                t, blocks,
+                [&](IndexType col_idx, TPartType &part)
+                {
+                    auto const &A_col(A.getCol(col_idx));
+
+                    if (!A_col.empty())
+                    {
+                        D3ScalarT t_val;
+                        if (dot2(t_val, u, A_col, op))
+                        {
+                            part.push_back(std::make_tuple(col_idx, t_val));
+                        }
+                    }
+                },
+                [&](IndexType col_idx, IndexType row_begin, IndexType row_end,
+                    TPartType &partial)
+                {
+                    auto const &A_col(A.getCol(col_idx));
+                    auto slice(row_slice(A_col, row_begin, row_end));
+
+                    ScratchRow<AScalarType> piece_buf;
+                    auto &piece(piece_buf.get());
+                    piece.assign(slice.begin(), slice.end());
+
+                    D3ScalarT t_val;
+                    if (dot2(t_val, u, piece, op))
+                    {
+                        partial.push_back(std::make_tuple(col_idx, t_val));
+                    }
+                },
+                [&](IndexType col_idx, std::vector<TPartType> &partials,
+                    TPartType &part)
+                {
+                    merge_piece_values(col_idx, partials, part,
+                                       [&op](D3ScalarT lhs, D3ScalarT rhs)
+                                       { return op.add(lhs, rhs); });
+                });
+        }
+
+        //********************************************************************
+        /// Implementation of 4.3.2 vxm: Vector-Matrix multiply
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UVectorT>
+        inline void vxm(WVectorT        &w,
+                        MaskT     const &mask,
+                        AccumT           accum,
+                        SemiringT        op,
+                        UVectorT  const &u,
+                        AMatrixT  const &A,
+                        bool             replace_flag = false)
+        {
+            // =================================================================
+            // Do the basic dot-product work with the semi-ring.
+            typedef typename SemiringT::result_type D3ScalarType;
+
+            ScratchRow<D3ScalarType> t_buf;
+            auto &t(t_buf.get());
+
+            if ((A.nvals() > 0) && (u.nvals() > 0))
+            {
+                vxm_products(t, w.size(), op, u, A);
+            }
+
+            // =================================================================
+            // Accumulate into Z
+            /// @todo Do we need a type generator for z: D(w) if no accum,
+            /// or D3(accum). I think that output type should be equivalent, but
+            /// still need to work the proof.
+            typedef typename WVectorT::ScalarType WScalarType;
+            ScratchRow<WScalarType> z_buf;
+            auto &z(z_buf.get());
+            ewise_or_opt_accum_1D(z, w, t, accum);
+
+            // =================================================================
+            // Copy Z into the final output, w, considering mask and replace
+            write_with_opt_mask_1D(w, z, mask, replace_flag);
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif
@@ -0,0 +1,481 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE openmp_parallel_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    typedef GraphBLAS::Matrix<int> IntMatrix;
+    typedef GraphBLAS::Vector<int> IntVector;
+
+    /// A matrix with an irregular pattern (and some empty and some heavy
+    /// rows) that spans several row chunks.
+    IntMatrix pattern_matrix(IndexType nrows, IndexType ncols, IndexType seed)
+    {
+        IndexArrayType rows, cols;
+        std::vector<int> vals;
+        for (IndexType i = 0; i < nrows; ++i)
+        {
+            IndexType density((i % 13 == 0) ? 6 : ((i % 5 == 0) ? 0 : 2));
+            for (IndexType j = 0; j < ncols; ++j)
+            {
+                if ((i*31 + j*17 + seed) % 7 < density)
+                {
+                    rows.push_back(i);
+                    cols.push_back(j);
+                    vals.push_back(int((i*3 + j*5 + seed) % 11) - 5);
+                }
+            }
+        }
+
+        IntMatrix A(nrows, ncols);
+        A.build(rows, cols, vals);
+        return A;
+    }
+
+    IntVector pattern_vector(IndexType size, IndexType stride)
+    {
+        IntVector u(size);
+        for (IndexType i = 0; i < size; i += stride)
+        {
+            u.setElement(i, int(i % 9) - 4);
+        }
+        return u;
+    }
+
+    /// A matrix whose stored values are mostly in a few full rows and one
+    /// full column, so that a balanced row loop has to split rows.
+    IntMatrix skewed_matrix(IndexType nrows, IndexType ncols, IndexType seed)
+    {
+        IndexArrayType rows, cols;
+        std::vector<int> vals;
+        for (IndexType i = 0; i < nrows; ++i)
+        {
+            bool hub((i == 1) || (i == nrows/2) || (i == nrows - 1));
+            for (IndexType j = 0; j < ncols; ++j)
+            {
+                if (hub || (j == 3) || ((i + j*7 + seed) % 97 == 0))
+                {
+                    rows.push_back(i);
+                    cols.push_back(j);
+                    vals.push_back(int((i*5 + j*3 + seed) % 9) - 4);
+                }
+            }
+        }
+
+        IntMatrix A(nrows, ncols);
+        A.build(rows, cols, vals);
+        return A;
+    }
+
+    /// A dense matrix of values of very different magnitudes.
+    GraphBLAS::Matrix<double> real_matrix(IndexType nrows, IndexType ncols)
+    {
+        IndexArrayType rows, cols;
+        std::vector<double> vals;
+        for (IndexType i = 0; i < nrows; ++i)
+        {
+            for (IndexType j = 0; j < ncols; ++j)
+            {
+                rows.push_back(i);
+                cols.push_back(j);
+                vals.push_back(((i + j) % 7 == 0) ? 1.e6/(j + 1) : 0.1/(i + 1));
+            }
+        }
+
+        GraphBLAS::Matrix<double> A(nrows, ncols);
+        A.build(rows, cols, vals);
+        return A;
+    }
+
+    /// Run the computation with one thread and with several and check that
+    /// the results are identical.
+    template <typename FunctionT>
+    void check_thread_independent(FunctionT compute)
+    {
+        backend::set_num_threads(1);
+        auto one_thread(compute());
+
+        backend::set_num_threads(4);
+        BOOST_CHECK_EQUAL(backend::get_num_threads(), 4);
+        auto four_threads(compute());
+
+        BOOST_CHECK_EQUAL(one_thread, four_threads);
+    }
+
+    static IndexType const NROWS = 150;
+    static IndexType const NCOLS = 130;
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxm_thread_independent)
+{
+    IntMatrix A(pattern_matrix(NROWS, NCOLS, 1));
+    IntMatrix B(pattern_matrix(NCOLS, NROWS, 2));
+    IntMatrix Bt(pattern_matrix(NROWS, NCOLS, 2));
+    IntMatrix M(pattern_matrix(NROWS, NROWS, 3));
+
+    check_thread_independent([&]() {
+            IntMatrix C(pattern_matrix(NROWS, NROWS, 4));
+            mxm(C, M, Plus<int>(), ArithmeticSemiring<int>(), A, B);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(NROWS, NROWS);
+            mxm(C, complement(M), NoAccumulate(),
+                ArithmeticSemiring<int>(), A, transpose(Bt), true);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(NCOLS, NCOLS);
+            mxm(C, NoMask(), NoAccumulate(),
+                MinPlusSemiring<int>(), transpose(A), A);
+            return C; });
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxv_vxm_thread_independent)
+{
+    IntMatrix A(pattern_matrix(NROWS, NCOLS, 5));
+    IntVector u_rows(pattern_vector(NROWS, 3));
+    IntVector u_cols(pattern_vector(NCOLS, 1));
+
+    check_thread_independent([&]() {
+            IntVector w(NROWS);
+            mxv(w, NoMask(), NoAccumulate(), ArithmeticSemiring<int>(),
+                A, u_cols);
+            return w; });
+
+    check_thread_independent([&]() {
+            IntVector w(NCOLS);
+            mxv(w, NoMask(), NoAccumulate(), ArithmeticSemiring<int>(),
+                transpose(A), u_rows);
+            return w; });
+
+    check_thread_independent([&]() {
+            IntVector w(pattern_vector(NCOLS, 2));
+            vxm(w, NoMask(), Plus<int>(), ArithmeticSemiring<int>(),
+                u_rows, A);
+            return w; });
+
+    check_thread_independent([&]() {
+            IntVector w(NROWS);
+            vxm(w, NoMask(), NoAccumulate(), ArithmeticSemiring<int>(),
+                u_cols, transpose(A));
+            return w; });
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_ewise_apply_thread_independent)
+{
+    IntMatrix A(pattern_matrix(NROWS, NCOLS, 6));
+    IntMatrix B(pattern_matrix(NROWS, NCOLS, 7));
+    IntMatrix M(pattern_matrix(NROWS, NCOLS, 8));
+
+    check_thread_independent([&]() {
+            IntMatrix C(pattern_matrix(NROWS, NCOLS, 9));
+            eWiseAdd(C, M, Times<int>(), Plus<int>(), A, B);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(pattern_matrix(NROWS, NCOLS, 9));
+            eWiseMult(C, complement(M), NoAccumulate(), Times<int>(), A, B,
+                      true);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(NROWS, NCOLS);
+            apply(C, M, Plus<int>(), AdditiveInverse<int>(), A);
+            return C; });
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_build_thread_independent)
+{
+    // More tuples than a build handles without dividing its work, with
+    // duplicates combined by a non-commutative operator.
+    IndexArrayType rows, cols;
+    std::vector<int> vals;
+    for (IndexType k = 0; k < 50000; ++k)
+    {
+        rows.push_back((k * 7919) % NROWS);
+        cols.push_back((k * k + 5 * k) % NCOLS);
+        vals.push_back(int(k % 19) - 9);
+    }
+
+    check_thread_independent([&]() {
+            IntMatrix C(pattern_matrix(NROWS, NCOLS, 3));
+            C.build(rows, cols, vals, Minus<int>());
+            return C; });
+
+    check_thread_independent([&]() {
+            IntVector w(NCOLS);
+            w.build(cols, vals, Minus<int>());
+            return w; });
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_reduce_transpose_thread_independent)
+{
+    IntMatrix A(pattern_matrix(NROWS, NCOLS, 10));
+
+    check_thread_independent([&]() {
+            IntVector w(NROWS);
+            reduce(w, NoMask(), NoAccumulate(), Plus<int>(), A);
+            return w; });
+
+    check_thread_independent([&]() {
+            int val(0);
+            reduce(val, NoAccumulate(), PlusMonoid<int>(), A);
+            return val; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(NCOLS, NROWS);
+            transpose(C, NoMask(), NoAccumulate(), A);
+            return C; });
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_extract_assign_thread_independent)
+{
+    IntMatrix A(pattern_matrix(NROWS, NCOLS, 11));
+    IntMatrix B(pattern_matrix(70, 60, 12));
+
+    IndexArrayType row_indices, col_indices;
+    for (IndexType i = 0; i < 70; ++i)
+    {
+        row_indices.push_back((i*7) % NROWS);
+    }
+    for (IndexType j = 0; j < 60; ++j)
+    {
+        col_indices.push_back((j*11) % NCOLS);
+    }
+
+    check_thread_independent([&]() {
+            IntMatrix C(70, 60);
+            extract(C, NoMask(), NoAccumulate(), A, row_indices, col_indices);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(60, 70);
+            extract(C, NoMask(), NoAccumulate(), transpose(A),
+                    col_indices, row_indices);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(A);
+            assign(C, NoMask(), Plus<int>(), B, row_indices, col_indices);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(A);
+            assign(C, NoMask(), NoAccumulate(), B, row_indices, col_indices);
+            return C; });
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_partition_rows)
+{
+    // Rows of work 0, 40, 1, 1, ... 1 (with 4 threads a block is about
+    // 160/16 = 10 units, so row 1 is split).
+    std::vector<IndexType> work_prefix(1, 0);
+    for (IndexType i = 0; i < 80; ++i)
+    {
+        work_prefix.push_back(work_prefix.back() +
+                              ((i == 1) ? 40 : ((i == 0) ? 0 : 1)));
+    }
+
+    backend::set_num_threads(4);
+    std::vector<backend::RowBlock> blocks;
+    backend::partition_rows(
+        blocks, work_prefix,
+        [](IndexType, IndexType num_pieces, std::vector<IndexType> &bounds)
+        {
+            for (IndexType piece = 0; piece <= num_pieces; ++piece)
+            {
+                bounds.push_back(piece*100/num_pieces);
+            }
+        });
+
+    // The blocks cover every row once, in order, and only row 1 is split.
+    IndexType next_row(0);
+    IndexType next_col(0);
+    IndexType num_pieces(0);
+    for (auto const &block : blocks)
+    {
+        BOOST_CHECK_EQUAL(block.row_begin, next_row);
+        BOOST_CHECK(block.row_begin < block.row_end);
+        if (block.split)
+        {
+            BOOST_CHECK_EQUAL(block.row_begin, 1);
+            BOOST_CHECK_EQUAL(block.col_begin, next_col);
+            next_col = block.col_end;
+            ++num_pieces;
+            if (next_col == 100)
+            {
+                next_row = block.row_end;
+            }
+        }
+        else
+        {
+            next_row = block.row_end;
+        }
+    }
+    BOOST_CHECK_EQUAL(next_row, 80);
+    BOOST_CHECK(num_pieces > 1);
+
+    // Without splitting, row 1 is a block of its own.
+    backend::partition_rows(blocks, work_prefix);
+    next_row = 0;
+    for (auto const &block : blocks)
+    {
+        BOOST_CHECK(!block.split);
+        BOOST_CHECK_EQUAL(block.row_begin, next_row);
+        next_row = block.row_end;
+    }
+    BOOST_CHECK_EQUAL(next_row, 80);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_skewed_thread_independent)
+{
+    IntMatrix A(skewed_matrix(NROWS, NCOLS, 1));
+    IntMatrix B(skewed_matrix(NCOLS, NROWS, 2));
+    IntMatrix A2(skewed_matrix(NROWS, NCOLS, 3));
+    IntVector u_rows(pattern_vector(NROWS, 2));
+    IntVector u_cols(pattern_vector(NCOLS, 1));
+
+    check_thread_independent([&]() {
+            IntMatrix C(NROWS, NROWS);
+            mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<int>(), A, B);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(NROWS, NROWS);
+            mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<int>(),
+                A, transpose(A2));
+            return C; });
+
+    check_thread_independent([&]() {
+            IntVector w(NROWS);
+            mxv(w, NoMask(), NoAccumulate(), ArithmeticSemiring<int>(),
+                A, u_cols);
+            return w; });
+
+    check_thread_independent([&]() {
+            IntVector w(NROWS);
+            vxm(w, NoMask(), NoAccumulate(), ArithmeticSemiring<int>(),
+                u_cols, transpose(A));
+            return w; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(NROWS, NCOLS);
+            eWiseAdd(C, NoMask(), NoAccumulate(), Plus<int>(), A, A2);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntMatrix C(NROWS, NCOLS);
+            eWiseMult(C, NoMask(), NoAccumulate(), Times<int>(), A, A2);
+            return C; });
+
+    check_thread_independent([&]() {
+            IntVector w(NROWS);
+            reduce(w, NoMask(), NoAccumulate(), Plus<int>(), A);
+            return w; });
+
+    check_thread_independent([&]() {
+            int val(0);
+            reduce(val, NoAccumulate(), PlusMonoid<int>(), A);
+            return val; });
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_reproducible_reductions_thread_independent)
+{
+    // Values that do not add exactly, in rows long enough to be split
+    // (which gives different sums on different numbers of threads in the
+    // FAST mode)
+    typedef GraphBLAS::Matrix<double> RealMatrix;
+    typedef GraphBLAS::Vector<double> RealVector;
+
+    RealMatrix A(NROWS, 40*NCOLS);
+    eWiseMult(A, NoMask(), NoAccumulate(), Times<double>(),
+              skewed_matrix(NROWS, 40*NCOLS, 1),
+              real_matrix(NROWS, 40*NCOLS));
+    RealVector u(40*NCOLS);
+    apply(u, NoMask(), NoAccumulate(),
+          BinaryOp_Bind2nd<double, Times<double> >(0.3),
+          pattern_vector(40*NCOLS, 1));
+
+    for (auto mode : {ReductionMode::REPRODUCIBLE, ReductionMode::COMPENSATED})
+    {
+        ReductionContext context(mode);
+
+        check_thread_independent([&]() {
+                double val(0);
+                reduce(val, NoAccumulate(), PlusMonoid<double>(), A);
+                return val; });
+
+        check_thread_independent([&]() {
+                RealVector w(NROWS);
+                reduce(w, NoMask(), NoAccumulate(), PlusMonoid<double>(), A);
+                return w; });
+
+        check_thread_independent([&]() {
+                RealVector w(NROWS);
+                mxv(w, NoMask(), NoAccumulate(),
+                    ArithmeticSemiring<double>(), A, u);
+                return w; });
+
+        check_thread_independent([&]() {
+                RealVector w(NROWS);
+                vxm(w, NoMask(), NoAccumulate(),
+                    ArithmeticSemiring<double>(), u, transpose(A));
+                return w; });
+
+        check_thread_independent([&]() {
+                RealMatrix C(NROWS, NROWS);
+                mxm(C, NoMask(), NoAccumulate(),
+                    ArithmeticSemiring<double>(), A, transpose(A));
+                return C; });
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
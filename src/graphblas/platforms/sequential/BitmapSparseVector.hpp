@@ -32,14 +32,42 @@
 
 #include <iostream>
 #include <vector>
+#include <tuple>
+#include <iterator>
+#include <utility>
+#include <algorithm>
+#include <numeric>
 #include <typeinfo>
 
+#include <graphblas/platforms/sequential/bitmap_helpers.hpp>
+#include <graphblas/platforms/sequential/build_helpers.hpp>
+#include <graphblas/platforms/sequential/NumaPlacement.hpp>
+
 namespace GraphBLAS
 {
     namespace backend
     {
         /**
-         * @brief Class representing a sparse vector by using a bitmap + dense vector
+         * @brief The representations a BitmapSparseVector switches between.
+         */
+        enum class VectorForm
+        {
+            SPARSE,   ///< sorted list of (index, value) tuples
+            BITMAP,   ///< dense array of values plus a bitmap of stored ones
+            DENSE     ///< dense array of values, every element is stored
+        };
+
+        /**
+         * @brief Class representing a sparse vector.
+         *
+         * The stored elements are kept in one of three forms chosen from the
+         * ratio of nvals to size: a sorted list of (index, value) tuples when
+         * there are few (memory and work are O(nvals)), a bitmap + dense
+         * vector in between, and a dense vector with no bitmap when every
+         * element is stored.  The form changes automatically as elements are
+         * added or the contents are replaced; the thresholds for leaving and
+         * reentering the sparse form differ so that a vector near the
+         * boundary does not convert back and forth.
          */
         template<typename ScalarT>
         class BitmapSparseVector
@@ -47,20 +75,14 @@ namespace GraphBLAS
         public:
             typedef ScalarT ScalarType;
 
-            // Ambiguous with size constructor
-            // template <typename OtherVectorT>
-            // BitmapSparseVector(OtherVectorT const &rhs)
-            //     : m_size(rhs.m_size),
-            //       m_nvals(rhs.m_nvals),
-            //       m_vals(rhs.m_vals.size()),
-            //       m_bitmap(rhs.m_bitmap)
-            // {
-            //     for (size_t ix = 0; ix < rhs.m_vals.size(); ++ix)
-            //     {
-            //         m_vals[ix] =
-            //             static_cast<ScalarType>(rhs.m_vals[ix]);
-            //     }
-            // }
+            /// The stored elements are visited as (index, value) tuples
+            typedef std::tuple<IndexType, ScalarT> value_type;
+
+            /// Leave the sparse form when nvals > size/SPARSE_TO_BITMAP
+            static constexpr IndexType SPARSE_TO_BITMAP = 16;
+
+            /// Return to the sparse form when nvals < size/BITMAP_TO_SPARSE
+            static constexpr IndexType BITMAP_TO_SPARSE = 64;
 
             /**
              * @brief Construct an empty sparse vector with given size
@@ -70,8 +92,7 @@ namespace GraphBLAS
             BitmapSparseVector(IndexType nsize)
                 : m_size(nsize),
                   m_nvals(0),
-                  m_vals(nsize),
-                  m_bitmap(nsize, false)
+                  m_form(VectorForm::SPARSE)
             {
                 if (nsize == 0)
                 {
@@ -81,9 +102,9 @@ namespace GraphBLAS
 
             BitmapSparseVector(IndexType const &nsize, ScalarT const &value)
                 : m_size(nsize),
-                  m_nvals(0),
-                  m_vals(nsize, value),
-                  m_bitmap(nsize, true)
+                  m_nvals(nsize),
+                  m_form(VectorForm::DENSE),
+                  m_vals(nsize, value)
             {
             }
 
@@ -97,8 +118,8 @@ namespace GraphBLAS
             BitmapSparseVector(std::vector<ScalarT> const &rhs)
                 : m_size(rhs.size()),
                   m_nvals(rhs.size()),
-                  m_vals(rhs),
-                  m_bitmap(rhs.size(), true)
+                  m_form(VectorForm::DENSE),
+                  m_vals(rhs)
             {
                 if (rhs.size() == 0)
                 {
@@ -119,8 +140,7 @@ namespace GraphBLAS
                                ScalarT const              &zero)
                 : m_size(rhs.size()),
                   m_nvals(0),
-                  m_vals(rhs.size()),
-                  m_bitmap(rhs.size(), false)
+                  m_form(VectorForm::SPARSE)
             {
                 if (rhs.size() == 0)
                 {
@@ -131,11 +151,11 @@ namespace GraphBLAS
                 {
                     if (rhs[idx] != zero)
                     {
-                        m_vals[idx] = rhs[idx];
-                        m_bitmap[idx] = true;
-                        ++m_nvals;
+                        m_sparse.push_back(std::make_tuple(idx, rhs[idx]));
                     }
                 }
+                m_nvals = m_sparse.size();
+                update_form();
             }
 
             /**
@@ -148,22 +168,20 @@ namespace GraphBLAS
                 std::vector<ScalarT>   const &values)
                 : m_size(nsize),
                   m_nvals(0),
-                  m_vals(nsize),
-                  m_bitmap(nsize, false)
+                  m_form(VectorForm::SPARSE)
             {
                 /// @todo check for same size indices and values
                 for (IndexType idx = 0; idx < indices.size(); ++idx)
                 {
-                    IndexType i = indices[idx];
-                    if (i >= m_size)
+                    if (indices[idx] >= m_size)
                     {
                         throw DimensionException();  // Should this be IndexOutOfBounds?
                     }
-
-                    m_vals[i] = values[idx];
-                    m_bitmap[i] = true;
-                    ++m_nvals;
                 }
+
+                // Later values for the same index replace earlier ones
+                build(indices.begin(), values.begin(), indices.size(),
+                      GraphBLAS::Second<ScalarType>());
             }
 
             /**
@@ -175,11 +193,30 @@ namespace GraphBLAS
             BitmapSparseVector(BitmapSparseVector<ScalarT> const &rhs)
                 : m_size(rhs.m_size),
                   m_nvals(rhs.m_nvals),
+                  m_form(rhs.m_form),
+                  m_sparse(rhs.m_sparse),
                   m_vals(rhs.m_vals),
                   m_bitmap(rhs.m_bitmap)
             {
             }
 
+            /**
+             * @brief Move constructor for BitmapSparseVector.
+             *
+             * @param[in] rhs  The BitmapSparseVector whose storage is taken.
+             *                 It is left as an empty vector of the same size.
+             */
+            BitmapSparseVector(BitmapSparseVector<ScalarT> &&rhs)
+                : m_size(rhs.m_size),
+                  m_nvals(rhs.m_nvals),
+                  m_form(rhs.m_form),
+                  m_sparse(std::move(rhs.m_sparse)),
+                  m_vals(std::move(rhs.m_vals)),
+                  m_bitmap(std::move(rhs.m_bitmap))
+            {
+                rhs.clear();
+            }
+
             ~BitmapSparseVector() {}
 
             /**
@@ -200,12 +237,42 @@ namespace GraphBLAS
                     }
 
                     m_nvals = rhs.m_nvals;
+                    m_form = rhs.m_form;
+                    m_sparse = rhs.m_sparse;
                     m_vals = rhs.m_vals;
                     m_bitmap = rhs.m_bitmap;
                 }
                 return *this;
             }
 
+            /**
+             * @brief Move assignment.
+             *
+             * @param[in] rhs  The BitmapSparseVector whose storage is taken.
+             *                 It is cleared.
+             *
+             * @return *this.
+             */
+            BitmapSparseVector<ScalarT>& operator=(
+                BitmapSparseVector<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    if (m_size != rhs.m_size)
+                    {
+                        throw DimensionException();
+                    }
+
+                    std::swap(m_nvals, rhs.m_nvals);
+                    std::swap(m_form, rhs.m_form);
+                    m_sparse.swap(rhs.m_sparse);
+                    m_vals.swap(rhs.m_vals);
+                    m_bitmap.swap(rhs.m_bitmap);
+                    rhs.clear();
+                }
+                return *this;
+            }
+
             /**
              * @brief Assignment from a dense vector.
              *
@@ -219,12 +286,12 @@ namespace GraphBLAS
                 {
                     throw DimensionException();
                 }
-                for (IndexType idx = 0; idx < rhs.size(); ++idx)
-                {
-                    m_vals[idx] = rhs[idx];
-                    m_bitmap[idx] = true;
-                }
+
+                release(m_sparse);
+                release(m_bitmap);
+                m_vals = rhs;
                 m_nvals = m_size;
+                m_form = VectorForm::DENSE;
                 return *this;
             }
 
@@ -241,19 +308,15 @@ namespace GraphBLAS
                     return false;
                 }
 
-                for (IndexType i = 0; i < m_size; ++i)
+                // Same number of stored elements: compare them in order
+                auto rhs_it = rhs.begin();
+                for (auto it = begin(); it != end(); ++it, ++rhs_it)
                 {
-                    if (m_bitmap[i] != rhs.m_bitmap[i])
+                    if ((std::get<0>(*it) != std::get<0>(*rhs_it)) ||
+                        (std::get<1>(*it) != std::get<1>(*rhs_it)))
                     {
                         return false;
                     }
-                    if (m_bitmap[i])
-                    {
-                        if (m_vals[i] != rhs.m_vals[i])
-                        {
-                            return false;
-                        }
-                    }
                 }
 
                 return true;
@@ -272,7 +335,12 @@ namespace GraphBLAS
             // FUNCTIONS
 
             /**
+             * @brief Replace the contents with the given tuples.  Values for
+             *        the same index are combined with dup in input order.
              *
+             * The positions of the tuples are sorted by index and then by
+             * position (in parallel when compiled with OpenMP), so
+             * duplicates are met in input order.
              */
             template<typename RAIteratorIT,
                      typename RAIteratorVT,
@@ -282,44 +350,60 @@ namespace GraphBLAS
                        IndexType     nvals,
                        BinaryOpT     dup = BinaryOpT())
             {
-                std::vector<ScalarType> vals(m_size);
-                std::vector<bool> bitmap(m_size);
-
                 /// @todo check for same size indices and values
-                for (IndexType idx = 0; idx < nvals; ++idx)
+                if (!indices_in_range(i_it, nvals, m_size))
                 {
-                    IndexType i = i_it[idx];
-                    if (i >= m_size)
-                    {
-                        throw IndexOutOfBoundsException();
-                    }
+                    throw IndexOutOfBoundsException();
+                }
 
-                    if (bitmap[i] == true)
+                std::vector<IndexType> order(nvals);
+                std::iota(order.begin(), order.end(), 0);
+                parallel_sort(order.begin(), order.end(),
+                              [&](IndexType lhs, IndexType rhs)
+                              {
+                                  IndexType lhs_idx(i_it[lhs]);
+                                  IndexType rhs_idx(i_it[rhs]);
+                                  return ((lhs_idx < rhs_idx) ||
+                                          ((lhs_idx == rhs_idx) &&
+                                           (lhs < rhs)));
+                              });
+
+                std::vector<std::tuple<IndexType, ScalarT> > contents;
+                contents.reserve(nvals);
+                for (auto pos : order)
+                {
+                    IndexType i(i_it[pos]);
+                    ScalarT   val(static_cast<ScalarT>(v_it[pos]));
+                    if (!contents.empty() &&
+                        (std::get<0>(contents.back()) == i))
                     {
-                        vals[i] = dup(vals[i], v_it[idx]);
+                        std::get<1>(contents.back()) =
+                            dup(std::get<1>(contents.back()), val);
                     }
                     else
                     {
-                        vals[i] = v_it[idx];
-                        bitmap[i] = true;
+                        contents.push_back(std::make_tuple(i, val));
                     }
                 }
 
-                m_vals.swap(vals);
-                m_bitmap.swap(bitmap);
-                m_nvals = nvals;
+                setContents(contents);
             }
 
             void clear()
             {
                 m_nvals = 0;
-                //m_vals.clear();
-                m_bitmap.assign(m_size, false);
+                m_form = VectorForm::SPARSE;
+                m_sparse.clear();
+                release(m_vals);
+                release(m_bitmap);
             }
 
             IndexType size() const { return m_size; }
             IndexType nvals() const { return m_nvals; }
 
+            /// The representation currently used for the stored elements
+            VectorForm form() const { return m_form; }
+
             bool hasElement(IndexType index) const
             {
                 if (index >= m_size)
@@ -327,7 +411,8 @@ namespace GraphBLAS
                     throw IndexOutOfBoundsException();
                 }
 
-                return m_bitmap[index];
+                ScalarT val;
+                return probe(index, val);
             }
 
             /**
@@ -348,12 +433,48 @@ namespace GraphBLAS
                     throw IndexOutOfBoundsException();
                 }
 
-                if (m_bitmap[index] == false)
+                ScalarT val;
+                if (!probe(index, val))
                 {
                     throw NoValueException();
                 }
 
-                return m_vals[index];
+                return val;
+            }
+
+            /**
+             * @brief Look up an element without bounds checking.
+             *
+             * @param[in]  index  Position to access (must be < size()).
+             * @param[out] val    The stored value, if there is one.
+             *
+             * @return true if there is a stored value at index.
+             */
+            bool probe(IndexType index, ScalarT &val) const
+            {
+                switch (m_form)
+                {
+                case VectorForm::SPARSE:
+                {
+                    auto it = sparse_lower_bound(index);
+                    if ((it == m_sparse.end()) || (std::get<0>(*it) != index))
+                    {
+                        return false;
+                    }
+                    val = std::get<1>(*it);
+                    return true;
+                }
+                case VectorForm::BITMAP:
+                    if (!bitmap_test(m_bitmap, index))
+                    {
+                        return false;
+                    }
+                    val = m_vals[index];
+                    return true;
+                default:
+                    val = m_vals[index];
+                    return true;
+                }
             }
 
             /// @todo Not certain about this implementation
@@ -364,11 +485,77 @@ namespace GraphBLAS
                 {
                     throw IndexOutOfBoundsException();
                 }
-                m_vals[index] = new_val;
-                if (m_bitmap[index] == false)
+
+                switch (m_form)
+                {
+                case VectorForm::SPARSE:
+                {
+                    // Appending in increasing index order is O(1)
+                    if (m_sparse.empty() ||
+                        (std::get<0>(m_sparse.back()) < index))
+                    {
+                        m_sparse.push_back(std::make_tuple(index, new_val));
+                        ++m_nvals;
+                    }
+                    else
+                    {
+                        auto it = sparse_lower_bound(index);
+                        if (std::get<0>(*it) == index)
+                        {
+                            std::get<1>(*it) = new_val;
+                        }
+                        else
+                        {
+                            m_sparse.insert(it, std::make_tuple(index, new_val));
+                            ++m_nvals;
+                        }
+                    }
+                    break;
+                }
+                case VectorForm::BITMAP:
+                    m_vals[index] = new_val;
+                    if (!bitmap_test(m_bitmap, index))
+                    {
+                        ++m_nvals;
+                        bitmap_set(m_bitmap, index);
+                    }
+                    break;
+                default:
+                    m_vals[index] = new_val;
+                    break;
+                }
+
+                update_form();
+            }
+
+            /// Replace every stored value v with fn(v), keeping the stored
+            /// elements (and the form) as they are.
+            template <typename FunctionT>
+            void transformValues(FunctionT fn)
+            {
+                switch (m_form)
                 {
-                    ++m_nvals;
-                    m_bitmap[index] = true;
+                case VectorForm::SPARSE:
+                    for (auto &elt : m_sparse)
+                    {
+                        std::get<1>(elt) = fn(std::get<1>(elt));
+                    }
+                    break;
+                case VectorForm::BITMAP:
+                    for (IndexType idx = 0; idx < m_size; ++idx)
+                    {
+                        if (bitmap_test(m_bitmap, idx))
+                        {
+                            m_vals[idx] = fn(m_vals[idx]);
+                        }
+                    }
+                    break;
+                default:
+                    for (IndexType idx = 0; idx < m_size; ++idx)
+                    {
+                        m_vals[idx] = fn(m_vals[idx]);
+                    }
+                    break;
                 }
             }
 
@@ -377,13 +564,10 @@ namespace GraphBLAS
             void extractTuples(RAIteratorIT        i_it,
                                RAIteratorVT        v_it) const
             {
-                for (IndexType idx = 0; idx < m_size; ++idx)
+                for (auto it = begin(); it != end(); ++it)
                 {
-                    if (m_bitmap[idx])
-                    {
-                        *i_it = idx; ++i_it;
-                        *v_it = m_vals[idx]; ++v_it;
-                    }
+                    *i_it = std::get<0>(*it); ++i_it;
+                    *v_it = std::get<1>(*it); ++v_it;
                 }
             }
 
@@ -400,11 +584,12 @@ namespace GraphBLAS
                 //os << "size  = " << m_size;
                 //os << ", nvals = " << m_nvals << std::endl;
                 //os << "contents: [";
+                ScalarT val;
                 os << "[";
-                if (m_bitmap[0]) os << m_vals[0]; else os << "-";
+                if (probe(0, val)) os << val; else os << "-";
                 for (IndexType idx = 1; idx < m_size; ++idx)
                 {
-                    if (m_bitmap[idx]) os << ", " << m_vals[idx]; else os << ", -";
+                    if (probe(idx, val)) os << ", " << val; else os << ", -";
                 }
                 os << "]";
             }
@@ -416,41 +601,325 @@ namespace GraphBLAS
                 return os;
             }
 
-            std::vector<bool> const &get_bitmap() const { return m_bitmap; }
+            /**
+             * @brief Forward iterator over the stored elements in increasing
+             *        index order.
+             *
+             * Lets the backend walk the contents in place instead of
+             * materializing them with getContents().
+             */
+            class const_iterator
+            {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef std::tuple<IndexType, ScalarT> value_type;
+                typedef std::ptrdiff_t                 difference_type;
+                typedef value_type const              *pointer;
+                typedef value_type                     reference;
+
+                /// @param[in] pos  Position in the sparse list, or the index
+                ///                 for the other forms
+                const_iterator(BitmapSparseVector<ScalarT> const &vec,
+                               IndexType                          pos)
+                    : m_vec(&vec),
+                      m_pos(pos)
+                {
+                    skip_unstored();
+                }
+
+                value_type operator*() const
+                {
+                    if (m_vec->m_form == VectorForm::SPARSE)
+                    {
+                        return m_vec->m_sparse[m_pos];
+                    }
+                    return std::make_tuple(m_pos, m_vec->m_vals[m_pos]);
+                }
+
+                const_iterator &operator++()
+                {
+                    ++m_pos;
+                    skip_unstored();
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator tmp(*this);
+                    ++(*this);
+                    return tmp;
+                }
+
+                bool operator==(const_iterator const &rhs) const
+                {
+                    return (m_pos == rhs.m_pos);
+                }
+
+                bool operator!=(const_iterator const &rhs) const
+                {
+                    return (m_pos != rhs.m_pos);
+                }
+
+            private:
+                void skip_unstored()
+                {
+                    if (m_vec->m_form == VectorForm::BITMAP)
+                    {
+                        m_pos = bitmap_find_next(m_vec->m_bitmap,
+                                                 m_vec->m_size, m_pos);
+                    }
+                }
+
+                BitmapSparseVector<ScalarT> const *m_vec;
+                IndexType                          m_pos;
+            };
+
+            const_iterator begin() const { return const_iterator(*this, 0); }
+            const_iterator end() const
+            {
+                return const_iterator(*this,
+                                      (m_form == VectorForm::SPARSE) ?
+                                      m_sparse.size() : m_size);
+            }
+
+            /**
+             * @brief Place the stored values on the NUMA nodes.  The contents
+             *        do not change.
+             *
+             * INTERLEAVE copies the arrays of the current form on a thread
+             * whose pages are interleaved over the nodes, and FIRST_TOUCH
+             * moves equal blocks of them to the nodes of the threads of an
+             * OpenMP team.  Arrays made later (when the form changes, for
+             * example) are placed where they are first written.
+             *
+             * @throw InvalidValueException for REPLICATE (matrices only).
+             */
+            void place(NumaPolicy policy)
+            {
+                if (policy == NumaPolicy::REPLICATE)
+                {
+                    throw InvalidValueException(
+                        "BitmapSparseVector::place: vectors are not replicated");
+                }
+
+                if (policy == NumaPolicy::INTERLEAVE)
+                {
+                    numa_run_placed(
+                        -1,
+                        [&]()
+                        {
+                            std::vector<std::tuple<IndexType, ScalarT> >(
+                                m_sparse).swap(m_sparse);
+                            std::vector<ScalarT>(m_vals).swap(m_vals);
+                            std::vector<BitmapWord>(m_bitmap).swap(m_bitmap);
+                        });
+                }
+                else if (policy == NumaPolicy::FIRST_TOUCH)
+                {
+                    numa_spread_blocks(m_sparse);
+                    numa_spread_blocks(m_vals);
+                    numa_spread_blocks(m_bitmap);
+                }
+
+                m_placement = policy;
+            }
+
+            /// The policy the stored values were last placed with.
+            NumaPolicy placement() const { return m_placement; }
+
+            /// The node holding the start of the stored values, or -1 when
+            /// there are none (or it cannot be found).
+            int values_node() const
+            {
+                return (m_form == VectorForm::SPARSE) ?
+                    numa_node_of(m_sparse) : numa_node_of(m_vals);
+            }
+
+            /// The sorted (index, value) list (SPARSE form only)
+            std::vector<std::tuple<IndexType,ScalarT> > const &get_sparse() const
+            {
+                return m_sparse;
+            }
+
+            /// The bitmap of stored elements, packed into words (BITMAP form
+            /// only, see bitmap_helpers.hpp)
+            std::vector<BitmapWord> const &get_bitmap() const { return m_bitmap; }
+
+            /// The dense array of values (BITMAP and DENSE forms only)
             std::vector<ScalarT> const &get_vals() const { return m_vals; }
 
+            /// Word word_idx of the bitmap of stored elements (BITMAP and
+            /// DENSE forms only)
+            BitmapWord stored_word(IndexType word_idx) const
+            {
+                return ((m_form == VectorForm::DENSE) ?
+                        bitmap_valid_bits(m_size, word_idx) :
+                        m_bitmap[word_idx]);
+            }
+
             std::vector<std::tuple<IndexType,ScalarT> > getContents() const
             {
                 std::vector<std::tuple<IndexType,ScalarT> > contents;
                 contents.reserve(m_nvals);
-                for (IndexType idx = 0; idx < m_size; ++idx)
+                for (auto it = begin(); it != end(); ++it)
                 {
-                    if (m_bitmap[idx])
-                    {
-                        contents.push_back(std::make_tuple(idx, m_vals[idx]));
-                    }
+                    contents.push_back(*it);
                 }
                 return contents;
             }
 
+            /// Replace the contents; they must be in increasing index order.
             template <typename OtherScalarT>
             void setContents(
                 std::vector<std::tuple<IndexType,OtherScalarT> > const &contents)
             {
-                clear();
-                for (auto tupl : contents)
+                m_nvals = contents.size();
+                VectorForm form(preferred_form(m_nvals));
+
+                switch (form)
                 {
-                    ++m_nvals;
-                    m_bitmap[std::get<0>(tupl)] = true;
-                    m_vals[std::get<0>(tupl)] = static_cast<ScalarT>(std::get<1>(tupl));
+                case VectorForm::SPARSE:
+                    m_sparse.clear();
+                    m_sparse.reserve(m_nvals);
+                    for (auto const &tupl : contents)
+                    {
+                        m_sparse.push_back(std::make_tuple(
+                            std::get<0>(tupl),
+                            static_cast<ScalarT>(std::get<1>(tupl))));
+                    }
+                    release(m_vals);
+                    release(m_bitmap);
+                    break;
+
+                case VectorForm::BITMAP:
+                    m_vals.resize(m_size);
+                    m_bitmap.assign(bitmap_num_words(m_size), 0);
+                    for (auto const &tupl : contents)
+                    {
+                        bitmap_set(m_bitmap, std::get<0>(tupl));
+                        m_vals[std::get<0>(tupl)] =
+                            static_cast<ScalarT>(std::get<1>(tupl));
+                    }
+                    release(m_sparse);
+                    break;
+
+                default:
+                    m_vals.resize(m_size);
+                    for (auto const &tupl : contents)
+                    {
+                        m_vals[std::get<0>(tupl)] =
+                            static_cast<ScalarT>(std::get<1>(tupl));
+                    }
+                    release(m_sparse);
+                    release(m_bitmap);
+                    break;
                 }
+
+                m_form = form;
             }
 
         private:
+            template <typename T>
+            static void release(std::vector<T> &storage)
+            {
+                std::vector<T>().swap(storage);
+            }
+
+            typename std::vector<std::tuple<IndexType,ScalarT> >::const_iterator
+            sparse_lower_bound(IndexType index) const
+            {
+                return std::lower_bound(
+                    m_sparse.begin(), m_sparse.end(), index,
+                    [](std::tuple<IndexType, ScalarT> const &tupl, IndexType idx)
+                    { return std::get<0>(tupl) < idx; });
+            }
+
+            typename std::vector<std::tuple<IndexType,ScalarT> >::iterator
+            sparse_lower_bound(IndexType index)
+            {
+                return std::lower_bound(
+                    m_sparse.begin(), m_sparse.end(), index,
+                    [](std::tuple<IndexType, ScalarT> const &tupl, IndexType idx)
+                    { return std::get<0>(tupl) < idx; });
+            }
+
+            /// The form for nvals stored elements given the current form
+            VectorForm preferred_form(IndexType nvals) const
+            {
+                if (nvals == m_size)
+                {
+                    return VectorForm::DENSE;
+                }
+                else if (m_form == VectorForm::SPARSE)
+                {
+                    return ((nvals > m_size/SPARSE_TO_BITMAP) ?
+                            VectorForm::BITMAP : VectorForm::SPARSE);
+                }
+                else
+                {
+                    return ((nvals < m_size/BITMAP_TO_SPARSE) ?
+                            VectorForm::SPARSE : VectorForm::BITMAP);
+                }
+            }
+
+            /// Convert the storage if nvals calls for a different form
+            void update_form()
+            {
+                VectorForm form(preferred_form(m_nvals));
+                if (form == m_form)
+                {
+                    return;
+                }
+
+                if (form == VectorForm::SPARSE)
+                {
+                    m_sparse.clear();
+                    m_sparse.reserve(m_nvals);
+                    for (auto it = begin(); it != end(); ++it)
+                    {
+                        m_sparse.push_back(*it);
+                    }
+                    release(m_vals);
+                    release(m_bitmap);
+                }
+                else if (m_form == VectorForm::SPARSE)
+                {
+                    m_vals.resize(m_size);
+                    if (form == VectorForm::BITMAP)
+                    {
+                        m_bitmap.assign(bitmap_num_words(m_size), 0);
+                    }
+                    for (auto const &tupl : m_sparse)
+                    {
+                        m_vals[std::get<0>(tupl)] = std::get<1>(tupl);
+                        if (form == VectorForm::BITMAP)
+                        {
+                            bitmap_set(m_bitmap, std::get<0>(tupl));
+                        }
+                    }
+                    release(m_sparse);
+                }
+                else if (form == VectorForm::DENSE)
+                {
+                    release(m_bitmap);
+                }
+                else
+                {
+                    bitmap_fill(m_bitmap, m_size);
+                }
+
+                m_form = form;
+            }
+
             IndexType const       m_size;   // immutable after construction
             IndexType             m_nvals;
-            std::vector<ScalarT>  m_vals;
-            std::vector<bool>     m_bitmap;
+            VectorForm            m_form;
+
+            std::vector<std::tuple<IndexType,ScalarT> > m_sparse;
+            std::vector<ScalarT>    m_vals;
+            std::vector<BitmapWord> m_bitmap;
+
+            NumaPolicy              m_placement{NumaPolicy::NONE};
         };
     } // backend
 } // GraphBLAS
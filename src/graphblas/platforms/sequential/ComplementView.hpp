@@ -30,7 +30,12 @@
 #ifndef GB_SEQUENTIAL_NEW_COMPLEMENT_VIEW_HPP
 #define GB_SEQUENTIAL_NEW_COMPLEMENT_VIEW_HPP
 
+#include <tuple>
+#include <iterator>
+#include <vector>
+
 #include <graphblas/platforms/sequential/Matrix.hpp>
+#include <graphblas/platforms/sequential/bitmap_helpers.hpp>
 
 namespace GraphBLAS
 {
@@ -279,6 +284,9 @@ namespace GraphBLAS
                 }
             }
 
+            /// The matrix whose structure this view complements.
+            MatrixT const &matrix() const { return m_matrix; }
+
             void printInfo(std::ostream &os) const
             {
                 os << "Backend MatrixComplementView of:" << std::endl;
@@ -345,6 +353,9 @@ namespace GraphBLAS
             typedef bool ScalarType;
             typedef typename VectorT::ScalarType InternalScalarType;
 
+            /// The elements of the complement are visited as (index, true)
+            typedef std::tuple<IndexType, bool> value_type;
+
             // CONSTRUCTORS
 
             VectorComplementView(VectorT const &vector):
@@ -372,17 +383,15 @@ namespace GraphBLAS
             IndexType size() const  { return m_vector.size(); }
             IndexType nvals() const
             {
-                // THIS IS COSTLY
+                // One popcount per 64 elements
                 IndexType num_vals(0);
-                auto bitmap(m_vector.get_bitmap());
-                auto vals(m_vector.get_vals());
-
-                for (IndexType idx = 0; idx < size(); ++idx)
+                IndexType sparse_pos(0);
+                for (IndexType word_idx = 0;
+                     word_idx < bitmap_num_words(size());
+                     ++word_idx)
                 {
-                    if (!bitmap[idx] || !vals[idx])
-                    {
-                        ++num_vals;
-                    }
+                    num_vals += popcount(
+                        complement_word(m_vector, word_idx, sparse_pos));
                 }
                 return num_vals;
             }
@@ -462,23 +471,124 @@ namespace GraphBLAS
                 throw GraphBLAS::NoValueException();
             }
 
-            std::vector<std::tuple<IndexType, bool> > getContents() const
+            /**
+             * @brief Forward iterator over the elements of the complement
+             *        (the indices with no stored value, or a stored value
+             *        that evaluates to false) in increasing index order,
+             *        whatever the form of the underlying vector.
+             *
+             * The complement is built 64 elements at a time and the
+             * iterator jumps between its set bits.
+             */
+            class const_iterator
             {
-                auto bitmap(m_vector.get_bitmap());
-                auto vals(m_vector.get_vals());
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef std::tuple<IndexType, bool>   value_type;
+                typedef std::ptrdiff_t                difference_type;
+                typedef value_type const             *pointer;
+                typedef value_type                    reference;
+
+                const_iterator(VectorT const &vec, IndexType index)
+                    : m_vec(&vec),
+                      m_index(index),
+                      m_word_idx(index/BITMAP_WORD_BITS),
+                      m_word(0),
+                      m_sparse_pos(0)
+                {
+                    if (m_index < m_vec->size())
+                    {
+                        if (m_vec->form() == VectorForm::SPARSE)
+                        {
+                            // Start the cursor at the word holding index
+                            auto const &sparse(m_vec->get_sparse());
+                            IndexType first(m_word_idx*BITMAP_WORD_BITS);
+                            while ((m_sparse_pos < sparse.size()) &&
+                                   (std::get<0>(sparse[m_sparse_pos]) < first))
+                            {
+                                ++m_sparse_pos;
+                            }
+                        }
+                        m_word = (complement_word(*m_vec, m_word_idx,
+                                                  m_sparse_pos) &
+                                  (~BitmapWord(0) << (m_index%BITMAP_WORD_BITS)));
+                        find_next();
+                    }
+                }
 
-                std::vector<std::tuple<IndexType, bool> > contents;
-                //contents.reserve(nvals());
-                for (IndexType idx = 0; idx < size(); ++idx)
+                value_type operator*() const
                 {
-                    if (!bitmap[idx] || !vals[idx])
+                    return std::make_tuple(m_index, true);
+                }
+
+                const_iterator &operator++()
+                {
+                    m_word &= (m_word - 1);   // clear the current bit
+                    find_next();
+                    return *this;
+                }
+
+                const_iterator operator++(int)
+                {
+                    const_iterator tmp(*this);
+                    ++(*this);
+                    return tmp;
+                }
+
+                bool operator==(const_iterator const &rhs) const
+                {
+                    return (m_index == rhs.m_index);
+                }
+
+                bool operator!=(const_iterator const &rhs) const
+                {
+                    return (m_index != rhs.m_index);
+                }
+
+            private:
+                // Move m_index to the lowest set bit, loading words as needed
+                void find_next()
+                {
+                    IndexType num_words(bitmap_num_words(m_vec->size()));
+                    while (m_word == 0)
                     {
-                        contents.push_back(std::make_tuple(idx, true));
+                        if (++m_word_idx >= num_words)
+                        {
+                            m_index = m_vec->size();
+                            return;
+                        }
+                        m_word = complement_word(*m_vec, m_word_idx,
+                                                 m_sparse_pos);
                     }
+                    m_index = (m_word_idx*BITMAP_WORD_BITS +
+                               count_trailing_zeros(m_word));
                 }
-                return contents;
+
+                VectorT const *m_vec;
+                IndexType      m_index;
+                IndexType      m_word_idx;
+                BitmapWord     m_word;
+                IndexType      m_sparse_pos;
+            };
+
+            const_iterator begin() const
+            {
+                return const_iterator(m_vector, 0);
+            }
+
+            const_iterator end() const
+            {
+                return const_iterator(m_vector, size());
+            }
+
+            std::vector<std::tuple<IndexType, bool> > getContents() const
+            {
+                return std::vector<std::tuple<IndexType, bool> >(begin(), end());
             }
 
+            /// The vector whose structure this view complements.
+            VectorT const &vector() const { return m_vector; }
+
             void printInfo(std::ostream &os) const
             {
                 os << "Backend VectorComplementView of:" << std::endl;
@@ -516,6 +626,79 @@ namespace GraphBLAS
             operator=(VectorComplementView<VectorT> const &rhs) = delete;
 
         private:
+            /**
+             * @brief Bit b is set if element word_idx*64 + b is in the
+             *        complement.
+             *
+             * Only the stored elements are visited one at a time (to test
+             * their values); the rest of the word comes from a single
+             * complement of the bitmap.
+             *
+             * @param[in,out] sparse_pos  Cursor into the sparse list of vec
+             *                            (SPARSE form), at or before the
+             *                            word; it is left after the word.
+             */
+            static BitmapWord complement_word(VectorT const &vec,
+                                              IndexType      word_idx,
+                                              IndexType     &sparse_pos)
+            {
+                IndexType  first(word_idx*BITMAP_WORD_BITS);
+                BitmapWord valid(bitmap_valid_bits(vec.size(), word_idx));
+                BitmapWord word(0);
+
+                switch (vec.form())
+                {
+                case VectorForm::SPARSE:
+                {
+                    auto const &sparse(vec.get_sparse());
+                    IndexType   last(first + BITMAP_WORD_BITS);
+                    word = valid;
+                    while ((sparse_pos < sparse.size()) &&
+                           (std::get<0>(sparse[sparse_pos]) < last))
+                    {
+                        if (static_cast<bool>(std::get<1>(sparse[sparse_pos])))
+                        {
+                            word &= ~(BitmapWord(1) <<
+                                      (std::get<0>(sparse[sparse_pos]) - first));
+                        }
+                        ++sparse_pos;
+                    }
+                    break;
+                }
+                case VectorForm::BITMAP:
+                {
+                    auto const &vals(vec.get_vals());
+                    BitmapWord  stored(vec.get_bitmap()[word_idx]);
+                    word = (~stored & valid);
+                    for (; stored != 0; stored &= (stored - 1))
+                    {
+                        IndexType bit(count_trailing_zeros(stored));
+                        if (!static_cast<bool>(vals[first + bit]))
+                        {
+                            word |= (BitmapWord(1) << bit);
+                        }
+                    }
+                    break;
+                }
+                default:
+                {
+                    auto const &vals(vec.get_vals());
+                    for (IndexType bit = 0;
+                         (bit < BITMAP_WORD_BITS) && (first + bit < vec.size());
+                         ++bit)
+                    {
+                        if (!static_cast<bool>(vals[first + bit]))
+                        {
+                            word |= (BitmapWord(1) << bit);
+                        }
+                    }
+                    break;
+                }
+                }
+
+                return word;
+            }
+
             VectorT const &m_vector;
         };
 
@@ -30,12 +30,17 @@
 #ifndef GB_SEQUENTIAL_LILSPARSEMATRIX_HPP
 #define GB_SEQUENTIAL_LILSPARSEMATRIX_HPP
 
+#include <atomic>
 #include <iostream>
+#include <mutex>
 #include <vector>
+#include <utility>
 #include <typeinfo>
 #include <stdexcept>
 
 #include <graphblas/graphblas.hpp>
+#include <graphblas/platforms/sequential/build_helpers.hpp>
+#include <graphblas/platforms/sequential/NumaPlacement.hpp>
 
 //****************************************************************************
 
@@ -69,6 +74,19 @@ namespace GraphBLAS
             {
             }
 
+            // Constructor - move
+            LilSparseMatrix(LilSparseMatrix<ScalarT> &&rhs)
+                : m_num_rows(rhs.m_num_rows),
+                  m_num_cols(rhs.m_num_cols),
+                  m_nvals(rhs.m_nvals),
+                  m_data(std::move(rhs.m_data))
+            {
+                // leave rhs as a valid empty matrix of the same shape
+                rhs.m_nvals = 0;
+                rhs.m_data.resize(rhs.m_num_rows);
+                rhs.contents_changed();
+            }
+
             // Constructor - dense from dense matrix
             LilSparseMatrix(std::vector<std::vector<ScalarT>> const &val)
                 : m_num_rows(val.size()),
@@ -135,10 +153,47 @@ namespace GraphBLAS
 
                     m_nvals = rhs.m_nvals;
                     m_data = rhs.m_data;
+                    contents_changed();
+                }
+                return *this;
+            }
+
+            // Move assignment (currently restricted to same dimensions)
+            LilSparseMatrix<ScalarT> &operator=(LilSparseMatrix<ScalarT> &&rhs)
+            {
+                if (this != &rhs)
+                {
+                    // push this check to frontend
+                    if ((m_num_rows != rhs.m_num_rows) ||
+                        (m_num_cols != rhs.m_num_cols))
+                    {
+                        throw DimensionException();
+                    }
+
+                    swap(rhs);
+                    rhs.clear();
                 }
                 return *this;
             }
 
+            /**
+             * @brief Exchange the stored values of two matrices of the same
+             *        shape without copying any rows.
+             */
+            void swap(LilSparseMatrix<ScalarT> &rhs)
+            {
+                if ((m_num_rows != rhs.m_num_rows) ||
+                    (m_num_cols != rhs.m_num_cols))
+                {
+                    throw DimensionException("LilSparseMatrix::swap");
+                }
+
+                std::swap(m_nvals, rhs.m_nvals);
+                m_data.swap(rhs.m_data);
+                contents_changed();
+                rhs.contents_changed();
+            }
+
             // EQUALITY OPERATORS
             /**
              * @brief Equality testing for LilMatrix.
@@ -163,6 +218,15 @@ namespace GraphBLAS
                 return !(*this == rhs);
             }
 
+            /**
+             * @brief Add the tuples (i_it[k], j_it[k], v_it[k]), k < n.
+             *
+             * Values for the same location, including one already stored,
+             * are combined with dup in input order, as if each tuple were
+             * set with setElement.  The tuples are grouped by row with a
+             * counting sort and each row is then sorted and merged on its
+             * own, concurrently when compiled with OpenMP.
+             */
             template<typename RAIteratorI,
                      typename RAIteratorJ,
                      typename RAIteratorV,
@@ -175,21 +239,51 @@ namespace GraphBLAS
             {
                 /// @todo should this function throw an error if matrix is not empty
 
-                /// @todo should this function call clear?
-                //clear();
+                if (!indices_in_range(i_it, n, m_num_rows) ||
+                    !indices_in_range(j_it, n, m_num_cols))
+                {
+                    throw IndexOutOfBoundsException(
+                        "build: index out of bounds");
+                }
+
+                std::vector<IndexType> offsets, order;
+                group_by_key(offsets, order, m_num_rows, n,
+                             [&](IndexType pos)
+                             { return static_cast<IndexType>(i_it[pos]); });
+
+                IndexType nvals = 0;
 
-                /// @todo DOING SOMETHING REALLY STUPID RIGHT NOW
-                for (IndexType ix = 0; ix < n; ++ix)
+#pragma omp parallel for schedule(dynamic, 64) reduction(+:nvals) if(n >= BUILD_PARALLEL_MIN)
+                for (IndexType row = 0; row < m_num_rows; ++row)
                 {
-                    setElement(*i_it, *j_it, *v_it, dup);
-                    ++i_it; ++j_it; ++v_it;
+                    auto first(order.begin() + offsets[row]);
+                    auto last(order.begin() + offsets[row + 1]);
+                    if (first != last)
+                    {
+                        std::sort(first, last,
+                                  [&](IndexType lhs, IndexType rhs)
+                                  {
+                                      IndexType lhs_col(j_it[lhs]);
+                                      IndexType rhs_col(j_it[rhs]);
+                                      return ((lhs_col < rhs_col) ||
+                                              ((lhs_col == rhs_col) &&
+                                               (lhs < rhs)));
+                                  });
+                        merge_into_row(m_data[row], first, last,
+                                       j_it, v_it, dup);
+                    }
+                    nvals += m_data[row].size();
                 }
+
+                m_nvals = nvals;
+                contents_changed();
             }
 
             void clear()
             {
                 /// @todo make atomic? transactional?
                 m_nvals = 0;
+                contents_changed();
                 for (IndexType row = 0; row < m_data.size(); ++row)
                 {
                     m_data[row].clear();
@@ -277,6 +371,7 @@ namespace GraphBLAS
                 {
                     throw IndexOutOfBoundsException("setElement: index out of bounds");
                 }
+                contents_changed();
 
                 if (m_data[irow].empty())
                 {
@@ -323,6 +418,7 @@ namespace GraphBLAS
                     throw IndexOutOfBoundsException(
                         "setElement(merge): index out of bounds");
                 }
+                contents_changed();
 
                 if (m_data[irow].empty())
                 {
@@ -357,7 +453,118 @@ namespace GraphBLAS
             typedef std::vector<std::tuple<IndexType, ScalarT>> const & RowType;
             RowType getRow(IndexType row_index) const
             {
-                return m_data[row_index];
+                if (m_replicas.empty())
+                {
+                    return m_data[row_index];
+                }
+                return m_replicas[numa_current_node() % m_replicas.size()][row_index];
+            }
+
+            /**
+             * @brief Replace every stored value v of a row with fn(v).  The
+             *        structure of the row is not changed, so different rows
+             *        can be transformed concurrently.
+             */
+            template <typename FunctionT>
+            void transformRow(IndexType row_index, FunctionT fn)
+            {
+                for (auto &elt : m_data[row_index])
+                {
+                    std::get<1>(elt) = fn(std::get<1>(elt));
+                }
+                for (auto &replica : m_replicas)
+                {
+                    replica[row_index] = m_data[row_index];
+                }
+            }
+
+            /**
+             * @brief Place the rows on the NUMA nodes.  The contents do not
+             *        change.
+             *
+             * The rows are copied to new storage: for INTERLEAVE by a thread
+             * whose pages are interleaved over the nodes, for FIRST_TOUCH by
+             * the threads of an OpenMP team, one block of rows (with about
+             * the same number of stored values) each, and for REPLICATE
+             * once for every node, by a thread on that node.  getRow then
+             * returns the copy on the calling thread's node.  Any change to
+             * the matrix drops the copies and the policy goes back to NONE.
+             */
+            void place(NumaPolicy policy)
+            {
+                m_replicas.clear();
+
+                if (policy == NumaPolicy::INTERLEAVE)
+                {
+                    numa_run_placed(-1, [&]() { copy_rows(0, m_num_rows); });
+                }
+                else if (policy == NumaPolicy::FIRST_TOUCH)
+                {
+                    std::vector<IndexType> bounds;
+                    numa_partition(bounds, m_num_rows,
+                                   [&](IndexType row_idx)
+                                   { return m_data[row_idx].size(); });
+                    int nblocks(bounds.size() - 1);
+
+#pragma omp parallel for schedule(static, 1)
+                    for (int block = 0; block < nblocks; ++block)
+                    {
+                        copy_rows(bounds[block], bounds[block + 1]);
+                    }
+                }
+                else if (policy == NumaPolicy::REPLICATE)
+                {
+                    int nnodes(numa_num_nodes());
+                    m_replicas.resize(nnodes);
+                    for (int node = 0; node < nnodes; ++node)
+                    {
+                        numa_run_placed(node,
+                                        [&]() { m_replicas[node] = m_data; });
+                    }
+                }
+
+                m_placement = policy;
+            }
+
+            /// The policy the rows were last placed with (NONE once the
+            /// matrix has changed).
+            NumaPolicy placement() const { return m_placement; }
+
+            /// The node holding a row's stored values (of the copy getRow
+            /// returns on the calling thread), or -1 for an empty row.
+            int row_node(IndexType row_index) const
+            {
+                RowType row(getRow(row_index));
+                return numa_node_of(row.empty() ? nullptr : row.data());
+            }
+
+            /**
+             * @brief The number of stored values in the rows before each row.
+             *
+             * Element i is the number of stored values in rows [0, i), so
+             * the result has nrows() + 1 elements and ends with nvals().  It
+             * is computed when first asked for after the matrix changes and
+             * then kept, so a matrix that is only read computes it once.
+             * Concurrent calls on an unchanging matrix are safe.
+             */
+            std::vector<IndexType> const &row_nnz_prefix() const
+            {
+                if (!m_row_prefix_valid.load(std::memory_order_acquire))
+                {
+                    std::lock_guard<std::mutex> lock(m_row_prefix_mutex);
+                    if (!m_row_prefix_valid.load(std::memory_order_relaxed))
+                    {
+                        m_row_prefix.resize(m_num_rows + 1);
+                        m_row_prefix[0] = 0;
+                        for (IndexType row_idx = 0; row_idx < m_num_rows; ++row_idx)
+                        {
+                            m_row_prefix[row_idx + 1] =
+                                m_row_prefix[row_idx] + m_data[row_idx].size();
+                        }
+                        m_row_prefix_valid.store(true, std::memory_order_release);
+                    }
+                }
+                return m_row_prefix;
             }
 
             // Allow casting
@@ -370,6 +577,7 @@ namespace GraphBLAS
                 IndexType new_nvals = row_data.size();
 
                 m_nvals = m_nvals + new_nvals - old_nvals;
+                contents_changed();
                 //m_data[row_index] = row_data;   // swap here?
                 m_data[row_index].clear();
                 for (auto &tupl : row_data)
@@ -389,7 +597,43 @@ namespace GraphBLAS
                 IndexType new_nvals = row_data.size();
 
                 m_nvals = m_nvals + new_nvals - old_nvals;
-                m_data[row_index] = row_data;   // swap here?
+                contents_changed();
+                m_data[row_index] = row_data;
+            }
+
+            // When not casting and the caller is done with the row, take
+            // its storage.  The previous contents of the row are handed back
+            // in row_data so that scratch rows keep their capacity.
+            void setRow(
+                IndexType row_index,
+                std::vector<std::tuple<IndexType, ScalarT> > &&row_data)
+            {
+                IndexType old_nvals = m_data[row_index].size();
+                IndexType new_nvals = row_data.size();
+
+                m_nvals = m_nvals + new_nvals - old_nvals;
+                contents_changed();
+                m_data[row_index].swap(row_data);
+            }
+
+            // Take the storage of every row at once (rows must hold
+            // nrows() rows, each in increasing column order).  The previous
+            // rows are handed back in rows.
+            void setRows(
+                std::vector<std::vector<std::tuple<IndexType, ScalarT> > > &&rows)
+            {
+                if (rows.size() != m_num_rows)
+                {
+                    throw DimensionException("LilSparseMatrix::setRows");
+                }
+
+                m_data.swap(rows);
+                m_nvals = 0;
+                for (auto const &row : m_data)
+                {
+                    m_nvals += row.size();
+                }
+                contents_changed();
             }
 
             /// @todo need move semantics.
@@ -422,6 +666,7 @@ namespace GraphBLAS
                 IndexType col_index,
                 std::vector<std::tuple<IndexType, OtherScalarT> > const &col_data)
             {
+                contents_changed();
                 auto it = col_data.begin();
                 for (IndexType row_index = 0; row_index < m_num_rows; row_index++)
                 {
@@ -560,7 +805,7 @@ namespace GraphBLAS
             template<typename RAIteratorIT,
                      typename RAIteratorJT,
                      typename RAIteratorVT>
-            ScalarT extractTuples(RAIteratorIT        row_it,
+            void extractTuples(RAIteratorIT        row_it,
                                   RAIteratorJT        col_it,
                                   RAIteratorVT        values) const
             {
@@ -667,12 +912,48 @@ namespace GraphBLAS
             }
 
         private:
+            /// Called by every member that changes the contents: the row
+            /// prefix is recomputed when next asked for, and the rows are no
+            /// longer placed by a policy (any replicas are dropped).
+            void contents_changed()
+            {
+                m_row_prefix_valid.store(false, std::memory_order_relaxed);
+                if (m_placement != NumaPolicy::NONE)
+                {
+                    m_placement = NumaPolicy::NONE;
+                    m_replicas.clear();
+                }
+            }
+
+            /// Copy rows [begin, end) to new storage allocated (and first
+            /// touched) by the calling thread.
+            void copy_rows(IndexType begin, IndexType end)
+            {
+                for (IndexType row_idx = begin; row_idx < end; ++row_idx)
+                {
+                    std::vector<std::tuple<IndexType, ScalarT> >
+                        fresh(m_data[row_idx]);
+                    m_data[row_idx].swap(fresh);
+                }
+            }
+
             IndexType m_num_rows;
             IndexType m_num_cols;
             IndexType m_nvals;
 
             // List-of-lists storage (LIL)
             std::vector<std::vector<std::tuple<IndexType, ScalarT>>> m_data;
+
+            // NUMA placement (see place()): replicas holds a copy of the rows
+            // per node when the policy is REPLICATE.
+            NumaPolicy m_placement{NumaPolicy::NONE};
+            std::vector<std::vector<std::vector<std::tuple<IndexType, ScalarT>>>>
+                m_replicas;
+
+            // Cached result of row_nnz_prefix()
+            mutable std::vector<IndexType> m_row_prefix;
+            mutable std::atomic<bool>      m_row_prefix_valid{false};
+            mutable std::mutex             m_row_prefix_mutex;
         };
 
     } // namespace backend
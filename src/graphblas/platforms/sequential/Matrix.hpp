@@ -30,6 +30,7 @@
 #pragma once
 
 #include <cstddef>
+#include <utility>
 #include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
 
 //****************************************************************************
@@ -75,6 +76,12 @@ namespace GraphBLAS
             {
             }
 
+            // move construct
+            Matrix(Matrix &&rhs)
+                : LilSparseMatrix<ScalarT>(std::move(rhs))
+            {
+            }
+
             // construct a dense matrix from dense data.
             Matrix(std::vector<std::vector<ScalarT> > const &values)
                 : LilSparseMatrix<ScalarT>(values)
@@ -90,6 +97,18 @@ namespace GraphBLAS
 
             ~Matrix() {}  // virtual?
 
+            Matrix &operator=(Matrix const &rhs)
+            {
+                LilSparseMatrix<ScalarT>::operator=(rhs);
+                return *this;
+            }
+
+            Matrix &operator=(Matrix &&rhs)
+            {
+                LilSparseMatrix<ScalarT>::operator=(std::move(rhs));
+                return *this;
+            }
+
             // necessary?
             bool operator==(Matrix const &rhs) const
             {
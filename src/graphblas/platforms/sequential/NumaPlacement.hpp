@@ -0,0 +1,287 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * NUMA placement of container storage.  With GB_USE_LIBNUMA defined (and
+ * libnuma linked) the functions here query and control which node holds
+ * a page.  Otherwise, or when the system has no NUMA support, there is
+ * one node and placement does nothing, so the same code runs everywhere.
+ */
+
+#ifndef GB_SEQUENTIAL_NUMA_PLACEMENT_HPP
+#define GB_SEQUENTIAL_NUMA_PLACEMENT_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#ifdef GB_USE_LIBNUMA
+#include <numa.h>
+#include <numaif.h>
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// Whether placement has an effect on this system.
+        inline bool numa_enabled()
+        {
+#ifdef GB_USE_LIBNUMA
+            static bool const enabled(numa_available() >= 0);
+            return enabled;
+#else
+            return false;
+#endif
+        }
+
+        /// The number of NUMA nodes.
+        inline int numa_num_nodes()
+        {
+#ifdef GB_USE_LIBNUMA
+            if (numa_enabled())
+            {
+                return numa_max_node() + 1;
+            }
+#endif
+            return 1;
+        }
+
+        /// The node of the CPU the calling thread ran on when it first
+        /// asked (threads that care about placement are bound to a node).
+        inline int numa_current_node()
+        {
+#ifdef GB_USE_LIBNUMA
+            static thread_local int node(-1);
+            if (node < 0)
+            {
+                node = numa_enabled() ?
+                    std::max(numa_node_of_cpu(sched_getcpu()), 0) : 0;
+            }
+            return node;
+#else
+            return 0;
+#endif
+        }
+
+        /// The node holding the page at addr, or -1 for no address.
+        inline int numa_node_of(void const *addr)
+        {
+            if (addr == nullptr)
+            {
+                return -1;
+            }
+#ifdef GB_USE_LIBNUMA
+            if (numa_enabled())
+            {
+                int node(-1);
+                if (get_mempolicy(&node, nullptr, 0, const_cast<void *>(addr),
+                                  MPOL_F_NODE | MPOL_F_ADDR) == 0)
+                {
+                    return node;
+                }
+            }
+#endif
+            return 0;
+        }
+
+        //********************************************************************
+        /**
+         * @brief Run fn on a thread whose new pages are placed on node, or
+         *        interleaved over all nodes when node is negative.
+         *
+         * Without NUMA support fn runs on the calling thread.
+         */
+        template <typename FunctionT>
+        void numa_run_placed(int node, FunctionT fn)
+        {
+#ifdef GB_USE_LIBNUMA
+            if (numa_enabled())
+            {
+                std::exception_ptr error;
+                std::thread placed(
+                    [&]()
+                    {
+                        try
+                        {
+                            if (node < 0)
+                            {
+                                numa_set_interleave_mask(numa_all_nodes_ptr);
+                            }
+                            else
+                            {
+                                numa_run_on_node(node);
+                                numa_set_preferred(node);
+                            }
+                            fn();
+                        }
+                        catch (...)
+                        {
+                            error = std::current_exception();
+                        }
+                    });
+                placed.join();
+                if (error)
+                {
+                    std::rethrow_exception(error);
+                }
+                return;
+            }
+#endif
+            fn();
+        }
+
+        /// Move the pages holding [begin, begin + bytes) to node.
+        inline void numa_move_range(void const *begin, std::size_t bytes,
+                                    int node)
+        {
+#ifdef GB_USE_LIBNUMA
+            if (!numa_enabled() || (bytes == 0))
+            {
+                return;
+            }
+
+            std::uintptr_t page_size(numa_pagesize());
+            std::uintptr_t first(reinterpret_cast<std::uintptr_t>(begin) &
+                                 ~(page_size - 1));
+            std::uintptr_t last(reinterpret_cast<std::uintptr_t>(begin) + bytes);
+
+            std::vector<void *> pages;
+            for (std::uintptr_t page = first; page < last; page += page_size)
+            {
+                pages.push_back(reinterpret_cast<void *>(page));
+            }
+            std::vector<int> nodes(pages.size(), node);
+            std::vector<int> status(pages.size());
+            numa_move_pages(0, pages.size(), pages.data(), nodes.data(),
+                            status.data(), MPOL_MF_MOVE);
+#endif
+        }
+
+        //********************************************************************
+        /**
+         * @brief Divide [0, n) into one block per thread for first-touch
+         *        placement, weighting element i by weight(i).
+         *
+         * bounds gets the number of threads + 1 elements.
+         */
+        template <typename WeightFunctionT>
+        void numa_partition(std::vector<IndexType> &bounds,
+                            IndexType               n,
+                            WeightFunctionT         weight)
+        {
+            int nthreads = 1;
+#ifdef _OPENMP
+            nthreads = omp_get_max_threads();
+#endif
+            IndexType total(0);
+            for (IndexType idx = 0; idx < n; ++idx)
+            {
+                total += weight(idx) + 1;
+            }
+
+            bounds.assign(nthreads + 1, n);
+            bounds[0] = 0;
+            IndexType idx(0), sum(0);
+            for (int block = 1; block < nthreads; ++block)
+            {
+                IndexType target((total * block) / nthreads);
+                while ((idx < n) && (sum < target))
+                {
+                    sum += weight(idx) + 1;
+                    ++idx;
+                }
+                bounds[block] = idx;
+            }
+        }
+
+        //********************************************************************
+        /// Move equal blocks of an array to the nodes of the threads of an
+        /// OpenMP team, one block each.
+        template <typename ElementT>
+        void numa_spread_blocks(std::vector<ElementT> const &arr)
+        {
+            if (!numa_enabled() || arr.empty())
+            {
+                return;
+            }
+
+            int nblocks = 1;
+#ifdef _OPENMP
+            nblocks = omp_get_max_threads();
+#endif
+            IndexType n(arr.size());
+
+#pragma omp parallel for schedule(static, 1)
+            for (int block = 0; block < nblocks; ++block)
+            {
+                IndexType begin((n * block) / nblocks);
+                IndexType end((n * (block + 1)) / nblocks);
+                numa_move_range(arr.data() + begin,
+                                (end - begin) * sizeof(ElementT),
+                                numa_current_node());
+            }
+        }
+
+        // The elements of a vector<bool> are not addressable
+        inline void numa_spread_blocks(std::vector<bool> const &)
+        {
+        }
+
+        /// The node holding the start of an array, or -1 when it is empty
+        /// (or cannot be found).
+        template <typename ElementT>
+        int numa_node_of(std::vector<ElementT> const &arr)
+        {
+            return numa_node_of(arr.empty() ? nullptr : arr.data());
+        }
+
+        inline int numa_node_of(std::vector<bool> const &)
+        {
+            return -1;
+        }
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_NUMA_PLACEMENT_HPP
@@ -207,6 +207,13 @@ namespace GraphBLAS
                 return m_matrix.getRow(col_index);
             }
 
+            /// The number of stored values in the columns before each column
+            /// (the underlying matrix's row_nnz_prefix).
+            std::vector<IndexType> const &col_nnz_prefix() const
+            {
+                return m_matrix.row_nnz_prefix();
+            }
+
             // Not implemented
             //void setCol(IndexType col_index,
             //            std::vector<std::tuple<IndexType, ScalarType> > &col_data)
@@ -224,6 +231,9 @@ namespace GraphBLAS
                 m_matrix.getColIndices(icol, v);
             }
 
+            /// The matrix that this view transposes.
+            MatrixT const &matrix() const { return m_matrix; }
+
             //other methods that may or may not belong here:
             //
             void printInfo(std::ostream &os) const
@@ -31,6 +31,7 @@
 
 #include <cstddef>
 #include <iostream>
+#include <utility>
 
 #include <graphblas/detail/config.hpp>
 #include <vector>
@@ -65,8 +66,30 @@ namespace GraphBLAS
             Vector(std::vector<ScalarT> const &values, ScalarT const &zero)
                 : ParentVectorType(values, zero) {}
 
+            Vector(Vector const &rhs) : ParentVectorType(rhs) {}
+
+            Vector(Vector &&rhs) : ParentVectorType(std::move(rhs)) {}
+
             ~Vector() {}  // virtual?
 
+            Vector &operator=(Vector const &rhs)
+            {
+                ParentVectorType::operator=(rhs);
+                return *this;
+            }
+
+            Vector &operator=(Vector &&rhs)
+            {
+                ParentVectorType::operator=(std::move(rhs));
+                return *this;
+            }
+
+            Vector &operator=(std::vector<ScalarT> const &rhs)
+            {
+                ParentVectorType::operator=(rhs);
+                return *this;
+            }
+
             // necessary?
             bool operator==(Vector const &rhs) const
             {
@@ -0,0 +1,240 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#ifndef GB_SEQUENTIAL_WORKSPACE_HPP
+#define GB_SEQUENTIAL_WORKSPACE_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        //********************************************************************
+        /// Counters describing the scratch memory held by a Workspace.
+        struct WorkspaceStats
+        {
+            WorkspaceStats()
+                : bytes(0), peak_bytes(0), allocation_count(0), borrow_count(0)
+            {}
+
+            std::size_t bytes;            ///< capacity currently held
+            std::size_t peak_bytes;       ///< high water mark of bytes
+            std::size_t allocation_count; ///< buffers allocated or grown
+            std::size_t borrow_count;     ///< buffers handed out
+        };
+
+        //********************************************************************
+        /**
+         * @brief A per-thread pool of scratch buffers for the backend kernels.
+         *
+         * Kernels borrow the vectors they use for temporary rows and
+         * intermediate results (through ScratchBuffer) instead of
+         * constructing new ones.  Returned buffers are cleared but keep
+         * their capacity, so an iterative algorithm that repeats the same
+         * operations on same-shaped data stops allocating after the first
+         * iteration.
+         */
+        class Workspace
+        {
+        public:
+            /// Maximum number of idle buffers kept for each element type.
+            static constexpr std::size_t MAX_IDLE_BUFFERS = 32;
+
+            /// The workspace of the calling thread.
+            static Workspace &instance()
+            {
+                static thread_local Workspace workspace;
+                return workspace;
+            }
+
+            /// Take an empty buffer from the pool (one with capacity if
+            /// there is one).
+            template <typename ElementT>
+            std::vector<ElementT> acquire()
+            {
+                std::vector<std::vector<ElementT> > &idle(pool<ElementT>());
+                ++m_stats.borrow_count;
+
+                if (idle.empty())
+                {
+                    return std::vector<ElementT>();
+                }
+
+                std::vector<ElementT> buf(std::move(idle.back()));
+                idle.pop_back();
+                return buf;
+            }
+
+            /**
+             * @brief Give a buffer back to the pool.
+             *
+             * @param[in] buf       The buffer, it is cleared and kept.
+             * @param[in] capacity  The capacity of buf when it was acquired.
+             */
+            template <typename ElementT>
+            void release(std::vector<ElementT> &&buf, std::size_t capacity)
+            {
+                if (buf.capacity() > capacity)
+                {
+                    ++m_stats.allocation_count;
+                    m_stats.bytes += (buf.capacity() - capacity)*sizeof(ElementT);
+                    if (m_stats.bytes > m_stats.peak_bytes)
+                    {
+                        m_stats.peak_bytes = m_stats.bytes;
+                    }
+                }
+                else
+                {
+                    // The storage was handed off (moved into a result)
+                    m_stats.bytes -= (capacity - buf.capacity())*sizeof(ElementT);
+                }
+
+                if (buf.capacity() == 0)
+                {
+                    return;
+                }
+
+                std::vector<std::vector<ElementT> > &idle(pool<ElementT>());
+                if (idle.size() < MAX_IDLE_BUFFERS)
+                {
+                    buf.clear();
+                    idle.push_back(std::move(buf));
+                }
+                else
+                {
+                    m_stats.bytes -= buf.capacity()*sizeof(ElementT);
+                    std::vector<ElementT>().swap(buf);
+                }
+            }
+
+            /// Free every idle buffer held by this workspace.
+            void clear()
+            {
+                for (auto &clear_pool : m_clear_pools)
+                {
+                    m_stats.bytes -= clear_pool();
+                }
+            }
+
+            WorkspaceStats const &stats() const { return m_stats; }
+
+            /// Restart the peak and the counters from the current state.
+            void reset_stats()
+            {
+                m_stats.peak_bytes = m_stats.bytes;
+                m_stats.allocation_count = 0;
+                m_stats.borrow_count = 0;
+            }
+
+        private:
+            Workspace() {}
+            Workspace(Workspace const &) = delete;
+            Workspace &operator=(Workspace const &) = delete;
+
+            /// The idle buffers of one element type for the calling thread.
+            template <typename ElementT>
+            std::vector<std::vector<ElementT> > &pool()
+            {
+                static thread_local std::vector<std::vector<ElementT> > idle;
+                static thread_local bool registered(false);
+
+                if (!registered)
+                {
+                    registered = true;
+
+                    // Register a function that frees the buffers and
+                    // reports how many bytes it released.
+                    std::vector<std::vector<ElementT> > *idle_ptr(&idle);
+                    m_clear_pools.push_back([idle_ptr]() -> std::size_t {
+                            std::size_t freed(0);
+                            for (auto &buf : *idle_ptr)
+                            {
+                                freed += buf.capacity()*sizeof(ElementT);
+                            }
+                            idle_ptr->clear();
+                            return freed;
+                        });
+                }
+                return idle;
+            }
+
+            WorkspaceStats                            m_stats;
+            std::vector<std::function<std::size_t()> > m_clear_pools;
+        };
+
+        //********************************************************************
+        /**
+         * @brief A vector borrowed from the calling thread's Workspace for
+         *        the lifetime of this object.
+         */
+        template <typename ElementT>
+        class ScratchBuffer
+        {
+        public:
+            ScratchBuffer()
+                : m_buf(Workspace::instance().acquire<ElementT>()),
+                  m_capacity(m_buf.capacity())
+            {
+            }
+
+            ~ScratchBuffer()
+            {
+                Workspace::instance().release(std::move(m_buf), m_capacity);
+            }
+
+            ScratchBuffer(ScratchBuffer const &) = delete;
+            ScratchBuffer &operator=(ScratchBuffer const &) = delete;
+
+            std::vector<ElementT>       &get()       { return m_buf; }
+            std::vector<ElementT> const &get() const { return m_buf; }
+
+        private:
+            std::vector<ElementT> m_buf;
+            std::size_t           m_capacity;
+        };
+
+        /// A scratch buffer holding one sparse row (or sparse vector).
+        template <typename ScalarT>
+        using ScratchRow = ScratchBuffer<std::tuple<IndexType, ScalarT> >;
+
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_WORKSPACE_HPP
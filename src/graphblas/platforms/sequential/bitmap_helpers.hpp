@@ -0,0 +1,174 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Word-packed bitmaps: one bit per element, 64 elements to a word.  Bits
+ * past the last element are kept clear so that whole words can be counted
+ * and combined without masking.
+ */
+
+#ifndef GB_SEQUENTIAL_BITMAP_HELPERS_HPP
+#define GB_SEQUENTIAL_BITMAP_HELPERS_HPP
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        typedef std::uint64_t BitmapWord;
+
+        static constexpr IndexType BITMAP_WORD_BITS = 64;
+
+        //********************************************************************
+        /// Number of set bits in a word.
+        inline IndexType popcount(BitmapWord word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcountll(word);
+#else
+            IndexType count(0);
+            for (; word != 0; word &= (word - 1))
+            {
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        //********************************************************************
+        /// Position of the lowest set bit of a word (which must not be zero).
+        inline IndexType count_trailing_zeros(BitmapWord word)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(word);
+#else
+            IndexType count(0);
+            for (; (word & 1) == 0; word >>= 1)
+            {
+                ++count;
+            }
+            return count;
+#endif
+        }
+
+        //********************************************************************
+        /// Number of words needed to hold nbits bits.
+        inline IndexType bitmap_num_words(IndexType nbits)
+        {
+            return (nbits + BITMAP_WORD_BITS - 1)/BITMAP_WORD_BITS;
+        }
+
+        //********************************************************************
+        /// The bits of word word_idx that correspond to one of nbits elements.
+        inline BitmapWord bitmap_valid_bits(IndexType nbits, IndexType word_idx)
+        {
+            IndexType remaining(nbits - word_idx*BITMAP_WORD_BITS);
+            return ((remaining >= BITMAP_WORD_BITS) ?
+                    ~BitmapWord(0) :
+                    ((BitmapWord(1) << remaining) - 1));
+        }
+
+        //********************************************************************
+        inline bool bitmap_test(std::vector<BitmapWord> const &bits,
+                                IndexType                      idx)
+        {
+            return ((bits[idx/BITMAP_WORD_BITS] >>
+                     (idx%BITMAP_WORD_BITS)) & 1) != 0;
+        }
+
+        //********************************************************************
+        inline void bitmap_set(std::vector<BitmapWord> &bits, IndexType idx)
+        {
+            bits[idx/BITMAP_WORD_BITS] |=
+                (BitmapWord(1) << (idx%BITMAP_WORD_BITS));
+        }
+
+        //********************************************************************
+        /// Size bits for nbits elements and set them all.
+        inline void bitmap_fill(std::vector<BitmapWord> &bits, IndexType nbits)
+        {
+            IndexType num_words(bitmap_num_words(nbits));
+            bits.assign(num_words, ~BitmapWord(0));
+            if (num_words > 0)
+            {
+                bits.back() = bitmap_valid_bits(nbits, num_words - 1);
+            }
+        }
+
+        //********************************************************************
+        /// Number of set bits in the bitmap.
+        inline IndexType bitmap_count(std::vector<BitmapWord> const &bits)
+        {
+            IndexType count(0);
+            for (auto word : bits)
+            {
+                count += popcount(word);
+            }
+            return count;
+        }
+
+        //********************************************************************
+        /// The first set bit at or after idx, or nbits if there is none.
+        inline IndexType bitmap_find_next(std::vector<BitmapWord> const &bits,
+                                          IndexType                      nbits,
+                                          IndexType                      idx)
+        {
+            if (idx >= nbits)
+            {
+                return nbits;
+            }
+
+            IndexType word_idx(idx/BITMAP_WORD_BITS);
+            BitmapWord word(bits[word_idx] &
+                            (~BitmapWord(0) << (idx%BITMAP_WORD_BITS)));
+
+            while (word == 0)
+            {
+                if (++word_idx == bits.size())
+                {
+                    return nbits;
+                }
+                word = bits[word_idx];
+            }
+
+            return word_idx*BITMAP_WORD_BITS + count_trailing_zeros(word);
+        }
+
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_BITMAP_HELPERS_HPP
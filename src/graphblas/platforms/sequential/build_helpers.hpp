@@ -0,0 +1,233 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+/**
+ * Building containers from lists of (unsorted) tuples.  The positions of
+ * the tuples are sorted, or grouped by row, and the tuples for each row
+ * are then put in column order with their duplicates combined.  The loops
+ * are OpenMP loops, so the containers shared with the openmp platform are
+ * built in parallel there; the results do not depend on the number of
+ * threads.
+ */
+
+#ifndef GB_SEQUENTIAL_BUILD_HELPERS_HPP
+#define GB_SEQUENTIAL_BUILD_HELPERS_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <graphblas/types.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    namespace backend
+    {
+        /// Below this many tuples a build does not divide its work.
+        static constexpr IndexType BUILD_PARALLEL_MIN = 1 << 14;
+
+        //********************************************************************
+        /// Whether the first n indices are all less than bound.
+        template <typename RAIteratorT>
+        bool indices_in_range(RAIteratorT it, IndexType n, IndexType bound)
+        {
+            bool in_range = true;
+
+#pragma omp parallel for reduction(&&:in_range) if(n >= BUILD_PARALLEL_MIN)
+            for (IndexType idx = 0; idx < n; ++idx)
+            {
+                in_range = in_range && (static_cast<IndexType>(it[idx]) < bound);
+            }
+            return in_range;
+        }
+
+        //********************************************************************
+        /**
+         * @brief Group the positions [0, n) by key(pos), a counting sort.
+         *
+         * On return the positions with key k are
+         * order[offsets[k], offsets[k + 1]), in no particular order.
+         */
+        template <typename KeyFunctionT>
+        void group_by_key(std::vector<IndexType> &offsets,
+                          std::vector<IndexType> &order,
+                          IndexType               nkeys,
+                          IndexType               n,
+                          KeyFunctionT            key)
+        {
+            offsets.assign(nkeys + 1, 0);
+
+#pragma omp parallel for if(n >= BUILD_PARALLEL_MIN)
+            for (IndexType pos = 0; pos < n; ++pos)
+            {
+                IndexType k(key(pos));
+#pragma omp atomic
+                ++offsets[k + 1];
+            }
+
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            std::vector<IndexType> cursor(offsets.begin(), offsets.end() - 1);
+            order.resize(n);
+
+#pragma omp parallel for if(n >= BUILD_PARALLEL_MIN)
+            for (IndexType pos = 0; pos < n; ++pos)
+            {
+                IndexType k(key(pos));
+                IndexType slot;
+#pragma omp atomic capture
+                slot = cursor[k]++;
+                order[slot] = pos;
+            }
+        }
+
+        //********************************************************************
+        /**
+         * @brief Sort [first, last) with comp, a strict total order.
+         *
+         * With more than one thread, blocks are sorted concurrently and
+         * then merged in pairs.  Equal elements are indistinguishable under
+         * a total order, so the result is the same as that of std::sort.
+         */
+        template <typename RAIteratorT, typename CompareT>
+        void parallel_sort(RAIteratorT first, RAIteratorT last, CompareT comp)
+        {
+            IndexType n(last - first);
+            int nblocks = 1;
+#ifdef _OPENMP
+            nblocks = omp_get_max_threads();
+#endif
+            if ((nblocks < 2) || (n < BUILD_PARALLEL_MIN))
+            {
+                std::sort(first, last, comp);
+                return;
+            }
+
+            std::vector<IndexType> bounds(nblocks + 1);
+            for (int block = 0; block <= nblocks; ++block)
+            {
+                bounds[block] = (n * block) / nblocks;
+            }
+
+#pragma omp parallel for
+            for (int block = 0; block < nblocks; ++block)
+            {
+                std::sort(first + bounds[block], first + bounds[block + 1],
+                          comp);
+            }
+
+            for (int width = 1; width < nblocks; width *= 2)
+            {
+#pragma omp parallel for
+                for (int block = 0; block < nblocks; block += 2 * width)
+                {
+                    int middle = std::min(block + width, nblocks);
+                    int end = std::min(block + 2 * width, nblocks);
+                    if (middle < end)
+                    {
+                        std::inplace_merge(first + bounds[block],
+                                           first + bounds[middle],
+                                           first + bounds[end],
+                                           comp);
+                    }
+                }
+            }
+        }
+
+        //********************************************************************
+        /**
+         * @brief Merge tuples into a (sorted) row.
+         *
+         * The positions [first, last) are sorted by column and then by
+         * position.  Values for the same column are combined with dup in
+         * that order, starting with the value already stored in the row;
+         * this is the result of setting the tuples one at a time.
+         */
+        template <typename ScalarT,
+                  typename PosIteratorT,
+                  typename RAIteratorJ,
+                  typename RAIteratorV,
+                  typename DupT>
+        void merge_into_row(std::vector<std::tuple<IndexType, ScalarT> > &row,
+                            PosIteratorT                                  first,
+                            PosIteratorT                                  last,
+                            RAIteratorJ                                   j_it,
+                            RAIteratorV                                   v_it,
+                            DupT                                          dup)
+        {
+            std::vector<std::tuple<IndexType, ScalarT> > merged;
+            merged.reserve(row.size() + (last - first));
+
+            auto row_it = row.begin();
+            for (; first != last; ++first)
+            {
+                IndexType col(j_it[*first]);
+                ScalarT   val(static_cast<ScalarT>(v_it[*first]));
+
+                while ((row_it != row.end()) && (std::get<0>(*row_it) < col))
+                {
+                    merged.push_back(*row_it);
+                    ++row_it;
+                }
+
+                if (!merged.empty() && (std::get<0>(merged.back()) == col))
+                {
+                    std::get<1>(merged.back()) = static_cast<ScalarT>(
+                        dup(std::get<1>(merged.back()), val));
+                }
+                else if ((row_it != row.end()) &&
+                         (std::get<0>(*row_it) == col))
+                {
+                    merged.push_back(std::make_tuple(
+                        col,
+                        static_cast<ScalarT>(dup(std::get<1>(*row_it), val))));
+                    ++row_it;
+                }
+                else
+                {
+                    merged.push_back(std::make_tuple(col, val));
+                }
+            }
+            merged.insert(merged.end(), row_it, row.end());
+
+            row.swap(merged);
+        }
+    } // backend
+} // GraphBLAS
+
+#endif // GB_SEQUENTIAL_BUILD_HELPERS_HPP
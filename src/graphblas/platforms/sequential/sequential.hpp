@@ -44,5 +44,6 @@
 
 #include <graphblas/platforms/sequential/BitmapSparseVector.hpp>
 #include <graphblas/platforms/sequential/LilSparseMatrix.hpp>
+#include <graphblas/platforms/sequential/Workspace.hpp>
 
 #endif // GB_SEQUENTIAL_HPP
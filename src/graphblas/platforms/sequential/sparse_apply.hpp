@@ -75,13 +75,13 @@ namespace GraphBLAS
             // This is really the guts of what makes this special.
             typedef typename UVectorT::ScalarType        UScalarType;
             typedef typename UnaryFunctionT::result_type TScalarType;
-            std::vector<std::tuple<IndexType,TScalarType> > t_contents;
+            ScratchRow<TScalarType> t_contents_buf;
+            auto &t_contents(t_contents_buf.get());
 
             if (u.nvals() > 0)
             {
-                auto u_contents(u.getContents());
-                auto row_iter = u_contents.begin();
-                while (row_iter != u_contents.end())
+                auto row_iter = u.begin();
+                while (row_iter != u.end())
                 {
                     GraphBLAS::IndexType u_idx;
                     UScalarType          u_val;
@@ -101,7 +101,8 @@ namespace GraphBLAS
                 TScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            std::vector<std::tuple<IndexType,ZScalarType> > z_contents;
+            ScratchRow<ZScalarType> z_contents_buf;
+            auto &z_contents(z_contents_buf.get());
             ewise_or_opt_accum_1D(z_contents, w, t_contents, accum);
 
             GRB_LOG_VERBOSE("z: " << z_contents);
@@ -145,15 +146,15 @@ namespace GraphBLAS
             // This is really the guts of what makes this special.
             LilSparseMatrix<TScalarType> T(nrows, ncols);
 
-            ARowType a_row;
-            TRowType t_row;
+            ScratchRow<TScalarType> t_row_buf;
+            auto &t_row(t_row_buf.get());
 
             IndexType a_idx;
             AScalarType a_val;
 
             for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
             {
-                a_row = A.getRow(row_idx);
+                ARowType const &a_row(A.getRow(row_idx));
                 if (!a_row.empty())
                 {
                     t_row.clear();
@@ -181,13 +182,47 @@ namespace GraphBLAS
                 typename AccumT::result_type>::type  ZScalarType;
 
             LilSparseMatrix<ZScalarType> Z(nrows, ncols);
-            ewise_or_opt_accum(Z, C, T, accum);
+            ewise_or_opt_accum(Z, C, std::move(T), accum);
 
             GRB_LOG_VERBOSE("Z: " << Z);
 
             // =================================================================
             // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, mask, replace_flag);
+            write_with_opt_mask(C, std::move(Z), mask, replace_flag);
+        }
+
+        //**********************************************************************
+        /// Apply with no mask whose input is its output: C(i,j) =
+        /// [accum](C(i,j), op(C(i,j))) for the stored values of C.  The
+        /// structure of C does not change so the values are replaced where
+        /// they are stored.
+        template<typename WScalarT,
+                 typename AccumT,
+                 typename UnaryFunctionT,
+                 typename ...WTagsT>
+        inline void apply_in_place(
+            GraphBLAS::backend::Vector<WScalarT, WTagsT...> &w,
+            AccumT                                           accum,
+            UnaryFunctionT                                   op)
+        {
+            w.transformValues(
+                InPlaceApply<WScalarT, AccumT, UnaryFunctionT>(accum, op));
+        }
+
+        template<typename CScalarT,
+                 typename AccumT,
+                 typename UnaryFunctionT,
+                 typename ...CTagsT>
+        inline void apply_in_place(
+            GraphBLAS::backend::Matrix<CScalarT, CTagsT...> &C,
+            AccumT                                           accum,
+            UnaryFunctionT                                   op)
+        {
+            InPlaceApply<CScalarT, AccumT, UnaryFunctionT> fn(accum, op);
+            for (IndexType row_idx = 0; row_idx < C.nrows(); ++row_idx)
+            {
+                C.transformRow(row_idx, fn);
+            }
         }
     }
 }
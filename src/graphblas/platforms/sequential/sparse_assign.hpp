@@ -44,6 +44,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "BitmapSparseVector.hpp"
 
 //******************************************************************************
 
@@ -148,6 +149,29 @@ namespace GraphBLAS
             }
         }
 
+        //********************************************************************
+        /// Expand a sparse vector: the stored values are probed directly
+        /// rather than searched for.
+        template <typename TScalarT,
+                  typename AScalarT>
+        void vectorExpand(std::vector<std::tuple<IndexType, TScalarT>>  &vec_dest,
+                          BitmapSparseVector<AScalarT>            const &vec_src,
+                          std::vector<std::pair<IndexType, IndexType>> const &Indices)
+        {
+            AScalarT src_val;
+
+            // The Indices are pairs of (output_index, input_index) in
+            // output order
+            for (auto const &index_pair : Indices)
+            {
+                if (vec_src.probe(index_pair.second, src_val))
+                {
+                    vec_dest.push_back(std::make_tuple(
+                        index_pair.first, static_cast<TScalarT>(src_val)));
+                }
+            }
+        }
+
         //********************************************************************
         template<typename TScalarT,
                  typename AScalarT,
@@ -178,19 +202,20 @@ namespace GraphBLAS
             std::vector<std::pair<IndexType, IndexType>> oi_pairs;
             compute_outin_mapping(col_Indices, oi_pairs);
 
+            ScratchRow<TScalarT> out_row_buf;
+            auto &out_row(out_row_buf.get());
+
             // Walk the rows
             for (IndexType in_row_index = 0;
                  in_row_index < row_Indices.size();
                  ++in_row_index)
             {
                 IndexType out_row_index = row_Indices[in_row_index];
-                ARowType row(A.getRow(in_row_index));
-                auto row_it = row.begin();
-
-                TRowType out_row;
+                ARowType const &row(A.getRow(in_row_index));
 
                 // Extract the values from the row
                 //std::cerr << "Expanding row " << in_row_index << " to " << out_row_index << std::endl;
+                out_row.clear();
                 vectorExpand(out_row, row, oi_pairs);
 
                 if (!out_row.empty())
@@ -220,6 +245,9 @@ namespace GraphBLAS
             std::vector<std::pair<IndexType, IndexType>> oi_pairs;
             compute_outin_mapping(col_Indices, oi_pairs);
 
+            ScratchRow<TScalarT> out_row_buf;
+            auto &out_row(out_row_buf.get());
+
             // Walk the rows
             for (IndexType in_row_index = 0;
                  in_row_index < row_Indices.size();
@@ -227,12 +255,10 @@ namespace GraphBLAS
             {
                 IndexType out_row_index = row_Indices[in_row_index];
                 auto row(A.getRow(in_row_index));
-                auto row_it = row.begin();
-
-                TRowType out_row;
 
                 // Extract the values from the row
                 //std::cerr << "Expanding row " << in_row_index << " to " << out_row_index << std::endl;
+                out_row.clear();
                 vectorExpand(out_row, row, oi_pairs);
 
                 if (!out_row.empty())
@@ -251,9 +277,12 @@ namespace GraphBLAS
         {
             typedef std::vector<std::tuple<IndexType,ValueT> > TRowType;
 
+            ScratchRow<ValueT> out_row_buf;
+            auto &out_row(out_row_buf.get());
+
             for (auto row_it = row_begin; row_it != row_end; ++row_it)
             {
-                TRowType out_row;
+                out_row.clear();
                 for (auto col_it = col_begin; col_it != col_end; ++col_it)
                 {
                     // @todo: add bounds check
@@ -322,9 +351,9 @@ namespace GraphBLAS
             // =================================================================
             // Expand to t
             typedef typename UVectorT::ScalarType UScalarType;
-            std::vector<std::tuple<IndexType, UScalarType> > t;
-            auto u_contents(u.getContents());
-            vectorExpand(t, u_contents, oi_pairs);
+            ScratchRow<UScalarType> t_buf;
+            auto &t(t_buf.get());
+            vectorExpand(t, u, oi_pairs);
 
             GRB_LOG_VERBOSE("t: " << t);
 
@@ -335,7 +364,8 @@ namespace GraphBLAS
                     typename WVectorT::ScalarType,
                     typename AccumT::result_type>::type ZScalarType;
 
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
             ewise_or_stencil_opt_accum_1D(z, w, t,
                                           setupIndices(indices, u.size()),
                                           accum);
@@ -399,7 +429,7 @@ namespace GraphBLAS
 
             // =================================================================
             // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, mask, replace);
+            write_with_opt_mask(C, std::move(Z), mask, replace);
         }
 
         //=====================================================================
@@ -528,7 +558,8 @@ namespace GraphBLAS
             check_index_array_content(indices, w.size(),
                                       "assign(const vec): indices content check");
 
-            std::vector<std::tuple<IndexType, ValueT> > t;
+            ScratchRow<ValueT> t_buf;
+            auto &t(t_buf.get());
 
             // Set all in T
             auto seq = setupIndices(indices, w.size());
@@ -545,7 +576,8 @@ namespace GraphBLAS
                 typename WVectorT::ScalarType,
                 typename AccumT::result_type>::type ZScalarType;
 
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
             ewise_or_stencil_opt_accum_1D(z, w, t,
                                           setupIndices(indices, w.size()),
                                           accum);
@@ -608,7 +640,7 @@ namespace GraphBLAS
 
             // =================================================================
             // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, Mask, replace_flag);
+            write_with_opt_mask(C, std::move(Z), Mask, replace_flag);
         }
     }
 }
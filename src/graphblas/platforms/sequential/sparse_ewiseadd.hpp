@@ -76,19 +76,18 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic ewise-and work: T = A .* B
             typedef typename BinaryOpT::result_type D3ScalarType;
-            std::vector<std::tuple<IndexType,D3ScalarType> > t_contents;
+            ScratchRow<D3ScalarType> t_contents_buf;
+            auto &t_contents(t_contents_buf.get());
 
             if ((u.nvals() > 0) || (v.nvals() > 0))
             {
-                auto u_contents(u.getContents());
-                auto v_contents(v.getContents());
-
-                ewise_or(t_contents, u_contents, v_contents, op);
+                ewise_or(t_contents, u, v, op);
             }
 
             // =================================================================
             // Accumulate into Z
-            std::vector<std::tuple<IndexType,WScalarT> > z_contents;
+            ScratchRow<WScalarT> z_contents_buf;
+            auto &z_contents(z_contents_buf.get());
             ewise_or_opt_accum_1D(z_contents, w, t_contents, accum);
 
             // =================================================================
@@ -133,11 +132,12 @@ namespace GraphBLAS
             if ((A.nvals() > 0) || (B.nvals() > 0))
             {
                 // create a row of result at a time
-                TRowType T_row;
+                ScratchRow<D3ScalarType> T_row_buf;
+                auto &T_row(T_row_buf.get());
                 for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
                 {
-                    ARowType A_row(A.getRow(row_idx));
-                    BRowType B_row(B.getRow(row_idx));
+                    ARowType const &A_row(A.getRow(row_idx));
+                    BRowType const &B_row(B.getRow(row_idx));
 
                     if (B_row.empty())
                     {
@@ -164,13 +164,49 @@ namespace GraphBLAS
             // Accumulate into Z
 
             LilSparseMatrix<CScalarT> Z(num_rows, num_cols);
-            ewise_or_opt_accum(Z, C, T, accum);
+            ewise_or_opt_accum(Z, C, std::move(T), accum);
 
             // =================================================================
             // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, Mask, replace_flag);
+            write_with_opt_mask(C, std::move(Z), Mask, replace_flag);
         } // ewisemult
 
+        //**********************************************************************
+        /// eWiseAdd with no mask whose output is also one of its inputs.
+        /// Row i of the result depends only on row i of C, A and B, so C is
+        /// rewritten a row at a time instead of through T and Z matrices.
+        /// The frontend only calls this when neither input reads C through
+        /// a view.
+        template<typename CScalarT,
+                 typename AccumT,
+                 typename BinaryOpT,
+                 typename AMatrixT,
+                 typename BMatrixT,
+                 typename ...CTagsT>
+        inline void eWiseAdd_in_place(
+            GraphBLAS::backend::Matrix<CScalarT, CTagsT...> &C,
+            AccumT                                           accum,
+            BinaryOpT                                        op,
+            AMatrixT                                  const &A,
+            BMatrixT                                  const &B)
+        {
+            typedef typename BinaryOpT::result_type D3ScalarType;
+
+            ScratchRow<D3ScalarType> T_row_buf;
+            auto &T_row(T_row_buf.get());
+            ScratchRow<CScalarT> Z_row_buf;
+            auto &Z_row(Z_row_buf.get());
+
+            for (IndexType row_idx = 0; row_idx < C.nrows(); ++row_idx)
+            {
+                ewise_or(T_row, A.getRow(row_idx), B.getRow(row_idx), op);
+
+                Z_row.clear();
+                ewise_or_opt_accum_1D(Z_row, C.getRow(row_idx), T_row, accum);
+                C.setRow(row_idx, std::move(Z_row));
+            }
+        } // eWiseAdd_in_place
+
     } // backend
 } // GraphBLAS
 
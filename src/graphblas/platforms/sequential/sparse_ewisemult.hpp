@@ -56,6 +56,92 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //**********************************************************************
+        /// t = u .* v for any pair of vectors (or vector views)
+        template<typename D3ScalarT,
+                 typename UVectorT,
+                 typename VVectorT,
+                 typename BinaryOpT>
+        inline void ewise_and_vectors(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            UVectorT                                 const &u,
+            VVectorT                                 const &v,
+            BinaryOpT                                       op)
+        {
+            ewise_and(t, u, v, op);
+        }
+
+        //**********************************************************************
+        /// t = u .* v for two vectors: probe the other vector for each element
+        /// of a sparse one, otherwise intersect the bitmaps 64 elements at a
+        /// time.
+        template<typename D3ScalarT,
+                 typename UScalarT,
+                 typename VScalarT,
+                 typename BinaryOpT,
+                 typename... UTagsT,
+                 typename... VTagsT>
+        inline void ewise_and_vectors(
+            std::vector<std::tuple<IndexType, D3ScalarT> >        &t,
+            GraphBLAS::backend::Vector<UScalarT, UTagsT...> const &u,
+            GraphBLAS::backend::Vector<VScalarT, VTagsT...> const &v,
+            BinaryOpT                                              op)
+        {
+            t.clear();
+
+            if ((u.form() == VectorForm::SPARSE) &&
+                (v.form() == VectorForm::SPARSE))
+            {
+                ewise_and(t, u.get_sparse(), v.get_sparse(), op);
+            }
+            else if (u.form() == VectorForm::SPARSE)
+            {
+                VScalarT v_val;
+                for (auto const &u_elt : u.get_sparse())
+                {
+                    if (v.probe(std::get<0>(u_elt), v_val))
+                    {
+                        t.push_back(std::make_tuple(
+                            std::get<0>(u_elt),
+                            static_cast<D3ScalarT>(op(std::get<1>(u_elt), v_val))));
+                    }
+                }
+            }
+            else if (v.form() == VectorForm::SPARSE)
+            {
+                UScalarT u_val;
+                for (auto const &v_elt : v.get_sparse())
+                {
+                    if (u.probe(std::get<0>(v_elt), u_val))
+                    {
+                        t.push_back(std::make_tuple(
+                            std::get<0>(v_elt),
+                            static_cast<D3ScalarT>(op(u_val, std::get<1>(v_elt)))));
+                    }
+                }
+            }
+            else
+            {
+                auto const &u_vals(u.get_vals());
+                auto const &v_vals(v.get_vals());
+                for (IndexType word_idx = 0;
+                     word_idx < bitmap_num_words(u.size());
+                     ++word_idx)
+                {
+                    BitmapWord word(u.stored_word(word_idx) &
+                                    v.stored_word(word_idx));
+                    for (; word != 0; word &= (word - 1))
+                    {
+                        IndexType idx(word_idx*BITMAP_WORD_BITS +
+                                      count_trailing_zeros(word));
+                        t.push_back(std::make_tuple(
+                            idx,
+                            static_cast<D3ScalarT>(op(u_vals[idx], v_vals[idx]))));
+                    }
+                }
+            }
+        }
+
         //**********************************************************************
         /// Implementation of 4.3.4.1 eWiseMult: Vector variant
         template<typename WScalarT,
@@ -77,19 +163,18 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic ewise-and work: t = u .* v
             typedef typename BinaryOpT::result_type D3ScalarType;
-            std::vector<std::tuple<IndexType,D3ScalarType> > t_contents;
+            ScratchRow<D3ScalarType> t_contents_buf;
+            auto &t_contents(t_contents_buf.get());
 
             if ((u.nvals() > 0) && (v.nvals() > 0))
             {
-                auto u_contents(u.getContents());
-                auto v_contents(v.getContents());
-
-                ewise_and(t_contents, u_contents, v_contents, op);
+                ewise_and_vectors(t_contents, u, v, op);
             }
 
             // =================================================================
             // Accumulate into Z
-            std::vector<std::tuple<IndexType,WScalarT> > z_contents;
+            ScratchRow<WScalarT> z_contents_buf;
+            auto &z_contents(z_contents_buf.get());
             ewise_or_opt_accum_1D(z_contents, w, t_contents, accum);
 
             // =================================================================
@@ -134,14 +219,15 @@ namespace GraphBLAS
             if ((A.nvals() > 0) && (B.nvals() > 0))
             {
                 // create a row of result at a time
-                TRowType T_row;
+                ScratchRow<D3ScalarType> T_row_buf;
+                auto &T_row(T_row_buf.get());
                 for (IndexType row_idx = 0; row_idx < num_rows; ++row_idx)
                 {
-                    BRowType B_row(B.getRow(row_idx));
+                    BRowType const &B_row(B.getRow(row_idx));
 
                     if (!B_row.empty())
                     {
-                        ARowType A_row(A.getRow(row_idx));
+                        ARowType const &A_row(A.getRow(row_idx));
                         if (!A_row.empty())
                         {
                             ewise_and(T_row, A_row, B_row, op);
@@ -163,20 +249,56 @@ namespace GraphBLAS
             // Accumulate into Z
 
             LilSparseMatrix<CScalarT> Z(num_rows, num_cols);
-            ewise_or_opt_accum(Z, C, T, accum);
+            ewise_or_opt_accum(Z, C, std::move(T), accum);
 
 //            GRB_LOG_E(">>> Z <<< ");
 //            GRB_LOG_E(Z);
 
             // =================================================================
             // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, Mask, replace_flag);
+            write_with_opt_mask(C, std::move(Z), Mask, replace_flag);
 
 //            GRB_LOG_E(">>> C <<< ");
 //            GRB_LOG_E(C);
 
         } // ewisemult
 
+        //**********************************************************************
+        /// eWiseMult with no mask whose output is also one of its inputs.
+        /// Row i of the result depends only on row i of C, A and B, so C is
+        /// rewritten a row at a time instead of through T and Z matrices.
+        /// The frontend only calls this when neither input reads C through
+        /// a view.
+        template<typename CScalarT,
+                 typename AccumT,
+                 typename BinaryOpT,
+                 typename AMatrixT,
+                 typename BMatrixT,
+                 typename ...CTagsT>
+        inline void eWiseMult_in_place(
+            GraphBLAS::backend::Matrix<CScalarT, CTagsT...> &C,
+            AccumT                                           accum,
+            BinaryOpT                                        op,
+            AMatrixT                                  const &A,
+            BMatrixT                                  const &B)
+        {
+            typedef typename BinaryOpT::result_type D3ScalarType;
+
+            ScratchRow<D3ScalarType> T_row_buf;
+            auto &T_row(T_row_buf.get());
+            ScratchRow<CScalarT> Z_row_buf;
+            auto &Z_row(Z_row_buf.get());
+
+            for (IndexType row_idx = 0; row_idx < C.nrows(); ++row_idx)
+            {
+                ewise_and(T_row, A.getRow(row_idx), B.getRow(row_idx), op);
+
+                Z_row.clear();
+                ewise_or_opt_accum_1D(Z_row, C.getRow(row_idx), T_row, accum);
+                C.setRow(row_idx, std::move(Z_row));
+            }
+        } // eWiseMult_in_place
+
     } // backend
 } // GraphBLAS
 
@@ -50,6 +50,7 @@
 
 #include "sparse_helpers.hpp"
 #include "LilSparseMatrix.hpp"
+#include "BitmapSparseVector.hpp"
 
 //******************************************************************************
 
@@ -120,6 +121,32 @@ namespace GraphBLAS
             vectorExtract(vec_dest, vec_src, indices.begin(), indices.end());
         }
 
+        // *******************************************************************
+        /// Extract from a sparse vector: the stored values are probed
+        /// directly rather than searched for.
+        template<typename CScalarT,
+                 typename AScalarT,
+                 typename SequenceT>
+        void vectorExtract(
+                std::vector<std::tuple<IndexType, CScalarT> >       &vec_dest,
+                BitmapSparseVector<AScalarT>                  const &vec_src,
+                SequenceT                                            indices)
+        {
+            vec_dest.clear();
+
+            AScalarT src_val;
+            IndexType out_idx = 0;
+            for (auto it = indices.begin(); it != indices.end(); ++it, ++out_idx)
+            {
+                if (vec_src.probe(*it, src_val))
+                {
+                    vec_dest.push_back(
+                        std::make_tuple(out_idx,
+                                        static_cast<CScalarT>(src_val)));
+                }
+            }
+        }
+
         // *******************************************************************
         template<typename CScalarT,
                  typename AScalarT,
@@ -137,6 +164,9 @@ namespace GraphBLAS
 
             C.clear();
 
+            ScratchRow<CScalarT> out_row_buf;
+            auto &out_row(out_row_buf.get());
+
             // Walk the rows
             IndexType out_row_index = 0;
 
@@ -146,10 +176,6 @@ namespace GraphBLAS
             {
                 auto row(A.getRow(*row_it));
 
-                IndexType tmp_idx;
-                AScalarT tmp_value;
-                CRowType out_row;
-
                 // Extract the values from the row
                 vectorExtract(out_row, row, col_begin, col_end);
 
@@ -176,6 +202,9 @@ namespace GraphBLAS
 
             C.clear();
 
+            ScratchRow<CScalarT> out_row_buf;
+            auto &out_row(out_row_buf.get());
+
             // Walk the rows
             IndexType out_row_index = 0;
 
@@ -185,10 +214,6 @@ namespace GraphBLAS
             {
                 auto row(A.getRow(*row_it));
 
-                IndexType tmp_idx;
-                AScalarT tmp_value;
-                CRowType out_row;
-
                 // Extract the values from the row
                 vectorExtract(out_row, row, col_begin, col_end);
 
@@ -345,9 +370,9 @@ namespace GraphBLAS
             // =================================================================
             // Extract to T
             typedef typename UVectorT::ScalarType UScalarType;
-            std::vector<std::tuple<IndexType, UScalarType> > t;
-            auto u_contents(u.getContents());
-            vectorExtract(t, u_contents,
+            ScratchRow<UScalarType> t_buf;
+            auto &t(t_buf.get());
+            vectorExtract(t, u,
                           setupIndices(indices,
                                        std::min(w.size(), u.size())));
 
@@ -360,7 +385,8 @@ namespace GraphBLAS
                 UScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
             ewise_or_opt_accum_1D(z, w, t, accum);
 
             GRB_LOG_VERBOSE("z: " << z);
@@ -418,13 +444,13 @@ namespace GraphBLAS
                 typename AccumT::result_type>::type  ZScalarType;
 
             LilSparseMatrix<ZScalarType> Z(C.nrows(), C.ncols());
-            ewise_or_opt_accum(Z, C, T, accum);
+            ewise_or_opt_accum(Z, C, std::move(T), accum);
 
             GRB_LOG_VERBOSE("Z: " << Z);
 
             // =================================================================
             // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, Mask, replace_flag);
+            write_with_opt_mask(C, std::move(Z), Mask, replace_flag);
 
             GRB_LOG_VERBOSE("C (Result): " << C);
         };
@@ -474,7 +500,8 @@ namespace GraphBLAS
                 AScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
 
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
             ewise_or_opt_accum_1D(z, w, t, accum);
 
             GRB_LOG_VERBOSE("z: " << z);
@@ -39,12 +39,18 @@
 
 #include <functional>
 #include <utility>
+#include <type_traits>
 #include <vector>
+#include <algorithm>
 #include <iterator>
+#include <memory>
 #include <iostream>
 #include <string>
 #include <graphblas/algebra.hpp>
 #include <graphblas/indices.hpp>
+#include <graphblas/ReductionMode.hpp>
+#include <graphblas/platforms/sequential/Workspace.hpp>
+#include <graphblas/platforms/sequential/BitmapSparseVector.hpp>
 
 //****************************************************************************
 
@@ -89,13 +95,15 @@ namespace GraphBLAS
             // Copying removes the contents of the other matrix so clear it first.
             dstMatrix.clear();
 
+            DstRowType dstRow;
             IndexType nrows(dstMatrix.nrows());
             for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
             {
-                SrcRowType srcRow = srcMatrix.getRow(row_idx);
-                DstRowType dstRow;
+                SrcRowType const &srcRow(srcMatrix.getRow(row_idx));
 
                 // We need to construct a new row with the appropriate cast!
+                dstRow.clear();
+                dstRow.reserve(srcRow.size());
                 for (auto it = srcRow.begin(); it != srcRow.end(); ++it)
                 {
                     IndexType idx;
@@ -105,11 +113,100 @@ namespace GraphBLAS
                 }
 
                 if (!dstRow.empty())
-                    dstMatrix.setRow(row_idx, dstRow);
+                    dstMatrix.setRow(row_idx, std::move(dstRow));
             }
         }
 
-        // @todo: Make a sparse copy where they are the same type for efficiency
+        //**********************************************************************
+        // Same scalar type: take the rows of the source without copying them.
+        template <typename DstMatrixT,
+                  typename SrcMatrixT>
+        void sparse_move(DstMatrixT &dstMatrix,
+                         SrcMatrixT &srcMatrix,
+                         std::true_type)
+        {
+            dstMatrix.swap(srcMatrix);
+            srcMatrix.clear();
+        }
+
+        // Different scalar types: every value needs a cast so copy.
+        template <typename DstMatrixT,
+                  typename SrcMatrixT>
+        void sparse_move(DstMatrixT &dstMatrix,
+                         SrcMatrixT &srcMatrix,
+                         std::false_type)
+        {
+            sparse_copy(dstMatrix, srcMatrix);
+        }
+
+        /// Replace the contents of dstMatrix with those of a temporary
+        /// matrix that is no longer needed by the caller.
+        template <typename DstMatrixT,
+                  typename SrcScalarT>
+        void sparse_move(DstMatrixT                     &dstMatrix,
+                         LilSparseMatrix<SrcScalarT>   &&srcMatrix)
+        {
+            sparse_move(dstMatrix, srcMatrix,
+                        std::is_same<typename DstMatrixT::ScalarType,
+                                     SrcScalarT>());
+        }
+
+        //**********************************************************************
+        /**
+         * @brief A matrix borrowed from the calling thread for the lifetime of
+         *        this object, used as the back buffer of an operation's
+         *        result.
+         *
+         * When the result is swapped into the output (sparse_move), the
+         * buffer is left with the output's old rows, so the next operation on
+         * a matrix of the same shape reuses their storage.  An operation
+         * repeated on the same output, such as A = A*B in a loop, then
+         * alternates between two sets of rows instead of allocating a new
+         * matrix every time.
+         */
+        template <typename ScalarT>
+        class ScratchMatrix
+        {
+        public:
+            ScratchMatrix(IndexType nrows, IndexType ncols)
+                : m_mat(std::move(idle()))
+            {
+                if (!m_mat || (m_mat->nrows() != nrows) ||
+                    (m_mat->ncols() != ncols))
+                {
+                    m_mat.reset(new LilSparseMatrix<ScalarT>(nrows, ncols));
+                }
+            }
+
+            ~ScratchMatrix()
+            {
+                m_mat->clear();
+                idle() = std::move(m_mat);
+            }
+
+            ScratchMatrix(ScratchMatrix const &) = delete;
+            ScratchMatrix &operator=(ScratchMatrix const &) = delete;
+
+            LilSparseMatrix<ScalarT> &get() { return *m_mat; }
+
+        private:
+            /// The buffer kept by the calling thread (one per scalar type).
+            static std::unique_ptr<LilSparseMatrix<ScalarT> > &idle()
+            {
+                static thread_local std::unique_ptr<LilSparseMatrix<ScalarT> > mat;
+                return mat;
+            }
+
+            std::unique_ptr<LilSparseMatrix<ScalarT> > m_mat;
+        };
+
+        //**********************************************************************
+        /// The value type of a sparse sequence of (index, value) tuples: a
+        /// row of a matrix, or a vector (or vector view) walked through its
+        /// const_iterator.
+        template <typename SequenceT>
+        using SequenceScalarType =
+            typename std::tuple_element<1, typename SequenceT::value_type>::type;
 
         //**********************************************************************
         /// Increments the provided iterate while the value is less
@@ -211,70 +308,6 @@ namespace GraphBLAS
             }
         }
 
-        //**********************************************************************
-
-        /// Perform the dot product of a row of a matrix with a sparse vector without
-        /// pulling the indices out of the vector first.
-        template <typename D1, typename D2, typename D3, typename SemiringT>
-        bool dot2(D3                                                      &ans,
-                  std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &A_row,
-                  std::vector<bool>                                 const &u_bitmap,
-                  std::vector<D2>                                   const &u_vals,
-                  GraphBLAS::IndexType                                     u_nvals,
-                  SemiringT                                                op)
-        {
-            bool value_set(false);
-            ans = op.zero();
-
-            if ((u_nvals == 0) || A_row.empty())
-            {
-                return value_set;
-            }
-
-            // find first stored value in u
-            GraphBLAS::IndexType u_idx(0);
-            while (!u_bitmap[u_idx]) ++u_idx; // skip unstored elements
-
-            // pull first value out of the row
-            auto A_iter = A_row.begin();
-            D1 a_val;
-            GraphBLAS::IndexType a_idx;
-
-            // loop through both ordered sets to compute sparse dot prod
-            while ((A_iter != A_row.end()) && (u_idx < u_vals.size()))
-            {
-                std::tie(a_idx, a_val) = *A_iter;
-                //std::cerr << "Examine u index = " << u_idx << "," << u_vals[u_idx]
-                //          << ", A col_idx = " << a_idx << "," << a_val << std::endl;
-
-                if (u_idx == a_idx)
-                {
-                    //std::cerr << ans << " + "  << a_val << " * "  << u_vals[u_idx]
-                    //          << " = " << op.mult(a_val, u_vals[u_idx]) << std::endl;
-
-                    ans = op.add(ans, op.mult(a_val, u_vals[u_idx]));
-                    value_set = true;
-
-                    //std::cerr << "Equal, mutliply_accum, ans = " << ans << std::endl;
-
-                    do { ++u_idx; } while ((u_idx < u_vals.size()) && !u_bitmap[u_idx]);
-                    ++A_iter;
-                }
-                else if (u_idx > a_idx)
-                {
-                    //std::cerr << "Advancing A_iter" << std::endl;
-                    ++A_iter;
-                }
-                else
-                {
-                    //std::cerr << "Advancing u_iter" << std::endl;
-                    do { ++u_idx; } while ((u_idx < u_vals.size()) && !u_bitmap[u_idx]);
-                }
-            }
-
-            return value_set;
-        }
-
         //************************************************************************
         /// A dot product of two sparse vectors (vectors<tuple(index,value)>)
         template <typename D1, typename D2, typename D3, typename SemiringT>
@@ -334,16 +367,302 @@ namespace GraphBLAS
             return value_set;
         }
 
+        //**********************************************************************
+
+        /// Perform the dot product of a row of a matrix with a sparse vector without
+        /// pulling the contents out of the vector first.  The form of the
+        /// vector decides how: merge with its sorted list, probe its bitmap,
+        /// or index its dense values directly.
+        template <typename D1, typename D3, typename UVectorT, typename SemiringT>
+        bool dot2(D3                                                      &ans,
+                  std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &A_row,
+                  UVectorT                                          const &u,
+                  SemiringT                                                op)
+        {
+            if (u.form() == VectorForm::SPARSE)
+            {
+                return dot(ans, A_row, u.get_sparse(), op);
+            }
+
+            bool value_set(false);
+            ans = op.zero();
+
+            if ((u.nvals() == 0) || A_row.empty())
+            {
+                return value_set;
+            }
+
+            auto const &u_vals(u.get_vals());
+            D1 a_val;
+            GraphBLAS::IndexType a_idx;
+
+            if (u.form() == VectorForm::DENSE)
+            {
+                for (auto A_iter = A_row.begin(); A_iter != A_row.end(); ++A_iter)
+                {
+                    std::tie(a_idx, a_val) = *A_iter;
+                    ans = op.add(ans, op.mult(a_val, u_vals[a_idx]));
+                }
+                return true;
+            }
+
+            auto const &u_bitmap(u.get_bitmap());
+            for (auto A_iter = A_row.begin(); A_iter != A_row.end(); ++A_iter)
+            {
+                std::tie(a_idx, a_val) = *A_iter;
+                if (bitmap_test(u_bitmap, a_idx))
+                {
+                    ans = op.add(ans, op.mult(a_val, u_vals[a_idx]));
+                    value_set = true;
+                }
+            }
+
+            return value_set;
+        }
+
         //************************************************************************
-        /// A reduction of a sparse vector (vector<tuple(index,value)>) using a
-        /// binary op or a monoid.
-        template <typename D1, typename D3, typename BinaryOpT>
+        /// Same as above for the product of a sparse vector (on the left) with
+        /// a column of a matrix.
+        template <typename D2, typename D3, typename UVectorT, typename SemiringT>
+        bool dot2(D3                                                      &ans,
+                  UVectorT                                          const &u,
+                  std::vector<std::tuple<GraphBLAS::IndexType,D2> > const &A_col,
+                  SemiringT                                                op)
+        {
+            if (u.form() == VectorForm::SPARSE)
+            {
+                return dot(ans, u.get_sparse(), A_col, op);
+            }
+
+            bool value_set(false);
+            ans = op.zero();
+
+            if ((u.nvals() == 0) || A_col.empty())
+            {
+                return value_set;
+            }
+
+            auto const &u_vals(u.get_vals());
+            D2 a_val;
+            GraphBLAS::IndexType a_idx;
+
+            if (u.form() == VectorForm::DENSE)
+            {
+                for (auto A_iter = A_col.begin(); A_iter != A_col.end(); ++A_iter)
+                {
+                    std::tie(a_idx, a_val) = *A_iter;
+                    ans = op.add(ans, op.mult(u_vals[a_idx], a_val));
+                }
+                return true;
+            }
+
+            auto const &u_bitmap(u.get_bitmap());
+            for (auto A_iter = A_col.begin(); A_iter != A_col.end(); ++A_iter)
+            {
+                std::tie(a_idx, a_val) = *A_iter;
+                if (bitmap_test(u_bitmap, a_idx))
+                {
+                    ans = op.add(ans, op.mult(u_vals[a_idx], a_val));
+                    value_set = true;
+                }
+            }
+
+            return value_set;
+        }
+
+        //************************************************************************
+        /// The reduction with monoid of the elements of row row_idx of
+        /// (A*B)<M>: the dot products of A_row with the columns of B selected
+        /// by the stored values of row row_idx of the mask.  Returns false if
+        /// no dot product has a value.
+        template <typename D3, typename MMatrixT, typename ARowT,
+                  typename BMatrixT, typename SemiringT, typename MonoidT>
+        bool masked_dot_reduction(D3              &ans,
+                                  MonoidT          monoid,
+                                  MMatrixT const  &M,
+                                  IndexType        row_idx,
+                                  SemiringT        op,
+                                  ARowT    const  &A_row,
+                                  BMatrixT const  &B)
+        {
+            typedef typename SemiringT::result_type TScalarType;
+
+            bool value_set(false);
+            ans = monoid.identity();
+
+            if (A_row.empty())
+            {
+                return value_set;
+            }
+
+            TScalarType t_val;
+            for (auto const &mask_elt : M.getRow(row_idx))
+            {
+                typename BMatrixT::ColType B_col(B.getCol(std::get<0>(mask_elt)));
+                if (dot(t_val, A_row, B_col, op))
+                {
+                    ans = monoid(ans, t_val);
+                    value_set = true;
+                }
+            }
+
+            return value_set;
+        }
+
+        /// Same as above with no mask: every column of B is used.
+        template <typename D3, typename ARowT,
+                  typename BMatrixT, typename SemiringT, typename MonoidT>
+        bool masked_dot_reduction(D3                     &ans,
+                                  MonoidT                 monoid,
+                                  backend::NoMask const  &M,
+                                  IndexType               row_idx,
+                                  SemiringT               op,
+                                  ARowT           const  &A_row,
+                                  BMatrixT        const  &B)
+        {
+            typedef typename SemiringT::result_type TScalarType;
+
+            bool value_set(false);
+            ans = monoid.identity();
+
+            if (A_row.empty())
+            {
+                return value_set;
+            }
+
+            TScalarType t_val;
+            for (IndexType col_idx = 0; col_idx < B.ncols(); ++col_idx)
+            {
+                typename BMatrixT::ColType B_col(B.getCol(col_idx));
+                if (dot(t_val, A_row, B_col, op))
+                {
+                    ans = monoid(ans, t_val);
+                    value_set = true;
+                }
+            }
+
+            return value_set;
+        }
+
+        //************************************************************************
+        /**
+         * @brief Compute t(i) = sum over the stored u(k) of mult(u(k), S_k(i)),
+         *        where S_k = slice(k) is a row of a matrix (or a column of a
+         *        TransposeView), by pushing each stored element of u through
+         *        its slice.
+         *
+         * The stored elements of u are visited in increasing index order so
+         * each element of t is summed in the same order as the corresponding
+         * dot product.  A sparse u gathers and sorts the products, otherwise
+         * they are summed in a dense accumulator.
+         *
+         * @param[out] t       The result, in increasing index order.
+         * @param[in]  t_size  The size of the result.
+         * @param[in]  u       The vector.
+         * @param[in]  slice   Returns the k-th slice of the matrix.
+         * @param[in]  mult    mult(u(k), S_k(i)) in the right operand order.
+         * @param[in]  op      Semiring supplying zero() and add().
+         */
+        template <typename D3,
+                  typename UVectorT,
+                  typename SliceFunctionT,
+                  typename MultiplyT,
+                  typename SemiringT>
+        void push_products(std::vector<std::tuple<IndexType, D3> > &t,
+                           IndexType                                t_size,
+                           UVectorT                          const &u,
+                           SliceFunctionT                           slice,
+                           MultiplyT                                mult,
+                           SemiringT                                op)
+        {
+            t.clear();
+
+            if (u.form() == VectorForm::SPARSE)
+            {
+                ScratchRow<D3> products_buf;
+                auto &products(products_buf.get());
+
+                for (auto u_it = u.begin(); u_it != u.end(); ++u_it)
+                {
+                    auto const &slice_k(slice(std::get<0>(*u_it)));
+                    for (auto const &elt : slice_k)
+                    {
+                        products.push_back(std::make_tuple(
+                            std::get<0>(elt),
+                            static_cast<D3>(mult(std::get<1>(*u_it),
+                                                 std::get<1>(elt)))));
+                    }
+                }
+
+                // Stable so the products for an index stay in u order
+                std::stable_sort(
+                    products.begin(), products.end(),
+                    [](std::tuple<IndexType, D3> const &lhs,
+                       std::tuple<IndexType, D3> const &rhs)
+                    { return std::get<0>(lhs) < std::get<0>(rhs); });
+
+                for (auto const &product : products)
+                {
+                    if (!t.empty() &&
+                        (std::get<0>(t.back()) == std::get<0>(product)))
+                    {
+                        std::get<1>(t.back()) =
+                            op.add(std::get<1>(t.back()), std::get<1>(product));
+                    }
+                    else
+                    {
+                        t.push_back(std::make_tuple(
+                            std::get<0>(product),
+                            static_cast<D3>(op.add(op.zero(),
+                                                   std::get<1>(product)))));
+                    }
+                }
+            }
+            else
+            {
+                ScratchBuffer<D3> acc_buf;
+                auto &acc(acc_buf.get());
+                ScratchBuffer<bool> acc_set_buf;
+                auto &acc_set(acc_set_buf.get());
+
+                acc.resize(t_size, op.zero());
+                acc_set.resize(t_size, false);
+
+                for (auto u_it = u.begin(); u_it != u.end(); ++u_it)
+                {
+                    auto const &slice_k(slice(std::get<0>(*u_it)));
+                    for (auto const &elt : slice_k)
+                    {
+                        IndexType idx(std::get<0>(elt));
+                        acc[idx] = op.add(acc[idx],
+                                          mult(std::get<1>(*u_it),
+                                               std::get<1>(elt)));
+                        acc_set[idx] = true;
+                    }
+                }
+
+                for (IndexType idx = 0; idx < t_size; ++idx)
+                {
+                    if (acc_set[idx])
+                    {
+                        t.push_back(std::make_tuple(idx,
+                                                    static_cast<D3>(acc[idx])));
+                    }
+                }
+            }
+        }
+
+        //************************************************************************
+        /// A reduction of a sparse sequence of (index, value) tuples (a row or
+        /// the stored elements of a vector) using a binary op or a monoid.
+        template <typename D3, typename SequenceT, typename BinaryOpT>
         bool reduction(
             D3                                                      &ans,
-            std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &vec,
+            SequenceT                                         const &vec,
             BinaryOpT                                                op)
         {
-            if (vec.empty())
+            auto it = vec.begin();
+            if (it == vec.end())
             {
                 return false;
             }
@@ -351,19 +670,21 @@ namespace GraphBLAS
             typedef typename BinaryOpT::result_type D3ScalarType;
             D3ScalarType tmp;
 
-            if (vec.size() == 1)
+            auto first_val = std::get<1>(*it);
+            ++it;
+            if (it == vec.end())
             {
-                tmp = static_cast<D3ScalarType>(std::get<1>(vec[0]));
+                tmp = static_cast<D3ScalarType>(first_val);
             }
             else
             {
                 /// @note Since op is associative and commutative left to right
                 /// ordering is not strictly required.
-                tmp = op(std::get<1>(vec[0]), std::get<1>(vec[1]));
+                tmp = op(first_val, std::get<1>(*it));
 
-                for (size_t idx = 2; idx < vec.size(); ++idx)
+                for (++it; it != vec.end(); ++it)
                 {
-                    tmp = op(tmp, std::get<1>(vec[idx]));
+                    tmp = op(tmp, std::get<1>(*it));
                 }
             }
 
@@ -371,20 +692,53 @@ namespace GraphBLAS
             return true;
         }
 
+        //************************************************************************
+        /// reduction() in the given reduction mode: left to right when it is
+        /// FAST, otherwise in the order of a TreeReduction.
+        template <typename D3, typename SequenceT, typename BinaryOpT>
+        bool reduction(
+            D3                                                      &ans,
+            SequenceT                                         const &vec,
+            BinaryOpT                                                op,
+            ReductionMode                                            mode)
+        {
+            if (mode == ReductionMode::FAST)
+            {
+                return reduction(ans, vec, op);
+            }
+
+            typedef typename BinaryOpT::result_type D3ScalarType;
+            TreeReduction<D3ScalarType, BinaryOpT> tree(
+                op, mode == ReductionMode::COMPENSATED);
+            for (auto it = vec.begin(); it != vec.end(); ++it)
+            {
+                tree.add(static_cast<D3ScalarType>(std::get<1>(*it)));
+            }
+
+            if (tree.empty())
+            {
+                return false;
+            }
+
+            ans = static_cast<D3>(tree.result());
+            return true;
+        }
+
         //**********************************************************************
-        /// Apply element-wise operation to union on sparse vectors.
-        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        /// Apply element-wise operation to union on sparse vectors (sparse
+        /// sequences of (index, value) tuples).
+        template <typename D3, typename Seq1T, typename Seq2T, typename BinaryOpT>
         void ewise_or(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
-                      std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &vec1,
-                      std::vector<std::tuple<GraphBLAS::IndexType,D2> > const &vec2,
+                      Seq1T                                             const &vec1,
+                      Seq2T                                             const &vec2,
                       BinaryOpT                                                op)
         {
             ans.clear();
             auto v1_it = vec1.begin();
             auto v2_it = vec2.begin();
 
-            D1 v1_val;
-            D2 v2_val;
+            SequenceScalarType<Seq1T> v1_val;
+            SequenceScalarType<Seq2T> v2_val;
             GraphBLAS::IndexType v1_idx, v2_idx;
 
             // loop through both ordered sets to compute ewise_or
@@ -483,11 +837,11 @@ namespace GraphBLAS
         /// \param vec2  A row of the T (or t) container, indices in increasing order
         /// \param stencil_indices  Assumed to not be in order
         ///
-        template <typename D1, typename D2, typename D3, typename SequenceT>
+        template <typename D3, typename Seq1T, typename Seq2T, typename SequenceT>
         void ewise_or_stencil(
             std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
-            std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &vec1,
-            std::vector<std::tuple<GraphBLAS::IndexType,D2> > const &vec2,
+            Seq1T                                             const &vec1,
+            Seq2T                                             const &vec2,
             SequenceT                                                stencil_indices)
         {
             ans.clear();
@@ -500,8 +854,8 @@ namespace GraphBLAS
             //    ++stencil_it;
             //}
 
-            D1 v1_val;
-            D2 v2_val;
+            SequenceScalarType<Seq1T> v1_val;
+            SequenceScalarType<Seq2T> v2_val;
             GraphBLAS::IndexType v1_idx, v2_idx;
 
             // loop through both ordered sets to compute ewise_or
@@ -581,7 +935,7 @@ namespace GraphBLAS
             BinaryOpT                                                     accum)
         {
             // If there is an accumulate operations, do nothing with the stencil
-            ewise_or(z, w.getContents(), t, accum);
+            ewise_or(z, w, t, accum);
         }
 
         //**********************************************************************
@@ -598,7 +952,7 @@ namespace GraphBLAS
         {
             // If there is no accumulate we need to annihilate stored values
             // in w that fall in the stencil
-            ewise_or_stencil(z, w.getContents(), t, indices);
+            ewise_or_stencil(z, w, t, indices);
         }
 
 
@@ -621,7 +975,8 @@ namespace GraphBLAS
 
             typedef std::vector<std::tuple<IndexType,ZScalarType> > ZRowType;
 
-            ZRowType tmp_row;
+            ScratchRow<ZScalarType> tmp_row_buf;
+            auto &tmp_row(tmp_row_buf.get());
             IndexType nRows(Z.nrows());
             for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
             {
@@ -649,7 +1004,8 @@ namespace GraphBLAS
 
             typedef std::vector<std::tuple<IndexType,ZScalarType> > ZRowType;
 
-            ZRowType tmp_row;
+            ScratchRow<ZScalarType> tmp_row_buf;
+            auto &tmp_row(tmp_row_buf.get());
             IndexType nRows(Z.nrows());
 
             for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
@@ -684,7 +1040,8 @@ namespace GraphBLAS
 
             typedef std::vector<std::tuple<IndexType,ZScalarType> > ZRowType;
 
-            ZRowType tmp_row;
+            ScratchRow<ZScalarType> tmp_row_buf;
+            auto &tmp_row(tmp_row_buf.get());
             IndexType nRows(Z.nrows());
             for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
             {
@@ -707,6 +1064,19 @@ namespace GraphBLAS
             sparse_copy(Z, T);
         }
 
+        // Z is just T, so a T that is a temporary of the calling operation
+        // is moved instead of copied.
+        template < typename ZMatrixT,
+                   typename CMatrixT,
+                   typename TScalarT>
+        void ewise_or_opt_accum(ZMatrixT                      &Z,
+                                CMatrixT const                &C,
+                                LilSparseMatrix<TScalarT>    &&T,
+                                GraphBLAS::NoAccumulate )
+        {
+            sparse_move(Z, std::move(T));
+        }
+
         //**********************************************************************
         template <typename ZScalarT,
                   typename WVectorT,
@@ -719,7 +1089,7 @@ namespace GraphBLAS
             BinaryOpT                                                     accum)
         {
             //z.clear();
-            ewise_or(z, w.getContents(), t, accum);
+            ewise_or(z, w, t, accum);
         }
 
         //**********************************************************************
@@ -768,20 +1138,46 @@ namespace GraphBLAS
             z = static_cast<ZScalarT>(t);
         }
 
+        //**********************************************************************
+        /// c := accum(c, op(c)), or op(c) with no accumulator: apply of an
+        /// output to itself, one stored value at a time.
+        template <typename CScalarT, typename AccumT, typename UnaryFunctionT>
+        class InPlaceApply
+        {
+        public:
+            InPlaceApply(AccumT accum, UnaryFunctionT op)
+                : m_accum(accum), m_op(op)
+            {
+            }
+
+            CScalarT operator()(CScalarT c_val)
+            {
+                typename UnaryFunctionT::result_type t_val(m_op(c_val));
+                CScalarT z_val;
+                opt_accum_scalar(z_val, c_val, t_val, m_accum);
+                return z_val;
+            }
+
+        private:
+            AccumT         m_accum;
+            UnaryFunctionT m_op;
+        };
+
         //************************************************************************
-        /// Apply element-wise operation to intersection of sparse vectors.
-        template <typename D1, typename D2, typename D3, typename BinaryOpT>
+        /// Apply element-wise operation to intersection of sparse vectors
+        /// (sparse sequences of (index, value) tuples).
+        template <typename D3, typename Seq1T, typename Seq2T, typename BinaryOpT>
         void ewise_and(std::vector<std::tuple<GraphBLAS::IndexType,D3> >       &ans,
-                       std::vector<std::tuple<GraphBLAS::IndexType,D1> > const &vec1,
-                       std::vector<std::tuple<GraphBLAS::IndexType,D2> > const &vec2,
+                       Seq1T                                             const &vec1,
+                       Seq2T                                             const &vec2,
                        BinaryOpT                                                op)
         {
             ans.clear();
             auto v1_it = vec1.begin();
             auto v2_it = vec2.begin();
 
-            D1 v1_val;
-            D2 v2_val;
+            SequenceScalarType<Seq1T> v1_val;
+            SequenceScalarType<Seq2T> v2_val;
             GraphBLAS::IndexType v1_idx, v2_idx;
 
             // loop through both ordered sets to compute ewise_or
@@ -829,8 +1225,9 @@ namespace GraphBLAS
          *        {(i,j,Zij):(i,j) \in (ind(Z) \cap int(\not M))}
          *
          * @tparam CScalarT The scalar type of the C vector input AND result.
-         * @tparam ZScalarT The scalar type of the Z vector input.
-         * @tparam MScalarT The scalar type of the mask vector.
+         * @tparam CSequenceT The type of the C row or vector.
+         * @tparam ZSequenceT The type of the Z row or vector.
+         * @tparam MSequenceT The type of the mask row or vector.
          *
          * @param result Result vector.  We clear this first.
          * @param c_vec The original c values that may be carried through.
@@ -840,12 +1237,13 @@ namespace GraphBLAS
          *                by the mask regardless if they are overlayed.
          */
         template < typename CScalarT,
-                   typename ZScalarT,
-                   typename MScalarT>
+                   typename CSequenceT,
+                   typename ZSequenceT,
+                   typename MSequenceT>
         void apply_with_mask(std::vector<std::tuple<IndexType, CScalarT> >          &result,
-                             std::vector<std::tuple<IndexType, CScalarT> > const    &c_vec,
-                             std::vector<std::tuple<IndexType, ZScalarT> > const    &z_vec,
-                             std::vector<std::tuple<IndexType, MScalarT> > const    &mask_vec,
+                             CSequenceT                                     const   &c_vec,
+                             ZSequenceT                                     const   &z_vec,
+                             MSequenceT                                     const   &mask_vec,
                              bool                                                    replace)
         {
             auto c_it = c_vec.begin();
@@ -853,8 +1251,8 @@ namespace GraphBLAS
             auto mask_it = mask_vec.begin();
 
             CScalarT c_val;
-            ZScalarT z_val;
-            MScalarT mask_val;
+            SequenceScalarType<ZSequenceT> z_val;
+            SequenceScalarType<MSequenceT> mask_val;
             GraphBLAS::IndexType c_idx, z_idx, mask_idx;
 
             //std::cerr << "Executing apply_with_mask with mask and replace: " << replace << std::endl;
@@ -956,14 +1354,15 @@ namespace GraphBLAS
             typedef std::vector<std::tuple<IndexType, ZScalarType> > ZRowType;
             typedef std::vector<std::tuple<IndexType, MScalarType> > MRowType;
 
-            CRowType tmp_row;
+            ScratchRow<CScalarType> tmp_row_buf;
+            auto &tmp_row(tmp_row_buf.get());
             IndexType nRows(C.nrows());
             for (IndexType row_idx = 0; row_idx < nRows; ++row_idx)
             {
                 apply_with_mask(tmp_row, C.getRow(row_idx), Z.getRow(row_idx),
                                 mask.getRow(row_idx), replace);
 
-                // Now, set the new one.  Yes, we can optimize this later
+                // Now, set the new one (reusing the storage of the old row)
                 C.setRow(row_idx, tmp_row);
             }
         }
@@ -981,6 +1380,16 @@ namespace GraphBLAS
             sparse_copy(C, Z);
         }
 
+        template < typename CMatrixT,
+                   typename ZScalarT >
+        void write_with_opt_mask(CMatrixT                     &C,
+                                 LilSparseMatrix<ZScalarT>   &&Z,
+                                 backend::NoMask    const     &foo,
+                                 bool                          replace)
+        {
+            sparse_move(C, std::move(Z));
+        }
+
         //**********************************************************************
         // Vector version
 
@@ -994,12 +1403,11 @@ namespace GraphBLAS
             bool                                                replace)
         {
             typedef typename WVectorT::ScalarType WScalarType;
-            std::vector<std::tuple<IndexType, WScalarType> > tmp_row;
+            ScratchRow<WScalarType> tmp_row_buf;
+            auto &tmp_row(tmp_row_buf.get());
 
-            apply_with_mask(tmp_row, w.getContents(), z,
-                            mask.getContents(), replace);
+            apply_with_mask(tmp_row, w, z, mask, replace);
 
-            // Now, set the new one.  Yes, we can optimize this later
             w.setContents(tmp_row);
         }
 
@@ -1018,6 +1426,43 @@ namespace GraphBLAS
             w.setContents(z);
         }
 
+        //**********************************************************************
+        /**
+         * @brief Accumulate T into C and write the result through the mask.
+         *
+         * T is a temporary of the calling operation.  With no accumulator it
+         * is written directly (and swapped into C when there is no mask), so
+         * no Z matrix is made.
+         */
+        template <typename CMatrixT,
+                  typename TScalarT,
+                  typename MaskT,
+                  typename AccumT>
+        void opt_accum_and_write(CMatrixT                     &C,
+                                 LilSparseMatrix<TScalarT>   &&T,
+                                 MaskT                const   &mask,
+                                 AccumT                        accum,
+                                 bool                          replace)
+        {
+            typedef typename AccumT::result_type ZScalarType;
+
+            LilSparseMatrix<ZScalarType> Z(C.nrows(), C.ncols());
+            ewise_or_opt_accum(Z, C, T, accum);
+            write_with_opt_mask(C, std::move(Z), mask, replace);
+        }
+
+        template <typename CMatrixT,
+                  typename TScalarT,
+                  typename MaskT>
+        void opt_accum_and_write(CMatrixT                     &C,
+                                 LilSparseMatrix<TScalarT>   &&T,
+                                 MaskT                const   &mask,
+                                 GraphBLAS::NoAccumulate,
+                                 bool                          replace)
+        {
+            write_with_opt_mask(C, std::move(T), mask, replace);
+        }
+
         //********************************************************************
         // Index-out-of-bounds is an execution error and a responsibility of
         // the backend.
@@ -76,9 +76,6 @@ namespace GraphBLAS
             // Dimension checks happen in front end
             IndexType nrow_A(A.nrows());
             IndexType ncol_B(B.ncols());
-            //Frontend checks the dimensions, but use C explicitly
-            IndexType nrow_C(C.nrows());
-            IndexType ncol_C(C.ncols());
 
             typedef typename SemiringT::result_type D3ScalarType;
             typedef typename AMatrixT::ScalarType AScalarType;
@@ -89,13 +86,15 @@ namespace GraphBLAS
 
             // =================================================================
             // Do the basic dot-product work with the semi-ring.
-            LilSparseMatrix<D3ScalarType> T(nrow_A, ncol_B);
+            ScratchMatrix<D3ScalarType> T_buf(nrow_A, ncol_B);
+            auto &T(T_buf.get());
 
             // Build this completely based on the semiring
             if ((A.nvals() > 0) && (B.nvals() > 0))
             {
                 // create a column of result at a time
-                TColType T_col;
+                ScratchRow<D3ScalarType> T_col_buf;
+                auto &T_col(T_col_buf.get());
                 for (IndexType col_idx = 0; col_idx < ncol_B; ++col_idx)
                 {
                     typename BMatrixT::ColType B_col(B.getCol(col_idx));
@@ -104,7 +103,7 @@ namespace GraphBLAS
                     {
                         for (IndexType row_idx = 0; row_idx < nrow_A; ++row_idx)
                         {
-                            typename AMatrixT::RowType A_row(A.getRow(row_idx));
+                            typename AMatrixT::RowType const &A_row(A.getRow(row_idx));
                             if (!A_row.empty())
                             {
                                 D3ScalarType T_val;
@@ -127,22 +126,118 @@ namespace GraphBLAS
             GRB_LOG_VERBOSE("T: " << T);
 
             // =================================================================
-            // Accumulate into Z
+            // Accumulate into Z and copy into the final output considering
+            // mask and replace.  T is the back buffer of C: when it is
+            // swapped in, the old rows of C become the buffer for the next
+            // product of this shape.
+            opt_accum_and_write(C, std::move(T), M, accum, replace_flag);
+
+        } // mxm
+
+        //**********************************************************************
+        /// t(i) = the reduction with monoid of row i of (A*B)<M>, for the
+        /// rows that have a value.  The product is never stored.
+        template<typename D3ScalarT,
+                 typename MonoidT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void reduce_masked_mxm_rows(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            MonoidT                                         monoid,
+            MMatrixT                                const  &M,
+            SemiringT                                       op,
+            AMatrixT                                const  &A,
+            BMatrixT                                const  &B)
+        {
+            t.clear();
+            if ((A.nvals() == 0) || (B.nvals() == 0))
+            {
+                return;
+            }
+
+            for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+            {
+                D3ScalarT t_val;
+                if (masked_dot_reduction(t_val, monoid, M, row_idx, op,
+                                         A.getRow(row_idx), B))
+                {
+                    t.push_back(std::make_tuple(row_idx, t_val));
+                }
+            }
+        }
+
+        //**********************************************************************
+        /// reduce(w, mask, accum, monoid, (A*B)<M>): the row reduction of a
+        /// masked product without computing the product matrix.
+        template<typename WVectorT,
+                 typename MaskT,
+                 typename AccumT,
+                 typename MonoidT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void reduce_masked_mxm(WVectorT        &w,
+                                      MaskT     const &mask,
+                                      AccumT           accum,
+                                      MonoidT          monoid,
+                                      MMatrixT  const &M,
+                                      SemiringT        op,
+                                      AMatrixT  const &A,
+                                      BMatrixT  const &B,
+                                      bool             replace_flag = false)
+        {
+            typedef typename MonoidT::result_type D3ScalarType;
+            ScratchRow<D3ScalarType> t_buf;
+            auto &t(t_buf.get());
+            reduce_masked_mxm_rows(t, monoid, M, op, A, B);
+
             typedef typename std::conditional<
                 std::is_same<AccumT, NoAccumulate>::value,
                 D3ScalarType,
-                typename AccumT::result_type>::type ZScalarType;
-            LilSparseMatrix<ZScalarType> Z(nrow_C, ncol_C);
+                typename AccumT::result_type>::type  ZScalarType;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
+            ewise_or_opt_accum_1D(z, w, t, accum);
 
-            ewise_or_opt_accum(Z, C, T, accum);
+            write_with_opt_mask_1D(w, z, mask, replace_flag);
+        }
 
-            GRB_LOG_VERBOSE("Z: " << Z);
+        //**********************************************************************
+        /// reduce(val, accum, monoid, (A*B)<M>): the scalar reduction of a
+        /// masked product without computing the product matrix.
+        template<typename ValueT,
+                 typename AccumT,
+                 typename MonoidT,
+                 typename MMatrixT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename BMatrixT>
+        inline void reduce_masked_mxm_to_scalar(ValueT         &val,
+                                                AccumT          accum,
+                                                MonoidT         monoid,
+                                                MMatrixT const &M,
+                                                SemiringT       op,
+                                                AMatrixT const &A,
+                                                BMatrixT const &B)
+        {
+            typedef typename MonoidT::result_type D3ScalarType;
+            ScratchRow<D3ScalarType> row_vals_buf;
+            auto &row_vals(row_vals_buf.get());
+            reduce_masked_mxm_rows(row_vals, monoid, M, op, A, B);
 
-            // =================================================================
-            // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, M, replace_flag);
+            D3ScalarType t = monoid.identity();
+            for (auto const &row_val : row_vals)
+            {
+                t = monoid(t, std::get<1>(row_val));
+            }
 
-        } // mxm
+            ValueT z;
+            opt_accum_scalar(z, val, t, accum);
+            val = z;
+        }
     } // backend
 } // GraphBLAS
 
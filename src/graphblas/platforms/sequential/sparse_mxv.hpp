@@ -44,6 +44,7 @@
 #include <graphblas/algebra.hpp>
 
 #include "sparse_helpers.hpp"
+#include "TransposeView.hpp"
 
 
 //****************************************************************************
@@ -52,6 +53,62 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //********************************************************************
+        /// t = Au when the rows of A are stored: take the dot product of u
+        /// with each one.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename AMatrixT,
+                 typename UVectorT>
+        inline void mxv_products(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            IndexType                                       t_size,
+            SemiringT                                       op,
+            AMatrixT                                 const &A,
+            UVectorT                                 const &u)
+        {
+            for (IndexType row_idx = 0; row_idx < t_size; ++row_idx)
+            {
+                auto const &A_row(A.getRow(row_idx));
+
+                if (!A_row.empty())
+                {
+                    D3ScalarT t_val;
+                    if (dot2(t_val, A_row, u, op))
+                    {
+                        t.push_back(std::make_tuple(row_idx, t_val));
+                    }
+                }
+            }
+        }
+
+        //********************************************************************
+        /// t = Au when A is a transpose: its columns are the stored rows of
+        /// the underlying matrix, so push each stored element u(k) through
+        /// column k of A.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename MatrixT,
+                 typename UVectorT>
+        inline void mxv_products(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            IndexType                                       t_size,
+            SemiringT                                       op,
+            TransposeView<MatrixT>                   const &A,
+            UVectorT                                 const &u)
+        {
+            typedef typename UVectorT::ScalarType UScalarType;
+            typedef typename MatrixT::ScalarType  AScalarType;
+
+            push_products(
+                t, t_size, u,
+                [&A](IndexType k) -> decltype(A.getCol(k))
+                { return A.getCol(k); },
+                [&op](UScalarType u_val, AScalarType a_val)
+                { return op.mult(a_val, u_val); },
+                op);
+        }
+
         //********************************************************************
         /// Implementation of 4.3.3 mxv: Matrix-Vector variant
         template<typename WVectorT,
@@ -71,27 +128,13 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic dot-product work with the semi-ring.
             typedef typename SemiringT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
 
-            std::vector<std::tuple<IndexType, D3ScalarType> > t;
+            ScratchRow<D3ScalarType> t_buf;
+            auto &t(t_buf.get());
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                auto u_contents(u.getContents());
-                for (IndexType row_idx = 0; row_idx < w.size(); ++row_idx)
-                {
-                    ARowType const &A_row(A.getRow(row_idx));
-
-                    if (!A_row.empty())
-                    {
-                        D3ScalarType t_val;
-                        if (dot(t_val, A_row, u_contents, op))
-                        {
-                            t.push_back(std::make_tuple(row_idx, t_val));
-                        }
-                    }
-                }
+                mxv_products(t, w.size(), op, A, u);
             }
 
             // =================================================================
@@ -99,7 +142,8 @@ namespace GraphBLAS
             typedef typename std::conditional<std::is_same<AccumT, NoAccumulate>::value,
                                               D3ScalarType,
                                               typename AccumT::result_type>::type ZScalarType;
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
             ewise_or_opt_accum_1D(z, w, t, accum);
 
             // =================================================================
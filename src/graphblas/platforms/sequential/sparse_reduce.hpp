@@ -71,7 +71,9 @@ namespace GraphBLAS
             typedef typename AMatrixT::ScalarType AScalarType;
             typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
 
-            std::vector<std::tuple<IndexType, D3ScalarType> > t;
+            ScratchRow<D3ScalarType> t_buf;
+            auto &t(t_buf.get());
+            ReductionMode const mode(reduction_mode());
 
             if (A.nvals() > 0)
             {
@@ -79,13 +81,13 @@ namespace GraphBLAS
                 {
                     /// @todo Can't be a reference because A might be transpose
                     /// view.  Need to specialize on TransposeView and getCol()
-                    ARowType const A_row(A.getRow(row_idx));
+                    ARowType const &A_row(A.getRow(row_idx));
 
                     /// @todo There is something hinky with domains here.  How
                     /// does one perform the reduction in A domain but produce
                     /// partial results in D3(op)?
                     D3ScalarType t_val;
-                    if (reduction(t_val, A_row, op))
+                    if (reduction(t_val, A_row, op, mode))
                     {
                         t.push_back(std::make_tuple(row_idx, t_val));
                     }
@@ -99,7 +101,8 @@ namespace GraphBLAS
                 std::is_same<AccumT, NoAccumulate>::value,
                 D3ScalarType,
                 typename AccumT::result_type>::type  ZScalarType;
-            std::vector<std::tuple<IndexType, ZScalarType> > z;
+            ScratchRow<ZScalarType> z_buf;
+            auto &z(z_buf.get());
             ewise_or_opt_accum_1D(z, w, t, accum);
 
             // =================================================================
@@ -128,9 +131,7 @@ namespace GraphBLAS
 
             if (u.nvals() > 0)
             {
-                UColType const u_col(u.getContents());
-
-                reduction(t, u_col, op);
+                reduction(t, u, op, reduction_mode());
             }
 
             // =================================================================
@@ -163,14 +164,29 @@ namespace GraphBLAS
             typedef std::vector<std::tuple<IndexType,AScalarType> >  ARowType;
 
             D3ScalarType t = op.identity();
+            ReductionMode const mode(reduction_mode());
 
-            if (A.nvals() > 0)
+            if ((A.nvals() > 0) && (mode != ReductionMode::FAST))
+            {
+                // All of the stored values in row order, as one sequence
+                TreeReduction<D3ScalarType, MonoidT> tree(
+                    op, mode == ReductionMode::COMPENSATED);
+                for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
+                {
+                    for (auto const &elt : A.getRow(row_idx))
+                    {
+                        tree.add(static_cast<D3ScalarType>(std::get<1>(elt)));
+                    }
+                }
+                t = tree.result();
+            }
+            else if (A.nvals() > 0)
             {
                 for (IndexType row_idx = 0; row_idx < A.nrows(); ++row_idx)
                 {
                     /// @todo Can't be a reference because A might be transpose
                     /// view.  Need to specialize on TransposeView and getCol()
-                    ARowType const A_row(A.getRow(row_idx));
+                    ARowType const &A_row(A.getRow(row_idx));
 
                     /// @todo There is something hinky with domains here.  How
                     /// does one perform the reduction in A domain but produce
@@ -106,13 +106,13 @@ namespace GraphBLAS
                 typename AccumT::result_type>::type  ZScalarType;
 
             LilSparseMatrix<ZScalarType> Z(ncols, nrows);
-            ewise_or_opt_accum(Z, C, T, accum);
+            ewise_or_opt_accum(Z, C, std::move(T), accum);
 
             GRB_LOG_VERBOSE("Z: " << Z);
 
             // =================================================================
             // Copy Z into the final output considering mask and replace
-            write_with_opt_mask(C, Z, mask, replace_flag);
+            write_with_opt_mask(C, std::move(Z), mask, replace_flag);
         }
     }
 }
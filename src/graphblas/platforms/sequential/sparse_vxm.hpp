@@ -44,6 +44,7 @@
 #include <graphblas/algebra.hpp>
 
 #include "sparse_helpers.hpp"
+#include "TransposeView.hpp"
 
 
 //****************************************************************************
@@ -52,6 +53,61 @@ namespace GraphBLAS
 {
     namespace backend
     {
+        //********************************************************************
+        /// t = u'A when the rows of A are stored: push each stored element
+        /// u(k) through row k of A.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename UVectorT,
+                 typename AMatrixT>
+        inline void vxm_products(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            IndexType                                       t_size,
+            SemiringT                                       op,
+            UVectorT                                 const &u,
+            AMatrixT                                 const &A)
+        {
+            typedef typename UVectorT::ScalarType UScalarType;
+            typedef typename AMatrixT::ScalarType AScalarType;
+
+            push_products(
+                t, t_size, u,
+                [&A](IndexType k) -> decltype(A.getRow(k))
+                { return A.getRow(k); },
+                [&op](UScalarType u_val, AScalarType a_val)
+                { return op.mult(u_val, a_val); },
+                op);
+        }
+
+        //********************************************************************
+        /// t = u'A when A is a transpose: the columns of A are the stored rows
+        /// of the underlying matrix, so take the dot product with each one.
+        template<typename D3ScalarT,
+                 typename SemiringT,
+                 typename UVectorT,
+                 typename MatrixT>
+        inline void vxm_products(
+            std::vector<std::tuple<IndexType, D3ScalarT> > &t,
+            IndexType                                       t_size,
+            SemiringT                                       op,
+            UVectorT                                 const &u,
+            TransposeView<MatrixT>                   const &A)
+        {
+            for (IndexType col_idx = 0; col_idx < t_size; ++col_idx)
+            {
+                auto const &A_col(A.getCol(col_idx));
+
+                if (!A_col.empty())
+                {
+                    D3ScalarT t_val;
+                    if (dot2(t_val, u, A_col, op))
+                    {
+                        t.push_back(std::make_tuple(col_idx, t_val));
+                    }
+                }
+            }
+        }
+
         //********************************************************************
         /// Implementation of 4.3.2 vxm: Vector-Matrix multiply
         template<typename WVectorT,
@@ -71,27 +127,13 @@ namespace GraphBLAS
             // =================================================================
             // Do the basic dot-product work with the semi-ring.
             typedef typename SemiringT::result_type D3ScalarType;
-            typedef typename AMatrixT::ScalarType AScalarType;
-            typedef std::vector<std::tuple<IndexType,AScalarType> > AColType;
 
-            std::vector<std::tuple<IndexType, D3ScalarType> > t;
+            ScratchRow<D3ScalarType> t_buf;
+            auto &t(t_buf.get());
 
             if ((A.nvals() > 0) && (u.nvals() > 0))
             {
-                auto u_contents(u.getContents());
-                for (IndexType col_idx = 0; col_idx < w.size(); ++col_idx)
-                {
-                    AColType const &A_col(A.getCol(col_idx));
-
-                    if (!A_col.empty())
-                    {
-                        D3ScalarType t_val;
-                        if (dot(t_val, u_contents, A_col, op))
-                        {
-                            t.push_back(std::make_tuple(col_idx, t_val));
-                        }
-                    }
-                }
+                vxm_products(t, w.size(), op, u, A);
             }
 
             // =================================================================
@@ -100,7 +142,8 @@ namespace GraphBLAS
             /// or D3(accum). I think that output type should be equivalent, but
             /// still need to work the proof.
             typedef typename WVectorT::ScalarType WScalarType;
-            std::vector<std::tuple<IndexType, WScalarType> > z;
+            ScratchRow<WScalarType> z_buf;
+            auto &z(z_buf.get());
             ewise_or_opt_accum_1D(z, w, t, accum);
 
             // =================================================================
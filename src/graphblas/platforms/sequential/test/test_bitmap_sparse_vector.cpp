@@ -176,6 +176,49 @@ BOOST_AUTO_TEST_CASE(test_assignment)
     BOOST_CHECK_EQUAL(v1, v2);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_const_iterator)
+{
+    std::vector<IndexType> indices = {0, 3, 4, 6, 7};
+    std::vector<double>    values  = {6 ,4, 7, 9, 4};
+
+    GraphBLAS::backend::BitmapSparseVector<double> v1(8, indices, values);
+
+    IndexType count(0);
+    for (auto it = v1.begin(); it != v1.end(); ++it, ++count)
+    {
+        BOOST_CHECK_EQUAL(std::get<0>(*it), indices[count]);
+        BOOST_CHECK_EQUAL(std::get<1>(*it), values[count]);
+    }
+    BOOST_CHECK_EQUAL(count, v1.nvals());
+
+    GraphBLAS::backend::BitmapSparseVector<double> v2(8);
+    BOOST_CHECK(v2.begin() == v2.end());
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_move_construction_assignment)
+{
+    std::vector<IndexType> indices = {0, 3, 4, 6, 7};
+    std::vector<double>    values  = {6 ,4, 7, 9, 4};
+
+    GraphBLAS::backend::BitmapSparseVector<double> ans(8, indices, values);
+    GraphBLAS::backend::BitmapSparseVector<double> v1(8, indices, values);
+
+    GraphBLAS::backend::BitmapSparseVector<double> v2(std::move(v1));
+    BOOST_CHECK_EQUAL(v2, ans);
+    BOOST_CHECK_EQUAL(v1.size(), 8UL);
+    BOOST_CHECK_EQUAL(v1.nvals(), 0UL);
+
+    GraphBLAS::backend::BitmapSparseVector<double> v3(8);
+    v3 = std::move(v2);
+    BOOST_CHECK_EQUAL(v3, ans);
+    BOOST_CHECK_EQUAL(v2.nvals(), 0UL);
+
+    GraphBLAS::backend::BitmapSparseVector<double> v4(7);
+    BOOST_CHECK_THROW(v4 = std::move(v3), GraphBLAS::DimensionException);
+}
+
 //****************************************************************************
 BOOST_AUTO_TEST_CASE(test_mxv_sparse_nomask_noaccum)
 {
@@ -215,4 +258,272 @@ BOOST_AUTO_TEST_CASE(test_mxv_sparse_nomask_noaccum)
     w.printInfo(std::cerr);
 }
 
+//****************************************************************************
+namespace
+{
+    // Stored elements at 0, stride, 2*stride, ... with value index + 1
+    std::vector<std::tuple<GraphBLAS::IndexType, double> >
+    strided_contents(GraphBLAS::IndexType nvals, GraphBLAS::IndexType stride)
+    {
+        std::vector<std::tuple<GraphBLAS::IndexType, double> > contents;
+        for (GraphBLAS::IndexType ix = 0; ix < nvals; ++ix)
+        {
+            contents.push_back(std::make_tuple(ix*stride, double(ix*stride + 1)));
+        }
+        return contents;
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_form_transitions)
+{
+    using GraphBLAS::backend::VectorForm;
+    GraphBLAS::backend::BitmapSparseVector<double> v(1000);
+    BOOST_CHECK(v.form() == VectorForm::SPARSE);
+
+    // Up to size/16 stored elements stay sparse
+    for (GraphBLAS::IndexType ix = 0; ix < 62; ++ix)
+    {
+        v.setElement(ix*10, 1.0);
+    }
+    BOOST_CHECK(v.form() == VectorForm::SPARSE);
+    v.setElement(999, 1.0);
+    BOOST_CHECK(v.form() == VectorForm::BITMAP);
+    BOOST_CHECK_EQUAL(v.nvals(), 63);
+
+    // ... but do not go back until below size/64
+    v.setContents(strided_contents(30, 10));
+    BOOST_CHECK(v.form() == VectorForm::BITMAP);
+    v.setContents(strided_contents(10, 10));
+    BOOST_CHECK(v.form() == VectorForm::SPARSE);
+    v.setContents(strided_contents(30, 10));
+    BOOST_CHECK(v.form() == VectorForm::SPARSE);
+    BOOST_CHECK_EQUAL(v.nvals(), 30);
+
+    v.setContents(strided_contents(1000, 1));
+    BOOST_CHECK(v.form() == VectorForm::DENSE);
+    BOOST_CHECK_EQUAL(v.nvals(), 1000);
+
+    v.clear();
+    BOOST_CHECK(v.form() == VectorForm::SPARSE);
+    BOOST_CHECK_EQUAL(v.nvals(), 0);
+
+    GraphBLAS::backend::BitmapSparseVector<double> full(1000, 3.0);
+    BOOST_CHECK(full.form() == VectorForm::DENSE);
+    BOOST_CHECK_EQUAL(full.nvals(), 1000);
+    BOOST_CHECK_EQUAL(full.extractElement(999), 3.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_forms_iterate_and_compare_alike)
+{
+    using GraphBLAS::backend::VectorForm;
+    auto contents(strided_contents(40, 7));
+
+    // Same contents reached from a sparse and from a bitmap vector
+    GraphBLAS::backend::BitmapSparseVector<double> sparse(1000);
+    sparse.setContents(contents);
+    GraphBLAS::backend::BitmapSparseVector<double> bitmap(1000);
+    bitmap.setContents(strided_contents(100, 7));
+    bitmap.setContents(contents);
+
+    BOOST_CHECK(sparse.form() == VectorForm::SPARSE);
+    BOOST_CHECK(bitmap.form() == VectorForm::BITMAP);
+    BOOST_CHECK_EQUAL(sparse, bitmap);
+
+    std::vector<std::tuple<GraphBLAS::IndexType, double> > from_sparse(
+        sparse.begin(), sparse.end());
+    std::vector<std::tuple<GraphBLAS::IndexType, double> > from_bitmap(
+        bitmap.begin(), bitmap.end());
+    BOOST_CHECK(from_sparse == contents);
+    BOOST_CHECK(from_bitmap == contents);
+
+    double val;
+    BOOST_CHECK(sparse.probe(14, val));
+    BOOST_CHECK_EQUAL(val, 15.0);
+    BOOST_CHECK(!sparse.probe(15, val));
+    BOOST_CHECK(bitmap.probe(14, val));
+    BOOST_CHECK_EQUAL(val, 15.0);
+    BOOST_CHECK(!bitmap.probe(15, val));
+
+    bitmap.setElement(15, 2.0);
+    BOOST_CHECK(sparse != bitmap);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_build_duplicates)
+{
+    GraphBLAS::IndexArrayType i = {500, 3, 500, 7};
+    std::vector<double>       v = {1,   2, 10,  4};
+
+    GraphBLAS::backend::BitmapSparseVector<double> vec(1000);
+    vec.build(i.begin(), v.begin(), i.size(), GraphBLAS::Plus<double>());
+
+    BOOST_CHECK(vec.form() == GraphBLAS::backend::VectorForm::SPARSE);
+    BOOST_CHECK_EQUAL(vec.nvals(), 3);
+    BOOST_CHECK_EQUAL(vec.extractElement(3), 2.0);
+    BOOST_CHECK_EQUAL(vec.extractElement(7), 4.0);
+    BOOST_CHECK_EQUAL(vec.extractElement(500), 11.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mxv_vxm_all_forms)
+{
+    // A(i,j) = i + j + 1 on a band around the diagonal
+    GraphBLAS::IndexType const N = 200;
+    GraphBLAS::backend::LilSparseMatrix<double> A(N, N);
+    for (GraphBLAS::IndexType i = 0; i < N; ++i)
+    {
+        for (GraphBLAS::IndexType j = (i < 2 ? 0 : i - 2);
+             j < std::min(N, i + 3); ++j)
+        {
+            A.setElement(i, j, double(i + j + 1));
+        }
+    }
+    GraphBLAS::backend::TransposeView<
+        GraphBLAS::backend::LilSparseMatrix<double> > AT(A);
+
+    for (GraphBLAS::IndexType nvals : {5, 50, 200})
+    {
+        GraphBLAS::backend::BitmapSparseVector<double> u(N);
+        u.setContents(strided_contents(nvals, N/nvals));
+
+        // Expected: Au (= A'u since A is symmetric) from dense arithmetic
+        std::vector<double> u_dense(N, 0.0);
+        for (auto const &elt : strided_contents(nvals, N/nvals))
+        {
+            u_dense[std::get<0>(elt)] = std::get<1>(elt);
+        }
+        GraphBLAS::backend::BitmapSparseVector<double> answer(N);
+        for (GraphBLAS::IndexType i = 0; i < N; ++i)
+        {
+            bool stored(false);
+            double sum(0.0);
+            for (auto const &a : A.getRow(i))
+            {
+                if (u_dense[std::get<0>(a)] != 0.0)
+                {
+                    stored = true;
+                    sum += std::get<1>(a)*u_dense[std::get<0>(a)];
+                }
+            }
+            if (stored) answer.setElement(i, sum);
+        }
+
+        GraphBLAS::backend::BitmapSparseVector<double> w1(N), w2(N), w3(N), w4(N);
+        GraphBLAS::backend::mxv(w1, GraphBLAS::backend::NoMask(),
+                                GraphBLAS::NoAccumulate(),
+                                GraphBLAS::ArithmeticSemiring<double>(), A, u);
+        GraphBLAS::backend::mxv(w2, GraphBLAS::backend::NoMask(),
+                                GraphBLAS::NoAccumulate(),
+                                GraphBLAS::ArithmeticSemiring<double>(), AT, u);
+        GraphBLAS::backend::vxm(w3, GraphBLAS::backend::NoMask(),
+                                GraphBLAS::NoAccumulate(),
+                                GraphBLAS::ArithmeticSemiring<double>(), u, A);
+        GraphBLAS::backend::vxm(w4, GraphBLAS::backend::NoMask(),
+                                GraphBLAS::NoAccumulate(),
+                                GraphBLAS::ArithmeticSemiring<double>(), u, AT);
+        BOOST_CHECK_EQUAL(w1, answer);
+        BOOST_CHECK_EQUAL(w2, answer);
+        BOOST_CHECK_EQUAL(w3, answer);
+        BOOST_CHECK_EQUAL(w4, answer);
+
+        // Complement of u as a mask keeps the rows where u is not stored
+        GraphBLAS::backend::BitmapSparseVector<double> w5(N);
+        GraphBLAS::backend::mxv(
+            w5,
+            GraphBLAS::backend::VectorComplementView<
+                GraphBLAS::backend::BitmapSparseVector<double> >(u),
+            GraphBLAS::NoAccumulate(),
+            GraphBLAS::ArithmeticSemiring<double>(), A, u, true);
+        for (GraphBLAS::IndexType i = 0; i < N; ++i)
+        {
+            BOOST_CHECK_EQUAL(w5.hasElement(i),
+                              answer.hasElement(i) && !u.hasElement(i));
+        }
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_complement_across_word_boundaries)
+{
+    using GraphBLAS::backend::VectorForm;
+    typedef GraphBLAS::backend::BitmapSparseVector<bool> BoolVector;
+    GraphBLAS::IndexType const N = 130;
+
+    // Stored true/false pattern touching the first and last bit of words
+    std::vector<std::tuple<GraphBLAS::IndexType, bool> > few = {
+        {0, true}, {63, false}, {64, true}, {127, true}, {129, false}};
+    std::vector<std::tuple<GraphBLAS::IndexType, bool> > many, all;
+    for (GraphBLAS::IndexType ix = 0; ix < N; ++ix)
+    {
+        if (ix % 5 != 1) many.push_back(std::make_tuple(ix, (ix % 3) == 0));
+        all.push_back(std::make_tuple(ix, (ix % 7) != 0));
+    }
+
+    for (auto const &contents : {few, many, all})
+    {
+        BoolVector v(N);
+        v.setContents(contents);
+
+        std::vector<std::tuple<GraphBLAS::IndexType, bool> > expected;
+        for (GraphBLAS::IndexType ix = 0; ix < N; ++ix)
+        {
+            bool val;
+            if (!v.probe(ix, val) || !val)
+            {
+                expected.push_back(std::make_tuple(ix, true));
+            }
+        }
+
+        GraphBLAS::backend::VectorComplementView<BoolVector> cv(v);
+        BOOST_CHECK(cv.getContents() == expected);
+        BOOST_CHECK_EQUAL(cv.nvals(), expected.size());
+    }
+
+    BoolVector bitmap(N);
+    bitmap.setContents(many);
+    BOOST_CHECK(bitmap.form() == VectorForm::BITMAP);
+    BoolVector dense(N);
+    dense.setContents(all);
+    BOOST_CHECK(dense.form() == VectorForm::DENSE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_ewisemult_all_forms)
+{
+    GraphBLAS::IndexType const N = 300;
+    std::vector<GraphBLAS::IndexType> counts = {5, 100, 300};
+    std::vector<GraphBLAS::IndexType> strides = {37, 3, 1};
+
+    for (GraphBLAS::IndexType iu = 0; iu < counts.size(); ++iu)
+    {
+        for (GraphBLAS::IndexType iv = 0; iv < counts.size(); ++iv)
+        {
+            GraphBLAS::backend::Vector<double> u(N), v(N), w(N), answer(N);
+            u.setContents(strided_contents(counts[iu], strides[iu]));
+            auto v_contents(strided_contents(counts[iv], strides[iv]));
+            for (auto &elt : v_contents)
+            {
+                std::get<1>(elt) *= 3.0;
+            }
+            v.setContents(v_contents);
+
+            for (GraphBLAS::IndexType ix = 0; ix < N; ++ix)
+            {
+                if (u.hasElement(ix) && v.hasElement(ix))
+                {
+                    answer.setElement(ix, u.extractElement(ix) -
+                                      v.extractElement(ix));
+                }
+            }
+
+            GraphBLAS::backend::eWiseMult(
+                w, GraphBLAS::backend::NoMask(), GraphBLAS::NoAccumulate(),
+                GraphBLAS::Minus<double>(), u, v);
+            BOOST_CHECK_EQUAL(w, answer);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -333,4 +333,136 @@ BOOST_AUTO_TEST_CASE(lil_test_get_set_row)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(lil_test_move_construction_assignment)
+{
+    std::vector<std::vector<double>> mat = {{6, 7, 0, 2, 2, 0, 0},
+                                            {0, 0, 0, 5, 0, 0, 1},
+                                            {0, 0, 9, 0, 0, 0, 0},
+                                            {4, 0, 4, 3, 1, 0, 2}};
+
+    backend::LilSparseMatrix<double> m1(mat, 0);
+    backend::LilSparseMatrix<double> ans(mat, 0);
+
+    backend::LilSparseMatrix<double> m2(std::move(m1));
+    BOOST_CHECK_EQUAL(m2, ans);
+    BOOST_CHECK_EQUAL(m1.nrows(), 4UL);
+    BOOST_CHECK_EQUAL(m1.ncols(), 7UL);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0UL);
+
+    backend::LilSparseMatrix<double> m3(4, 7);
+    m3 = std::move(m2);
+    BOOST_CHECK_EQUAL(m3, ans);
+    BOOST_CHECK_EQUAL(m2.nvals(), 0UL);
+
+    backend::LilSparseMatrix<double> m4(3, 7);
+    BOOST_CHECK_THROW(m4 = std::move(m3), DimensionException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(lil_test_set_row_move)
+{
+    std::vector<std::vector<double>> mat = {{6, 7, 0, 2, 2, 0, 0},
+                                            {0, 0, 0, 5, 0, 0, 1}};
+
+    backend::LilSparseMatrix<double> m1(mat, 0);
+
+    std::vector<std::tuple<IndexType, double>> row = {
+        std::make_tuple(1, 3.0), std::make_tuple(5, 8.0)};
+    m1.setRow(0, std::move(row));
+
+    BOOST_CHECK_EQUAL(m1.nvals(), 4UL);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 1), 3.0);
+    BOOST_CHECK_EQUAL(m1.extractElement(0, 5), 8.0);
+    BOOST_CHECK_EQUAL(m1.hasElement(0, 0), false);
+
+    // The previous contents of the row are handed back
+    BOOST_CHECK_EQUAL(row.size(), 4UL);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(lil_test_row_nnz_prefix)
+{
+    std::vector<std::vector<double>> mat = {{6, 7, 0, 2},
+                                            {0, 0, 0, 0},
+                                            {0, 0, 0, 5},
+                                            {1, 2, 3, 4}};
+
+    backend::LilSparseMatrix<double> m1(mat, 0);
+    std::vector<IndexType> ans = {0, 3, 3, 4, 8};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.row_nnz_prefix().begin(),
+                                  m1.row_nnz_prefix().end(),
+                                  ans.begin(), ans.end());
+
+    // Every change to the matrix is reflected
+    m1.setElement(1, 2, 9.0);
+    ans = {0, 3, 4, 5, 9};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.row_nnz_prefix().begin(),
+                                  m1.row_nnz_prefix().end(),
+                                  ans.begin(), ans.end());
+
+    std::vector<std::tuple<IndexType, double>> row = {
+        std::make_tuple(0, 1.0)};
+    m1.setRow(3, row);
+    ans = {0, 3, 4, 5, 6};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.row_nnz_prefix().begin(),
+                                  m1.row_nnz_prefix().end(),
+                                  ans.begin(), ans.end());
+
+    std::vector<std::tuple<IndexType, double>> col = {
+        std::make_tuple(1, 1.0), std::make_tuple(3, 1.0)};
+    m1.setCol(3, col);
+    ans = {0, 2, 4, 4, 6};
+    BOOST_CHECK_EQUAL_COLLECTIONS(m1.row_nnz_prefix().begin(),
+                                  m1.row_nnz_prefix().end(),
+                                  ans.begin(), ans.end());
+
+    backend::LilSparseMatrix<double> m2(4, 4);
+    m2.swap(m1);
+    BOOST_CHECK_EQUAL(m1.row_nnz_prefix().back(), 0UL);
+    BOOST_CHECK_EQUAL(m2.row_nnz_prefix().back(), 6UL);
+
+    m2.clear();
+    BOOST_CHECK_EQUAL(m2.row_nnz_prefix().back(), 0UL);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(lil_test_numa_placement)
+{
+    std::vector<std::vector<double>> mat = {{6, 0, 0, 4},
+                                            {7, 3, 0, 0},
+                                            {0, 0, 0, 0},
+                                            {0, 8, 0, 1}};
+    backend::LilSparseMatrix<double> const ans(mat, 0);
+    backend::LilSparseMatrix<double> m1(mat, 0);
+    BOOST_CHECK(m1.placement() == NumaPolicy::NONE);
+
+    for (auto policy : {NumaPolicy::INTERLEAVE, NumaPolicy::FIRST_TOUCH,
+                        NumaPolicy::REPLICATE, NumaPolicy::NONE})
+    {
+        m1.place(policy);
+        BOOST_CHECK(m1.placement() == policy);
+        BOOST_CHECK_EQUAL(m1, ans);
+        for (IndexType row_idx = 0; row_idx < m1.nrows(); ++row_idx)
+        {
+            BOOST_CHECK(m1.getRow(row_idx) == ans.getRow(row_idx));
+            int node(m1.row_node(row_idx));
+            BOOST_CHECK((node >= -1) && (node < backend::numa_num_nodes()));
+        }
+        BOOST_CHECK_EQUAL(m1.row_node(2), -1);
+    }
+
+    // The replicas follow in-place changes to the values...
+    m1.place(NumaPolicy::REPLICATE);
+    m1.transformRow(1, [](double v) { return 2.0*v; });
+    BOOST_CHECK_EQUAL(m1.extractElement(1, 0), 14.0);
+    BOOST_CHECK_EQUAL(std::get<1>(m1.getRow(1)[0]), 14.0);
+    BOOST_CHECK(m1.placement() == NumaPolicy::REPLICATE);
+
+    // ...and are dropped by any other change
+    m1.setElement(2, 2, 5.0);
+    BOOST_CHECK(m1.placement() == NumaPolicy::NONE);
+    BOOST_CHECK_EQUAL(m1.getRow(2).size(), 1UL);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,135 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE workspace_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_scratch_buffer_reuse)
+{
+    backend::Workspace &ws(backend::Workspace::instance());
+    ws.clear();
+    ws.reset_stats();
+
+    std::size_t capacity;
+    {
+        backend::ScratchRow<double> buf;
+        BOOST_CHECK(buf.get().empty());
+        for (IndexType ix = 0; ix < 100; ++ix)
+        {
+            buf.get().push_back(std::make_tuple(ix, 1.0));
+        }
+        capacity = buf.get().capacity();
+    }
+
+    BOOST_CHECK_EQUAL(ws.stats().allocation_count, 1UL);
+    BOOST_CHECK_EQUAL(ws.stats().borrow_count, 1UL);
+    BOOST_CHECK_EQUAL(ws.stats().bytes,
+                      capacity*sizeof(std::tuple<IndexType, double>));
+    BOOST_CHECK_EQUAL(ws.stats().peak_bytes, ws.stats().bytes);
+
+    // The returned buffer comes back empty with its capacity intact
+    {
+        backend::ScratchRow<double> buf;
+        BOOST_CHECK(buf.get().empty());
+        BOOST_CHECK_EQUAL(buf.get().capacity(), capacity);
+        for (IndexType ix = 0; ix < 100; ++ix)
+        {
+            buf.get().push_back(std::make_tuple(ix, 2.0));
+        }
+    }
+
+    BOOST_CHECK_EQUAL(ws.stats().allocation_count, 1UL);
+    BOOST_CHECK_EQUAL(ws.stats().borrow_count, 2UL);
+
+    ws.clear();
+    BOOST_CHECK_EQUAL(ws.stats().bytes, 0UL);
+    {
+        backend::ScratchRow<double> buf;
+        BOOST_CHECK_EQUAL(buf.get().capacity(), 0UL);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_scratch_buffer_handoff)
+{
+    backend::Workspace &ws(backend::Workspace::instance());
+    ws.clear();
+    ws.reset_stats();
+
+    std::vector<std::tuple<IndexType, double> > result;
+    {
+        backend::ScratchRow<double> buf;
+        buf.get().push_back(std::make_tuple(0, 1.0));
+        result = std::move(buf.get());
+    }
+
+    BOOST_CHECK_EQUAL(result.size(), 1UL);
+    BOOST_CHECK_EQUAL(ws.stats().bytes, 0UL);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_repeated_operations_stop_allocating)
+{
+    std::vector<std::vector<double>> mat = {{0, 1, 1, 0},
+                                            {1, 0, 0, 1},
+                                            {1, 0, 0, 1},
+                                            {0, 1, 1, 0}};
+    Matrix<double> A(mat, 0);
+    Vector<double> u(std::vector<double>{1, 2, 3, 4});
+    Vector<double> w(4);
+
+    backend::Workspace &ws(backend::Workspace::instance());
+
+    // The first call sizes the scratch buffers
+    mxv(w, NoMask(), Plus<double>(), ArithmeticSemiring<double>(), A, u);
+    eWiseAdd(w, NoMask(), NoAccumulate(), Plus<double>(), w, u);
+    ws.reset_stats();
+
+    for (int iteration = 0; iteration < 10; ++iteration)
+    {
+        mxv(w, NoMask(), Plus<double>(), ArithmeticSemiring<double>(), A, u);
+        eWiseAdd(w, NoMask(), NoAccumulate(), Plus<double>(), w, u);
+    }
+
+    BOOST_CHECK(ws.stats().borrow_count > 0);
+    BOOST_CHECK_EQUAL(ws.stats().allocation_count, 0UL);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,811 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+/**
+ * @file snapshot.hpp
+ *
+ * @brief A binary file format for matrices and vectors (snapshots) that
+ *        loads without parsing, and a read-only matrix that serves its
+ *        rows straight from a mapped snapshot.
+ *
+ * A snapshot is a SnapshotHeader followed by sections aligned to
+ * SNAPSHOT_ALIGNMENT bytes, in the byte order of the machine that wrote
+ * it:
+ *
+ * - a matrix: the row offsets (nrows + 1 64-bit integers), the column
+ *   indices (nvals 64-bit integers, sorted within each row) and the values;
+ * - a vector: the indices (sorted) and the values.
+ *
+ * bool values are stored as one byte each.  The header holds a checksum of
+ * everything after it.
+ */
+
+#ifndef GB_SNAPSHOT_HPP
+#define GB_SNAPSHOT_HPP
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <graphblas/types.hpp>
+#include <graphblas/exceptions.hpp>
+#include <graphblas/Matrix.hpp>
+#include <graphblas/Vector.hpp>
+#include <graphblas/TaskPool.hpp>
+#include <graphblas/NonBlocking.hpp>
+#include <graphblas/expressions.hpp>
+#include <graphblas/matrix_io.hpp>
+
+//****************************************************************************
+
+namespace GraphBLAS
+{
+    /// The version of the snapshot format written by save().
+    static std::uint32_t const SNAPSHOT_VERSION = 1;
+
+    /// The alignment (in bytes) of the sections of a snapshot.
+    static std::size_t const SNAPSHOT_ALIGNMENT = 64;
+
+    namespace detail
+    {
+        //********************************************************************
+        /// The first bytes of a snapshot.
+        struct SnapshotHeader
+        {
+            char          magic[8];       ///< "GBTLSNAP"
+            std::uint32_t byte_order;     ///< 0x01020304 as written
+            std::uint32_t version;        ///< SNAPSHOT_VERSION
+            std::uint32_t kind;           ///< SNAPSHOT_MATRIX, SNAPSHOT_VECTOR, ...
+            std::uint32_t scalar_type;    ///< snapshot_type_tag<ScalarT>()
+            std::uint64_t nrows;          ///< the size of a vector
+            std::uint64_t ncols;          ///< 0 for a vector
+            std::uint64_t nvals;
+            std::uint64_t offsets_pos;    ///< row offsets (0 for a vector),
+                                          ///< or the block directory
+            std::uint64_t indices_pos;
+            std::uint64_t values_pos;
+            std::uint64_t file_size;
+            std::uint64_t checksum;       ///< of bytes [sizeof header, file_size)
+            std::uint64_t block_rows;     ///< rows per block (compressed)
+            std::uint64_t num_blocks;     ///< (compressed)
+            std::uint64_t reserved[3];
+        };
+
+        static_assert(sizeof(SnapshotHeader) == 128,
+                      "SnapshotHeader must be 128 bytes");
+
+        static std::uint32_t const SNAPSHOT_MATRIX = 1;
+        static std::uint32_t const SNAPSHOT_VECTOR = 2;
+        static std::uint32_t const SNAPSHOT_COMPRESSED_MATRIX = 3;
+        static std::uint32_t const SNAPSHOT_COMPRESSED_VECTOR = 4;
+
+        inline char const *snapshot_kind_name(std::uint32_t kind)
+        {
+            switch (kind)
+            {
+            case SNAPSHOT_MATRIX:            return "matrix";
+            case SNAPSHOT_VECTOR:            return "vector";
+            case SNAPSHOT_COMPRESSED_MATRIX: return "compressed matrix";
+            default:                         return "compressed vector";
+            }
+        }
+
+        /// The number of bytes of a snapshot covered by one block checksum.
+        static std::size_t const SNAPSHOT_CHECKSUM_BLOCK = 1 << 20;
+
+        /// The number of rows a task copies out of a snapshot in load().
+        static IndexType const SNAPSHOT_ROWS_PER_TASK = 1024;
+
+        /// The type of a value as it is stored in a snapshot.
+        template <typename ScalarT>
+        struct snapshot_value
+        {
+            typedef typename std::conditional<
+                std::is_same<ScalarT, bool>::value,
+                std::uint8_t, ScalarT>::type type;
+        };
+
+        /// A code for the scalar type: its kind (bool, signed, unsigned or
+        /// floating point) and size.
+        template <typename ScalarT>
+        std::uint32_t snapshot_type_tag()
+        {
+            static_assert(std::is_arithmetic<ScalarT>::value,
+                          "snapshots hold arithmetic scalar types only");
+            std::uint32_t kind(std::is_same<ScalarT, bool>::value ? 1 :
+                               std::is_floating_point<ScalarT>::value ? 4 :
+                               std::is_signed<ScalarT>::value ? 2 : 3);
+            return (kind << 8) | static_cast<std::uint32_t>(sizeof(ScalarT));
+        }
+
+        inline std::uint64_t snapshot_align(std::uint64_t pos)
+        {
+            return (pos + SNAPSHOT_ALIGNMENT - 1)/SNAPSHOT_ALIGNMENT*
+                SNAPSHOT_ALIGNMENT;
+        }
+
+        /// The checksum of one block (a multiple of 8 bytes long).
+        inline std::uint64_t snapshot_block_checksum(char const  *data,
+                                                     std::size_t  size)
+        {
+            std::uint64_t hash(0x9e3779b97f4a7c15ULL ^ size);
+            for (std::size_t pos = 0; pos < size; pos += 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, data + pos, 8);
+                hash ^= word*0xff51afd7ed558ccdULL;
+                hash = ((hash << 31) | (hash >> 33))*0xc4ceb9fe1a85ec53ULL;
+            }
+            return hash;
+        }
+
+        /// Add the checksum of the next block to a running checksum.
+        inline std::uint64_t snapshot_combine(std::uint64_t checksum,
+                                              std::uint64_t block_checksum)
+        {
+            checksum ^= block_checksum + 0x9e3779b97f4a7c15ULL +
+                (checksum << 6) + (checksum >> 2);
+            return checksum;
+        }
+
+        /// The checksum of [begin, end), computed a block at a time in
+        /// parallel.
+        inline std::uint64_t snapshot_checksum(char const *begin,
+                                               char const *end)
+        {
+            std::size_t size(end - begin);
+            IndexType num_blocks((size + SNAPSHOT_CHECKSUM_BLOCK - 1)/
+                                 SNAPSHOT_CHECKSUM_BLOCK);
+            std::vector<std::uint64_t> block_checksums(num_blocks);
+            parallel_for(
+                0, num_blocks,
+                [&](IndexType block_begin, IndexType block_end)
+                {
+                    for (IndexType block = block_begin; block < block_end;
+                         ++block)
+                    {
+                        std::size_t pos(block*SNAPSHOT_CHECKSUM_BLOCK);
+                        block_checksums[block] = snapshot_block_checksum(
+                            begin + pos,
+                            std::min(SNAPSHOT_CHECKSUM_BLOCK, size - pos));
+                    }
+                });
+
+            std::uint64_t checksum(0);
+            for (auto block_checksum : block_checksums)
+            {
+                checksum = snapshot_combine(checksum, block_checksum);
+            }
+            return checksum;
+        }
+
+        //********************************************************************
+        /**
+         * @brief Writes the sections of a snapshot through a buffer of
+         *        SNAPSHOT_CHECKSUM_BLOCK bytes, computing the checksum as
+         *        it goes, and then the header.
+         */
+        class SnapshotWriter
+        {
+        public:
+            explicit SnapshotWriter(std::string const &path)
+                : m_path(path),
+                  m_out(path, std::ios::binary),
+                  m_pos(sizeof(SnapshotHeader)),
+                  m_checksum(0)
+            {
+                if (!m_out)
+                {
+                    throw IOException("cannot open " + path);
+                }
+                m_out.seekp(sizeof(SnapshotHeader));
+                m_buffer.reserve(SNAPSHOT_CHECKSUM_BLOCK);
+            }
+
+            std::uint64_t position() const { return m_pos; }
+
+            void write(void const *data, std::size_t size)
+            {
+                char const *bytes(static_cast<char const *>(data));
+                while (size > 0)
+                {
+                    std::size_t count(std::min(size, SNAPSHOT_CHECKSUM_BLOCK -
+                                               m_buffer.size()));
+                    m_buffer.insert(m_buffer.end(), bytes, bytes + count);
+                    bytes += count;
+                    size -= count;
+                    m_pos += count;
+                    if (m_buffer.size() == SNAPSHOT_CHECKSUM_BLOCK)
+                    {
+                        flush();
+                    }
+                }
+            }
+
+            template <typename T>
+            void write_array(T const *data, std::size_t count)
+            {
+                write(data, count*sizeof(T));
+            }
+
+            /// Pad with zeros to the next section.
+            void align()
+            {
+                static char const zeros[SNAPSHOT_ALIGNMENT] = {};
+                write(zeros, snapshot_align(m_pos) - m_pos);
+            }
+
+            /// Write the header (with the file size and checksum filled in).
+            void finish(SnapshotHeader header)
+            {
+                align();
+                flush();
+                header.file_size = m_pos;
+                header.checksum = m_checksum;
+                m_out.seekp(0);
+                m_out.write(reinterpret_cast<char const *>(&header),
+                            sizeof(header));
+                m_out.close();
+                if (!m_out)
+                {
+                    throw IOException("cannot write " + m_path);
+                }
+            }
+
+        private:
+            void flush()
+            {
+                if (!m_buffer.empty())
+                {
+                    m_checksum = snapshot_combine(
+                        m_checksum,
+                        snapshot_block_checksum(m_buffer.data(),
+                                                m_buffer.size()));
+                    m_out.write(m_buffer.data(), m_buffer.size());
+                    m_buffer.clear();
+                }
+            }
+
+            std::string        m_path;
+            std::ofstream      m_out;
+            std::vector<char>  m_buffer;
+            std::uint64_t      m_pos;
+            std::uint64_t      m_checksum;
+        };
+
+        template <typename ScalarT>
+        SnapshotHeader make_snapshot_header(std::uint32_t kind,
+                                            IndexType     nrows,
+                                            IndexType     ncols,
+                                            IndexType     nvals)
+        {
+            SnapshotHeader header;
+            std::memset(&header, 0, sizeof(header));
+            std::memcpy(header.magic, "GBTLSNAP", 8);
+            header.byte_order = 0x01020304;
+            header.version = SNAPSHOT_VERSION;
+            header.kind = kind;
+            header.scalar_type = snapshot_type_tag<ScalarT>();
+            header.nrows = nrows;
+            header.ncols = ncols;
+            header.nvals = nvals;
+            return header;
+        }
+
+        /**
+         * @brief Check the header of a mapped snapshot (and, if asked, the
+         *        checksum), and return it.
+         */
+        template <typename ScalarT>
+        SnapshotHeader read_snapshot_header(MappedFile  const &file,
+                                            std::string const &path,
+                                            std::uint32_t      kind,
+                                            bool               verify)
+        {
+            SnapshotHeader header;
+            std::size_t size(file.end() - file.begin());
+            if (size < sizeof(header))
+            {
+                throw IOException("not a snapshot: " + path);
+            }
+            std::memcpy(&header, file.begin(), sizeof(header));
+
+            if ((std::memcmp(header.magic, "GBTLSNAP", 8) != 0) ||
+                (header.byte_order != 0x01020304))
+            {
+                throw IOException("not a snapshot (or of another byte "
+                                  "order): " + path);
+            }
+            if (header.version != SNAPSHOT_VERSION)
+            {
+                throw IOException("unsupported snapshot version " +
+                                  std::to_string(header.version) + ": " + path);
+            }
+            if (header.kind != kind)
+            {
+                throw IOException(std::string("snapshot is not of a ") +
+                                  snapshot_kind_name(kind) + ": " + path);
+            }
+            if (header.scalar_type != snapshot_type_tag<ScalarT>())
+            {
+                throw IOException("snapshot holds another scalar type: " +
+                                  path);
+            }
+
+            typedef typename snapshot_value<ScalarT>::type ValueType;
+            bool valid(header.file_size == size);
+            if ((kind == SNAPSHOT_MATRIX) || (kind == SNAPSHOT_VECTOR))
+            {
+                std::uint64_t offsets_size(
+                    (kind == SNAPSHOT_MATRIX) ?
+                    (header.nrows + 1)*sizeof(IndexType) : 0);
+                valid = valid &&
+                    (header.indices_pos + header.nvals*sizeof(IndexType) <=
+                     header.values_pos) &&
+                    (header.values_pos + header.nvals*sizeof(ValueType) <=
+                     size) &&
+                    (header.offsets_pos + offsets_size <= size) &&
+                    ((header.offsets_pos | header.indices_pos |
+                      header.values_pos) % SNAPSHOT_ALIGNMENT == 0);
+            }
+            else
+            {
+                // The directory (three words a block) must fit; the
+                // blocks are checked as they are decoded
+                valid = valid && (header.block_rows > 0) &&
+                    (header.num_blocks ==
+                     (header.nrows + header.block_rows - 1)/header.block_rows) &&
+                    (header.offsets_pos + header.num_blocks*3*sizeof(std::uint64_t)
+                     <= size);
+            }
+            if (!valid)
+            {
+                throw IOException("snapshot is truncated or corrupt: " + path);
+            }
+
+            if (verify &&
+                (snapshot_checksum(file.begin() + sizeof(header), file.end()) !=
+                 header.checksum))
+            {
+                throw IOException("snapshot checksum mismatch: " + path);
+            }
+            return header;
+        }
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief A read-only matrix whose rows are read straight from a mapped
+     *        snapshot (see save()).
+     *
+     * Nothing is copied when it is opened: getRow() returns a view of the
+     * row's indices and values in the mapped file, so the pages of a row
+     * are read from disk when the row is first used.  Use load() for a
+     * Matrix that operations can use.
+     */
+    template <typename ScalarT>
+    class MappedMatrix
+    {
+    public:
+        typedef ScalarT ScalarType;
+        typedef typename detail::snapshot_value<ScalarT>::type ValueType;
+
+        /// The stored elements of a row: (index, value) tuples.
+        class RowView
+        {
+        public:
+            class const_iterator
+            {
+            public:
+                typedef std::random_access_iterator_tag    iterator_category;
+                typedef std::tuple<IndexType, ScalarT>     value_type;
+                typedef std::ptrdiff_t                     difference_type;
+                typedef value_type const                  *pointer;
+                typedef value_type                         reference;
+
+                const_iterator(IndexType const *index, ValueType const *value)
+                    : m_index(index), m_value(value) {}
+
+                value_type operator*() const
+                {
+                    return std::make_tuple(*m_index,
+                                           static_cast<ScalarT>(*m_value));
+                }
+                value_type operator[](difference_type n) const
+                {
+                    return *(*this + n);
+                }
+
+                const_iterator &operator++() { ++m_index; ++m_value; return *this; }
+                const_iterator operator++(int)
+                {
+                    const_iterator it(*this); ++*this; return it;
+                }
+                const_iterator &operator--() { --m_index; --m_value; return *this; }
+                const_iterator operator--(int)
+                {
+                    const_iterator it(*this); --*this; return it;
+                }
+                const_iterator &operator+=(difference_type n)
+                {
+                    m_index += n; m_value += n; return *this;
+                }
+                const_iterator &operator-=(difference_type n)
+                {
+                    m_index -= n; m_value -= n; return *this;
+                }
+                const_iterator operator+(difference_type n) const
+                {
+                    return const_iterator(m_index + n, m_value + n);
+                }
+                const_iterator operator-(difference_type n) const
+                {
+                    return const_iterator(m_index - n, m_value - n);
+                }
+                difference_type operator-(const_iterator const &rhs) const
+                {
+                    return m_index - rhs.m_index;
+                }
+
+                bool operator==(const_iterator const &rhs) const { return m_index == rhs.m_index; }
+                bool operator!=(const_iterator const &rhs) const { return m_index != rhs.m_index; }
+                bool operator<(const_iterator const &rhs) const  { return m_index < rhs.m_index; }
+
+            private:
+                IndexType const *m_index;
+                ValueType const *m_value;
+            };
+
+            RowView(IndexType const *indices, ValueType const *values,
+                    IndexType size)
+                : m_indices(indices), m_values(values), m_size(size) {}
+
+            const_iterator begin() const { return const_iterator(m_indices, m_values); }
+            const_iterator end() const
+            {
+                return const_iterator(m_indices + m_size, m_values + m_size);
+            }
+
+            IndexType size() const { return m_size; }
+            bool empty() const     { return m_size == 0; }
+
+            /// The column indices and values, in the mapped file.
+            IndexType const *indices() const { return m_indices; }
+            ValueType const *values() const  { return m_values; }
+
+            /// A copy of the row.
+            operator std::vector<std::tuple<IndexType, ScalarT> >() const
+            {
+                return std::vector<std::tuple<IndexType, ScalarT> >(begin(),
+                                                                    end());
+            }
+
+        private:
+            IndexType const *m_indices;
+            ValueType const *m_values;
+            IndexType        m_size;
+        };
+
+        /**
+         * @brief Map the snapshot of a matrix.
+         *
+         * @param[in] verify  Also check the checksum (which reads the whole
+         *                    file) and the row offsets.
+         *
+         * @throw IOException  if the file is not a snapshot of a matrix of
+         *                     ScalarT or is corrupt.
+         */
+        explicit MappedMatrix(std::string const &path, bool verify = false)
+            : m_file(path)
+        {
+            detail::SnapshotHeader header(
+                detail::read_snapshot_header<ScalarT>(
+                    m_file, path, detail::SNAPSHOT_MATRIX, verify));
+            m_nrows = header.nrows;
+            m_ncols = header.ncols;
+            m_nvals = header.nvals;
+            m_offsets = reinterpret_cast<IndexType const *>(
+                m_file.begin() + header.offsets_pos);
+            m_indices = reinterpret_cast<IndexType const *>(
+                m_file.begin() + header.indices_pos);
+            m_values = reinterpret_cast<ValueType const *>(
+                m_file.begin() + header.values_pos);
+
+            if (verify)
+            {
+                bool valid(m_offsets[0] == 0 && m_offsets[m_nrows] == m_nvals);
+                for (IndexType row_idx = 0; valid && (row_idx < m_nrows);
+                     ++row_idx)
+                {
+                    valid = (m_offsets[row_idx] <= m_offsets[row_idx + 1]);
+                }
+                if (!valid)
+                {
+                    throw IOException("snapshot has bad row offsets: " + path);
+                }
+            }
+        }
+
+        MappedMatrix(MappedMatrix const &) = delete;
+        MappedMatrix &operator=(MappedMatrix const &) = delete;
+
+        IndexType nrows() const { return m_nrows; }
+        IndexType ncols() const { return m_ncols; }
+        IndexType nvals() const { return m_nvals; }
+
+        /// The stored elements of a row, in the mapped file.
+        RowView getRow(IndexType row_index) const
+        {
+            IndexType first(m_offsets[row_index]);
+            return RowView(m_indices + first, m_values + first,
+                           m_offsets[row_index + 1] - first);
+        }
+
+        bool hasElement(IndexType row_index, IndexType col_index) const
+        {
+            return find(row_index, col_index) != nullptr;
+        }
+
+        /// @throw NoValueException  if there is no stored value there.
+        ScalarT extractElement(IndexType row_index, IndexType col_index) const
+        {
+            IndexType const *index(find(row_index, col_index));
+            if (index == nullptr)
+            {
+                throw NoValueException("MappedMatrix::extractElement");
+            }
+            return static_cast<ScalarT>(m_values[index - m_indices]);
+        }
+
+    private:
+        /// The column index of an element in the mapped file, or nullptr.
+        IndexType const *find(IndexType row_index, IndexType col_index) const
+        {
+            if ((row_index >= m_nrows) || (col_index >= m_ncols))
+            {
+                throw IndexOutOfBoundsException("MappedMatrix: index out of bounds");
+            }
+            IndexType const *first(m_indices + m_offsets[row_index]);
+            IndexType const *last(m_indices + m_offsets[row_index + 1]);
+            IndexType const *index(std::lower_bound(first, last, col_index));
+            return ((index != last) && (*index == col_index)) ? index : nullptr;
+        }
+
+        detail::MappedFile  m_file;
+        IndexType           m_nrows;
+        IndexType           m_ncols;
+        IndexType           m_nvals;
+        IndexType const    *m_offsets;
+        IndexType const    *m_indices;
+        ValueType const    *m_values;
+    };
+
+    namespace detail
+    {
+        template <typename ScalarT, typename... TagsT>
+        Matrix<ScalarT, TagsT...> load_snapshot(std::string const &path,
+                                                bool               verify,
+                                                Matrix<ScalarT, TagsT...> *)
+        {
+            typedef std::vector<std::tuple<IndexType, ScalarT> > RowType;
+
+            MappedMatrix<ScalarT> mapped(path, verify);
+            std::vector<RowType> rows(mapped.nrows());
+            parallel_for(
+                0, mapped.nrows(),
+                [&](IndexType row_begin, IndexType row_end)
+                {
+                    for (IndexType row_idx = row_begin; row_idx < row_end;
+                         ++row_idx)
+                    {
+                        typename MappedMatrix<ScalarT>::RowView row(
+                            mapped.getRow(row_idx));
+                        if (verify)
+                        {
+                            IndexType const *indices(row.indices());
+                            for (IndexType idx = 0; idx < row.size(); ++idx)
+                            {
+                                if ((indices[idx] >= mapped.ncols()) ||
+                                    ((idx > 0) &&
+                                     (indices[idx] <= indices[idx - 1])))
+                                {
+                                    throw IOException(
+                                        "snapshot has bad column indices: " +
+                                        path);
+                                }
+                            }
+                        }
+                        rows[row_idx].assign(row.begin(), row.end());
+                    }
+                },
+                SNAPSHOT_ROWS_PER_TASK);
+
+            Matrix<ScalarT, TagsT...> A(mapped.nrows(), mapped.ncols());
+            expr::backend_access::matrix(A).setRows(std::move(rows));
+            return A;
+        }
+
+        template <typename ScalarT, typename... TagsT>
+        Vector<ScalarT, TagsT...> load_snapshot(std::string const &path,
+                                                bool               verify,
+                                                Vector<ScalarT, TagsT...> *)
+        {
+            typedef typename snapshot_value<ScalarT>::type ValueType;
+
+            MappedFile file(path);
+            SnapshotHeader header(read_snapshot_header<ScalarT>(
+                file, path, SNAPSHOT_VECTOR, verify));
+            IndexType const *indices(reinterpret_cast<IndexType const *>(
+                file.begin() + header.indices_pos));
+            ValueType const *values(reinterpret_cast<ValueType const *>(
+                file.begin() + header.values_pos));
+
+            std::vector<std::tuple<IndexType, ScalarT> > contents;
+            contents.reserve(header.nvals);
+            for (IndexType idx = 0; idx < header.nvals; ++idx)
+            {
+                if (verify &&
+                    ((indices[idx] >= header.nrows) ||
+                     ((idx > 0) && (indices[idx] <= indices[idx - 1]))))
+                {
+                    throw IOException("snapshot has bad indices: " + path);
+                }
+                contents.push_back(std::make_tuple(
+                    indices[idx], static_cast<ScalarT>(values[idx])));
+            }
+
+            Vector<ScalarT, TagsT...> w(header.nrows);
+            expr::backend_access::vector(w).setContents(contents);
+            return w;
+        }
+    } // detail
+
+    //************************************************************************
+    /**
+     * @brief Write a snapshot of a matrix (see snapshot.hpp), which load()
+     *        reads back without parsing and MappedMatrix maps.
+     *
+     * @throw IOException  if the file cannot be written.
+     */
+    template <typename ScalarT, typename... TagsT>
+    void save(std::string const &path, Matrix<ScalarT, TagsT...> const &A)
+    {
+        typedef typename detail::snapshot_value<ScalarT>::type ValueType;
+
+        auto const &mat(expr::backend_access::matrix(A));
+        detail::sync_read(mat);
+
+        IndexType nrows(mat.nrows());
+        detail::SnapshotHeader header(
+            detail::make_snapshot_header<ScalarT>(
+                detail::SNAPSHOT_MATRIX, nrows, mat.ncols(), mat.nvals()));
+        detail::SnapshotWriter out(path);
+
+        out.align();
+        header.offsets_pos = out.position();
+        IndexType offset(0);
+        out.write_array(&offset, 1);
+        for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+        {
+            offset += mat.getRow(row_idx).size();
+            out.write_array(&offset, 1);
+        }
+
+        out.align();
+        header.indices_pos = out.position();
+        for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+        {
+            for (auto const &elt : mat.getRow(row_idx))
+            {
+                IndexType col_idx(std::get<0>(elt));
+                out.write_array(&col_idx, 1);
+            }
+        }
+
+        out.align();
+        header.values_pos = out.position();
+        for (IndexType row_idx = 0; row_idx < nrows; ++row_idx)
+        {
+            for (auto const &elt : mat.getRow(row_idx))
+            {
+                ValueType val(static_cast<ValueType>(std::get<1>(elt)));
+                out.write_array(&val, 1);
+            }
+        }
+
+        out.finish(header);
+    }
+
+    /**
+     * @brief Write a snapshot of a vector, which load() reads back without
+     *        parsing.
+     *
+     * @throw IOException  if the file cannot be written.
+     */
+    template <typename ScalarT, typename... TagsT>
+    void save(std::string const &path, Vector<ScalarT, TagsT...> const &u)
+    {
+        typedef typename detail::snapshot_value<ScalarT>::type ValueType;
+
+        auto const &vec(expr::backend_access::vector(u));
+        detail::sync_read(vec);
+
+        IndexType nvals(vec.nvals());
+        IndexArrayType indices(nvals);
+        std::vector<ScalarT> values(nvals);
+        vec.extractTuples(indices.begin(), values.begin());
+
+        detail::SnapshotHeader header(
+            detail::make_snapshot_header<ScalarT>(
+                detail::SNAPSHOT_VECTOR, vec.size(), 0, nvals));
+        detail::SnapshotWriter out(path);
+
+        out.align();
+        header.indices_pos = out.position();
+        out.write_array(indices.data(), nvals);
+
+        out.align();
+        header.values_pos = out.position();
+        std::vector<ValueType> stored(values.begin(), values.end());
+        out.write_array(stored.data(), nvals);
+
+        out.finish(header);
+    }
+
+    /**
+     * @brief Read a matrix or vector from a snapshot written by save().
+     *
+     * The arrays of the snapshot are mapped and copied into the rows of
+     * the new matrix in parallel; nothing is parsed.
+     *
+     * @tparam ContainerT  The Matrix or Vector type to read; its scalar
+     *                     type must be the one the snapshot was saved with.
+     * @param[in] verify   Check the checksum and the indices, which costs
+     *                     another pass over the data.
+     *
+     * @throw IOException  if the file cannot be read, is not a snapshot of
+     *                     a ContainerT or is corrupt.
+     */
+    template <typename ContainerT>
+    ContainerT load(std::string const &path, bool verify = true)
+    {
+        return detail::load_snapshot(path, verify,
+                                     static_cast<ContainerT *>(nullptr));
+    }
+} // GraphBLAS
+
+#endif // GB_SNAPSHOT_HPP
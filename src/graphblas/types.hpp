@@ -53,6 +53,17 @@ namespace GraphBLAS
     };
 
 
+    //**************************************************************************
+    /// How the storage of a matrix or vector is placed on the NUMA nodes of
+    /// the system (see Matrix::place and Vector::place).
+    enum class NumaPolicy
+    {
+        NONE,         ///< wherever it was allocated (the default)
+        INTERLEAVE,   ///< pages spread over all of the nodes
+        FIRST_TOUCH,  ///< each block of rows on the node of its thread
+        REPLICATE     ///< a read-only copy on every node (matrices only)
+    };
+
     //**************************************************************************
 
     // This is the "Matrix" class for this example
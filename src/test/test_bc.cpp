@@ -369,4 +369,36 @@ BOOST_AUTO_TEST_CASE(bc_test_batch_alt_trans_v2)
 }
 
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bc_test_batch_split_into_tasks)
+{
+    // On a directed cycle every vertex is inside the paths between
+    // (n-1)(n-2)/2 ordered pairs of other vertices.
+    IndexType const n(2*BC_SOURCES_PER_TASK + 7);
+    IndexArrayType i, j, seed_set_all;
+    for (IndexType ix = 0; ix < n; ++ix)
+    {
+        i.push_back(ix);
+        j.push_back((ix + 1) % n);
+        seed_set_all.push_back(ix);
+    }
+    std::vector<double> v(i.size(), 1);
+    Matrix<double, DirectedMatrixTag> cycle(n, n);
+    cycle.build(i, j, v);
+
+    double answer((n - 1)*(n - 2)/2.0);
+
+    std::vector<float> result =
+        vertex_betweenness_centrality_batch(cycle, seed_set_all);
+    BOOST_CHECK_EQUAL(result.size(), n);
+    for (unsigned int ix = 0; ix < result.size(); ++ix)
+        BOOST_CHECK_CLOSE(result[ix], answer, 0.0001);
+
+    std::vector<float> result_alt =
+        vertex_betweenness_centrality_batch_alt(cycle, seed_set_all);
+    BOOST_CHECK_EQUAL(result_alt.size(), n);
+    for (unsigned int ix = 0; ix < result_alt.size(); ++ix)
+        BOOST_CHECK_CLOSE(result_alt[ix], answer, 0.0001);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -673,4 +673,50 @@ BOOST_AUTO_TEST_CASE(bfs_level_masked_v2_test_one_root_integer)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(bfs_batch_test_cycle_tasks)
+{
+    typedef double T;
+    typedef GraphBLAS::Matrix<T, GraphBLAS::DirectedMatrixTag> GrBMatrix;
+
+    // More roots than one task traverses from: blocks run as tasks
+    GraphBLAS::IndexType const NUM_NODES(2*algorithms::BFS_TRAVERSALS_PER_TASK + 3);
+
+    GraphBLAS::IndexArrayType i, j;
+    for (GraphBLAS::IndexType ix = 0; ix < NUM_NODES; ++ix)
+    {
+        i.push_back(ix);
+        j.push_back((ix + 1) % NUM_NODES);
+    }
+    std::vector<T> v(i.size(), 1);
+
+    GrBMatrix G_cycle(NUM_NODES, NUM_NODES);
+    G_cycle.build(i, j, v);
+
+    GrBMatrix roots(NUM_NODES, NUM_NODES);
+    GraphBLAS::IndexArrayType ii, jj, vv;
+    for (GraphBLAS::IndexType ix = 0; ix < NUM_NODES; ++ix)
+    {
+        ii.push_back(ix);
+        jj.push_back(ix);
+        vv.push_back(1);
+    }
+    roots.build(ii, jj, vv);
+
+    GrBMatrix parent_lists(NUM_NODES, NUM_NODES);
+
+    algorithms::bfs_batch(G_cycle, roots, parent_lists);
+
+    // The parent of every vertex but the root is the vertex before it
+    BOOST_CHECK_EQUAL(parent_lists.nvals(), NUM_NODES*NUM_NODES);
+    for (GraphBLAS::IndexType r = 0; r < NUM_NODES; ++r)
+    {
+        for (GraphBLAS::IndexType c = 0; c < NUM_NODES; ++c)
+        {
+            T answer((r == c) ? r : (c + NUM_NODES - 1) % NUM_NODES);
+            BOOST_CHECK_EQUAL(parent_lists.extractElement(r, c), answer);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
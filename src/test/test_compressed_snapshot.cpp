@@ -0,0 +1,221 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE compressed_snapshot_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    /// A path for a snapshot that is removed at the end of the test.
+    class TempPath
+    {
+    public:
+        TempPath()
+        {
+            char name[] = "/tmp/gbtl_compressed_XXXXXX";
+            int fd(mkstemp(name));
+            BOOST_REQUIRE(fd >= 0);
+            ::close(fd);
+            m_path = name;
+        }
+
+        ~TempPath() { std::remove(m_path.c_str()); }
+
+        std::string const &path() const { return m_path; }
+
+    private:
+        std::string m_path;
+    };
+
+    std::streamoff file_size(std::string const &path)
+    {
+        std::ifstream in(path, std::ios::binary | std::ios::ate);
+        return in.tellg();
+    }
+
+    /// A matrix with several blocks of rows, short and long rows, and
+    /// indices that need several bytes.
+    Matrix<float> make_matrix()
+    {
+        IndexType const N(3*COMPRESSED_BLOCK_ROWS + 17);
+        IndexArrayType rows, cols;
+        std::vector<float> vals;
+        for (IndexType idx = 0; idx < 20*N; ++idx)
+        {
+            rows.push_back((idx*7919) % N);
+            cols.push_back((idx*104729) % N);
+            vals.push_back(static_cast<float>(idx % 13) - 6.f);
+        }
+        for (IndexType col = 0; col < N; col += 2)
+        {
+            rows.push_back(5);
+            cols.push_back(col);
+            vals.push_back(1.f);
+        }
+        Matrix<float> A(N, N);
+        A.build(rows, cols, vals);
+        return A;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_varint)
+{
+    std::vector<unsigned char> bytes;
+    std::vector<std::uint64_t> values = {0, 1, 127, 128, 300, 16383, 16384,
+                                         0xffffffffULL, ~0ULL};
+    for (auto value : values)
+    {
+        detail::append_varint(bytes, value);
+    }
+    BOOST_CHECK_EQUAL(bytes.size(), 1 + 1 + 1 + 2 + 2 + 2 + 3 + 5 + 10);
+
+    unsigned char const *p(bytes.data());
+    for (auto value : values)
+    {
+        BOOST_CHECK_EQUAL(detail::read_varint(p, bytes.data() + bytes.size()),
+                          value);
+    }
+    BOOST_CHECK(p == bytes.data() + bytes.size());
+
+    // a truncated varint
+    unsigned char const truncated[] = {0x80, 0x80};
+    p = truncated;
+    BOOST_CHECK_THROW(detail::read_varint(p, truncated + 2), IOException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_save_load_compressed_matrix)
+{
+    Matrix<float> A(make_matrix());
+    TempPath file, plain;
+    save_compressed(file.path(), A);
+    BOOST_CHECK_EQUAL(A, load_compressed<Matrix<float> >(file.path()));
+
+    // indices take one or two bytes instead of eight
+    save(plain.path(), A);
+    BOOST_CHECK(2*file_size(file.path()) < file_size(plain.path()));
+
+    Matrix<bool> P(3, 4);
+    P.setElement(0, 3, true);
+    P.setElement(2, 0, false);
+    save_compressed(file.path(), P);
+    BOOST_CHECK_EQUAL(P, load_compressed<Matrix<bool> >(file.path()));
+
+    BOOST_CHECK_THROW(load_compressed<Matrix<double> >(file.path()),
+                      IOException);
+    BOOST_CHECK_THROW(load<Matrix<bool> >(file.path()), IOException);
+    BOOST_CHECK_THROW(load_compressed<Matrix<bool> >(plain.path()),
+                      IOException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_save_load_compressed_vector)
+{
+    std::vector<double> u_dense = {0, 3.5, 0, -1, 0, 0, 2};
+    Vector<double> u(u_dense, 0.);
+    TempPath file;
+    save_compressed(file.path(), u);
+    BOOST_CHECK_EQUAL(u, load_compressed<Vector<double> >(file.path()));
+
+    Vector<int> empty(1000);
+    save_compressed(file.path(), empty);
+    BOOST_CHECK_EQUAL(empty, load_compressed<Vector<int> >(file.path()));
+    BOOST_CHECK_THROW(load_compressed<Matrix<int> >(file.path()),
+                      IOException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_compressed_matrix)
+{
+    Matrix<float> A(make_matrix());
+    TempPath file;
+    save_compressed(file.path(), A);
+
+    CompressedMatrix<float> C(file.path(), true);
+    BOOST_CHECK_EQUAL(C.nrows(), A.nrows());
+    BOOST_CHECK_EQUAL(C.nvals(), A.nvals());
+    BOOST_CHECK_EQUAL(C.numBlocks(), 4);
+
+    std::vector<CompressedMatrix<float>::RowType> rows;
+    C.decodeBlock(3, rows);
+    BOOST_CHECK_EQUAL(rows.size(), 17);
+
+    MatrixRows<float> A_rows(export_rows(A));
+    for (IndexType row_idx = 3*COMPRESSED_BLOCK_ROWS;
+         row_idx < C.nrows(); ++row_idx)
+    {
+        BOOST_CHECK(rows[row_idx - 3*COMPRESSED_BLOCK_ROWS] == A_rows[row_idx]);
+    }
+    BOOST_CHECK(C.getRow(5) == A_rows[5]);
+    BOOST_CHECK(C.getRow(COMPRESSED_BLOCK_ROWS + 1) ==
+                A_rows[COMPRESSED_BLOCK_ROWS + 1]);
+    BOOST_CHECK_THROW(C.getRow(C.nrows()), IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_compressed_corrupt)
+{
+    Matrix<float> A(make_matrix());
+    TempPath file;
+    save_compressed(file.path(), A);
+
+    // corrupt a byte of the first block's indices
+    {
+        std::fstream out(file.path(),
+                         std::ios::in | std::ios::out | std::ios::binary);
+        out.seekp(sizeof(detail::SnapshotHeader) + 100);
+        out.put(static_cast<char>(0xff));
+    }
+    BOOST_CHECK_THROW(load_compressed<Matrix<float> >(file.path()),
+                      IOException);
+
+    // caught by the decoder even without the checksum
+    BOOST_CHECK_THROW(load_compressed<Matrix<float> >(file.path(), false),
+                      IOException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,180 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE expressions_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<std::vector<double> > const A_dense = {{1, 0, 2, 0},
+                                                       {0, 3, 0, 4},
+                                                       {5, 0, 0, 6},
+                                                       {0, 7, 8, 0}};
+
+    std::vector<std::vector<double> > const B_dense = {{0, 1, 0, 2},
+                                                       {3, 0, 4, 0},
+                                                       {0, 5, 6, 0},
+                                                       {7, 0, 0, 8}};
+
+    std::vector<std::vector<bool> > const M_dense = {{true,  false, true,  false},
+                                                     {false, true,  false, false},
+                                                     {true,  true,  false, true},
+                                                     {false, false, false, true}};
+
+    std::vector<double> const u_dense = {1, 0, 2, 3};
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(expressions_test_mxm)
+{
+    Matrix<double> A(A_dense, 0.), B(B_dense, 0.);
+    Matrix<bool> M(M_dense, false);
+
+    Matrix<double> answer(A), result(A);
+    mxm(answer, M, NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(B), true);
+    result(M, true) = A.mul(transpose(B), ArithmeticSemiring<double>());
+    BOOST_CHECK_EQUAL(result, answer);
+
+    mxm(answer, complement(M), Plus<double>(), ArithmeticSemiring<double>(),
+        A, B);
+    result(complement(M)) += A.mul(B, ArithmeticSemiring<double>());
+    BOOST_CHECK_EQUAL(result, answer);
+
+    mxm(answer, NoMask(), NoAccumulate(), MinPlusSemiring<double>(),
+        transpose(A), B);
+    result(NoMask()) = transpose(A).mul(B, MinPlusSemiring<double>());
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(expressions_test_vector_products)
+{
+    Matrix<double> A(A_dense, 0.);
+    Vector<double> u(u_dense, 0.);
+    Vector<bool> m(std::vector<bool>{true, false, true, true}, false);
+
+    Vector<double> answer(u), result(u);
+    vxm(answer, m, Plus<double>(), ArithmeticSemiring<double>(), u, A);
+    result(m) += u.mul(A, ArithmeticSemiring<double>());
+    BOOST_CHECK_EQUAL(result, answer);
+
+    mxv(answer, complement(m), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, u, true);
+    result(complement(m), true) = A.mul(u, ArithmeticSemiring<double>());
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(expressions_test_element_wise)
+{
+    Matrix<double> A(A_dense, 0.), B(B_dense, 0.);
+    Matrix<bool> M(M_dense, false);
+
+    Matrix<double> answer(4, 4), result(4, 4);
+    eWiseAdd(answer, M, NoAccumulate(), Plus<double>(), A, B);
+    result(M) = A.add(B, Plus<double>());
+    BOOST_CHECK_EQUAL(result, answer);
+
+    eWiseMult(answer, NoMask(), Plus<double>(), Times<double>(), A, B);
+    result(NoMask()) += A.emult(B, Times<double>());
+    BOOST_CHECK_EQUAL(result, answer);
+
+    Vector<double> u(u_dense, 0.), v(std::vector<double>{4, 5, 0, 6}, 0.);
+    Vector<double> w_answer(4), w_result(4);
+    eWiseAdd(w_answer, NoMask(), NoAccumulate(), Minus<double>(), u, v);
+    w_result(NoMask()) = u.add(v, Minus<double>());
+    BOOST_CHECK_EQUAL(w_result, w_answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(expressions_test_reduce_masked_product)
+{
+    Matrix<double> A(A_dense, 0.), B(B_dense, 0.);
+    Matrix<bool> M(M_dense, false);
+
+    // Reduce the masked product computed by mxm
+    Matrix<double> C(4, 4);
+    mxm(C, M, NoAccumulate(), ArithmeticSemiring<double>(), A, transpose(B));
+    double answer = 1.0;
+    reduce(answer, Plus<double>(), PlusMonoid<double>(), C);
+    Vector<double> w_answer(4);
+    reduce(w_answer, NoMask(), NoAccumulate(), PlusMonoid<double>(), C);
+
+    double result = 1.0;
+    reduce(result, Plus<double>(), PlusMonoid<double>(),
+           A.mul(transpose(B), ArithmeticSemiring<double>()).masked(M));
+    BOOST_CHECK_EQUAL(result, answer);
+
+    Vector<double> w_result(4);
+    reduce(w_result, NoMask(), NoAccumulate(), PlusMonoid<double>(),
+           A.mul(transpose(B), ArithmeticSemiring<double>()).masked(M));
+    BOOST_CHECK_EQUAL(w_result, w_answer);
+
+    // Complemented mask, and no mask
+    mxm(C, complement(M), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, B, true);
+    reduce(answer, NoAccumulate(), MaxMonoid<double>(), C);
+    reduce(result, NoAccumulate(), MaxMonoid<double>(),
+           A.mul(B, ArithmeticSemiring<double>()).masked(complement(M)));
+    BOOST_CHECK_EQUAL(result, answer);
+
+    mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, B);
+    reduce(answer, NoAccumulate(), PlusMonoid<double>(), C);
+    reduce(result, NoAccumulate(), PlusMonoid<double>(),
+           A.mul(B, ArithmeticSemiring<double>()).masked(NoMask()));
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(expressions_test_reduce_masked_product_bad_dimensions)
+{
+    Matrix<double> A(A_dense, 0.);
+    Matrix<double> B(3, 4);
+    Matrix<bool> M(M_dense, false);
+
+    double result = 0.0;
+    BOOST_CHECK_THROW(
+        (reduce(result, NoAccumulate(), PlusMonoid<double>(),
+                A.mul(B, ArithmeticSemiring<double>()).masked(M))),
+        DimensionException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
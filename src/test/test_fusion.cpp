@@ -0,0 +1,140 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE fusion_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<double> const u_dense = {1, 0, 2, 0, 3, 4, 0, 5};
+    std::vector<double> const v_dense = {0, 6, 7, 0, 8, 0, 9, 1};
+
+    template <typename D1, typename D2 = D1>
+    struct Square
+    {
+        typedef D2 result_type;
+        D2 operator()(D1 input) const { return input*input; }
+    };
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(fusion_test_union_and_intersection)
+{
+    Vector<double> u(u_dense, 0.), v(v_dense, 0.);
+
+    Vector<double> answer(8);
+    eWiseAdd(answer, NoMask(), NoAccumulate(), Minus<double>(), u, v);
+    Vector<double> result(8);
+    fused::assign(result, fused::eWiseAdd(Minus<double>(), u, v));
+    BOOST_CHECK_EQUAL(result, answer);
+
+    eWiseMult(answer, NoMask(), NoAccumulate(), Times<double>(), u, v);
+    fused::assign(result, fused::eWiseMult(Times<double>(), u, v));
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(fusion_test_chain_matches_operations)
+{
+    Vector<double> u(u_dense, 0.), v(v_dense, 0.);
+    BinaryOp_Bind2nd<double, Plus<double> > add_one(1.0);
+
+    // t = u .+ (v + 1); d = t .* t; sum = reduce(d)
+    Vector<double> t(8), d(8);
+    apply(t, NoMask(), NoAccumulate(), add_one, v);
+    eWiseAdd(t, NoMask(), NoAccumulate(), Plus<double>(), u, t);
+    eWiseMult(d, NoMask(), NoAccumulate(), Times<double>(), t, t);
+    double answer(0);
+    reduce(answer, NoAccumulate(), PlusMonoid<double>(), d);
+
+    double sum(0);
+    fused::reduce(sum, NoAccumulate(), PlusMonoid<double>(),
+                  fused::apply(Square<double>(),
+                               fused::eWiseAdd(Plus<double>(), u,
+                                               fused::apply(add_one, v))));
+    BOOST_CHECK_EQUAL(sum, answer);
+
+    // With an accumulator
+    fused::reduce(sum, Plus<double>(), PlusMonoid<double>(), u);
+    BOOST_CHECK_EQUAL(sum, answer + 15.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(fusion_test_store_in_place)
+{
+    Vector<double> u(u_dense, 0.), v(v_dense, 0.);
+    BinaryOp_Bind2nd<double, Plus<double> > add_one(1.0);
+
+    Vector<double> v_answer(8);
+    apply(v_answer, NoMask(), NoAccumulate(), add_one, v);
+    Vector<double> d(8);
+    eWiseAdd(d, NoMask(), NoAccumulate(), Minus<double>(), u, v_answer);
+    double answer(0);
+    reduce(answer, NoAccumulate(), PlusMonoid<double>(), d);
+
+    // v is read and replaced by the same expression; an intersection
+    // stops early but the store still gets every element.
+    double sum(0);
+    fused::reduce(sum, NoAccumulate(), PlusMonoid<double>(),
+                  fused::eWiseAdd(Minus<double>(), u,
+                                  fused::store(v, fused::apply(add_one, v))));
+    BOOST_CHECK_EQUAL(sum, answer);
+    BOOST_CHECK_EQUAL(v, v_answer);
+
+    Vector<double> w(8);
+    Vector<double> only_first(8);
+    only_first.setElement(1, 1.0);
+    fused::reduce(sum, NoAccumulate(), PlusMonoid<double>(),
+                  fused::eWiseMult(Times<double>(), only_first,
+                                   fused::store(w, u)));
+    BOOST_CHECK_EQUAL(sum, 0.0);
+    BOOST_CHECK_EQUAL(w, u);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(fusion_test_size_mismatch)
+{
+    Vector<double> u(8), v(7);
+    BOOST_CHECK_THROW(fused::eWiseAdd(Plus<double>(), u, v),
+                      DimensionException);
+    BOOST_CHECK_THROW(fused::store(v, u), DimensionException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
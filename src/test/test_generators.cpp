@@ -0,0 +1,195 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE generators_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    /// The number of stored values in each row of A.
+    template <typename MatrixT>
+    std::vector<IndexType> row_degrees(MatrixT const &A)
+    {
+        IndexArrayType rows(A.nvals()), cols(A.nvals());
+        std::vector<typename MatrixT::ScalarType> vals(A.nvals());
+        A.extractTuples(rows, cols, vals);
+
+        std::vector<IndexType> degrees(A.nrows(), 0);
+        for (auto row : rows)
+        {
+            ++degrees[row];
+        }
+        return degrees;
+    }
+
+    template <typename MatrixT>
+    bool has_self_loops(MatrixT const &A)
+    {
+        for (IndexType idx = 0; idx < A.nrows(); ++idx)
+        {
+            if (A.hasElement(idx, idx))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename MatrixT>
+    bool is_symmetric(MatrixT const &A)
+    {
+        MatrixT AT(A.ncols(), A.nrows());
+        transpose(AT, NoMask(), NoAccumulate(), A);
+        return AT == A;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_rmat_deterministic)
+{
+    GeneratorOptions options;
+    options.seed = 42;
+    // More edges than one task, so that they are generated in pieces
+    Matrix<double> A(rmat<Matrix<double> >(12, 20, options));
+    BOOST_CHECK_EQUAL(A.nrows(), 4096);
+    BOOST_CHECK(A.nvals() > 0);
+    BOOST_CHECK(A.nvals() <= 20*4096);
+    BOOST_CHECK(!has_self_loops(A));
+
+    BOOST_CHECK_EQUAL(A, (rmat<Matrix<double> >(12, 20, options)));
+
+    options.seed = 43;
+    BOOST_CHECK(A != (rmat<Matrix<double> >(12, 20, options)));
+
+    // Skewed: vertex 0 takes the largest share of the edges
+    std::vector<IndexType> degrees(row_degrees(A));
+    BOOST_CHECK_EQUAL(std::max_element(degrees.begin(), degrees.end()) -
+                      degrees.begin(), 0);
+
+    BOOST_CHECK_THROW(rmat<Matrix<double> >(4, 2, options, 0.6, 0.3, 0.3),
+                      InvalidValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_kronecker_symmetric_weighted)
+{
+    GeneratorOptions options;
+    options.symmetric = true;
+    options.weighted = true;
+    options.min_weight = 1;
+    options.max_weight = 10;
+    Matrix<int> A(kronecker<Matrix<int> >(10, 16, options));
+    BOOST_CHECK_EQUAL(A.nrows(), 1024);
+    BOOST_CHECK(is_symmetric(A));
+    BOOST_CHECK(!has_self_loops(A));
+
+    IndexArrayType rows(A.nvals()), cols(A.nvals());
+    std::vector<int> vals(A.nvals());
+    A.extractTuples(rows, cols, vals);
+    BOOST_CHECK_EQUAL(*std::min_element(vals.begin(), vals.end()), 1);
+    BOOST_CHECK_EQUAL(*std::max_element(vals.begin(), vals.end()), 10);
+
+    // The vertices are relabelled, so vertex 0 is no longer the hub
+    std::vector<IndexType> degrees(row_degrees(A));
+    BOOST_CHECK(std::max_element(degrees.begin(), degrees.end()) !=
+                degrees.begin());
+
+    options.self_loops = true;
+    BOOST_CHECK(has_self_loops(kronecker<Matrix<bool> >(10, 16, options)));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_erdos_renyi_and_power_law)
+{
+    GeneratorOptions options;
+    options.weighted = true;
+    options.min_weight = 0.5;
+    options.max_weight = 2.0;
+    Matrix<float> A(erdos_renyi<Matrix<float> >(100000, 200000, options));
+    BOOST_CHECK_EQUAL(A.nrows(), 100000);
+    // A handful of duplicates and self loops at most
+    BOOST_CHECK(A.nvals() > 199000);
+    BOOST_CHECK(A.nvals() <= 200000);
+
+    IndexArrayType rows(A.nvals()), cols(A.nvals());
+    std::vector<float> vals(A.nvals());
+    A.extractTuples(rows, cols, vals);
+    BOOST_CHECK(*std::min_element(vals.begin(), vals.end()) >= 0.5f);
+    BOOST_CHECK(*std::max_element(vals.begin(), vals.end()) <= 2.0f);
+
+    options.weighted = false;
+    Matrix<bool> B(power_law<Matrix<bool> >(10000, 100000, 2.1, options));
+    std::vector<IndexType> degrees(row_degrees(B));
+    BOOST_CHECK(degrees[0] > 100*degrees[9999] + 100);
+    BOOST_CHECK_EQUAL(B, (power_law<Matrix<bool> >(10000, 100000, 2.1, options)));
+
+    BOOST_CHECK_THROW(power_law<Matrix<bool> >(10, 10, 1.0), InvalidValueException);
+    options.weighted = true;
+    options.min_weight = 3;
+    BOOST_CHECK_THROW(erdos_renyi<Matrix<float> >(10, 10, options),
+                      InvalidValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_grids)
+{
+    std::vector<std::vector<int> > answer = {{0, 1, 0, 1, 0, 0},
+                                             {0, 0, 1, 0, 1, 0},
+                                             {0, 0, 0, 0, 0, 1},
+                                             {0, 0, 0, 0, 1, 0},
+                                             {0, 0, 0, 0, 0, 1},
+                                             {0, 0, 0, 0, 0, 0}};
+    BOOST_CHECK_EQUAL(grid_2d<Matrix<int> >(2, 3), Matrix<int>(answer, 0));
+
+    GeneratorOptions options;
+    options.symmetric = true;
+    Matrix<int> A(grid_3d<Matrix<int> >(4, 5, 6, options));
+    BOOST_CHECK_EQUAL(A.nrows(), 120);
+    // 2*(3*5*6 + 4*4*6 + 4*5*5) edges
+    BOOST_CHECK_EQUAL(A.nvals(), 2*(90 + 96 + 100));
+    BOOST_CHECK(is_symmetric(A));
+
+    std::vector<IndexType> degrees(row_degrees(A));
+    BOOST_CHECK_EQUAL(degrees[0], 3);
+    BOOST_CHECK_EQUAL(degrees[(2*5 + 2)*4 + 1], 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,161 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE in_place_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<std::vector<double> > const A_dense = {{1, 0, 2, 0},
+                                                       {0, 3, 0, 4},
+                                                       {5, 0, 0, 6},
+                                                       {0, 7, 8, 0}};
+
+    std::vector<std::vector<double> > const B_dense = {{0, 1, 0, 2},
+                                                       {3, 0, 4, 0},
+                                                       {0, 5, 6, 0},
+                                                       {7, 0, 0, 8}};
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(in_place_test_apply)
+{
+    Matrix<double> A(A_dense, 0.);
+    Matrix<double> answer(A);
+    apply(answer, NoMask(), Plus<double>(), AdditiveInverse<double>(), A);
+
+    Matrix<double> result(A);
+    apply(result, NoMask(), Plus<double>(), AdditiveInverse<double>(), result);
+    BOOST_CHECK_EQUAL(result, answer);
+
+    // Different output type: values are cast where they are stored
+    Matrix<int> int_answer(4, 4);
+    apply(int_answer, NoMask(), NoAccumulate(),
+          BinaryOp_Bind2nd<double, Times<double> >(0.5), A);
+    Matrix<int> int_result(4, 4);
+    apply(int_result, NoMask(), NoAccumulate(), Identity<double, int>(), A);
+    apply(int_result, NoMask(), NoAccumulate(),
+          BinaryOp_Bind2nd<double, Times<double> >(0.5), int_result);
+    BOOST_CHECK_EQUAL(int_result, int_answer);
+
+    Vector<double> u(std::vector<double>{1, 0, 2, 3}, 0.);
+    Vector<double> w_answer(4);
+    apply(w_answer, NoMask(), NoAccumulate(), AdditiveInverse<double>(), u);
+    apply(u, NoMask(), NoAccumulate(), AdditiveInverse<double>(), u);
+    BOOST_CHECK_EQUAL(u, w_answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(in_place_test_element_wise)
+{
+    Matrix<double> A(A_dense, 0.), B(B_dense, 0.);
+
+    Matrix<double> answer(A);
+    eWiseAdd(answer, NoMask(), Times<double>(), Plus<double>(), A, B);
+    Matrix<double> result(A);
+    eWiseAdd(result, NoMask(), Times<double>(), Plus<double>(), result, B);
+    BOOST_CHECK_EQUAL(result, answer);
+
+    answer = A;
+    eWiseMult(answer, NoMask(), NoAccumulate(), Times<double>(), B, A);
+    result = A;
+    eWiseMult(result, NoMask(), NoAccumulate(), Times<double>(), B, result);
+    BOOST_CHECK_EQUAL(result, answer);
+
+    // Both inputs are the output
+    answer = A;
+    eWiseMult(answer, NoMask(), NoAccumulate(), Times<double>(), A, A);
+    result = A;
+    eWiseMult(result, NoMask(), NoAccumulate(), Times<double>(), result, result);
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(in_place_test_transpose_of_output)
+{
+    // Reading the output through a transpose cannot be done a row at a time
+    Matrix<double> A(A_dense, 0.);
+
+    Matrix<double> answer(A);
+    eWiseAdd(answer, NoMask(), NoAccumulate(), Plus<double>(), A, transpose(A));
+    Matrix<double> result(A);
+    eWiseAdd(result, NoMask(), NoAccumulate(), Plus<double>(),
+             result, transpose(result));
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(in_place_test_masked)
+{
+    Matrix<double> A(A_dense, 0.), B(B_dense, 0.);
+
+    Matrix<double> answer(A);
+    eWiseAdd(answer, B, NoAccumulate(), Plus<double>(), A, B, true);
+    Matrix<double> result(A);
+    eWiseAdd(result, B, NoAccumulate(), Plus<double>(), result, B, true);
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(in_place_test_mxm_repeated)
+{
+    Matrix<double> A(A_dense, 0.), B(B_dense, 0.);
+
+    // The output alternates with the back buffer of the product
+    Matrix<double> answer(A), result(A);
+    for (int iteration = 0; iteration < 4; ++iteration)
+    {
+        Matrix<double> previous(answer);
+        mxm(answer, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+            previous, B);
+        mxm(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+            result, B);
+        BOOST_CHECK_EQUAL(result, answer);
+    }
+
+    Matrix<double> previous(answer);
+    mxm(answer, NoMask(), Plus<double>(), ArithmeticSemiring<double>(),
+        previous, previous);
+    mxm(result, NoMask(), Plus<double>(), ArithmeticSemiring<double>(),
+        result, result);
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
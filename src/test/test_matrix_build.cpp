@@ -102,4 +102,65 @@ BOOST_AUTO_TEST_CASE(matrix_build_test_iterators)
     }
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_build_test_duplicates_match_setElement)
+{
+    // Enough tuples, in no order and with many duplicates, that the build
+    // divides its work; values already stored are combined first.
+    IndexType const NROWS = 97, NCOLS = 89, NTUPLES = 40000;
+    IndexArrayType i, j;
+    std::vector<double> v;
+    for (IndexType k = 0; k < NTUPLES; ++k)
+    {
+        i.push_back((k * 7919) % NROWS);
+        j.push_back((k * k + 3 * k) % NCOLS);
+        v.push_back(double(k % 23) - 11.0);
+    }
+
+    Matrix<double> answer(NROWS, NCOLS), result(NROWS, NCOLS);
+    for (IndexType row = 0; row < NROWS; row += 3)
+    {
+        result.setElement(row, row % NCOLS, 100.0);
+    }
+
+    // Minus is not commutative, so the order of the duplicates matters
+    for (IndexType k = 0; k < NTUPLES; ++k)
+    {
+        double val(v[k]);
+        if (answer.hasElement(i[k], j[k]))
+        {
+            val = answer.extractElement(i[k], j[k]) - val;
+        }
+        else if ((i[k] % 3 == 0) && (j[k] == i[k] % NCOLS))
+        {
+            val = 100.0 - val;
+        }
+        answer.setElement(i[k], j[k], val);
+    }
+    for (IndexType row = 0; row < NROWS; row += 3)
+    {
+        if (!answer.hasElement(row, row % NCOLS))
+        {
+            answer.setElement(row, row % NCOLS, 100.0);
+        }
+    }
+
+    result.build(i, j, v, Minus<double>());
+
+    BOOST_CHECK_EQUAL(result.nvals(), answer.nvals());
+    BOOST_CHECK_EQUAL(result, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_build_test_bad_index)
+{
+    IndexArrayType i = {0, 1, 3};
+    IndexArrayType j = {1, 2, 0};
+    std::vector<double> v = {1, 2, 3};
+
+    Matrix<double> m1(3, 4);
+    BOOST_CHECK_THROW(m1.build(i, j, v), IndexOutOfBoundsException);
+    BOOST_CHECK_EQUAL(m1.nvals(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,168 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <iostream>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE matrix_interop_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    std::vector<std::vector<double> > const A_dense = {{0, 1.5, 0, 0},
+                                                       {2.25, 0, 0, -3},
+                                                       {0, 0, 0, 0},
+                                                       {0, 4, 7, 0}};
+
+    // A_dense as CSR and CSC arrays
+    IndexArrayType const      A_row_ptr = {0, 1, 3, 3, 5};
+    IndexArrayType const      A_col_idx = {1, 0, 3, 1, 2};
+    std::vector<double> const A_csr_values = {1.5, 2.25, -3, 4, 7};
+
+    IndexArrayType const      A_col_ptr = {0, 1, 3, 4, 5};
+    IndexArrayType const      A_row_idx = {1, 0, 3, 3, 1};
+    std::vector<double> const A_csc_values = {2.25, 1.5, 4, 7, -3};
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_import_export_rows)
+{
+    Matrix<double> A(A_dense, 0.);
+    Matrix<double> B(A);
+
+    MatrixRows<double> rows(export_rows(A));
+    BOOST_CHECK_EQUAL(A.nvals(), 0);
+    BOOST_CHECK_EQUAL(A.nrows(), 4);
+    BOOST_REQUIRE_EQUAL(rows.size(), 4);
+    BOOST_CHECK_EQUAL(rows[3].size(), 2);
+
+    // the storage of the rows is taken, not copied
+    std::tuple<IndexType, double> const *data(rows[1].data());
+    Matrix<double> C(4, 4);
+    import_rows(C, std::move(rows), true);
+    BOOST_CHECK_EQUAL(B, C);
+    BOOST_CHECK(export_rows(C)[1].data() == data);
+
+    MatrixRows<double> bad(3);
+    BOOST_CHECK_THROW(import_rows(C, std::move(bad)), DimensionException);
+
+    MatrixRows<double> out_of_range(4);
+    out_of_range[2].push_back(std::make_tuple(4, 1.));
+    BOOST_CHECK_THROW(import_rows(C, std::move(out_of_range), true),
+                      IndexOutOfBoundsException);
+
+    MatrixRows<double> unsorted(4);
+    unsorted[0].push_back(std::make_tuple(2, 1.));
+    unsorted[0].push_back(std::make_tuple(1, 1.));
+    BOOST_CHECK_THROW(import_rows(C, std::move(unsorted), true),
+                      InvalidIndexException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_import_export_csr)
+{
+    Matrix<double> A(A_dense, 0.);
+
+    Matrix<double> B(4, 4);
+    import_csr(B, A_row_ptr.data(), A_col_idx.data(), A_csr_values.data(),
+               true);
+    BOOST_CHECK_EQUAL(A, B);
+
+    IndexArrayType row_ptr, col_idx;
+    std::vector<double> values;
+    export_csr(A, row_ptr, col_idx, values);
+    BOOST_CHECK(row_ptr == A_row_ptr);
+    BOOST_CHECK(col_idx == A_col_idx);
+    BOOST_CHECK(values == A_csr_values);
+
+    // bool values (packed bits in std::vector<bool>)
+    Matrix<bool> P(4, 4);
+    std::vector<bool> ones(5, true);
+    import_csr(P, A_row_ptr.begin(), A_col_idx.begin(), ones.begin());
+    std::vector<bool> p_values;
+    export_csr(P, row_ptr, col_idx, p_values);
+    BOOST_CHECK(row_ptr == A_row_ptr);
+    BOOST_CHECK(p_values == ones);
+
+    IndexArrayType bad_ptr = {0, 2, 1, 3, 5};
+    BOOST_CHECK_THROW(import_csr(B, bad_ptr.begin(), A_col_idx.begin(),
+                                 A_csr_values.begin(), true),
+                      InvalidValueException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_import_export_csc)
+{
+    Matrix<double> A(A_dense, 0.);
+
+    Matrix<double> B(4, 4);
+    import_csc(B, A_col_ptr.begin(), A_row_idx.begin(),
+               A_csc_values.begin(), true);
+    BOOST_CHECK_EQUAL(A, B);
+
+    IndexArrayType col_ptr, row_idx;
+    std::vector<double> values;
+    export_csc(A, col_ptr, row_idx, values);
+    BOOST_CHECK(col_ptr == A_col_ptr);
+    BOOST_CHECK(row_idx == A_row_idx);
+    BOOST_CHECK(values == A_csc_values);
+
+    IndexArrayType bad_idx = {1, 3, 0, 3, 1};
+    BOOST_CHECK_THROW(import_csc(B, A_col_ptr.begin(), bad_idx.begin(),
+                                 A_csc_values.begin(), true),
+                      InvalidIndexException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_visit_rows)
+{
+    Matrix<double> A(A_dense, 0.);
+
+    std::vector<double> row_sums(A.nrows(), 0.);
+    visit_rows(A,
+               [&](IndexType row_idx,
+                   std::vector<std::tuple<IndexType, double> > const &row)
+               {
+                   for (auto const &elt : row)
+                   {
+                       row_sums[row_idx] += std::get<1>(elt);
+                   }
+               });
+    BOOST_CHECK(row_sums == std::vector<double>({1.5, -0.75, 0, 11}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,248 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE matrix_io_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    /// A file with the given contents that is removed at the end of the
+    /// test.
+    class TempFile
+    {
+    public:
+        TempFile(std::string const &contents = std::string())
+        {
+            char name[] = "/tmp/gbtl_matrix_io_XXXXXX";
+            int fd(mkstemp(name));
+            BOOST_REQUIRE(fd >= 0);
+            ::close(fd);
+            m_path = name;
+
+            std::ofstream out(m_path, std::ios::binary);
+            out << contents;
+        }
+
+        ~TempFile() { std::remove(m_path.c_str()); }
+
+        std::string const &path() const { return m_path; }
+
+    private:
+        std::string m_path;
+    };
+
+    std::vector<std::vector<double> > const A_dense = {{0, 1.5, 0, 0},
+                                                       {2.25, 0, 0, -3},
+                                                       {0, 0, 0, 0}};
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_read_matrix_market_general)
+{
+    TempFile file("%%MatrixMarket matrix coordinate real general\n"
+                  "% a comment\n"
+                  "%\n"
+                  "3 4 3\n"
+                  "1 2 1.5\n"
+                  "2 4 -3e0\n"
+                  "2 1 2.25");   // no newline at the end
+
+    Matrix<double> A(read_matrix_market<Matrix<double> >(file.path()));
+    BOOST_CHECK_EQUAL(A, Matrix<double>(A_dense, 0.));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_read_matrix_market_symmetric)
+{
+    TempFile file("%%MatrixMarket matrix coordinate integer symmetric\n"
+                  "3 3 3\n"
+                  "1 1 4\n"
+                  "3 1 -2\n"
+                  "3 2 7\n");
+    std::vector<std::vector<int> > answer = {{4, 0, -2},
+                                             {0, 0, 7},
+                                             {-2, 7, 0}};
+
+    Matrix<int> A(read_matrix_market<Matrix<int> >(file.path()));
+    BOOST_CHECK_EQUAL(A, Matrix<int>(answer, 0));
+
+    TempFile pattern("%%MatrixMarket matrix coordinate pattern skew-symmetric\n"
+                     "3 3 2\n"
+                     "2 1\n"
+                     "3 2\n");
+    std::vector<std::vector<int> > skew_answer = {{0, -1, 0},
+                                                  {1, 0, -1},
+                                                  {0, 1, 0}};
+    BOOST_CHECK_EQUAL(read_matrix_market<Matrix<int> >(pattern.path()),
+                      Matrix<int>(skew_answer, 0));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_read_matrix_market_errors)
+{
+    BOOST_CHECK_THROW(read_matrix_market<Matrix<double> >("/nonexistent.mtx"),
+                      IOException);
+
+    TempFile array("%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n");
+    BOOST_CHECK_THROW(read_matrix_market<Matrix<double> >(array.path()),
+                      IOException);
+
+    TempFile range("%%MatrixMarket matrix coordinate real general\n"
+                   "2 2 1\n3 1 1.0\n");
+    BOOST_CHECK_THROW(read_matrix_market<Matrix<double> >(range.path()),
+                      IOException);
+
+    TempFile count("%%MatrixMarket matrix coordinate real general\n"
+                   "2 2 2\n1 1 1.0\n");
+    BOOST_CHECK_THROW(read_matrix_market<Matrix<double> >(count.path()),
+                      IOException);
+
+    TempFile bad("%%MatrixMarket matrix coordinate real general\n"
+                 "2 2 1\n1 x 1.0\n");
+    BOOST_CHECK_THROW(read_matrix_market<Matrix<double> >(bad.path()),
+                      IOException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_matrix_market_round_trip)
+{
+    Matrix<double> A(A_dense, 0.);
+    A.setElement(2, 2, 1.0/3.0);
+
+    TempFile file;
+    write_matrix_market(file.path(), A);
+    BOOST_CHECK_EQUAL(read_matrix_market<Matrix<double> >(file.path()), A);
+
+    Matrix<int> B(std::vector<std::vector<int> >{{0, -7}, {123456789, 0}}, 0);
+    write_matrix_market(file.path(), B);
+    BOOST_CHECK_EQUAL(read_matrix_market<Matrix<int> >(file.path()), B);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_read_edge_list)
+{
+    TempFile tsv("# comment\n"
+                 "0\t1\n"
+                 "1\t2\n"
+                 "\n"
+                 "2\t2\n"
+                 "3\t0\r\n");
+    std::vector<std::vector<int> > answer = {{0, 1, 0, 0},
+                                             {0, 0, 1, 0},
+                                             {0, 0, 1, 0},
+                                             {1, 0, 0, 0}};
+    BOOST_CHECK_EQUAL(read_edge_list<Matrix<int> >(tsv.path()),
+                      Matrix<int>(answer, 0));
+
+    EdgeListOptions options;
+    options.symmetric = true;
+    options.skip_self_loops = true;
+    options.num_vertices = 5;
+    std::vector<std::vector<int> > sym_answer = {{0, 1, 0, 1, 0},
+                                                 {1, 0, 1, 0, 0},
+                                                 {0, 1, 0, 0, 0},
+                                                 {1, 0, 0, 0, 0},
+                                                 {0, 0, 0, 0, 0}};
+    BOOST_CHECK_EQUAL(read_edge_list<Matrix<int> >(tsv.path(), options),
+                      Matrix<int>(sym_answer, 0));
+
+    options.num_vertices = 3;
+    BOOST_CHECK_THROW(read_edge_list<Matrix<int> >(tsv.path(), options),
+                      IOException);
+
+    // CSV with a header, weights and 1-based ids
+    TempFile csv("src,dst,weight\n"
+                 "1,2,1.5\n"
+                 "2, 4, -3\n"
+                 "2,1,2.25\n");
+    EdgeListOptions csv_options;
+    csv_options.one_based = true;
+    Matrix<double> A(read_edge_list<Matrix<double> >(csv.path(), csv_options));
+    std::vector<std::vector<double> > csv_answer = {{0, 1.5, 0, 0},
+                                                    {2.25, 0, 0, -3},
+                                                    {0, 0, 0, 0},
+                                                    {0, 0, 0, 0}};
+    BOOST_CHECK_EQUAL(A, Matrix<double>(csv_answer, 0.));
+
+    TempFile bad("0 1\n1 2 3 4\n");
+    BOOST_CHECK_THROW(read_edge_list<Matrix<int> >(bad.path()), IOException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(matrix_io_test_edge_list_many_chunks)
+{
+    // More text than one chunk, so that it is parsed in pieces
+    IndexType const num_vertices = 50000;
+    std::string text;
+    IndexArrayType rows, cols;
+    std::vector<int> vals;
+    for (IndexType k = 0; text.size() < 2*IO_CHUNK_SIZE + 1000; ++k)
+    {
+        IndexType src((k*7919) % num_vertices);
+        IndexType dst((k*104729 + 13) % num_vertices);
+        int weight(int(k % 100) - 50);
+        text += std::to_string(src) + "\t" + std::to_string(dst) + "\t" +
+            std::to_string(weight) + "\n";
+        rows.push_back(src);
+        cols.push_back(dst);
+        vals.push_back(weight);
+    }
+    TempFile file(text);
+
+    EdgeListOptions options;
+    options.num_vertices = num_vertices;
+    Matrix<int> A(read_edge_list<Matrix<int> >(file.path(), options));
+
+    Matrix<int> answer(num_vertices, num_vertices);
+    answer.build(rows, cols, vals);
+    BOOST_CHECK_EQUAL(A, answer);
+
+    TempFile out;
+    write_edge_list(out.path(), A, ',');
+    BOOST_CHECK_EQUAL(read_edge_list<Matrix<int> >(out.path(), options), A);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
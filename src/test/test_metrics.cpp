@@ -187,4 +187,20 @@ BOOST_AUTO_TEST_CASE(metrics_test_closeness_centrality)
     BOOST_CHECK_EQUAL(result, 4);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(metrics_test_closeness_centrality_vertices)
+{
+    Matrix<double, DirectedMatrixTag> test5x5(5,5);
+    test5x5.build(tr.begin(), tc.begin(), tv.begin(), tv.size());
+
+    IndexArrayType vids = {0, 1, 2, 3, 4, 2};
+    std::vector<double> result = closeness_centrality(test5x5, vids);
+
+    BOOST_CHECK_EQUAL(result.size(), vids.size());
+    for (IndexType ix = 0; ix < vids.size(); ++ix)
+    {
+        BOOST_CHECK_EQUAL(result[ix], closeness_centrality(test5x5, vids[ix]));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,214 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE nonblocking_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    // A weighted ring with a few chords
+    Matrix<double> make_graph(IndexType n)
+    {
+        IndexArrayType i, j;
+        std::vector<double> v;
+        for (IndexType ix = 0; ix < n; ++ix)
+        {
+            i.push_back(ix); j.push_back((ix + 1) % n); v.push_back(ix + 1.0);
+            i.push_back(ix); j.push_back((ix*5 + 2) % n); v.push_back(0.5*ix);
+        }
+        Matrix<double> A(n, n);
+        A.build(i, j, v);
+        return A;
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_test_deferred_until_nvals)
+{
+    Matrix<double> A(make_graph(20));
+
+    Matrix<double> answer(20, 20);
+    mxm(answer, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A));
+
+    NonBlockingContext context;
+    Matrix<double> C(20, 20);
+    mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+        A, transpose(A));
+    BOOST_CHECK_EQUAL(context.num_pending(), 1);
+
+    BOOST_CHECK_EQUAL(C.nvals(), answer.nvals());
+    BOOST_CHECK_EQUAL(context.num_pending(), 0);
+    BOOST_CHECK_EQUAL(C, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_test_independent_operations)
+{
+    Matrix<double> A(make_graph(30));
+
+    // Two independent chains joined by eWiseAdd
+    Matrix<double> answer_lo(30, 30), answer_hi(30, 30), answer(30, 30);
+    BinaryOp_Bind2nd<double, LessEqual<double> > leq(5.0);
+    BinaryOp_Bind2nd<double, GreaterThan<double> > gt(5.0);
+    apply(answer_lo, NoMask(), NoAccumulate(), leq, A);
+    apply(answer_lo, answer_lo, NoAccumulate(), Identity<double>(), A, true);
+    apply(answer_hi, NoMask(), NoAccumulate(), gt, A);
+    apply(answer_hi, answer_hi, NoAccumulate(), Identity<double>(), A, true);
+    eWiseAdd(answer, NoMask(), NoAccumulate(), Plus<double>(),
+             answer_lo, answer_hi);
+
+    Matrix<double> lo(30, 30), hi(30, 30), result(30, 30);
+    {
+        NonBlockingContext context;
+        apply(lo, NoMask(), NoAccumulate(), leq, A);
+        apply(lo, lo, NoAccumulate(), Identity<double>(), A, true);
+        apply(hi, NoMask(), NoAccumulate(), gt, A);
+        apply(hi, hi, NoAccumulate(), Identity<double>(), A, true);
+        eWiseAdd(result, NoMask(), NoAccumulate(), Plus<double>(), lo, hi);
+        BOOST_CHECK_EQUAL(context.num_pending(), 5);
+
+        context.wait();
+        BOOST_CHECK_EQUAL(context.num_pending(), 0);
+    }
+
+    BOOST_CHECK_EQUAL(lo, answer_lo);
+    BOOST_CHECK_EQUAL(hi, answer_hi);
+    BOOST_CHECK_EQUAL(result, answer);
+    BOOST_CHECK_EQUAL(result, A);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_test_write_after_read)
+{
+    Matrix<double> A(make_graph(10));
+
+    Vector<double> u(10), w(10), answer(10);
+    u.setElement(3, 2.0);
+    mxv(answer, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+
+    NonBlockingContext context;
+
+    // w reads the old u, which a later operation and setElement overwrite
+    mxv(w, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    assign(u, NoMask(), NoAccumulate(), 7.0, AllIndices());
+    u.setElement(0, 1.0);
+
+    BOOST_CHECK_EQUAL(w, answer);
+    BOOST_CHECK_EQUAL(u.nvals(), 10);
+    BOOST_CHECK_EQUAL(u.extractElement(0), 1.0);
+    BOOST_CHECK_EQUAL(u.extractElement(3), 7.0);
+
+    // A matrix modified after it was read
+    Matrix<double> B(A);
+    Matrix<double> C(10, 10);
+    apply(C, NoMask(), NoAccumulate(), AdditiveInverse<double>(), B);
+    B.setElement(0, 0, 100.0);
+    BOOST_CHECK(!C.hasElement(0, 0));
+    BOOST_CHECK_EQUAL(C.extractElement(0, 1), -1.0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_test_scalar_reduce_and_temporaries)
+{
+    Matrix<double> A(make_graph(12));
+
+    double answer(0.0);
+    reduce(answer, NoAccumulate(), PlusMonoid<double>(), A);
+
+    NonBlockingContext context;
+    Matrix<double> C(12, 12);
+    {
+        // The temporary is an input of a recorded operation
+        Matrix<double> T(A);
+        apply(C, NoMask(), NoAccumulate(), Identity<double>(), T);
+    }
+
+    Vector<double> row_sums(12);
+    reduce(row_sums, NoMask(), NoAccumulate(), Plus<double>(), C);
+    BOOST_CHECK_EQUAL(context.num_pending(), 1);
+
+    // Reducing to a scalar runs at once
+    double sum(0.0);
+    reduce(sum, NoAccumulate(), PlusMonoid<double>(), row_sums);
+    BOOST_CHECK_EQUAL(context.num_pending(), 0);
+    BOOST_CHECK_EQUAL(sum, answer);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_test_nested_context_and_extract_tuples)
+{
+    Matrix<double> A(make_graph(8));
+
+    NonBlockingContext outer;
+    Matrix<double> C(8, 8);
+    {
+        NonBlockingContext inner;
+        transpose(C, NoMask(), NoAccumulate(), A);
+    }
+    // The inner context joined the outer one
+    BOOST_CHECK_EQUAL(outer.num_pending(), 1);
+
+    IndexArrayType rows(C.nvals()), cols(C.nvals());
+    std::vector<double> vals(C.nvals());
+    C.extractTuples(rows, cols, vals);
+    for (IndexType ix = 0; ix < rows.size(); ++ix)
+    {
+        BOOST_CHECK_EQUAL(vals[ix], A.extractElement(cols[ix], rows[ix]));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(nonblocking_test_dimension_check_is_immediate)
+{
+    Matrix<double> A(make_graph(8));
+    Matrix<double> C(7, 8);
+
+    NonBlockingContext context;
+    BOOST_CHECK_THROW(
+        (mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A)),
+        DimensionException);
+    BOOST_CHECK_EQUAL(context.num_pending(), 0);
+
+    // wait() is a no-op in blocking mode
+    GraphBLAS::wait();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,104 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <iostream>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE numa_placement_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    std::vector<std::vector<double> > const A_dense = {{1, 0, 2, 0},
+                                                       {0, 3, 0, 4},
+                                                       {5, 0, 0, 6},
+                                                       {0, 7, 8, 0}};
+
+    std::vector<double> const u_dense = {1, 0, 2, 3};
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(numa_placement_test_matrix)
+{
+    Matrix<double> A(A_dense, 0.);
+    Vector<double> u(u_dense, 0.);
+
+    Vector<double> answer(4);
+    mxv(answer, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    Matrix<double> AA(4, 4);
+    mxm(AA, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+
+    BOOST_CHECK(A.placement() == NumaPolicy::NONE);
+    for (auto policy : {NumaPolicy::INTERLEAVE, NumaPolicy::FIRST_TOUCH,
+                        NumaPolicy::REPLICATE})
+    {
+        A.place(policy);
+        BOOST_CHECK(A.placement() == policy);
+        BOOST_CHECK_EQUAL(A, Matrix<double>(A_dense, 0.));
+
+        Vector<double> result(4);
+        mxv(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+            A, u);
+        BOOST_CHECK_EQUAL(result, answer);
+
+        Matrix<double> C(4, 4);
+        mxm(C, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, A);
+        BOOST_CHECK_EQUAL(C, AA);
+    }
+
+    // Writing to the matrix ends the placement
+    A.setElement(0, 1, 9.);
+    BOOST_CHECK(A.placement() == NumaPolicy::NONE);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(numa_placement_test_vector)
+{
+    Vector<double> u(u_dense, 0.);
+
+    u.place(NumaPolicy::INTERLEAVE);
+    BOOST_CHECK(u.placement() == NumaPolicy::INTERLEAVE);
+    BOOST_CHECK_EQUAL(u, Vector<double>(u_dense, 0.));
+
+    u.place(NumaPolicy::FIRST_TOUCH);
+    BOOST_CHECK(u.placement() == NumaPolicy::FIRST_TOUCH);
+    BOOST_CHECK_EQUAL(u, Vector<double>(u_dense, 0.));
+
+    BOOST_CHECK_THROW(u.place(NumaPolicy::REPLICATE), InvalidValueException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,205 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE reduction_mode_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+namespace
+{
+    /// Values of very different magnitudes that do not add exactly.
+    double test_value(IndexType k)
+    {
+        return ((k % 3 == 0) ? -1.0 : 1.0) * (1.0 + 0.1*(k % 17)) *
+            ((k % 11 == 0) ? 1.e8 : 1.e-3);
+    }
+
+    /// A matrix with more stored values than a few reduction blocks.
+    Matrix<double> test_matrix(IndexType nrows, IndexType ncols)
+    {
+        IndexArrayType rows, cols;
+        std::vector<double> vals;
+        for (IndexType i = 0; i < nrows; ++i)
+        {
+            for (IndexType j = 0; j < ncols; ++j)
+            {
+                if ((i == 2) || ((i*7 + j*3) % 5 == 0))
+                {
+                    rows.push_back(i);
+                    cols.push_back(j);
+                    vals.push_back(test_value(i*ncols + j));
+                }
+            }
+        }
+
+        Matrix<double> A(nrows, ncols);
+        A.build(rows, cols, vals);
+        return A;
+    }
+
+    /// The TreeReduction of the values of A in row order.
+    double tree_sum(Matrix<double> const &A, bool compensated)
+    {
+        TreeReduction<double, PlusMonoid<double> > tree(PlusMonoid<double>(),
+                                                        compensated);
+        for (IndexType i = 0; i < A.nrows(); ++i)
+        {
+            for (IndexType j = 0; j < A.ncols(); ++j)
+            {
+                if (A.hasElement(i, j))
+                {
+                    tree.add(A.extractElement(i, j));
+                }
+            }
+        }
+        return tree.result();
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(reduction_mode_test_context)
+{
+    BOOST_CHECK(reduction_mode() == ReductionMode::FAST);
+    {
+        ReductionContext outer(ReductionMode::REPRODUCIBLE);
+        BOOST_CHECK(reduction_mode() == ReductionMode::REPRODUCIBLE);
+        {
+            ReductionContext inner(ReductionMode::COMPENSATED);
+            BOOST_CHECK(reduction_mode() == ReductionMode::COMPENSATED);
+        }
+        BOOST_CHECK(reduction_mode() == ReductionMode::REPRODUCIBLE);
+    }
+    BOOST_CHECK(reduction_mode() == ReductionMode::FAST);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(reduction_mode_test_tree_blocks)
+{
+    // Adding whole blocks gives the same result as adding their values.
+    for (bool compensated : {false, true})
+    {
+        IndexType const n(5*REDUCTION_BLOCK_SIZE + 123);
+        TreeReduction<double, PlusMonoid<double> > by_value(
+            PlusMonoid<double>(), compensated);
+        TreeReduction<double, PlusMonoid<double> > by_block(
+            PlusMonoid<double>(), compensated);
+
+        for (IndexType begin = 0; begin < n; begin += REDUCTION_BLOCK_SIZE)
+        {
+            IndexType end(std::min(begin + REDUCTION_BLOCK_SIZE, n));
+            TreeReduction<double, PlusMonoid<double> > block(
+                PlusMonoid<double>(), compensated);
+            for (IndexType k = begin; k < end; ++k)
+            {
+                by_value.add(test_value(k));
+                block.add(test_value(k));
+            }
+            by_block.add_block(block.partial(), end - begin);
+        }
+
+        BOOST_CHECK_EQUAL(by_value.result(), by_block.result());
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(reduction_mode_test_matrix_to_scalar)
+{
+    Matrix<double> A(test_matrix(120, 100));
+    BOOST_CHECK(A.nvals() > 2*REDUCTION_BLOCK_SIZE);
+
+    for (bool compensated : {false, true})
+    {
+        ReductionContext context(compensated ? ReductionMode::COMPENSATED :
+                                 ReductionMode::REPRODUCIBLE);
+        double result(0);
+        reduce(result, NoAccumulate(), PlusMonoid<double>(), A);
+        BOOST_CHECK_EQUAL(result, tree_sum(A, compensated));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(reduction_mode_test_compensated)
+{
+    // 1 + 1e100 + 1 - 1e100 is 0 when added left to right.
+    std::vector<double> vals = {1.0, 1.e100, 1.0, -1.e100};
+    Vector<double> u(vals);
+    Matrix<double> A(std::vector<std::vector<double> >{vals}, 0.0);
+
+    double result(0);
+    reduce(result, NoAccumulate(), PlusMonoid<double>(), u);
+    BOOST_CHECK_EQUAL(result, 0.0);
+
+    ReductionContext context(ReductionMode::COMPENSATED);
+    reduce(result, NoAccumulate(), PlusMonoid<double>(), u);
+    BOOST_CHECK_EQUAL(result, 2.0);
+
+    reduce(result, NoAccumulate(), PlusMonoid<double>(), A);
+    BOOST_CHECK_EQUAL(result, 2.0);
+
+    Vector<double> w(1);
+    reduce(w, NoMask(), NoAccumulate(), PlusMonoid<double>(), A);
+    BOOST_CHECK_EQUAL(w.extractElement(0), 2.0);
+
+    // Not a sum: combined as usual
+    reduce(result, NoAccumulate(), MaxMonoid<double>(), u);
+    BOOST_CHECK_EQUAL(result, 1.e100);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(reduction_mode_test_deferred)
+{
+    // A recorded operation keeps the mode it was called in.
+    std::vector<double> vals = {1.0, 1.e100, 1.0, -1.e100};
+    Matrix<double> A(std::vector<std::vector<double> >{vals}, 0.0);
+    Vector<double> w(1);
+
+    {
+        NonBlockingContext non_blocking;
+        {
+            ReductionContext context(ReductionMode::COMPENSATED);
+            reduce(w, NoMask(), NoAccumulate(), PlusMonoid<double>(), A);
+        }
+        non_blocking.wait();
+    }
+    BOOST_CHECK_EQUAL(w.extractElement(0), 2.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,202 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE snapshot_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    /// A path for a snapshot that is removed at the end of the test.
+    class TempPath
+    {
+    public:
+        TempPath()
+        {
+            char name[] = "/tmp/gbtl_snapshot_XXXXXX";
+            int fd(mkstemp(name));
+            BOOST_REQUIRE(fd >= 0);
+            ::close(fd);
+            m_path = name;
+        }
+
+        ~TempPath() { std::remove(m_path.c_str()); }
+
+        std::string const &path() const { return m_path; }
+
+    private:
+        std::string m_path;
+    };
+
+    /// Overwrite one byte of a file.
+    void corrupt(std::string const &path, std::streamoff pos)
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekg(pos);
+        char c(file.get());
+        file.seekp(pos);
+        file.put(static_cast<char>(c ^ 0x5a));
+    }
+
+    std::vector<std::vector<double> > const A_dense = {{0, 1.5, 0, 0},
+                                                       {2.25, 0, 0, -3},
+                                                       {0, 0, 0, 0},
+                                                       {0, 0, 7, 0}};
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_save_load_matrix)
+{
+    Matrix<double> A(A_dense, 0.);
+    TempPath file;
+    save(file.path(), A);
+
+    auto B(load<Matrix<double> >(file.path()));
+    BOOST_CHECK_EQUAL(A, B);
+
+    // a large matrix spans several checksum blocks and load tasks
+    IndexType const N(5000);
+    IndexArrayType rows, cols;
+    std::vector<int> vals;
+    for (IndexType idx = 0; idx < 200000; ++idx)
+    {
+        rows.push_back((idx*7919) % N);
+        cols.push_back((idx*104729) % N);
+        vals.push_back(static_cast<int>(idx % 1000) - 500);
+    }
+    Matrix<int> C(N, N);
+    C.build(rows, cols, vals);
+    save(file.path(), C);
+    BOOST_CHECK_EQUAL(C, load<Matrix<int> >(file.path()));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_save_load_vector)
+{
+    std::vector<double> u_dense = {0, 3.5, 0, -1, 0, 0, 2};
+    Vector<double> u(u_dense, 0.);
+    TempPath file;
+    save(file.path(), u);
+    BOOST_CHECK_EQUAL(u, load<Vector<double> >(file.path()));
+
+    std::vector<bool> v_dense = {true, false, false, true};
+    Vector<bool> v(v_dense, false);
+    save(file.path(), v);
+    BOOST_CHECK_EQUAL(v, load<Vector<bool> >(file.path()));
+
+    Vector<float> empty(10);
+    save(file.path(), empty);
+    BOOST_CHECK_EQUAL(empty, load<Vector<float> >(file.path()));
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_mapped_matrix)
+{
+    Matrix<double> A(A_dense, 0.);
+    TempPath file;
+    save(file.path(), A);
+
+    MappedMatrix<double> M(file.path(), true);
+    BOOST_CHECK_EQUAL(M.nrows(), 4);
+    BOOST_CHECK_EQUAL(M.ncols(), 4);
+    BOOST_CHECK_EQUAL(M.nvals(), 4);
+
+    IndexType nvals(0);
+    for (IndexType row_idx = 0; row_idx < M.nrows(); ++row_idx)
+    {
+        for (auto elt : M.getRow(row_idx))
+        {
+            BOOST_CHECK_EQUAL(std::get<1>(elt),
+                              A.extractElement(row_idx, std::get<0>(elt)));
+            ++nvals;
+        }
+    }
+    BOOST_CHECK_EQUAL(nvals, A.nvals());
+
+    std::vector<std::tuple<IndexType, double> > row(M.getRow(3));
+    BOOST_CHECK(row == (std::vector<std::tuple<IndexType, double> >{
+                std::make_tuple(2, 7.)}));
+    BOOST_CHECK(M.getRow(2).empty());
+    BOOST_CHECK_EQUAL(M.getRow(1).size(), 2);
+
+    BOOST_CHECK(M.hasElement(1, 3));
+    BOOST_CHECK(!M.hasElement(1, 2));
+    BOOST_CHECK_EQUAL(M.extractElement(1, 3), -3.);
+    BOOST_CHECK_THROW(M.extractElement(0, 0), NoValueException);
+    BOOST_CHECK_THROW(M.hasElement(4, 0), IndexOutOfBoundsException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_load_errors)
+{
+    Matrix<double> A(A_dense, 0.);
+    TempPath file;
+    save(file.path(), A);
+
+    // another scalar type, or a vector
+    BOOST_CHECK_THROW(load<Matrix<float> >(file.path()), IOException);
+    BOOST_CHECK_THROW(load<Vector<double> >(file.path()), IOException);
+
+    // a corrupt value is caught by the checksum (only when verifying)
+    std::ifstream in(file.path(), std::ios::binary | std::ios::ate);
+    std::streamoff size(in.tellg());
+    in.close();
+    corrupt(file.path(), size - 60);
+    BOOST_CHECK_THROW(load<Matrix<double> >(file.path()), IOException);
+    BOOST_CHECK_NO_THROW(load<Matrix<double> >(file.path(), false));
+
+    // a corrupt header
+    corrupt(file.path(), 0);
+    BOOST_CHECK_THROW(load<Matrix<double> >(file.path(), false), IOException);
+
+    // not a snapshot at all
+    {
+        std::ofstream out(file.path());
+        out << "%%MatrixMarket matrix coordinate real general\n";
+    }
+    BOOST_CHECK_THROW(MappedMatrix<double>(file.path()), IOException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
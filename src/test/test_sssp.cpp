@@ -350,4 +350,34 @@ BOOST_AUTO_TEST_CASE(test_sssp_delta_step_gilbert_uint)
     BOOST_CHECK_EQUAL(result, answer3);
 }
 
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(sssp_cycle_batch_tasks)
+{
+    // More sources than one task searches: the blocks of rows run as tasks
+    GraphBLAS::IndexType const NUM_NODES(2*SSSP_SOURCES_PER_TASK + 5);
+    GraphBLAS::IndexArrayType i, j;
+    for (GraphBLAS::IndexType ix = 0; ix < NUM_NODES; ++ix)
+    {
+        i.push_back(ix);
+        j.push_back((ix + 1) % NUM_NODES);
+    }
+    std::vector<unsigned int> v(i.size(), 1);
+    GraphBLAS::Matrix<unsigned int> G_cycle(NUM_NODES, NUM_NODES);
+    G_cycle.build(i, j, v);
+
+    auto paths = GraphBLAS::scaled_identity<
+        GraphBLAS::Matrix<unsigned int> >(NUM_NODES, 0);
+    batch_sssp(G_cycle, paths);
+
+    BOOST_CHECK_EQUAL(paths.nvals(), NUM_NODES*NUM_NODES);
+    for (GraphBLAS::IndexType r = 0; r < NUM_NODES; ++r)
+    {
+        for (GraphBLAS::IndexType c = 0; c < NUM_NODES; ++c)
+        {
+            BOOST_CHECK_EQUAL(paths.extractElement(r, c),
+                              (c + NUM_NODES - r) % NUM_NODES);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
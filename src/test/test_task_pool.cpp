@@ -0,0 +1,242 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <graphblas/graphblas.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE task_pool_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(task_pool_test_group_wait)
+{
+    TaskPool pool(4);
+    BOOST_CHECK_EQUAL(pool.num_threads(), 4);
+
+    std::vector<int> results(100, 0);
+    TaskGroup group(pool);
+    for (IndexType ix = 0; ix < results.size(); ++ix)
+    {
+        group.run([&results, ix]() { results[ix] = int(ix*ix); });
+    }
+    group.wait();
+
+    for (IndexType ix = 0; ix < results.size(); ++ix)
+    {
+        BOOST_CHECK_EQUAL(results[ix], int(ix*ix));
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(task_pool_test_parallel_for_chunks)
+{
+    TaskPool pool(3);
+
+    // Every index is visited once, in chunks of the grain size
+    std::vector<std::atomic<int> > visits(1000);
+    for (auto &count : visits)
+    {
+        count = 0;
+    }
+
+    std::atomic<int> bad_chunks(0);
+    parallel_for(5, 1000,
+                 [&](IndexType begin, IndexType end)
+                 {
+                     if (((begin - 5) % 7 != 0) ||
+                         ((end - begin != 7) && (end != 1000)))
+                     {
+                         ++bad_chunks;
+                     }
+                     for (IndexType ix = begin; ix < end; ++ix)
+                     {
+                         ++visits[ix];
+                     }
+                 },
+                 7, pool);
+
+    BOOST_CHECK_EQUAL(bad_chunks.load(), 0);
+    for (IndexType ix = 0; ix < visits.size(); ++ix)
+    {
+        BOOST_CHECK_EQUAL(visits[ix].load(), (ix < 5) ? 0 : 1);
+    }
+
+    // An empty range does nothing
+    parallel_for(10, 10, [&](IndexType, IndexType) { ++bad_chunks; }, 1, pool);
+    BOOST_CHECK_EQUAL(bad_chunks.load(), 0);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(task_pool_test_nested)
+{
+    TaskPool pool(4);
+
+    // Tasks that wait on tasks of their own do not deadlock
+    std::vector<IndexType> sums(20, 0);
+    parallel_for(0, sums.size(),
+                 [&](IndexType begin, IndexType end)
+                 {
+                     for (IndexType outer = begin; outer < end; ++outer)
+                     {
+                         std::vector<IndexType> inner(50, 0);
+                         parallel_for(0, inner.size(),
+                                      [&](IndexType b, IndexType e)
+                                      {
+                                          for (IndexType ix = b; ix < e; ++ix)
+                                          {
+                                              inner[ix] = outer + ix;
+                                          }
+                                      },
+                                      1, pool);
+                         for (auto val : inner)
+                         {
+                             sums[outer] += val;
+                         }
+                     }
+                 },
+                 1, pool);
+
+    for (IndexType outer = 0; outer < sums.size(); ++outer)
+    {
+        BOOST_CHECK_EQUAL(sums[outer], 50*outer + 49*50/2);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(task_pool_test_exception)
+{
+    TaskPool pool(4);
+
+    TaskGroup group(pool);
+    std::atomic<int> count(0);
+    for (int ix = 0; ix < 10; ++ix)
+    {
+        group.run([&count, ix]()
+                  {
+                      ++count;
+                      if (ix == 3)
+                      {
+                          throw std::runtime_error("task failed");
+                      }
+                  });
+    }
+    BOOST_CHECK_THROW(group.wait(), std::runtime_error);
+    BOOST_CHECK_EQUAL(count.load(), 10);
+
+    // The group can be used again
+    group.run([&count]() { ++count; });
+    group.wait();
+    BOOST_CHECK_EQUAL(count.load(), 11);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(task_pool_test_single_thread)
+{
+    TaskPool pool(1);
+    BOOST_CHECK_EQUAL(pool.num_threads(), 1);
+
+    // Tasks run at once, in order, on the calling thread
+    std::vector<IndexType> order;
+    TaskGroup group(pool);
+    for (IndexType ix = 0; ix < 5; ++ix)
+    {
+        group.run([&order, ix]() { order.push_back(ix); });
+    }
+    BOOST_CHECK_EQUAL(order.size(), 5);
+    group.wait();
+
+    parallel_for(5, 10,
+                 [&order](IndexType begin, IndexType end)
+                 {
+                     for (IndexType ix = begin; ix < end; ++ix)
+                     {
+                         order.push_back(ix);
+                     }
+                 },
+                 2, pool);
+
+    for (IndexType ix = 0; ix < order.size(); ++ix)
+    {
+        BOOST_CHECK_EQUAL(order[ix], ix);
+    }
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(task_pool_test_operations_in_tasks)
+{
+    TaskPool pool(4);
+
+    // Independent operations on a shared matrix run in separate tasks
+    IndexType const N(40);
+    Matrix<int> A(N, N);
+    IndexArrayType i, j;
+    std::vector<int> v;
+    for (IndexType ix = 0; ix < N; ++ix)
+    {
+        i.push_back(ix);
+        j.push_back((ix*7 + 3) % N);
+        v.push_back(int(ix) + 1);
+    }
+    A.build(i, j, v);
+
+    std::vector<int> sums(N, -1);
+    parallel_for(0, N,
+                 [&](IndexType begin, IndexType end)
+                 {
+                     for (IndexType ix = begin; ix < end; ++ix)
+                     {
+                         Vector<int> u(N);
+                         u.setElement(ix, 2);
+                         Vector<int> w(N);
+                         vxm(w, NoMask(), NoAccumulate(),
+                             ArithmeticSemiring<int>(), u, A);
+                         int sum(0);
+                         reduce(sum, NoAccumulate(), PlusMonoid<int>(), w);
+                         sums[ix] = sum;
+                     }
+                 },
+                 3, pool);
+
+    for (IndexType ix = 0; ix < N; ++ix)
+    {
+        BOOST_CHECK_EQUAL(sums[ix], 2*(int(ix) + 1));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
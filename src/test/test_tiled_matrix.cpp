@@ -0,0 +1,255 @@
+/*
+ * GraphBLAS Template Library, Version 2.0
+ *
+ * Copyright 2018 Carnegie Mellon University, Battelle Memorial Institute, and
+ * Authors. All Rights Reserved.
+ *
+ * THIS MATERIAL WAS PREPARED AS AN ACCOUNT OF WORK SPONSORED BY AN AGENCY OF
+ * THE UNITED STATES GOVERNMENT.  NEITHER THE UNITED STATES GOVERNMENT NOR THE
+ * UNITED STATES DEPARTMENT OF ENERGY, NOR THE UNITED STATES DEPARTMENT OF
+ * DEFENSE, NOR CARNEGIE MELLON UNIVERSITY, NOR BATTELLE, NOR ANY OF THEIR
+ * EMPLOYEES, NOR ANY JURISDICTION OR ORGANIZATION THAT HAS COOPERATED IN THE
+ * DEVELOPMENT OF THESE MATERIALS, MAKES ANY WARRANTY, EXPRESS OR IMPLIED, OR
+ * ASSUMES ANY LEGAL LIABILITY OR RESPONSIBILITY FOR THE ACCURACY, COMPLETENESS,
+ * OR USEFULNESS OR ANY INFORMATION, APPARATUS, PRODUCT, SOFTWARE, OR PROCESS
+ * DISCLOSED, OR REPRESENTS THAT ITS USE WOULD NOT INFRINGE PRIVATELY OWNED
+ * RIGHTS..
+ *
+ * Released under a BSD (SEI)-style license, please see license.txt or contact
+ * permission@sei.cmu.edu for full terms.
+ *
+ * This release is an update of:
+ *
+ * 1. GraphBLAS Template Library (GBTL)
+ * (https://github.com/cmu-sei/gbtl/blob/1.0.0/LICENSE) Copyright 2015 Carnegie
+ * Mellon University and The Trustees of Indiana. DM17-0037, DM-0002659
+ *
+ * DM18-0559
+ */
+
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <graphblas/graphblas.hpp>
+#include <algorithms/bfs.hpp>
+#include <algorithms/page_rank.hpp>
+
+using namespace GraphBLAS;
+
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_MODULE tiled_matrix_test_suite
+
+#include <boost/test/included/unit_test.hpp>
+
+namespace
+{
+    /// A path for a file that is removed at the end of the test.
+    class TempPath
+    {
+    public:
+        TempPath()
+        {
+            char name[] = "/tmp/gbtl_tiled_XXXXXX";
+            int fd(mkstemp(name));
+            BOOST_REQUIRE(fd >= 0);
+            ::close(fd);
+            m_path = name;
+        }
+
+        ~TempPath() { std::remove(m_path.c_str()); }
+
+        std::string const &path() const { return m_path; }
+
+    private:
+        std::string m_path;
+    };
+
+    /// A random-looking directed graph with some empty rows and columns.
+    Matrix<double> make_graph(IndexType N)
+    {
+        IndexArrayType rows, cols;
+        std::vector<double> vals;
+        for (IndexType idx = 0; idx < 8*N; ++idx)
+        {
+            IndexType row((idx*7919) % N);
+            if (row % 11 != 3)
+            {
+                rows.push_back(row);
+                cols.push_back((idx*104729 + idx/N) % N);
+                vals.push_back(static_cast<double>(idx % 7 + 1));
+            }
+        }
+        Matrix<double> A(N, N);
+        A.build(rows, cols, vals);
+        return A;
+    }
+
+    /// A sparse vector with every third element stored.
+    Vector<double> make_vector(IndexType N)
+    {
+        Vector<double> u(N);
+        for (IndexType idx = 0; idx < N; idx += 3)
+        {
+            u.setElement(idx, static_cast<double>(idx % 5) - 2.);
+        }
+        return u;
+    }
+
+    IndexType const N = 1000;
+
+    // Small tiles, so that the matrices below have many
+    std::size_t const TILE_BYTES = 4096;
+}
+
+BOOST_AUTO_TEST_SUITE(BOOST_TEST_MODULE)
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_tiled_matrix_rows)
+{
+    Matrix<double> A(make_graph(N));
+    TempPath file;
+    save_tiled(file.path(), A, TILE_BYTES);
+
+    TiledMatrix<double> T(file.path());
+    BOOST_CHECK_EQUAL(T.nrows(), N);
+    BOOST_CHECK_EQUAL(T.ncols(), N);
+    BOOST_CHECK_EQUAL(T.nvals(), A.nvals());
+    BOOST_CHECK(T.numTiles() > 10);
+
+    // Rebuild A from the tiles
+    IndexArrayType rows, cols;
+    std::vector<double> vals;
+    IndexType next_row(0);
+    T.forEachTile(
+        [&](TiledMatrix<double>::Tile const &tile)
+        {
+            BOOST_CHECK_EQUAL(tile.rowBegin(), next_row);
+            next_row = tile.rowEnd();
+            for (IndexType row_idx = tile.rowBegin(); row_idx < tile.rowEnd();
+                 ++row_idx)
+            {
+                for (auto elt : tile.getRow(row_idx))
+                {
+                    rows.push_back(row_idx);
+                    cols.push_back(std::get<0>(elt));
+                    vals.push_back(std::get<1>(elt));
+                }
+            }
+        });
+    BOOST_CHECK_EQUAL(next_row, N);
+
+    Matrix<double> B(N, N);
+    B.build(rows, cols, vals);
+    BOOST_CHECK_EQUAL(A, B);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_tiled_matrix_operations)
+{
+    Matrix<double> A(make_graph(N));
+    Vector<double> u(make_vector(N));
+    TempPath file;
+    save_tiled(file.path(), A, TILE_BYTES);
+    TiledMatrix<double> T(file.path());
+
+    Vector<double> expected(N), result(N);
+    mxv(expected, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    mxv(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), T, u);
+    BOOST_CHECK_EQUAL(expected, result);
+
+    // with a mask and an accumulator
+    mxv(expected, complement(u), Plus<double>(), MinPlusSemiring<double>(),
+        A, u, true);
+    mxv(result, complement(u), Plus<double>(), MinPlusSemiring<double>(),
+        T, u, true);
+    BOOST_CHECK_EQUAL(expected, result);
+
+    vxm(expected, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), u, A);
+    vxm(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), u, T);
+    BOOST_CHECK_EQUAL(expected, result);
+
+    vxm(expected, u, Second<double>(), MaxTimesSemiring<double>(), u, A);
+    vxm(result, u, Second<double>(), MaxTimesSemiring<double>(), u, T);
+    BOOST_CHECK_EQUAL(expected, result);
+
+    reduce(expected, NoMask(), NoAccumulate(), Plus<double>(), A);
+    reduce(result, NoMask(), NoAccumulate(), Plus<double>(), T);
+    BOOST_CHECK_EQUAL(expected, result);
+
+    double expected_sum(1), sum(1);
+    reduce(expected_sum, Plus<double>(), PlusMonoid<double>(), A);
+    reduce(sum, Plus<double>(), PlusMonoid<double>(), T);
+    BOOST_CHECK_EQUAL(expected_sum, sum);
+
+    {
+        ReductionContext reproducible(ReductionMode::REPRODUCIBLE);
+        reduce(expected_sum, NoAccumulate(), PlusMonoid<double>(), A);
+        reduce(sum, NoAccumulate(), PlusMonoid<double>(), T);
+        BOOST_CHECK_EQUAL(expected_sum, sum);
+    }
+
+    BOOST_CHECK_THROW(
+        mxv(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(),
+            T, Vector<double>(N + 1)),
+        DimensionException);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_tiled_matrix_algorithms)
+{
+    Matrix<double> A(make_graph(N));
+    TempPath file;
+    save_tiled(file.path(), A, TILE_BYTES);
+    TiledMatrix<double> T(file.path());
+
+    Vector<double> expected_rank(N), rank(N);
+    algorithms::page_rank(A, expected_rank);
+    algorithms::page_rank(T, rank);
+    BOOST_REQUIRE_EQUAL(expected_rank.nvals(), rank.nvals());
+    for (IndexType idx = 0; idx < N; ++idx)
+    {
+        BOOST_CHECK_CLOSE(expected_rank.extractElement(idx),
+                          rank.extractElement(idx), 1e-9);
+    }
+
+    Vector<unsigned int> root(N), expected_parents(N), parents(N);
+    root.setElement(0, 1);
+    algorithms::bfs(A, root, expected_parents);
+    algorithms::bfs(T, root, parents);
+    BOOST_CHECK_EQUAL(expected_parents, parents);
+}
+
+//****************************************************************************
+BOOST_AUTO_TEST_CASE(test_tiled_matrix_from_snapshot)
+{
+    Matrix<double> A(make_graph(N));
+    TempPath snapshot, file;
+    save(snapshot.path(), A);
+    {
+        MappedMatrix<double> M(snapshot.path());
+        save_tiled(file.path(), M, TILE_BYTES);
+    }
+
+    TiledMatrix<double> T(file.path());
+    Vector<double> u(make_vector(N)), expected(N), result(N);
+    mxv(expected, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), A, u);
+    mxv(result, NoMask(), NoAccumulate(), ArithmeticSemiring<double>(), T, u);
+    BOOST_CHECK_EQUAL(expected, result);
+
+    // the wrong scalar type, or not a tiled matrix
+    BOOST_CHECK_THROW(TiledMatrix<float>(file.path()), IOException);
+    BOOST_CHECK_THROW(TiledMatrix<double>(snapshot.path()), IOException);
+
+    // a writer rejects rows past the end and indices out of range
+    TiledMatrixWriter<double> out(file.path(), 1, 4);
+    std::vector<std::tuple<IndexType, double> > row = {std::make_tuple(4, 1.)};
+    BOOST_CHECK_THROW(out.appendRow(row), IndexOutOfBoundsException);
+}
+
+BOOST_AUTO_TEST_SUITE_END()